@@ -402,6 +402,8 @@ void ofxCvImage::draw( float x, float y, float w, float h ) {
             y += roiY;
         }
                 
+        // the headless BigBlobby tracker does not link OpenGL
+        #ifndef BLOBBY_HEADLESS
         glRasterPos2f( x, y+h );
 
         IplImage* tempImg;
@@ -411,6 +413,7 @@ void ofxCvImage::draw( float x, float y, float w, float h ) {
         glDrawPixels( tempImg->width, tempImg->height ,
                       glchannels, gldepth, tempImg->imageData );
         cvReleaseImage( &tempImg );
+        #endif
        
     }
 }
@@ -45,6 +45,13 @@ bool ofxPS3::isFrameNew()
 	return PS3EyeMulticamGetFrame(pBuffer);
 }
 
+// Blocks until the driver delivers a frame (or the timeout, in milliseconds,
+// runs out) and copies it into the pixel buffer.
+bool ofxPS3::waitForFrame(int waitTimeout)
+{
+	return PS3EyeMulticamGetFrame(pBuffer, waitTimeout);
+}
+
 void ofxPS3::initPS3(int width, int height, int framerate)
 {
 	printf("selecting format...\n");
@@ -20,6 +20,7 @@ public:
 	static int getDeviceCount();
 	void showSettings();
 	bool isFrameNew();
+	bool waitForFrame(int waitTimeout);
 	PBYTE getPixels();
 };
 #endif // OFXPS3_H_
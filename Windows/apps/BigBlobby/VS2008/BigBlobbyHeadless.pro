@@ -0,0 +1,159 @@
+# ----------------------------------------------------
+# Headless BigBlobby tracker (Linux): blob detection and TUIO output with no
+# Qt GUI and no OpenGL calls.  QtCore and QtXml are only used to read the
+# DefaultBlobParams.xml settings (BlobParamsXmlReader/BlobParamsValidator).
+#
+# Build:  qmake BigBlobbyHeadless.pro && make
+# Run:    ./bin/BigBlobbyHeadless [--weighted-centroids] [--weighted-angles]
+#                                 [--optimal-assignment]
+#                                 [data/settings/DefaultBlobParams.xml]
+#         ./bin/BigBlobbyHeadless --benchmark-tracker
+#
+# openFrameworks' window, graphics, image and texture sources are left out,
+# so the tracker needs neither libGL nor GLUT at run time.  BLOBBY_HEADLESS
+# compiles out every draw call (in BigBlobby, ofUtils, ofMath and ofxCvImage),
+# and blobHeadless/HeadlessTexture.cpp stands in for ofTexture.cpp (the 
+# ofxOpenCv images and ofVideoGrabber own an ofTexture).  The OpenGL headers
+# are still needed to compile, since ofConstants.h includes them.
+# ------------------------------------------------------
+
+TEMPLATE = app
+TARGET = BigBlobbyHeadless
+DESTDIR = ./bin
+QT = core xml
+CONFIG += console release
+CONFIG -= app_bundle
+DEFINES += BLOBBY_HEADLESS QT_XML_LIB POCO_STATIC
+INCLUDEPATH += ./src \
+    ./../../../libs/openFrameworks \
+    ./../../../libs/openFrameworks/graphics \
+    ./../../../libs/openFrameworks/app \
+    ./../../../libs/openFrameworks/utils \
+    ./../../../libs/openFrameworks/communication \
+    ./../../../libs/openFrameworks/video \
+    ./../../../libs/openFrameworks/events \
+    ./../../../libs/openFrameworks/sound \
+    ./../../../libs/free_type_2.1.4/include \
+    ./../../../libs/freeImage \
+    ./../../../libs/Poco/include \
+    ./../../../addons \
+    ./../../../addons/ofxNetwork/src \
+    ./../../../addons/ofxOpenCv/src \
+    ./../../../addons/ofxOsc/src \
+    ./../../../addons/ofxOsc/libs/oscpack/include/ip \
+    ./../../../addons/ofxOsc/libs/oscpack/include/osc \
+    ./../../../addons/ofxXmlSettings/libs \
+    ./../../../addons/ofxXmlSettings/src
+unix:LIBS += -lopencv_core -lopencv_imgproc -lopencv_highgui \
+    -lboost_thread -lboost_system -lboost_chrono -lboost_atomic \
+    -loscpack -lunicap -lpthread -lrt
+MOC_DIR += ./GeneratedFiles/headless
+OBJECTS_DIR += headless
+
+SOURCES += ./src/blobHeadless/HeadlessMain.cpp \
+    ./src/blobHeadless/HeadlessTexture.cpp \
+    ./src/blobHeadless/HeadlessVision.cpp \
+    ./src/blobHeadless/TrackerBenchmark.cpp \
+    ./src/blobBuffers/BitBuffer.cpp \
+    ./src/blobBuffers/BufferUtility.cpp \
+    ./src/blobBuffers/GrayBuffer.cpp \
+    ./src/blobBuffers/GrayBufferPool.cpp \
+    ./src/blobBuffers/GrayBufferShort.cpp \
+    ./src/blobBuffers/GrayBufferView.cpp \
+    ./src/blobCalibration/BlobCalibration.cpp \
+    ./src/blobCalibration/CalibrationLookup.cpp \
+    ./src/blobCalibration/CalibrationUtils.cpp \
+    ./src/blobCalibration/FastCalibration.cpp \
+    ./src/blobCore/CoreVision.cpp \
+    ./src/blobCore/FramePipeline.cpp \
+    ./src/blobCore/VisionFrame.cpp \
+    ./src/blobEnums/FilterEnum.cpp \
+    ./src/blobEnums/KeyEnum.cpp \
+    ./src/blobEnums/PixelFormatEnum.cpp \
+    ./src/blobEnums/SimdEnum.cpp \
+    ./src/blobEnums/TuioProfileEnum.cpp \
+    ./src/blobExceptions/BlobException.cpp \
+    ./src/blobExceptions/BlobIOException.cpp \
+    ./src/blobExceptions/BlobParamsException.cpp \
+    ./src/blobExceptions/BlobXmlReaderException.cpp \
+    ./src/blobExceptions/CalibrationException.cpp \
+    ./src/blobExceptions/FileNotFoundException.cpp \
+    ./src/blobExceptions/UnknownXmlTagException.cpp \
+    ./src/blobFilters/BackgroundFilter.cpp \
+    ./src/blobFilters/BlobFilter.cpp \
+    ./src/blobFilters/BoxFilter.cpp \
+    ./src/blobFilters/DisplayTaps.cpp \
+    ./src/blobFilters/FilterGraph.cpp \
+    ./src/blobFilters/FilterStrip.cpp \
+    ./src/blobFilters/FusedPointwiseFilter.cpp \
+    ./src/blobFilters/HighpassFilter.cpp \
+    ./src/blobFilters/ImageFilters.cpp \
+    ./src/blobFilters/MaskFilter.cpp \
+    ./src/blobFilters/MaskSpans.cpp \
+    ./src/blobFilters/SignalNormalizationFilter.cpp \
+    ./src/blobFilters/SmoothingFilter.cpp \
+    ./src/blobFilters/ThresholdFilter.cpp \
+    ./src/blobIO/BlobParamsValidator.cpp \
+    ./src/blobIO/BlobParamsXmlReader.cpp \
+    ./src/blobIO/DebugPrint.cpp \
+    ./src/blobKernels/Avx2Kernels.cpp \
+    ./src/blobKernels/CpuFeatures.cpp \
+    ./src/blobKernels/GrayKernels.cpp \
+    ./src/blobKernels/ScalarKernels.cpp \
+    ./src/blobKernels/Sse2Kernels.cpp \
+    ./src/blobKernels/Sse41Kernels.cpp \
+    ./src/blobNormalize/CalibrationGridPoints.cpp \
+    ./src/blobNormalize/CameraPoint.cpp \
+    ./src/blobNormalize/CameraPoints.cpp \
+    ./src/blobNormalize/FishEyeGrid.cpp \
+    ./src/blobNormalize/GridPoint.cpp \
+    ./src/blobStats/FilterStats.cpp \
+    ./src/blobStats/Stats.cpp \
+    ./src/blobTouchEvents/TouchEvents.cpp \
+    ./src/blobTouchEvents/TouchListener.cpp \
+    ./src/blobTracker/AssignmentSolver.cpp \
+    ./src/blobTracker/Blob.cpp \
+    ./src/blobTracker/BlobGrid.cpp \
+    ./src/blobTracker/BlobMatch.cpp \
+    ./src/blobTracker/BlobTracker.cpp \
+    ./src/blobTracker/CPUImageFilter.cpp \
+    ./src/blobTracker/ComponentLabeller.cpp \
+    ./src/blobTracker/ContourFinder.cpp \
+    ./src/blobTracker/TrackedBlobHolder.cpp \
+    ./src/blobTuio/BinaryTcpChannel.cpp \
+    ./src/blobTuio/FlashXmlChannel.cpp \
+    ./src/blobTuio/OutputChannel.cpp \
+    ./src/blobTuio/TuioChannels.cpp \
+    ./src/blobTuio/TuioUdpChannel.cpp \
+    ./src/blobUtils/BackgroundTimer.cpp \
+    ./src/blobUtils/FrameSignal.cpp \
+    ./src/blobUtils/FunctionTimer.cpp \
+    ./src/blobUtils/StopWatch.cpp \
+    ./src/blobUtils/WorkStealingPool.cpp \
+    ./src/blobVideo/FrameSource.cpp \
+    ./src/blobVideo/SharedFrameRing.cpp \
+    ./src/blobVideo/SharedFrameSource.cpp \
+    ./src/blobVideo/SimpleVideoReader.cpp \
+    ./src/blobVideo/SimpleVideoWriter.cpp \
+    ./src/blobVideo/V4l2FrameSource.cpp \
+    ./src/blobVideo/VideoGrabberFrameSource.cpp \
+    ../../../libs/openFrameworks/utils/ofMath.cpp \
+    ../../../libs/openFrameworks/utils/ofUtils.cpp \
+    ../../../libs/openFrameworks/video/ofUCUtils.cpp \
+    ../../../libs/openFrameworks/video/ofVideoGrabber.cpp \
+    ../../../addons/ofxNetwork/src/ofxTCPClient.cpp \
+    ../../../addons/ofxNetwork/src/ofxTCPManager.cpp \
+    ../../../addons/ofxNetwork/src/ofxTCPServer.cpp \
+    ../../../addons/ofxNetwork/src/ofxUDPManager.cpp \
+    ../../../addons/ofxOpenCv/src/ofxCvColorImage.cpp \
+    ../../../addons/ofxOpenCv/src/ofxCvFloatImage.cpp \
+    ../../../addons/ofxOpenCv/src/ofxCvGrayscaleImage.cpp \
+    ../../../addons/ofxOpenCv/src/ofxCvImage.cpp \
+    ../../../addons/ofxOpenCv/src/ofxCvShortImage.cpp \
+    ../../../addons/ofxOsc/src/ofxOscBundle.cpp \
+    ../../../addons/ofxOsc/src/ofxOscMessage.cpp \
+    ../../../addons/ofxOsc/src/ofxOscSender.cpp \
+    ../../../addons/ofxXmlSettings/src/ofxXmlSettings.cpp \
+    ../../../addons/ofxXmlSettings/libs/tinyxml.cpp \
+    ../../../addons/ofxXmlSettings/libs/tinyxmlerror.cpp \
+    ../../../addons/ofxXmlSettings/libs/tinyxmlparser.cpp
@@ -0,0 +1,25 @@
+# ----------------------------------------------------
+# Reference producer for the shared-memory frame ingest (Linux): writes 
+# synthetic frames of moving blobs into a SharedFrameRing, so that 
+# BigBlobby's SharedFrameSource can be tested without vendor camera software.
+#
+# Build:  qmake SharedFrameProducer.pro && make
+# Run:    ./bin/SharedFrameProducer [name [width [height [framesPerSecond]]]]
+#
+# Then set <sharedFrameRing> /bigblobby </sharedFrameRing> (or the name given
+# to the producer) in the <Camera> section of DefaultBlobParams.xml.
+# ------------------------------------------------------
+
+TEMPLATE = app
+TARGET = SharedFrameProducer
+DESTDIR = ./bin
+QT -= core gui
+CONFIG += console release
+CONFIG -= app_bundle qt
+INCLUDEPATH += ./src
+unix:LIBS += -lboost_thread -lboost_system -lboost_chrono -lboost_atomic -lpthread -lrt
+OBJECTS_DIR += producer
+
+SOURCES += ./src/blobProducer/SharedFrameProducer.cpp \
+    ./src/blobEnums/PixelFormatEnum.cpp \
+    ./src/blobVideo/SharedFrameRing.cpp
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// BitBuffer
+//
+// PURPOSE: Holds a black and white image packed one bit per pixel, 64 pixels
+//          to a word, as written by the threshold filter for the blob finder.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobBuffers/BitBuffer.h"
+#include <cstring>
+
+using blobBuffers::BitBuffer;
+
+const int BitBuffer::BITS_PER_WORD = 64;
+
+BitBuffer::BitBuffer( int w, int h ) :
+  words_( NULL ),
+  width_( w ),
+  height_( h ),
+  wordsPerRow_( wordsForWidth( w ) )
+{
+    words_ = new Word[wordsPerRow_ * height_];
+    zeroAllBits();
+}
+
+BitBuffer::~BitBuffer()
+{
+    delete [] words_;
+}
+
+/***************************************************************************//**
+The number of words needed for a row of the given number of pixels.
+*******************************************************************************/
+int BitBuffer::wordsForWidth( int width )
+{
+    return (width + BITS_PER_WORD - 1) / BITS_PER_WORD;
+}
+
+int BitBuffer::width() const
+{
+    return width_;
+}
+
+int BitBuffer::height() const
+{
+    return height_;
+}
+
+int BitBuffer::wordsPerRow() const
+{
+    return wordsPerRow_;
+}
+
+BitBuffer::Word * BitBuffer::words() const
+{
+    return words_;
+}
+
+BitBuffer::Word * BitBuffer::row( int r ) const
+{
+    return words_ + (r * wordsPerRow_);
+}
+
+bool BitBuffer::isSet( int row, int col ) const
+{
+    if( row < 0 || row >= height_ || col < 0 || col >= width_ ) {
+        return false;
+    }
+    Word word = words_[(row * wordsPerRow_) + (col / BITS_PER_WORD)];
+    return ((word >> (col % BITS_PER_WORD)) & 1) != 0;
+}
+
+void BitBuffer::copyBits( const BitBuffer * other )
+{
+    if( isSameWidthAndHeight( other ) ) {
+        std::memcpy( words_, other->words_, wordsPerRow_ * height_ * sizeof( Word ) );
+    }
+}
+
+bool BitBuffer::isSameWidthAndHeight( const BitBuffer * other ) const
+{
+    return other != NULL 
+        && width_ == other->width_ 
+        && height_ == other->height_;
+}
+
+void BitBuffer::zeroAllBits()
+{
+    std::memset( words_, 0, wordsPerRow_ * height_ * sizeof( Word ) );
+}
+
+void BitBuffer::zeroRow( int r )
+{
+    std::memset( row( r ), 0, wordsPerRow_ * sizeof( Word ) );
+}
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+// BitBuffer
+//
+// PURPOSE: Holds a black and white image packed one bit per pixel, 64 pixels
+//          to a word, as written by the threshold filter for the blob finder.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBBUFFERS_BITBUFFER_H
+#define BLOBBUFFERS_BITBUFFER_H
+
+#include <boost/cstdint.hpp>
+
+namespace blobBuffers
+{
+    /***********************************************************************//**
+    A binary image with one bit per pixel.  Pixel x of a row is bit (x % 64)
+    of word (x / 64) of that row, counting from the least significant bit, 
+    and each row starts on a new word.  The bits past width() in the last 
+    word of a row are always zero.
+
+    A touch image is almost all zeros, so the blob finder can skip 64 empty 
+    pixels with one comparison, and the whole image is an eighth of the size
+    of the 8-bit thresholded image.
+    ***************************************************************************/
+    class BitBuffer
+    {
+    public:
+        typedef boost::uint64_t Word;
+
+        static const int BITS_PER_WORD;
+
+        BitBuffer( int w, int h );
+        ~BitBuffer();
+
+        int width() const;
+        int height() const;
+        int wordsPerRow() const;
+        Word * words() const;
+        Word * row( int r ) const;
+        bool isSet( int row, int col ) const;
+
+        void copyBits( const BitBuffer * other );
+        bool isSameWidthAndHeight( const BitBuffer * other ) const;
+        void zeroAllBits();
+        void zeroRow( int r );
+
+        static int wordsForWidth( int width );
+
+    private:
+        // Not copyable.
+        BitBuffer( const BitBuffer & );
+        BitBuffer & operator=( const BitBuffer & );
+
+        Word * words_;
+        int width_,
+            height_,
+            wordsPerRow_;
+    };
+}
+
+#endif
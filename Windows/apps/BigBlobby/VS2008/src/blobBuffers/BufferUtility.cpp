@@ -2,7 +2,7 @@
 // BufferUtility
 //
 // PURPOSE: Knows how to copy an image while flipping it about the horizontal
-//          and/or vertical axis.
+//          and/or vertical axis (and converting it to gray).
 //
 // CREATED: 5/22/2014
 ////////////////////////////////////////////////////////////////////////////////
@@ -45,10 +45,12 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobBuffers/BufferUtility.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobKernels/GrayKernels.h"
 #include <opencv2/imgproc/imgproc.hpp>
 #include <iostream>
 
 using blobBuffers::BufferUtility;
+using blobKernels::GrayKernels;
 
 const int BufferUtility::GRAY_CHANNEL = 1,
           BufferUtility::RGB_CHANNELS = 3,
@@ -72,30 +74,63 @@ void BufferUtility::process( unsigned char * pixels,
                              int channels,
                              blobBuffers::GrayBuffer * dstImage )
 {
-    if(  width > 0 && height > 0 && dstImage != NULL ) {
-        if( channels == GRAY_CHANNEL ) {
-            copyGrayImage( pixels, width, height, dstImage );
-        }
-        else if( channels == RGB_CHANNELS ) {
-            copyRgbImage( pixels, width, height, dstImage );
+    if( channels == GRAY_CHANNEL ) {
+        copyFrame( pixels, width, height, width, blobEnums::PixelFormatEnum::GRAY8, dstImage );
+    }
+    else if( channels == RGB_CHANNELS ) {
+        copyFrame( pixels, width, height, width * 3, blobEnums::PixelFormatEnum::RGB24, dstImage );
+    }
+}
+
+/***************************************************************************//**
+Converts a camera frame to gray and flips it (if requested) on the way into 
+the destination image, in a single pass: each destination row is made from 
+the source row that the flip puts there.  Only the luma is read from YUYV 
+frames, and gray frames are just copied.  The stride is the number of bytes 
+from one source row to the next.
+*******************************************************************************/
+void BufferUtility::copyFrame( const unsigned char * pixels,
+                               int width,
+                               int height,
+                               int stride,
+                               blobEnums::PixelFormatEnum::Enum pixelFormat,
+                               blobBuffers::GrayBuffer * dstImage )
+{
+    if( pixels != NULL && width > 0 && height > 0 && dstImage != NULL 
+        && dstImage->width() == width && dstImage->height() == height ) 
+    {
+        for( int row = 0; row < height; ++row ) {
+            int srcRow = flipVertical_ ? (height - 1 - row) : row;
+            copyRow( pixels + (srcRow * stride), dstImage->row( row ), width, pixelFormat );
         }
     }
 }
 
-void BufferUtility::copyGrayImage( unsigned char * pixels, int width, int height,
-                                   blobBuffers::GrayBuffer * dstImage )
+/***************************************************************************//**
+False if a frame in the given format can be used as a gray image as it is 
+(it is GRAY8 and no flip has been requested).
+*******************************************************************************/
+bool BufferUtility::needsCopy( blobEnums::PixelFormatEnum::Enum pixelFormat )
 {
-    dstImage->copyPixels( pixels, width, height );
-    flipIfRequested( dstImage );
+    return pixelFormat != blobEnums::PixelFormatEnum::GRAY8 || flipVertical_ || flipHorizontal_;
 }
 
-void BufferUtility::copyRgbImage( unsigned char * pixels, int width, int height,
-                                  blobBuffers::GrayBuffer * dstImage )
+void BufferUtility::copyRow( const unsigned char * src, 
+                             unsigned char * dst, 
+                             int width, 
+                             blobEnums::PixelFormatEnum::Enum pixelFormat )
 {
-    cv::Mat srcM( height, width, CV_8UC3, pixels, width * 3 );
-    cv::Mat dstM( height, width, CV_8U, dstImage->pixels(), width );
-    cv::cvtColor( srcM, dstM, CV_RGB2GRAY, 1 );
-    flipIfRequested( dstImage );
+    switch( pixelFormat ) {
+        case blobEnums::PixelFormatEnum::GRAY8:
+            GrayKernels::copyGray( src, dst, width, flipHorizontal_ );
+            break;
+        case blobEnums::PixelFormatEnum::YUYV:
+            GrayKernels::yuyvToGray( src, dst, width, flipHorizontal_ );
+            break;
+        case blobEnums::PixelFormatEnum::RGB24:
+            GrayKernels::rgbToGray( src, dst, width, flipHorizontal_ );
+            break;
+    }
 }
 
 void BufferUtility::flipIfRequested( blobBuffers::GrayBuffer * buffer )
@@ -103,7 +138,7 @@ void BufferUtility::flipIfRequested( blobBuffers::GrayBuffer * buffer )
     if( (flipVertical_ || flipHorizontal_) && buffer != NULL ) {
         int width = buffer->width(),
             height = buffer->height();
-        cv::Mat dstM( height, width, CV_8U, buffer->pixels(), width );
+        cv::Mat dstM( height, width, CV_8U, buffer->pixels(), buffer->stride() );
 
         if( flipVertical_ && flipHorizontal_ ) {
             cv::flip( dstM, dstM, FLIP_ON_BOTH_AXES );
@@ -46,6 +46,8 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BLOBFILTERS_BUFFERUTILITY_H
 #define BLOBFILTERS_BUFFERUTILITY_H
 
+#include "blobEnums/PixelFormatEnum.h"
+
 namespace blobBuffers { class GrayBuffer; }
 
 namespace blobBuffers
@@ -67,6 +69,13 @@ namespace blobBuffers
                       int height,
                       int bytesPerPixel,
                       blobBuffers::GrayBuffer * dstImage );
+        void copyFrame( const unsigned char * pixels,
+                        int width,
+                        int height,
+                        int stride,
+                        blobEnums::PixelFormatEnum::Enum pixelFormat,
+                        blobBuffers::GrayBuffer * dstImage );
+        bool needsCopy( blobEnums::PixelFormatEnum::Enum pixelFormat );
         
         void flipIfRequested( blobBuffers::GrayBuffer * image );
         void setFlipVertical( bool flip );
@@ -75,10 +84,10 @@ namespace blobBuffers
         bool flipHorizontal();
 
     private:
-        void copyGrayImage( unsigned char * pixels, int width, int height,
-                            blobBuffers::GrayBuffer * dstImage );
-        void copyRgbImage( unsigned char * pixels, int width, int height,
-                           blobBuffers::GrayBuffer * dstImage );
+        void copyRow( const unsigned char * src, 
+                      unsigned char * dst, 
+                      int width, 
+                      blobEnums::PixelFormatEnum::Enum pixelFormat );
 
         bool flipVertical_,
              flipHorizontal_;
@@ -44,23 +44,77 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobBuffers/GrayBuffer.h"
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 
 using blobBuffers::GrayBuffer;
 
+// A cache line, which is also enough for AVX2 (32 byte) loads and stores.
+const int GrayBuffer::ALIGNMENT = 64;
+
 GrayBuffer::GrayBuffer( int w, int h ) :
+  allocation_( NULL ),
+  pixels_( NULL ),
+  width_( w ),
+  height_( h ),
+  stride_( w ),
+  numPixels_( w * h ) 
+{
+    allocatePixels();
+    zeroAllPixels();
+}
+
+GrayBuffer::GrayBuffer( int w, int h, int stride ) :
+  allocation_( NULL ),
   pixels_( NULL ),
   width_( w ),
   height_( h ),
+  stride_( std::max( w, stride ) ),
   numPixels_( w * h ) 
 {
-    pixels_ = new unsigned char[numPixels_];
+    allocatePixels();
     zeroAllPixels();
 }
 
+/***************************************************************************//**
+Uses the given pixels (not owned, and with no particular alignment) instead of
+allocating them.  They must stay valid for as long as the buffer is used.
+*******************************************************************************/
+GrayBuffer::GrayBuffer( unsigned char * pixels, int w, int h, int stride ) :
+  allocation_( NULL ),
+  pixels_( pixels ),
+  width_( w ),
+  height_( h ),
+  stride_( std::max( w, stride ) ),
+  numPixels_( w * h ) 
+{
+}
+
 GrayBuffer::~GrayBuffer()
 {
-    delete [] pixels_;
+    delete [] allocation_;
+}
+
+/***************************************************************************//**
+Over-allocates by ALIGNMENT - 1 bytes so that the first pixel can be moved up
+to the next ALIGNMENT-byte boundary.
+*******************************************************************************/
+void GrayBuffer::allocatePixels()
+{
+    allocation_ = new unsigned char[(stride_ * height_) + ALIGNMENT - 1];
+    std::size_t address = (std::size_t)allocation_,
+                offset = (ALIGNMENT - (address % ALIGNMENT)) % ALIGNMENT;
+    pixels_ = allocation_ + offset;
+}
+
+/***************************************************************************//**
+The width rounded up to a whole number of ALIGNMENT-byte blocks, so that every
+row starts on an aligned address.
+*******************************************************************************/
+int GrayBuffer::alignedStride( int width )
+{
+    return ((width + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
 }
 
 int GrayBuffer::width() const
@@ -73,28 +127,87 @@ int GrayBuffer::height() const
     return height_;
 }
 
+/***************************************************************************//**
+Number of bytes from the start of one row to the start of the next.  The 
+bytes past width() at the end of each row are padding and are not part of
+the image.
+*******************************************************************************/
+int GrayBuffer::stride() const
+{
+    return stride_;
+}
+
 int GrayBuffer::numPixels() const
 {
     return numPixels_;
 }
 
+bool GrayBuffer::isContiguous() const
+{
+    return stride_ == width_;
+}
+
+bool GrayBuffer::ownsPixels() const
+{
+    return allocation_ != NULL;
+}
+
 unsigned char * GrayBuffer::pixels() const
 {
     return pixels_;
 }
 
+unsigned char * GrayBuffer::row( int r ) const
+{
+    return pixels_ + (r * stride_);
+}
+
+/***************************************************************************//**
+Copies a contiguous image (no row padding) of the same width and height.
+*******************************************************************************/
 void GrayBuffer::copyPixels( unsigned char * pixels, int width, int height )
 {
     if( width == width_ && height == height_ ) {
-        std::memcpy( pixels_, pixels, numPixels_ );
+        if( isContiguous() ) {
+            std::memcpy( pixels_, pixels, numPixels_ );
+        }
+        else {
+            for( int r = 0; r < height_; ++r ) {
+                std::memcpy( row( r ), pixels + (r * width_), width_ );
+            }
+        }
     }
 }
 
 void GrayBuffer::copyPixels( const GrayBuffer * other )
 {
     if( isSameWidthAndHeight( other ) ) {
-        std::memcpy( pixels_, other->pixels_, numPixels_ );
+        if( stride_ == other->stride_ ) {
+            std::memcpy( pixels_, other->pixels_, stride_ * height_ );
+        }
+        else {
+            for( int r = 0; r < height_; ++r ) {
+                std::memcpy( row( r ), other->row( r ), width_ );
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+Exchanges the pixel arrays of the two buffers, which is how a stage hands its
+output to another buffer without copying it.  Only buffers with the same 
+width, height, and stride that own their pixels can be swapped; otherwise 
+nothing happens and false is returned (and the caller can use copyPixels() 
+instead).
+*******************************************************************************/
+bool GrayBuffer::swapPixels( GrayBuffer * other )
+{
+    if( other == this || !isSameLayout( other ) || !ownsPixels() || !other->ownsPixels() ) {
+        return false;
     }
+    std::swap( allocation_, other->allocation_ );
+    std::swap( pixels_, other->pixels_ );
+    return true;
 }
 
 bool GrayBuffer::isSameWidthAndHeight( const GrayBuffer * other ) const
@@ -104,9 +217,14 @@ bool GrayBuffer::isSameWidthAndHeight( const GrayBuffer * other ) const
         && height_ == other->height_;
 }
 
+bool GrayBuffer::isSameLayout( const GrayBuffer * other ) const
+{
+    return isSameWidthAndHeight( other ) && stride_ == other->stride_;
+}
+
 void GrayBuffer::zeroAllPixels()
 {
-    std::memset( pixels_, 0, numPixels_ );
+    std::memset( pixels_, 0, stride_ * height_ );
 }
 
 unsigned char GrayBuffer::pixel( int row, int col )
@@ -114,7 +232,7 @@ unsigned char GrayBuffer::pixel( int row, int col )
     unsigned char retVal = 0;
 
     if( isWithinRange( row, col ) ) {
-        int index = col + (row * width_);
+        int index = col + (row * stride_);
         retVal = pixels_[index];
     }
     return retVal;
@@ -48,28 +48,58 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace blobBuffers
 {
+    /***********************************************************************//**
+    The pixel array starts on an ALIGNMENT-byte boundary, and each row starts
+    stride() bytes after the one before it.  Buffers made with just a width 
+    and height are contiguous (stride equals width), which is what the GUI 
+    and the video writer expect.  The filter chain gets its buffers from a 
+    GrayBufferPool, where the stride is padded with alignedStride() so that
+    every row is aligned for the SIMD kernels.
+
+    A buffer can also be made around pixels that belong to someone else (a 
+    camera frame, for example), which it does not free and cannot swap.
+    ***************************************************************************/
     class GrayBuffer
     {
     public:
+        static const int ALIGNMENT;
+
         GrayBuffer( int w, int h );
+        GrayBuffer( int w, int h, int stride );
+        GrayBuffer( unsigned char * pixels, int w, int h, int stride );
         ~GrayBuffer();
 
         int width() const;
         int height() const;
+        int stride() const;
         int numPixels() const;
+        bool isContiguous() const;
+        bool ownsPixels() const;
         unsigned char * pixels() const;
+        unsigned char * row( int r ) const;
         void copyPixels( unsigned char * pixels, int width, int height );
         void copyPixels( const GrayBuffer * other );
+        bool swapPixels( GrayBuffer * other );
         bool isSameWidthAndHeight( const GrayBuffer * other ) const;
+        bool isSameLayout( const GrayBuffer * other ) const;
         void zeroAllPixels();
         unsigned char pixel( int row, int col );
 
+        static int alignedStride( int width );
+
     private:
+        // Not copyable.
+        GrayBuffer( const GrayBuffer & );
+        GrayBuffer & operator=( const GrayBuffer & );
+
+        void allocatePixels();
         bool isWithinRange( int row, int col ) ;
 
-        unsigned char * pixels_;
+        unsigned char * allocation_,
+                      * pixels_;
         int width_,
             height_,
+            stride_,
             numPixels_;
     };
 }
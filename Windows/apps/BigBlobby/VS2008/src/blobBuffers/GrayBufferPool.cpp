@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+// GrayBufferPool
+//
+// PURPOSE: Hands out aligned GrayBuffers of one size, and keeps the buffers
+//          that are given back so that they can be handed out again.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobBuffers/GrayBufferPool.h"
+#include "blobBuffers/GrayBuffer.h"
+#include <cstddef>
+
+using blobBuffers::GrayBufferPool;
+
+GrayBufferPool::GrayBufferPool() :
+  width_( 0 ),
+  height_( 0 ),
+  stride_( 0 ),
+  idleBuffers_()
+{
+}
+
+GrayBufferPool::~GrayBufferPool()
+{
+    deleteIdleBuffers();
+}
+
+void GrayBufferPool::deleteIdleBuffers()
+{
+    for( size_t i = 0; i < idleBuffers_.size(); ++i ) {
+        delete idleBuffers_[i];
+    }
+    idleBuffers_.clear();
+}
+
+/***************************************************************************//**
+Changes the size of the buffers that acquire() returns.  The idle buffers of 
+the old size are deleted.
+*******************************************************************************/
+void GrayBufferPool::setSize( int width, int height )
+{
+    if( width != width_ || height != height_ ) {
+        deleteIdleBuffers();
+        width_ = width;
+        height_ = height;
+        stride_ = blobBuffers::GrayBuffer::alignedStride( width );
+    }
+}
+
+int GrayBufferPool::width() const
+{
+    return width_;
+}
+
+int GrayBufferPool::height() const
+{
+    return height_;
+}
+
+int GrayBufferPool::stride() const
+{
+    return stride_;
+}
+
+int GrayBufferPool::numIdleBuffers() const
+{
+    return (int)idleBuffers_.size();
+}
+
+/***************************************************************************//**
+Returns an all-zero buffer, reusing an idle one if there is one.  Returns NULL
+if no size has been set.
+*******************************************************************************/
+blobBuffers::GrayBuffer * GrayBufferPool::acquire()
+{
+    if( width_ <= 0 || height_ <= 0 ) {
+        return NULL;
+    }
+    if( idleBuffers_.empty() ) {
+        return new blobBuffers::GrayBuffer( width_, height_, stride_ );
+    }
+    blobBuffers::GrayBuffer * buffer = idleBuffers_.back();
+    idleBuffers_.pop_back();
+    buffer->zeroAllPixels();
+    return buffer;
+}
+
+void GrayBufferPool::release( blobBuffers::GrayBuffer * buffer )
+{
+    if( buffer == NULL ) {
+        return;
+    }
+    if( buffer->width() == width_ && buffer->height() == height_ && buffer->stride() == stride_ ) {
+        idleBuffers_.push_back( buffer );
+    }
+    else {
+        delete buffer;
+    }
+}
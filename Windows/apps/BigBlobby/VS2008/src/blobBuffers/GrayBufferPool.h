@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// GrayBufferPool
+//
+// PURPOSE: Hands out aligned GrayBuffers of one size, and keeps the buffers
+//          that are given back so that they can be handed out again.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBBUFFERS_GRAYBUFFERPOOL_H
+#define BLOBBUFFERS_GRAYBUFFERPOOL_H
+
+#include <vector>
+
+namespace blobBuffers { class GrayBuffer; }
+
+namespace blobBuffers
+{
+    /***********************************************************************//**
+    Every buffer from the pool has the pool's width and height, starts on a 
+    GrayBuffer::ALIGNMENT boundary, and has a stride padded to a multiple of
+    GrayBuffer::ALIGNMENT, so any two of them can trade pixels with 
+    GrayBuffer::swapPixels().
+
+    The caller owns a buffer from acquire() until it hands it back with 
+    release().  The pool deletes the buffers it is holding when it is 
+    deleted or resized; buffers that are still out are not tracked, and a
+    buffer of the wrong size that is released is simply deleted.  The pool
+    is meant to be used from one thread (the filter thread), so it does no
+    locking.
+    ***************************************************************************/
+    class GrayBufferPool
+    {
+    public:
+        GrayBufferPool();
+        ~GrayBufferPool();
+
+        void setSize( int width, int height );
+        int width() const;
+        int height() const;
+        int stride() const;
+        int numIdleBuffers() const;
+
+        blobBuffers::GrayBuffer * acquire();
+        void release( blobBuffers::GrayBuffer * buffer );
+
+    private:
+        // Not copyable.
+        GrayBufferPool( const GrayBufferPool & );
+        GrayBufferPool & operator=( const GrayBufferPool & );
+
+        void deleteIdleBuffers();
+
+        int width_,
+            height_,
+            stride_;
+        std::vector<blobBuffers::GrayBuffer *> idleBuffers_;
+    };
+}
+
+#endif
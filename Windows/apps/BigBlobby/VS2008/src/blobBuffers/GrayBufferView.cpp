@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// GrayBufferView
+//
+// PURPOSE: A non-owning view of a rectangle of a GrayBuffer (or of any 8-bit
+//          image with a row stride).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobBuffers/GrayBufferView.h"
+#include "blobBuffers/GrayBuffer.h"
+#include <algorithm>
+#include <cstddef>
+
+using blobBuffers::GrayBufferView;
+
+GrayBufferView::GrayBufferView() :
+  pixels_( NULL ),
+  width_( 0 ),
+  height_( 0 ),
+  stride_( 0 )
+{
+}
+
+GrayBufferView::GrayBufferView( const blobBuffers::GrayBuffer * buffer ) :
+  pixels_( NULL ),
+  width_( 0 ),
+  height_( 0 ),
+  stride_( 0 )
+{
+    if( buffer != NULL ) {
+        pixels_ = buffer->pixels();
+        width_ = buffer->width();
+        height_ = buffer->height();
+        stride_ = buffer->stride();
+    }
+}
+
+GrayBufferView::GrayBufferView( unsigned char * pixels, int width, int height, int stride ) :
+  pixels_( pixels ),
+  width_( width ),
+  height_( height ),
+  stride_( stride )
+{
+}
+
+int GrayBufferView::width() const
+{
+    return width_;
+}
+
+int GrayBufferView::height() const
+{
+    return height_;
+}
+
+int GrayBufferView::stride() const
+{
+    return stride_;
+}
+
+bool GrayBufferView::isEmpty() const
+{
+    return pixels_ == NULL || width_ <= 0 || height_ <= 0;
+}
+
+unsigned char * GrayBufferView::pixels() const
+{
+    return pixels_;
+}
+
+unsigned char * GrayBufferView::row( int r ) const
+{
+    return pixels_ + (r * stride_);
+}
+
+/***************************************************************************//**
+The rows [firstRow, endRow) of this view, clipped to the view.
+*******************************************************************************/
+GrayBufferView GrayBufferView::rows( int firstRow, int endRow ) const
+{
+    return region( 0, firstRow, width_, endRow - firstRow );
+}
+
+/***************************************************************************//**
+The w x h rectangle whose top left corner is at column x and row y of this
+view, clipped to the view.  The result is empty if nothing is left after 
+clipping.
+*******************************************************************************/
+GrayBufferView GrayBufferView::region( int x, int y, int w, int h ) const
+{
+    int left = std::max( 0, x ),
+        top = std::max( 0, y ),
+        right = std::min( width_, x + w ),
+        bottom = std::min( height_, y + h );
+
+    if( isEmpty() || right <= left || bottom <= top ) {
+        return GrayBufferView();
+    }
+    return GrayBufferView( row( top ) + left, right - left, bottom - top, stride_ );
+}
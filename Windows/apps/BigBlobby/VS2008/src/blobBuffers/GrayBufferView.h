@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+// GrayBufferView
+//
+// PURPOSE: A non-owning view of a rectangle of a GrayBuffer (or of any 8-bit
+//          image with a row stride).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBBUFFERS_GRAYBUFFERVIEW_H
+#define BLOBBUFFERS_GRAYBUFFERVIEW_H
+
+namespace blobBuffers { class GrayBuffer; }
+
+namespace blobBuffers
+{
+    /***********************************************************************//**
+    Points at pixels that belong to someone else, so it is cheap to copy and
+    pass by value.  A view of a buffer stays valid only as long as the buffer
+    keeps its pixels (swapPixels() moves them to another buffer).  
+    
+    rows() and region() return smaller views of the same pixels, for working 
+    on a strip or a region of interest without copying it.
+    ***************************************************************************/
+    class GrayBufferView
+    {
+    public:
+        GrayBufferView();
+        explicit GrayBufferView( const blobBuffers::GrayBuffer * buffer );
+        GrayBufferView( unsigned char * pixels, int width, int height, int stride );
+
+        int width() const;
+        int height() const;
+        int stride() const;
+        bool isEmpty() const;
+        unsigned char * pixels() const;
+        unsigned char * row( int r ) const;
+
+        GrayBufferView rows( int firstRow, int endRow ) const;
+        GrayBufferView region( int x, int y, int w, int h ) const;
+
+    private:
+        unsigned char * pixels_;
+        int width_,
+            height_,
+            stride_;
+    };
+}
+
+#endif
@@ -84,9 +84,11 @@ BlobCalibration::BlobCalibration() :
   monitorHeight_( 600 ),
   arcAngle_( 0 ),
   targetColor_( 0xFF0000 ),
+#ifndef BLOBBY_HEADLESS
   verdana_(),
   calibrationText_(),
   calibrationParticle_(),
+#endif
   tracker_( NULL ),
   calibrationUtils_(),
   calibrationXML_(),
@@ -126,10 +128,12 @@ void BlobCalibration::setup( int videoWidth, int videoHeight,
     debug_.printLn( "    CALIBRATION_FILE = " + CALIBRATION_FILE );
     debug_.printLn( banner + "\n" );
 
+#ifndef BLOBBY_HEADLESS
     calibrationParticle_.loadImage( "images/particle.png" );
     calibrationParticle_.setUseTexture( true );
     verdana_.loadFont( "verdana.ttf", 7, true, true );
     calibrationText_.loadFont( "verdana.ttf", 14, true, true );
+#endif
     calibrationUtils_.setCamRes( videoWidth, videoHeight );
     calibrationUtils_.setXmlFilename( CALIBRATION_FILE );
     calibrationUtils_.loadXMLSettings();
@@ -187,6 +191,7 @@ int BlobCalibration::numberOfCalibrationGridPoints()
     return calibrationUtils_.numberOfGridPoints();
 }
 
+#ifndef BLOBBY_HEADLESS
 /***************************************************************************//**
 Starts the calibration routine by displaying the full screen showing the
 calibration instructions.
@@ -210,6 +215,7 @@ void BlobCalibration::doCalibration( int screenWidth, int screenHeight )
     }
     drawCalibrationInstructions();
 }
+#endif
 
 /***************************************************************************//**
 Captures camera points and then transfers data to CalibrationUtils.
@@ -237,6 +243,7 @@ std::string BlobCalibration::fastCalibrationSuccessMsg( int numPoints )
     return msg;
 }
 
+#ifndef BLOBBY_HEADLESS
 /***************************************************************************//**
 Draws black filled rectangle to fill the monitor area.
 *******************************************************************************/
@@ -255,12 +262,12 @@ void BlobCalibration::drawCalibrationPoints()
 {
     // This all has to do with getting the angle for loading circle.
     arcAngle_ = 0;
-    std::map<int, blobTracker::Blob> * trackedBlobs = tracker_->getTrackedBlobs();
-    std::map<int, blobTracker::Blob>::iterator iter;
+    std::vector<blobTracker::Blob> * trackedBlobs = tracker_->getTrackedBlobs();
+    std::vector<blobTracker::Blob>::iterator iter;
 
     for( iter = trackedBlobs->begin(); iter != trackedBlobs->end(); ++iter ) {
-        if( iter->second.sitting > arcAngle_ ) {
-            arcAngle_ = iter->second.sitting;
+        if( iter->sitting > arcAngle_ ) {
+            arcAngle_ = iter->sitting;
         }
     } // end loading circle angle
     //Get the screen points so we can make a grid
@@ -349,12 +356,12 @@ Draws cross-hairs to show blobs on the screen with the calibration instructions.
 *******************************************************************************/
 void BlobCalibration::drawCalibrationBlobs()
 {
-    std::map<int, blobTracker::Blob> * trackedBlobs = tracker_->getTrackedBlobs();
-    std::map<int, blobTracker::Blob>::iterator iter;
+    std::vector<blobTracker::Blob> * trackedBlobs = tracker_->getTrackedBlobs();
+    std::vector<blobTracker::Blob>::iterator iter;
 
     for( iter = trackedBlobs->begin(); iter != trackedBlobs->end(); ++iter ) {		
         blobTracker::Blob drawBlob;
-        drawBlob = iter->second;
+        drawBlob = *iter;
 
         //transform height/width to calibrated space
         drawBlob.boundingRect.width *= calibrationUtils_.screenBB.getWidth() * monitorWidth_ * 4;
@@ -519,16 +526,18 @@ void BlobCalibration::drawFastCalibrationInstructions()
     if( y < 3 ) { y = 3; }
     calibrationText_.drawString( reportStr, x, y );
 }
+#endif
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 //                                 Touch Events
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
+
 /***************************************************************************//**
 Used to detect if a finger is removed from a calibration point.
 *******************************************************************************/
-void BlobCalibration::RAWTouchUp( blobTracker::Blob blob )
+void BlobCalibration::RAWTouchUp( const blobTracker::Blob & blob )
 {
     //If Calibrating, register the calibration point on blobOff
     if( calibrationUtils_.isCalibrating() ) {
@@ -544,7 +553,7 @@ void BlobCalibration::RAWTouchUp( blobTracker::Blob blob )
 /***************************************************************************//**
 Used to detect if a finger is being held on a calibration point.
 *******************************************************************************/
-void BlobCalibration::RAWTouchHeld( blobTracker::Blob blob ) 
+void BlobCalibration::RAWTouchHeld( const blobTracker::Blob & blob ) 
 {
     //If Calibrating, register the calibration point on blobOff
     if( calibrationUtils_.isCalibrating() ) {
@@ -565,14 +574,14 @@ void BlobCalibration::RAWTouchHeld( blobTracker::Blob blob )
 /***************************************************************************//**
 Not currently used.
 *******************************************************************************/
-void BlobCalibration::RAWTouchMoved( blobTracker::Blob blob )
+void BlobCalibration::RAWTouchMoved( const blobTracker::Blob & blob )
 {
 }
 
 /***************************************************************************//**
 Not currently used.
 *******************************************************************************/
-void BlobCalibration::RAWTouchDown( blobTracker::Blob blob )
+void BlobCalibration::RAWTouchDown( const blobTracker::Blob & blob )
 {
 }
 
@@ -768,6 +777,7 @@ void BlobCalibration::moveBoundingBoxUp()
     else           { calibrationUtils_.moveBoundingBoxUpward(); }
 }
 
+#ifndef BLOBBY_HEADLESS
 /***************************************************************************//**
 Draws the current calibration grid as a wireframe.  Note that if the 
 calibration.xml file read in at startup was made with a 320 x 240 camera 
@@ -848,6 +858,7 @@ void BlobCalibration::drawCalibrationPointsWithIntensities( float videoWidth, fl
         glDisable( GL_BLEND );
     }
 }
+#endif
 
 blobNormalize::CalibrationGridPoints * BlobCalibration::copyOfGridPoints()
 {
@@ -96,9 +96,11 @@ namespace blobCalibration
         void setCalibrating( bool b );
         bool isCalibrating();
         int numberOfCalibrationGridPoints();
+#ifndef BLOBBY_HEADLESS
         void doCalibration( int screenWidth, int screenHeight ); 
         void drawCalibrationWireframe( float videoWidth, float videoHeight );
         void drawCalibrationPointsWithIntensities( float videoWidth, float videoHeight );
+#endif
         void checkForIncompleteCalibration();
         void updateCalGridPoints();
         blobNormalize::CalibrationGridPoints * copyOfGridPoints();
@@ -112,16 +114,17 @@ namespace blobCalibration
         void setNumRows( int rows );
 
         // Touch Events
-        virtual void RAWTouchDown( blobTracker::Blob blob );
-        virtual void RAWTouchMoved( blobTracker::Blob blob );
-        virtual void RAWTouchUp( blobTracker::Blob blob );
-        virtual void RAWTouchHeld( blobTracker::Blob blob );
+        virtual void RAWTouchDown( const blobTracker::Blob & blob );
+        virtual void RAWTouchMoved( const blobTracker::Blob & blob );
+        virtual void RAWTouchUp( const blobTracker::Blob & blob );
+        virtual void RAWTouchHeld( const blobTracker::Blob & blob );
             
         // Key Events
         void keyPressed( blobEnums::KeyEnum::Enum key );
         void keyReleased( blobEnums::KeyEnum::Enum key );
 
     private:
+#ifndef BLOBBY_HEADLESS
         void drawBlackScreen();
         void drawCalibrationPoints();
         void drawCircleAroundActivePoint();
@@ -133,6 +136,7 @@ namespace blobCalibration
         void drawStartCalibrationInstructions();
         void drawRegularCalibrationInstructions();
         void drawFastCalibrationInstructions();
+#endif
 
         void captureFastCalibrationPanel();
         std::string fastCalibrationSuccessMsg( int numPoints );
@@ -148,7 +152,9 @@ namespace blobCalibration
         void moveBoundingBoxDown();
         void moveBoundingBoxUp();
 
+#ifndef BLOBBY_HEADLESS
         void drawWireframeQuadStrips();
+#endif
         blobNormalize::CalibrationGridPoints * createCalibrationGridPoints();
 
         std::string intToStr( int n );
@@ -168,12 +174,14 @@ namespace blobCalibration
         float arcAngle_,
               targetColor_;
 
+#ifndef BLOBBY_HEADLESS
         // Fonts
         ofTrueTypeFont verdana_;
         ofTrueTypeFont calibrationText_;
 
         // Draw Particle Image
         ofImage calibrationParticle_;
+#endif
 
         // Blob Tracker
         blobTracker::BlobTracker * tracker_;
@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+// CalibrationLookup
+//
+// PURPOSE: Finds the calibration mesh triangle under a camera point without
+//          testing every triangle, and maps camera points to screen points
+//          with a precomputed affine transform per triangle.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobCalibration/CalibrationLookup.h"
+#include <algorithm>
+
+using blobCalibration::CalibrationLookup;
+
+// Cells of 8 x 8 pixels hold only a few triangles for any usable grid (at 
+// most 13 x 13 grid cells, so even on a 320 x 240 camera the triangles are 
+// about 18 pixels across).  The cells get bigger if the camera points are spread so far 
+// apart that there would be more than MAX_CELLS_PER_SIDE of them across.
+const float CalibrationLookup::MIN_CELL_SIZE = 8.0f;
+const int CalibrationLookup::MAX_CELLS_PER_SIDE = 512;
+
+CalibrationLookup::CalibrationLookup() :
+  triangles_(),
+  cellStarts_(),
+  cellTriangles_(),
+  pointTriangles_(),
+  minX_( 0.0f ),
+  minY_( 0.0f ),
+  maxX_( 0.0f ),
+  maxY_( 0.0f ),
+  cellsPerPixel_( 1.0f ),
+  numCellsX_( 0 ),
+  numCellsY_( 0 ),
+  isBuilt_( false )
+{
+}
+
+CalibrationLookup::~CalibrationLookup()
+{
+}
+
+/***************************************************************************//**
+Builds the table for the mesh.  The triangles array holds three point indices
+per triangle (as in CalibrationUtils), and the points are only read here.
+*******************************************************************************/
+void CalibrationLookup::build( const vector2df * cameraPoints,
+                               const vector2df * screenPoints,
+                               const int * triangles,
+                               int numTriangles )
+{
+    triangles_.clear();
+
+    for( int t = 0; t < numTriangles; ++t ) {
+        addTriangle( cameraPoints, screenPoints, triangles + 3 * t );
+    }
+    findBounds( cameraPoints, triangles, numTriangles );
+    fillCells( numTriangles );
+    isBuilt_ = true;
+}
+
+void CalibrationLookup::clear()
+{
+    std::vector<Triangle>().swap( triangles_ );
+    std::vector<int>().swap( cellStarts_ );
+    std::vector<int>().swap( cellTriangles_ );
+    std::vector<int>().swap( pointTriangles_ );
+    numCellsX_ = 0;
+    numCellsY_ = 0;
+    isBuilt_ = false;
+}
+
+bool CalibrationLookup::isBuilt() const
+{
+    return isBuilt_;
+}
+
+/***************************************************************************//**
+Returns the index of the first triangle (in mesh order) that has the camera 
+point inside it or on its edge, or -1 if there is none.
+*******************************************************************************/
+int CalibrationLookup::findTriangle( float x, float y ) const
+{
+    // Written so that NaN coordinates are outside too.
+    if( !(x >= minX_ && x <= maxX_ && y >= minY_ && y <= maxY_) || !isBuilt_ ) {
+        return -1;
+    }
+    int cell = cellOfY( y ) * numCellsX_ + cellOfX( x ),
+        end = cellStarts_[cell + 1];
+    vector2df p( x, y );
+
+    for( int i = cellStarts_[cell]; i < end; ++i ) {
+        const Triangle & triangle = triangles_[cellTriangles_[i]];
+
+        if( vector2df::isOnSameSide( p, triangle.a, triangle.b, triangle.c ) 
+         && vector2df::isOnSameSide( p, triangle.b, triangle.a, triangle.c )
+         && vector2df::isOnSameSide( p, triangle.c, triangle.a, triangle.b ) ) {
+            return cellTriangles_[i];
+        }
+    }
+    return -1;
+}
+
+/***************************************************************************//**
+Maps the camera point to the screen.  A point outside of the mesh goes to 
+(0, 0), as in CalibrationUtils::cameraToScreenSpace().
+*******************************************************************************/
+void CalibrationLookup::cameraToScreen( float & x, float & y ) const
+{
+    int t = findTriangle( x, y );
+
+    if( t == -1 ) {
+        x = 0.0f;
+        y = 0.0f;
+    }
+    else {
+        const Triangle & triangle = triangles_[t];
+        float screenX = x * triangle.screenX[0] + y * triangle.screenX[1] + triangle.screenX[2],
+              screenY = x * triangle.screenY[0] + y * triangle.screenY[1] + triangle.screenY[2];
+        x = screenX;
+        y = screenY;
+    }
+}
+
+/***************************************************************************//**
+Maps a batch of camera points to the screen in place.  The triangles are all
+found first, so the second loop is straight arithmetic over the points.
+*******************************************************************************/
+void CalibrationLookup::cameraToScreen( vector2df * points, int numPoints )
+{
+    pointTriangles_.resize( numPoints );
+
+    for( int i = 0; i < numPoints; ++i ) {
+        pointTriangles_[i] = findTriangle( points[i].X, points[i].Y );
+    }
+    for( int i = 0; i < numPoints; ++i ) {
+        int t = pointTriangles_[i];
+
+        if( t == -1 ) {
+            points[i].X = 0.0f;
+            points[i].Y = 0.0f;
+        }
+        else {
+            const Triangle & triangle = triangles_[t];
+            float x = points[i].X,
+                  y = points[i].Y;
+            points[i].X = x * triangle.screenX[0] + y * triangle.screenX[1] + triangle.screenX[2];
+            points[i].Y = x * triangle.screenY[0] + y * triangle.screenY[1] + triangle.screenY[2];
+        }
+    }
+}
+
+/***************************************************************************//**
+Works out the affine transform that gives the same result as the barycentric
+interpolation in CalibrationUtils::cameraToScreenSpace().  The barycentric 
+weights of A and B are linear in the camera point (the weight of C is one 
+minus the other two), so the screen point is sC + (sA - sC) wA + (sB - sC) wB.
+A triangle with no area maps everything to its first screen point.
+*******************************************************************************/
+void CalibrationLookup::addTriangle( const vector2df * cameraPoints,
+                                     const vector2df * screenPoints,
+                                     const int * corners )
+{
+    triangles_.push_back( Triangle() );
+    Triangle & triangle = triangles_.back();
+    vector2df sA = screenPoints[corners[0]],
+              sB = screenPoints[corners[1]],
+              sC = screenPoints[corners[2]];
+    triangle.a = cameraPoints[corners[0]];
+    triangle.b = cameraPoints[corners[1]];
+    triangle.c = cameraPoints[corners[2]];
+
+    double ax = triangle.a.X, ay = triangle.a.Y,
+           bx = triangle.b.X, by = triangle.b.Y,
+           cx = triangle.c.X, cy = triangle.c.Y,
+           totalArea = (ax - bx) * (ay - cy) - (ay - by) * (ax - cx);
+
+    if( totalArea == 0.0 ) {
+        triangle.screenX[0] = triangle.screenX[1] = 0.0f;
+        triangle.screenY[0] = triangle.screenY[1] = 0.0f;
+        triangle.screenX[2] = sA.X;
+        triangle.screenY[2] = sA.Y;
+        return;
+    }
+    // wA = (x * (by - cy) + y * (cx - bx) + (bx * cy - by * cx)) / totalArea
+    // wB = (x * (cy - ay) + y * (ax - cx) + (ay * cx - ax * cy)) / totalArea
+    double wA[3] = { (by - cy) / totalArea, (cx - bx) / totalArea, (bx * cy - by * cx) / totalArea },
+           wB[3] = { (cy - ay) / totalArea, (ax - cx) / totalArea, (ay * cx - ax * cy) / totalArea },
+           dxA = sA.X - sC.X, dyA = sA.Y - sC.Y,
+           dxB = sB.X - sC.X, dyB = sB.Y - sC.Y;
+
+    for( int k = 0; k < 3; ++k ) {
+        triangle.screenX[k] = (float)(dxA * wA[k] + dxB * wB[k]);
+        triangle.screenY[k] = (float)(dyA * wA[k] + dyB * wB[k]);
+    }
+    triangle.screenX[2] += sC.X;
+    triangle.screenY[2] += sC.Y;
+}
+
+/***************************************************************************//**
+The cells cover the bounding box of the mesh, which is the only place a 
+point can be inside a triangle.
+*******************************************************************************/
+void CalibrationLookup::findBounds( const vector2df * cameraPoints, const int * triangles, int numTriangles )
+{
+    int numCorners = 3 * numTriangles;
+
+    if( numCorners == 0 ) {
+        minX_ = minY_ = 1.0f;
+        maxX_ = maxY_ = 0.0f; // Empty, so every point is outside.
+        numCellsX_ = numCellsY_ = 1;
+        cellsPerPixel_ = 1.0f;
+        return;
+    }
+    minX_ = maxX_ = cameraPoints[triangles[0]].X;
+    minY_ = maxY_ = cameraPoints[triangles[0]].Y;
+
+    for( int i = 1; i < numCorners; ++i ) {
+        const vector2df & p = cameraPoints[triangles[i]];
+        minX_ = std::min( minX_, p.X );
+        maxX_ = std::max( maxX_, p.X );
+        minY_ = std::min( minY_, p.Y );
+        maxY_ = std::max( maxY_, p.Y );
+    }
+    float cellSize = std::max( MIN_CELL_SIZE, std::max( maxX_ - minX_, maxY_ - minY_ ) / MAX_CELLS_PER_SIDE );
+    cellsPerPixel_ = 1.0f / cellSize;
+    numCellsX_ = (int)((maxX_ - minX_) * cellsPerPixel_) + 1;
+    numCellsY_ = (int)((maxY_ - minY_) * cellsPerPixel_) + 1;
+}
+
+/***************************************************************************//**
+Lists each triangle in every cell that its bounding box overlaps.  A counting
+sort by cell, done in triangle order, so each cell's list is in mesh order.
+*******************************************************************************/
+void CalibrationLookup::fillCells( int numTriangles )
+{
+    int numCells = numCellsX_ * numCellsY_;
+    cellStarts_.assign( numCells + 1, 0 );
+
+    for( int pass = 0; pass < 2; ++pass ) {
+        for( int t = 0; t < numTriangles; ++t ) {
+            const Triangle & triangle = triangles_[t];
+            int left = cellOfX( std::min( triangle.a.X, std::min( triangle.b.X, triangle.c.X ) ) ),
+                right = cellOfX( std::max( triangle.a.X, std::max( triangle.b.X, triangle.c.X ) ) ),
+                top = cellOfY( std::min( triangle.a.Y, std::min( triangle.b.Y, triangle.c.Y ) ) ),
+                bottom = cellOfY( std::max( triangle.a.Y, std::max( triangle.b.Y, triangle.c.Y ) ) );
+
+            for( int row = top; row <= bottom; ++row ) {
+                for( int col = left; col <= right; ++col ) {
+                    int cell = row * numCellsX_ + col;
+
+                    if( pass == 0 ) {
+                        ++cellStarts_[cell + 1];
+                    }
+                    else {
+                        cellTriangles_[cellStarts_[cell]++] = t;
+                    }
+                }
+            }
+        }
+        if( pass == 0 ) {
+            for( int cell = 0; cell < numCells; ++cell ) {
+                cellStarts_[cell + 1] += cellStarts_[cell];
+            }
+            cellTriangles_.resize( cellStarts_[numCells] );
+        }
+        else {
+            // Each start was moved up to the next cell's start.
+            for( int cell = numCells; cell > 0; --cell ) {
+                cellStarts_[cell] = cellStarts_[cell - 1];
+            }
+            cellStarts_[0] = 0;
+        }
+    }
+}
+
+int CalibrationLookup::cellOfX( float x ) const
+{
+    int cell = (int)((x - minX_) * cellsPerPixel_);
+    return std::max( 0, std::min( cell, numCellsX_ - 1 ) );
+}
+
+int CalibrationLookup::cellOfY( float y ) const
+{
+    int cell = (int)((y - minY_) * cellsPerPixel_);
+    return std::max( 0, std::min( cell, numCellsY_ - 1 ) );
+}
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// CalibrationLookup
+//
+// PURPOSE: Finds the calibration mesh triangle under a camera point without
+//          testing every triangle, and maps camera points to screen points
+//          with a precomputed affine transform per triangle.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBCALIBRATION_CALIBRATIONLOOKUP_H
+#define BLOBCALIBRATION_CALIBRATIONLOOKUP_H
+
+#include "blobCalibration/vector2d.h"
+#include <vector>
+
+namespace blobCalibration
+{
+    /***********************************************************************//**
+    A lookup table for CalibrationUtils::cameraToScreenSpace().  The bounding 
+    box of the camera points is split into square cells, and each cell keeps 
+    the list of mesh triangles whose bounding boxes overlap it (in mesh 
+    order), so finding the triangle under a point only tests the one or two 
+    triangles of its cell instead of the whole mesh.  Since the lists keep 
+    the mesh order and use the same inside test, the triangle found is 
+    always the one that CalibrationUtils::findTriangleWithin() would find.
+
+    The barycentric interpolation of the screen points over a triangle is an
+    affine function of the camera point, so it is worked out once per 
+    triangle in build(), and mapping a point is then two multiply-adds per 
+    coordinate.  The table has to be built again whenever the camera points,
+    screen points, or grid change.
+    ***************************************************************************/
+    class CalibrationLookup
+    {
+    public:
+        static const float MIN_CELL_SIZE;
+        static const int MAX_CELLS_PER_SIDE;
+
+        CalibrationLookup();
+        ~CalibrationLookup();
+
+        void build( const vector2df * cameraPoints,
+                    const vector2df * screenPoints,
+                    const int * triangles,
+                    int numTriangles );
+        void clear();
+        bool isBuilt() const;
+        int findTriangle( float x, float y ) const;
+        void cameraToScreen( float & x, float & y ) const;
+        void cameraToScreen( vector2df * points, int numPoints );
+
+    private:
+        struct Triangle
+        {
+            vector2df a,
+                      b,
+                      c;
+            float screenX[3],   // screen x = x * screenX[0] + y * screenX[1] + screenX[2]
+                  screenY[3];   // screen y = x * screenY[0] + y * screenY[1] + screenY[2]
+        };
+
+        void addTriangle( const vector2df * cameraPoints,
+                          const vector2df * screenPoints,
+                          const int * corners );
+        void findBounds( const vector2df * cameraPoints, const int * triangles, int numTriangles );
+        void fillCells( int numTriangles );
+        int cellOfX( float x ) const;
+        int cellOfY( float y ) const;
+
+        std::vector<Triangle> triangles_;
+        std::vector<int> cellStarts_,
+                         cellTriangles_,
+                         pointTriangles_;
+        float minX_,
+              minY_,
+              maxX_,
+              maxY_,
+              cellsPerPixel_;
+        int numCellsX_,
+            numCellsY_;
+        bool isBuilt_;
+    };
+}
+
+#endif
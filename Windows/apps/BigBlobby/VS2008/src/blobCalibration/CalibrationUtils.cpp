@@ -74,7 +74,10 @@ CalibrationUtils::CalibrationUtils() :
   minBoxX_( 0 ),
   maxBoxY_( 0 ),
   minBoxY_( 0 ),
-  isCalibrationIncomplete_( false )
+  isCalibrationIncomplete_( false ),
+  lookup_(),
+  dimensionCorners_(),
+  isLookupCurrent_( false )
 {
 }
 
@@ -194,6 +197,7 @@ void CalibrationUtils::setGrid( int x, int y )
 	gridCellsY = y;
 	gridPoints = (gridCellsX + 1) * (gridCellsY + 1);
     gridIndices_ = gridCellsX * gridCellsY * 3 * 2;
+    isLookupCurrent_ = false;
 
     delete screenPoints_;
     delete cameraPoints_;
@@ -265,6 +269,7 @@ void CalibrationUtils::initTriangles()
 void CalibrationUtils::initScreenPoints()
 {
 	int p = 0;
+    isLookupCurrent_ = false;
 
 	vector2df xd(screenBB.lowerRightCorner.X-screenBB.upperLeftCorner.X,0.0f);
 	vector2df yd(0.0f, screenBB.lowerRightCorner.Y-screenBB.upperLeftCorner.Y);
@@ -286,6 +291,7 @@ void CalibrationUtils::initScreenPoints()
 void CalibrationUtils::initCameraPoints(int camWidth, int camHeight)
 {
 	int p = 0;
+    isLookupCurrent_ = false;
 
 	for(int j = 0; j <= gridCellsY; ++j ) {
 		for(int i = 0; i <= gridCellsX; ++i ) {
@@ -345,8 +351,16 @@ void CalibrationUtils::transformDimension(float &width, float &height)
 	height = std::fabs(ulY - lrY);
 }
 
+/***************************************************************************//**
+Works out the bounding box of the camera points.  This has to be called after
+the camera points have been changed through getCameraPoints() (as is done at 
+the end of a calibration), which also makes the vision thread rebuild its 
+lookup table for cameraToScreenSpace().
+*******************************************************************************/
 void CalibrationUtils::calculateBox()
 {
+    isLookupCurrent_ = false;
+
 	//reset variables
 	maxBoxX_ = 0;
 	minBoxX_ = camWidth_;
@@ -382,9 +396,18 @@ float * CalibrationUtils::cameraBackgroundIntensities()
     return cameraBackgroundIntensity_;
 }
 
-// Transforms a camera space coordinate into a screen space coord
+/***************************************************************************//**
+Transforms a camera space coordinate into a screen space coord.  Outside of a 
+calibration, the triangle is found (and the point mapped) with the lookup 
+table.  While a calibration is running, the camera points are being replaced
+one at a time, so every triangle is tested as in CCV.
+*******************************************************************************/
 void CalibrationUtils::cameraToScreenSpace(float &x, float &y)
 {
+    if( updateLookup() ) {
+        lookup_.cameraToScreen( x, y );
+        return;
+    }
 	vector2df pt(x, y);
 	int t = findTriangleWithin(pt);
 	if(t != -1)
@@ -421,6 +444,68 @@ void CalibrationUtils::cameraToScreenSpace(float &x, float &y)
 	// FIXME: what to do in the case that it's outside the mesh?
 }
 
+/***************************************************************************//**
+Same as calling cameraToScreenPosition() on each point, but all the points 
+are looked up in one batch.
+*******************************************************************************/
+void CalibrationUtils::cameraToScreenPositions(vector2df * points, int numPoints)
+{
+    if( updateLookup() ) {
+        lookup_.cameraToScreen( points, numPoints );
+    }
+    else {
+        for( int i = 0; i < numPoints; ++i ) {
+            cameraToScreenSpace( points[i].X, points[i].Y );
+        }
+    }
+}
+
+/***************************************************************************//**
+Same as calling transformDimension() on each (width, height) pair, but all 
+the corners are mapped in one batch.
+*******************************************************************************/
+void CalibrationUtils::transformDimensions(vector2df * dimensions, int numDimensions)
+{
+    if( numDimensions <= 0 ) {
+        return;
+    }
+	float centerX = ((maxBoxX_ - minBoxX_)/2) + minBoxX_;
+	float centerY = ((maxBoxY_ - minBoxY_)/2) + minBoxY_;
+    dimensionCorners_.resize( 2 * numDimensions );
+
+    for( int i = 0; i < numDimensions; ++i ) {
+        float halfX = dimensions[i].X * 0.5f,
+              halfY = dimensions[i].Y * 0.5f;
+        dimensionCorners_[2 * i] = vector2df( centerX - halfX, centerY - halfY );
+        dimensionCorners_[2 * i + 1] = vector2df( centerX + halfX, centerY + halfY );
+    }
+    cameraToScreenPositions( &dimensionCorners_[0], 2 * numDimensions );
+
+    for( int i = 0; i < numDimensions; ++i ) {
+        const vector2df & ul = dimensionCorners_[2 * i],
+                        & lr = dimensionCorners_[2 * i + 1];
+        dimensions[i].X = std::fabs( lr.X - ul.X );
+        dimensions[i].Y = std::fabs( ul.Y - lr.Y );
+    }
+}
+
+/***************************************************************************//**
+Rebuilds the lookup table if the calibration has changed since it was last 
+built, and returns false if it should not be used (during a calibration).  
+The flag is cleared before building, so a change made while the table is 
+being built makes it get built again next time.
+*******************************************************************************/
+bool CalibrationUtils::updateLookup()
+{
+    if( isCalibrating_ || triangles_ == NULL ) {
+        return false;
+    }
+    if( !isLookupCurrent_.exchange( true ) ) {
+        lookup_.build( cameraPoints_, screenPoints_, triangles_, gridIndices_ / 3 );
+    }
+    return true;
+}
+
 bool CalibrationUtils::isPointInTriangle(vector2df p, vector2df a, vector2df b, vector2df c)
 {
 	if (vector2df::isOnSameSide(p,a, b,c) && vector2df::isOnSameSide(p,b, a,c) && vector2df::isOnSameSide(p, c, a, b))
@@ -442,6 +527,7 @@ int CalibrationUtils::findTriangleWithin(vector2df pt)
 void CalibrationUtils::setCalibrating( bool b )
 {
     isCalibrating_ = b;
+    isLookupCurrent_ = false;
 }
 
 bool CalibrationUtils::isCalibrating()
@@ -463,6 +549,7 @@ void CalibrationUtils::beginCalibration()
 {
 	 isCalibrating_ = true;
 	 calibrationStep = 0;
+     isLookupCurrent_ = false;
 }
 
 void CalibrationUtils::nextCalibrationStep()
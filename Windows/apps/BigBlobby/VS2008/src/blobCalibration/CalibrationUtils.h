@@ -54,6 +54,9 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //Used other calibration
 #include "blobCalibration/rect2d.h"
 #include "blobCalibration/vector2d.h"
+#include "blobCalibration/CalibrationLookup.h"
+#include <boost/atomic.hpp>
+#include <vector>
 
 class CalibrationUtils
 {
@@ -81,6 +84,8 @@ class CalibrationUtils
 		void cameraToScreenPosition(float &x, float &y);
 		void cameraToScreenSpace(float &x, float &y);
 		void transformDimension(float &width, float &height);
+		void cameraToScreenPositions(vector2df * points, int numPoints);
+		void transformDimensions(vector2df * dimensions, int numDimensions);
 		void initScreenPoints();
 		void initCameraPoints(int camWidth, int camHeight);
 		void calculateBox(); //calculates min/max calibration rect
@@ -139,6 +144,7 @@ class CalibrationUtils
         void expandOuterEdgeOfCalibrationGrid();
         void expandFirstAndLastRow();
         void expandFirstAndLastCol();
+        bool updateLookup();
 
 		bool isCalibrating_;
 		bool goToNextStep_;
@@ -159,6 +165,9 @@ class CalibrationUtils
 		      maxBoxY_,
 		      minBoxY_;
         bool isCalibrationIncomplete_;
+        blobCalibration::CalibrationLookup lookup_;
+        std::vector<vector2df> dimensionCorners_;
+        boost::atomic<bool> isLookupCurrent_;
 };
 
 #endif
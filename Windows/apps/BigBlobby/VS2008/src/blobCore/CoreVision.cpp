@@ -50,14 +50,29 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobCore/CoreVision.h"
+#include "blobCore/FramePipeline.h"
+#include "blobCore/VisionFrame.h"
 #include "blobTuio/TuioChannels.h"
 #include "blobFilters/ImageFilters.h"
 #include "blobBuffers/GrayBuffer.h"
 #include "blobStats/Stats.h"
+#include "blobUtils/FrameSignal.h"
 #include "blobUtils/FunctionTimer.h"
 #include "blobUtils/StopWatch.h"
+#include "blobUtils/TripleBuffer.h"
 #include "blobVideo/SimpleVideoWriter.h"
 #include "blobVideo/SimpleVideoReader.h"
+#include "blobVideo/VideoGrabberFrameSource.h"
+#ifdef TARGET_WIN32
+    #include "blobVideo/Ps3FrameSource.h"
+    #include "blobVideo/FfmvFrameSource.h"
+#endif
+#ifdef TARGET_LINUX
+    #include "blobVideo/SharedFrameSource.h"
+    #include "blobVideo/V4l2FrameSource.h"
+#endif
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
 #include <iostream>
 #include <sstream>
 
@@ -69,12 +84,16 @@ const int CoreVision::VIDEO_WIDTH = 320,
           CoreVision::VIDEO_HEIGHT = 240,
           CoreVision::VIDEO_RATE = 30,
           CoreVision::MAX_NUMBER_BLOBS = 20,
-          CoreVision::BACKGROUND_FRAMES_COUNT = 5;
+          CoreVision::BACKGROUND_FRAMES_COUNT = 5,
+          CoreVision::CAMERA_WAIT_MILLIS = 100;
+
+// Cameras that can only be polled (ofVideoGrabber) are checked this often.
+const double CoreVision::GRABBER_POLL_SECONDS = 0.001;
 
 /***************************************************************************//**
 Creates instances of several helper classes: BlobFilters, ContourFinder, 
-BlobFinder, BlobTracker, BlobCalibration, TUIO, ofxCvColorImage (for the
-source image), and CPUImageFilter (for the processed image).
+BlobFinder, BlobTracker, BlobCalibration, and TUIO.  The ContourFinder labels
+the filtered image on the same thread pool as the ImageFilters strips.
 
 Creation of an ofTrueTypeFont object (for blob ID numbers) is deferred until
 the OpenGL state is initialized. and creation of a camera or video player is
@@ -83,12 +102,14 @@ deferred until the update() function is called.
 CoreVision::CoreVision() :
   // Camera
   videoGrabber_( NULL ),
+  cameraFrameSource_( NULL ),
   useCamera_( true ),
   startVideoCamera_( true ),
   deviceID_( 0 ),
   videoRate_( VIDEO_RATE ),
   videoWidth_( VIDEO_WIDTH ),
   videoHeight_( VIDEO_HEIGHT ),
+  sharedFrameRing_(),
 
   // VideoPlayer
   videoReader_( new blobVideo::SimpleVideoReader() ),
@@ -111,12 +132,13 @@ CoreVision::CoreVision() :
   showBlobLabels_( false ),
   showCalibrationWireframe_( false ),
   showCalibrationIntensities_( false ),
+#ifndef BLOBBY_HEADLESS
   verdana_(),
+#endif
 
   // Filters, Network, and Calibration
   imageFilters_( new blobFilters::ImageFilters() ),
   backgroundLearnRate_( 0.01f ),
-  processedImage_(),
   useGpuShaders_( false ),
   tuioChannels_( new blobTuio::TuioChannels() ),
   blobCalibration_(),
@@ -133,7 +155,26 @@ CoreVision::CoreVision() :
   hasNewFrame_( false ),
   needToDisplayUpdatedFps_( false ),
   frames_( 0 ),
+  frameNumber_( 0 ),
+  lastDroppedFrames_( 0 ),
   fps_( 0.0 ),
+  droppedFps_( 0.0 ),
+
+  // Vision thread
+  visionThread_( NULL ),
+  isVisionThreadRunning_( false ),
+  visionMutex_(),
+  visionFrames_( new blobUtils::TripleBuffer<blobCore::VisionFrame>() ),
+  hasNewDisplayFrame_( false ),
+  visionLockDepth_( 0 ),
+  frameSignal_( new blobUtils::FrameSignal() ),
+  hasCapturedFrame_( false ),
+
+  // Pipelined processing
+  framePipeline_( new blobCore::FramePipeline() ),
+  usePipelinedProcessing_( true ),
+  hasBlobs_( false ),
+  hasBlobsInScreenArea_( false ),
 
   hasExited_( false ),
   debug_( false )
@@ -143,6 +184,14 @@ CoreVision::CoreVision() :
     ps3Camera_ = NULL;
     dsvlCamera_ = NULL;
 #endif
+#ifdef TARGET_LINUX
+    sharedFrameSource_ = NULL;
+    v4l2Camera_ = NULL;
+#endif
+    contourFinder_.setThreadPool( imageFilters_->stripPool() );
+    framePipeline_->addStage( boost::bind( &CoreVision::filterStage, this, _1 ) );
+    framePipeline_->addStage( boost::bind( &CoreVision::trackingStage, this, _1 ) );
+    framePipeline_->addStage( boost::bind( &CoreVision::outputStage, this, _1 ) );
     stopWatch_->start();
     ofSeedRandom(); // CCV timers still used in TUIO classes and maybe elsewhere.
     ofResetElapsedTimeCounter();	   
@@ -150,7 +199,11 @@ CoreVision::CoreVision() :
 
 CoreVision::~CoreVision()
 {
+    stopVisionThread();
     hasExited_ = true;
+    delete framePipeline_;
+    delete visionFrames_;
+    delete frameSignal_;
     delete processTimer_;
     delete blobTrackerTimer_;
     delete contourFinderTimer_;
@@ -158,14 +211,20 @@ CoreVision::~CoreVision()
     delete stats_;
     delete tuioChannels_;
     delete imageFilters_;
+    delete cameraFrameSource_;
     delete videoReader_;
 #ifdef TARGET_WIN32
     delete ffmvCamera_;
     delete ps3Camera_;
     delete dsvlCamera_;
 #endif
+#ifdef TARGET_LINUX
+    delete sharedFrameSource_;
+    delete v4l2Camera_;
+#endif
 }
 
+#ifndef BLOBBY_HEADLESS
 /***************************************************************************//**
 This function should be called when the OpenGL state is first initialized so 
 that it can load the verdana font used for showing blob ID numbers in the
@@ -175,6 +234,251 @@ void CoreVision::loadFontForBlobIDNumbers()
 {
     verdana_.loadFont( "data/verdana.ttf", 12, true, true );
 }
+#endif
+
+/***************************************************************************//**
+Starts the vision thread, which calls update() in a loop until stopVisionThread()
+is called.  Does nothing if the vision thread is already running.
+
+The camera (or video player) is opened on the vision thread the first time that
+update() is called, so this function should not be called until the camera 
+width, height, and frame rate have been set.
+*******************************************************************************/
+void CoreVision::startVisionThread()
+{
+    if( visionThread_ == NULL ) {
+        debug_.printLn( "CoreVision::startVisionThread() called..." );
+        isVisionThreadRunning_ = true;
+        visionThread_ = new boost::thread( &CoreVision::runVisionThread, this );
+    }
+}
+
+/***************************************************************************//**
+Asks the vision thread to finish the frame that it is working on and then waits
+for the thread to exit.  Safe to call more than once.
+*******************************************************************************/
+void CoreVision::stopVisionThread()
+{
+    if( visionThread_ != NULL ) {
+        debug_.printLn( "CoreVision::stopVisionThread() called..." );
+        isVisionThreadRunning_ = false;
+        frameSignal_->notify();
+        visionThread_->join();
+        delete visionThread_;
+        visionThread_ = NULL;
+        framePipeline_->stop();
+    }
+}
+
+bool CoreVision::isVisionThreadRunning()
+{
+    return isVisionThreadRunning_;
+}
+
+/***************************************************************************//**
+Waits for the vision thread to finish the frame that it is working on and for 
+any pipeline stage functions to return, and then keeps both from starting new
+work until unlockVision() is called.  The GUI thread should do this (using a 
+CoreVision::ScopedLock) while applying a batch of settings so that a frame is
+never processed with half of the new settings.  Calls can be nested, so the 
+CoreVision functions that lock internally can still be called while locked.
+
+Must never be called from a pipeline stage thread.
+*******************************************************************************/
+void CoreVision::lockVision()
+{
+    visionMutex_.lock();
+
+    if( ++visionLockDepth_ == 1 ) {
+        framePipeline_->pause();
+    }
+}
+
+void CoreVision::unlockVision()
+{
+    if( --visionLockDepth_ == 0 ) {
+        framePipeline_->resume();
+    }
+    visionMutex_.unlock();
+}
+
+/***************************************************************************//**
+Turns the filter, tracking, and output stage threads on or off.  The change
+takes effect on the next update() call.  Calibration always runs serially.
+*******************************************************************************/
+void CoreVision::usePipelinedProcessing( bool b )
+{
+    ScopedLock lock( *this );
+    usePipelinedProcessing_ = b;
+}
+
+bool CoreVision::usePipelinedProcessing()
+{
+    return usePipelinedProcessing_;
+}
+
+/***************************************************************************//**
+Turns the parallel, strip-by-strip filter chain on or off (see 
+ImageFilters::useStripProcessing()).
+*******************************************************************************/
+void CoreVision::useStripFilterProcessing( bool b )
+{
+    ScopedLock lock( *this );
+    imageFilters_->useStripProcessing( b );
+}
+
+bool CoreVision::useStripFilterProcessing()
+{
+    return imageFilters_->useStripProcessing();
+}
+
+/***************************************************************************//**
+Turns the bit-packed tracked output that the blobs are found in on or off 
+(see ImageFilters::usePackedOutput()).
+*******************************************************************************/
+void CoreVision::usePackedTrackedOutput( bool b )
+{
+    ScopedLock lock( *this );
+    imageFilters_->usePackedOutput( b );
+}
+
+bool CoreVision::usePackedTrackedOutput()
+{
+    return imageFilters_->usePackedOutput();
+}
+
+/***************************************************************************//**
+Turns the optimal matching of tracked blobs to new blobs on or off (see 
+BlobTracker::useOptimalAssignment()).
+*******************************************************************************/
+void CoreVision::useOptimalBlobAssignment( bool b )
+{
+    ScopedLock lock( *this );
+    blobTracker_->useOptimalAssignment( b );
+}
+
+bool CoreVision::useOptimalBlobAssignment()
+{
+    return blobTracker_->useOptimalAssignment();
+}
+
+/***************************************************************************//**
+Turns the blob centroids weighted by the pre-threshold signal on or off (see 
+ContourFinder::useWeightedCentroids()).  The filters only keep the signal 
+image while weighted centroids or angles are on.
+*******************************************************************************/
+void CoreVision::useWeightedBlobCentroids( bool b )
+{
+    ScopedLock lock( *this );
+    contourFinder_.useWeightedCentroids( b );
+    imageFilters_->keepSignalImage( b || contourFinder_.useWeightedAngles() );
+}
+
+bool CoreVision::useWeightedBlobCentroids()
+{
+    return contourFinder_.useWeightedCentroids();
+}
+
+/***************************************************************************//**
+Turns the blob angles from the signal-weighted second moments on or off (see
+ContourFinder::useWeightedAngles()).
+*******************************************************************************/
+void CoreVision::useWeightedBlobAngles( bool b )
+{
+    ScopedLock lock( *this );
+    contourFinder_.useWeightedAngles( b );
+    imageFilters_->keepSignalImage( b || contourFinder_.useWeightedCentroids() );
+}
+
+bool CoreVision::useWeightedBlobAngles()
+{
+    return contourFinder_.useWeightedAngles();
+}
+
+/***************************************************************************//**
+Whether the intermediate filter images that are only used for display get 
+written (see ImageFilters::writeFilterImages()).
+*******************************************************************************/
+void CoreVision::writeFilterImages( bool b )
+{
+    ScopedLock lock( *this );
+    imageFilters_->writeFilterImages( b );
+}
+
+bool CoreVision::writeFilterImages()
+{
+    return imageFilters_->writeFilterImages();
+}
+
+/***************************************************************************//**
+Body of the vision thread.  Waits (without holding the vision mutex) for the
+camera or video player to have a frame, and then processes it under the vision
+mutex.
+*******************************************************************************/
+void CoreVision::runVisionThread()
+{
+    while( isVisionThreadRunning_ ) {
+        waitForVideoFrame();
+
+        if( isVisionThreadRunning_ ) {
+            boost::recursive_mutex::scoped_lock lock( visionMutex_ );
+            update();
+        }
+    }
+}
+
+/***************************************************************************//**
+Sleeps until the next frame should be available, so processing starts as soon
+as a frame lands instead of on the next tick of a polling timer:
+<br />
+
+The PS3, Firefly, and V4L2 (Linux) drivers block until the camera delivers a 
+frame, and that frame is captured here (hasCapturedFrame_) for update() to process.  The video
+player sleeps until its next frame is due at the video's frame rate.  The
+ofVideoGrabber and the SharedFrameSource can only be polled, so they are 
+checked every GRABBER_POLL_SECONDS.
+<br />
+
+All waits other than the camera drivers' are on the frameSignal_, which is
+notified when the vision thread is stopped or a different camera or video is
+requested, so those requests never wait for a frame timeout.
+*******************************************************************************/
+void CoreVision::waitForVideoFrame()
+{
+    hasCapturedFrame_ = false;
+
+    if( startVideoCamera_ || startVideoPlayer_ ) {
+        return;
+    }
+    if( useCamera_ ) {
+        #ifdef TARGET_WIN32
+            if( ps3Camera_ != NULL ) {
+                hasCapturedFrame_ = ps3Camera_->waitForFrame( CAMERA_WAIT_MILLIS );
+                return;
+            }
+            else if( ffmvCamera_ != NULL ) {
+                ffmvCamera_->grabFrame(); // Blocks until the next image.
+                hasCapturedFrame_ = true;
+                return;
+            }
+        #endif
+        #ifdef TARGET_LINUX
+            if( v4l2Camera_ != NULL ) {
+                hasCapturedFrame_ = v4l2Camera_->waitForFrame( CAMERA_WAIT_MILLIS );
+                return;
+            }
+        #endif
+        frameSignal_->waitFor( GRABBER_POLL_SECONDS );
+    }
+    else {
+        double seconds = videoReader_->secondsUntilNextFrame();
+
+        if( !hasNewFrame_ && seconds < GRABBER_POLL_SECONDS ) {
+            seconds = GRABBER_POLL_SECONDS; // No video open (or at end of file).
+        }
+        frameSignal_->waitFor( seconds );
+    }
+}
 
 /***************************************************************************//**
 Checks if the video camera (or video player) has a new frame for processing.
@@ -187,6 +491,9 @@ and sending out TUIO messages.
 This function also checks to see if a new video camera (or video player) has 
 been requested.  If so, any older camera or player will be shut down before 
 starting the new camera or player.
+
+This function is called on the vision thread, so it must not make any OpenGL 
+calls (the vision thread has no OpenGL context).
 *******************************************************************************/
 void CoreVision::update()
 {
@@ -195,21 +502,19 @@ void CoreVision::update()
 
     if( useCamera_ ) {
         if( startVideoCamera_ ) {
+            framePipeline_->stop();
             stopVideoPlayer();
-            clearVideoFrame();
             initVideoCamera();
-            setUpProcessedImage();
             learnBackground();
             imageFilters_->saveFramesAsBackground( BACKGROUND_FRAMES_COUNT );
             startVideoCamera_ = false;
         }
         #ifdef TARGET_WIN32
-            if( ps3Camera_ != NULL ) { //ps3 camera 
-                hasNewFrame_ = ps3Camera_->isFrameNew();
+            if( ps3Camera_ != NULL ) { //ps3 camera (frame grabbed by waitForVideoFrame)
+                hasNewFrame_ = hasCapturedFrame_;
             }
             else if( ffmvCamera_ != NULL ) {
-                ffmvCamera_->grabFrame();
-                hasNewFrame_ = true;
+                hasNewFrame_ = hasCapturedFrame_;
             }
             else if(videoGrabber_ != NULL) {
                 videoGrabber_->grabFrame();
@@ -219,13 +524,31 @@ void CoreVision::update()
             //    bNewFrame = dsvlCamera_->isFrameNew();
             //}
         #else
-            videoGrabber_->grabFrame();
-            hasNewFrame_ = videoGrabber_->isFrameNew();
+            #ifdef TARGET_LINUX
+                if( sharedFrameSource_ != NULL ) {
+                    hasNewFrame_ = sharedFrameSource_->readFrame();
+
+                    if( hasNewFrame_ && (sharedFrameSource_->width() != videoWidth_ 
+                                         || sharedFrameSource_->height() != videoHeight_) ) 
+                    {
+                        hasNewFrame_ = false;
+                        startVideoCamera_ = true; // Producer restarted at a new frame size.
+                    }
+                }
+                else if( v4l2Camera_ != NULL ) { // (frame grabbed by waitForVideoFrame)
+                    hasNewFrame_ = hasCapturedFrame_;
+                }
+                else
+            #endif
+            {
+                videoGrabber_->grabFrame();
+                hasNewFrame_ = videoGrabber_->isFrameNew();
+            }
         #endif
     }
     else { // Video player requested or in use.
         if( startVideoPlayer_  ) {
-            clearVideoFrame();
+            framePipeline_->stop();
             initVideoPlayer();
             learnBackground();
             imageFilters_->saveFramesAsBackground( BACKGROUND_FRAMES_COUNT );
@@ -234,9 +557,29 @@ void CoreVision::update()
         videoReader_->updateFrame();
         hasNewFrame_ = videoReader_->isFrameNew();
     }
+    updatePipelineState();
     processVideoFrame();
 }
 
+/*******************************************************************************
+Starts the stage threads when pipelined processing is requested, or stops them
+when it is not (or when calibration begins, since the calibration routine needs
+the source and background images of the frame it is tracking).
+*******************************************************************************/
+void CoreVision::updatePipelineState()
+{
+    bool usePipeline = usePipelinedProcessing_ && !isCalibrating_;
+
+    if( usePipeline && !framePipeline_->isRunning() ) {
+        debug_.printLn( "CoreVision::updatePipelineState() starting pipeline..." );
+        framePipeline_->start();
+    }
+    else if( !usePipeline && framePipeline_->isRunning() ) {
+        debug_.printLn( "CoreVision::updatePipelineState() stopping pipeline..." );
+        framePipeline_->stop();
+    }
+}
+
 /*******************************************************************************
 Calls close() on the video player.  
 
@@ -250,14 +593,6 @@ void CoreVision::stopVideoPlayer()
     hasNewFrame_ = true;
 }
 
-/*******************************************************************************
-Calls on OpenGL to clear the drawing surface.
-*******************************************************************************/
-void CoreVision::clearVideoFrame()
-{
-    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT ); 
-}
-
 /*******************************************************************************
 Looks for a PS3 (Play Station 3) camera first.  In the context of BigBlobby, 
 only the PS3Eye camera has been tested, so it is not clear if the Fire Fly or
@@ -327,6 +662,23 @@ void CoreVision::initVideoCamera()
     #else
         debug_.printLn( "TARGET_WIN32 is not defined." );
 
+        #ifdef TARGET_LINUX
+            if( sharedFrameSource_ != NULL && sharedFrameSource_->ringName() != sharedFrameRing_ ) {
+                delete sharedFrameSource_; // Ring name changed in the settings.
+                sharedFrameSource_ = NULL;
+            }
+            if( sharedFrameSource_ != NULL || openSharedFrameSource() ) {
+                if( sharedFrameSource_->isOpen() ) { // Else keeps the requested size.
+                    videoWidth_ = sharedFrameSource_->width();
+                    videoHeight_ = sharedFrameSource_->height();
+                }
+            }
+            else if( v4l2Camera_ != NULL || (videoGrabber_ == NULL && openV4l2Camera()) ) {
+                videoWidth_ = v4l2Camera_->width();
+                videoHeight_ = v4l2Camera_->height();
+            }
+            else
+        #endif
         if( videoGrabber_ == NULL ) {
             debug_.printLn( "About to create videoGrabber..." );
             videoGrabber_ = new ofVideoGrabber();
@@ -343,23 +695,12 @@ void CoreVision::initVideoCamera()
         }
     #endif
 
+    updateCameraFrameSource();
     tuioChannels_->setCameraWidthAndHeight( videoWidth_, videoHeight_ );
     blobTracker_->setMaxBlobDistance( videoWidth_ );
     debugPrintCamera( requestWidth, requestHeight, videoWidth_, videoHeight_ );
 }
 
-/*******************************************************************************
-Allocates memory for the source (ofxCvColorImage) and tracked (CPUImageFilter) 
-image buffers.
-*******************************************************************************/
-void CoreVision::setUpProcessedImage()
-{
-    debug_.printLn( "CoreVision::setUpProcessedImage() called...\n" );
-    processedImage_.clear();
-    processedImage_.setUseTexture( true );
-    processedImage_.allocate( videoWidth_, videoHeight_ );
-}
-
 /*******************************************************************************
 Quick Time must be installed for this to work.
 *******************************************************************************/
@@ -381,23 +722,116 @@ available, this function will call on the CPU frame grabber function (GPU is
 not currently used), and then process the image by apply filters and finding 
 any contours before calling on the TUIO object to send out tracking info.  
 Number of frames and time for calculating fps (frames per second) are also 
-tracked here.
+tracked here.  In pipelined mode, the output stage times the whole frame (see 
+outputStage()), since the vision thread only captures it.
 *******************************************************************************/
 void CoreVision::processVideoFrame()
 {
     if( hasNewFrame_ ) {
-        processTimer_->startTiming();
         calculateFps();
-        filterCameraImage();
-        findAndTrackBlobs();
-        updateAutoBackground();
-        sendTuio();
-        checkPeriodicBackground();
-        writeVideoIfRequested();
-        processTimer_->stopTiming();
+
+        if( framePipeline_->isRunning() ) {
+            captureVideoFrame();
+        }
+        else {
+            processTimer_->startTiming();
+            filterCameraImage();
+            findAndTrackBlobs( imageFilters_->grayOutputBuffer(), imageFilters_->trackedBits(),
+                               imageFilters_->signalBuffer(), imageFilters_->trackedRegion(), 
+                               isCalibrating_, frames_ );
+            updateAutoBackground( !contourFinder_.isEmpty() );
+            sendTuio();
+            checkPeriodicBackground( blobTracker_->hasBlobsInScreenArea() );
+            writeVideoIfRequested();
+            processTimer_->stopTiming();
+            publishVisionFrame();
+        }
     }
 }
 
+/*******************************************************************************
+Capture stage of the pipeline (runs on the vision thread).  Converts the camera
+frame to gray (and flips it) into the source buffer of a pooled frame and hands
+the frame to the filter stage.  If every pooled frame is still in flight, the 
+camera frame is dropped.
+*******************************************************************************/
+void CoreVision::captureVideoFrame()
+{
+    blobUtils::StopWatch stopWatch;
+    blobVideo::FrameSource * source = frameSource();
+
+    if( source != NULL && source->hasFrame() ) {
+        blobCore::VisionFrame * frame = framePipeline_->acquireFrame();
+
+        if( frame != NULL ) {
+            imageFilters_->copyFrame( source, frame->sourceBuffer( source->width(), source->height() ) );
+            frame->setFrameNumber( frameNumber_ );
+            frame->setProcessingTime( stopWatch.elapsed() );
+            framePipeline_->submitFrame( frame );
+        }
+    }
+}
+
+/*******************************************************************************
+Filter stage of the pipeline.  Runs the filter chain on the frame's source
+image and copies the filtered images into the frame.  The auto background 
+learn rate and periodic background use the blob counts from the most recent
+frame that finished the tracking stage.
+*******************************************************************************/
+blobCore::VisionFrame * CoreVision::filterStage( blobCore::VisionFrame * frame )
+{
+    blobUtils::StopWatch stopWatch;
+    imageFilters_->processSourceBuffer( frame->grayBuffer( blobEnums::FilterEnum::SOURCE ) );
+    updateNormalizationIfRequested();
+    frame->copyFilterImagesFrom( imageFilters_ );
+    updateAutoBackground( hasBlobs_ );
+    checkPeriodicBackground( hasBlobsInScreenArea_ );
+    frame->addProcessingTime( stopWatch.elapsed() );
+    return frame;
+}
+
+/*******************************************************************************
+Tracking stage of the pipeline.  Finds and tracks the blobs in the frame's 
+thresholded image and stores the results in the frame.
+*******************************************************************************/
+blobCore::VisionFrame * CoreVision::trackingStage( blobCore::VisionFrame * frame )
+{
+    blobUtils::StopWatch stopWatch;
+    findAndTrackBlobs( frame->grayBuffer( blobEnums::FilterEnum::TRACKED ), frame->trackedBits(),
+                       frame->signalBuffer(), frame->trackedRegion(), false, frame->frameNumber() );
+    frame->setBlobs( contourFinder_.getBlobs(), contourFinder_.contourPoints() );
+    frame->setTrackedBlobs( *blobTracker_->getTrackedBlobs() );
+    hasBlobs_ = !contourFinder_.isEmpty();
+    hasBlobsInScreenArea_ = blobTracker_->hasBlobsInScreenArea();
+    frame->addProcessingTime( stopWatch.elapsed() );
+    return frame;
+}
+
+/*******************************************************************************
+Output stage of the pipeline.  Sends TUIO for the frame's tracked blobs, 
+records its source image (if requested), and then publishes the frame for the 
+GUI thread by swapping its contents into the back buffer of the triple buffer.
+The frame goes back to the pool holding the old back buffer contents.  The 
+time that all of the stages spent on the frame is counted as the processing
+time (the stages work on different frames at the same time, so this can be 
+more than the time between frames).
+*******************************************************************************/
+blobCore::VisionFrame * CoreVision::outputStage( blobCore::VisionFrame * frame )
+{
+    blobUtils::StopWatch stopWatch;
+
+    if( !isCalibrating_ ) {
+        tuioChannels_->sendTuio( &frame->trackedBlobs() );
+    }
+    if( recordSourceImages_ ) {
+        videoWriter_->processGrayscaleImage( frame->grayBuffer( blobEnums::FilterEnum::SOURCE ) );
+    }
+    processTimer_->addTime( frame->processingTime() + stopWatch.elapsed() );
+    visionFrames_->backBuffer().swap( *frame );
+    visionFrames_->publish();
+    return frame;
+}
+
 void CoreVision::writeVideoIfRequested()
 {
     if( recordSourceImages_ ) {
@@ -406,15 +840,31 @@ void CoreVision::writeVideoIfRequested()
 }
 
 /*******************************************************************************
-Keeps track of the frame count and the time needed for fps calculation.
+Copies the images and blobs for the frame just processed into the back buffer
+of the triple buffer and publishes it for the GUI thread.
+*******************************************************************************/
+void CoreVision::publishVisionFrame()
+{
+    blobCore::VisionFrame & visionFrame = visionFrames_->backBuffer();
+    visionFrame.copyFrom( imageFilters_, contourFinder_.getBlobs(), contourFinder_.contourPoints(), frameNumber_ );
+    visionFrames_->publish();
+}
+
+/*******************************************************************************
+Keeps track of the frame count and the time needed for fps calculation.  The
+rate at which the FramePipeline drops frames is updated along with the fps.
 *******************************************************************************/
 void CoreVision::calculateFps()
 {
     ++frames_;
+    ++frameNumber_;
     double elapsedTime = stopWatch_->elapsed();
 
     if( elapsedTime > 1.0 ) {
+        int droppedFrames = framePipeline_->droppedFrames();
         fps_ = frames_ / elapsedTime;
+        droppedFps_ = (droppedFrames - lastDroppedFrames_) / elapsedTime;
+        lastDroppedFrames_ = droppedFrames;
         stopWatch_->start();
         frames_ = 0;
         needToDisplayUpdatedFps_ = true;
@@ -422,88 +872,159 @@ void CoreVision::calculateFps()
 }
 
 /*******************************************************************************
-Grabs the camera or video frame and sends it to the ImageFilters object.
+Returns the source of the current camera or video frame (or NULL if there is no
+camera).
 *******************************************************************************/
-void CoreVision::filterCameraImage()
+blobVideo::FrameSource * CoreVision::frameSource()
 {
-    unsigned char * pixels = NULL;
-    bool useGrayscale = true;
-
     if( useCamera_ ) {
-        #ifdef TARGET_WIN32
-            if( ps3Camera_ != NULL ) {
-                pixels = ps3Camera_->getPixels();
-            }
-            else if( ffmvCamera_ != NULL ) {
-                pixels = ffmvCamera_->fcImage[ ffmvCamera_->getDeviceID() ].pData;
-            }
-            else if( videoGrabber_ != NULL ) {
-                pixels = videoGrabber_->getPixels();
-                useGrayscale = false;
+        #ifdef TARGET_LINUX
+            if( sharedFrameSource_ != NULL ) {
+                return sharedFrameSource_;
             }
-            else if( dsvlCamera_ != NULL ) {
-                pixels = dsvlCamera_->getPixels();
-                useGrayscale = (dsvlCamera_->getNumByes() == 1);
-            }
-        #else
-            if( videoGrabber_ != NULL ) {
-                pixels = videoGrabber_->getPixels();
-                useGrayscale = false;
+            else if( v4l2Camera_ != NULL ) {
+                return v4l2Camera_;
             }
         #endif
+        return cameraFrameSource_;
     }
-    else { // Must be using video player.
-        pixels = videoReader_->getPixels();
-        useGrayscale = false;
-    }
-    if( pixels != NULL ) {
-        if( useGrayscale ) {
-            imageFilters_->processGrayscaleImage( pixels, videoWidth_, videoHeight_ );
+    return videoReader_; // Must be using video player.
+}
+
+/*******************************************************************************
+Makes the FrameSource for whichever camera initVideoCamera() set up.
+*******************************************************************************/
+void CoreVision::updateCameraFrameSource()
+{
+    delete cameraFrameSource_;
+    cameraFrameSource_ = NULL;
+
+    #ifdef TARGET_WIN32
+        if( ps3Camera_ != NULL ) {
+            cameraFrameSource_ = new blobVideo::Ps3FrameSource( ps3Camera_ );
         }
-        else {
-            imageFilters_->processRgbImage( pixels, videoWidth_, videoHeight_ );
+        else if( ffmvCamera_ != NULL ) {
+            cameraFrameSource_ = new blobVideo::FfmvFrameSource( ffmvCamera_ );
         }
-        // If background has changed, need to update signal intensity 
-        // normalization after several frames.  Updating immediately might not 
-        // work well, as a first camera or reader frame may have to much noise.
-        if( (updateNormalizationCountDown_ > 0) && !isCalibrating_ ) {
-            --updateNormalizationCountDown_;
-
-            if( updateNormalizationCountDown_ == 0 ) {
-                blobCalibration_.updateCalGridPointsBackground( imageFilters_->backgroundBuffer() );
-                imageFilters_->setSignalFishEyeGrid( blobCalibration_.copyOfFishEyeGrid() );
-            }
+        else if( videoGrabber_ != NULL ) {
+            cameraFrameSource_ = new blobVideo::VideoGrabberFrameSource( videoGrabber_ );
+        }
+    #else
+        if( videoGrabber_ != NULL ) {
+            cameraFrameSource_ = new blobVideo::VideoGrabberFrameSource( videoGrabber_ );
         }
+    #endif
+}
+
+#ifdef TARGET_LINUX
+/*******************************************************************************
+If a shared frame ring is named in the settings, frames are read from it (and
+not from a camera).  The producer process does not have to be running yet.
+*******************************************************************************/
+bool CoreVision::openSharedFrameSource()
+{
+    if( sharedFrameRing_.empty() ) {
+        return false;
+    }
+    debug_.printLn( "About to open shared frame ring " + sharedFrameRing_ + "..." );
+    sharedFrameSource_ = new blobVideo::SharedFrameSource( sharedFrameRing_ );
+    sharedFrameSource_->readFrame(); // Opens the ring if it is there already.
+    return true;
+}
+
+/*******************************************************************************
+Tries to open the camera through V4L2, which hands its mapped kernel buffers to
+the filters without a copy.  Returns false (so that the ofVideoGrabber is used
+instead) if there is no V4L2 device or it cannot stream a supported format.
+*******************************************************************************/
+bool CoreVision::openV4l2Camera()
+{
+    debug_.printLn( "About to open V4L2 camera..." );
+    v4l2Camera_ = new blobVideo::V4l2FrameSource();
+
+    if( !v4l2Camera_->open( deviceID_, videoWidth_, videoHeight_, videoRate_ ) ) {
+        delete v4l2Camera_;
+        v4l2Camera_ = NULL;
+        return false;
+    }
+    return true;
+}
+#endif
+
+/*******************************************************************************
+Grabs the camera or video frame and sends it to the ImageFilters object.
+*******************************************************************************/
+void CoreVision::filterCameraImage()
+{
+    blobVideo::FrameSource * source = frameSource();
+
+    if( source != NULL && source->hasFrame() ) {
+        imageFilters_->processFrame( source );
+        updateNormalizationIfRequested();
     }
 }
 
 /*******************************************************************************
-Copies the GrayBuffer processed image to a CCV CPUImageFilter that is then
-sent to the OpenCV findContour function.  The ContourFinder is then passed 
-to the BlobTracker.
+If background has changed, need to update signal intensity normalization after 
+several frames.  Updating immediately might not work well, as a first camera or
+reader frame may have to much noise.
 *******************************************************************************/
-void CoreVision::findAndTrackBlobs()
+void CoreVision::updateNormalizationIfRequested()
+{
+    if( (updateNormalizationCountDown_ > 0) && !isCalibrating_ ) {
+        --updateNormalizationCountDown_;
+
+        if( updateNormalizationCountDown_ == 0 ) {
+            blobCalibration_.updateCalGridPointsBackground( imageFilters_->backgroundBuffer() );
+            imageFilters_->setSignalFishEyeGrid( blobCalibration_.copyOfFishEyeGrid() );
+        }
+    }
+}
+
+/*******************************************************************************
+Hands the GrayBuffer processed image straight to the ContourFinder, which 
+only searches the tracked region (the part of the image inside the calibration
+mask).  If the filters wrote bit-packed tracked output, the blobs are found in
+those bits instead (trackedBits is NULL otherwise).  The signal image (NULL 
+unless weighted centroids or angles are on) is what the blob pixels are 
+weighted by.  The ContourFinder's blobs are then passed to the BlobTracker.  
+The calibration routine also needs the smoothed source and background images,
+which only the serial (non-pipelined) path can provide.
+*******************************************************************************/
+void CoreVision::findAndTrackBlobs( blobBuffers::GrayBuffer * grayOutputBuffer,
+                                    blobBuffers::BitBuffer * trackedBits,
+                                    blobBuffers::GrayBuffer * signalBuffer,
+                                    CvRect trackedRegion,
+                                    bool useCalibrationBuffers,
+                                    int frameCount )
 {
     contourFinderTimer_->startTiming();
-    blobBuffers::GrayBuffer * grayOutputBuffer = imageFilters_->grayOutputBuffer();
-    unsigned char * pixels = grayOutputBuffer->pixels();
-    processedImage_.setFromPixels( pixels, videoWidth_, videoHeight_);
     int maxNumBlobs = maxNumberBlobs_;
     blobBuffers::GrayBuffer * sourceBuffer = NULL,
                             * backgroundBuffer = NULL;
 
-    if( isCalibrating_ ) { 
+    if( useCalibrationBuffers ) { 
         maxNumBlobs = blobCalibration_.numberOfCalibrationGridPoints() + 5;
         sourceBuffer = imageFilters_->smoothedSourceBuffer();
         backgroundBuffer = imageFilters_->backgroundBuffer();
     }
     //debugPrintMaxNumBlobs( maxNumBlobs );
-    contourFinder_.findContours( processedImage_,
-                                 minBlobSize_, maxBlobSize_, maxNumBlobs,
-                                 false, 
-                                 frames_,
-                                 sourceBuffer,
-                                 backgroundBuffer );
+    contourFinder_.setSearchRegion( trackedRegion );
+    contourFinder_.setSignalImage( signalBuffer );
+    if( trackedBits != NULL ) {
+        contourFinder_.findContours( trackedBits,
+                                     minBlobSize_, maxBlobSize_, maxNumBlobs,
+                                     frameCount,
+                                     sourceBuffer,
+                                     backgroundBuffer );
+    }
+    else {
+        contourFinder_.findContours( grayOutputBuffer,
+                                     minBlobSize_, maxBlobSize_, maxNumBlobs,
+                                     frameCount,
+                                     sourceBuffer,
+                                     backgroundBuffer );
+    }
     contourFinderTimer_->stopTiming();
 
     blobTrackerTimer_->startTiming();
@@ -515,10 +1036,10 @@ void CoreVision::findAndTrackBlobs()
 Updates auto background learn rate (if needed).  The learning rate is slower 
 if the ContourFinder has blobs.
 *******************************************************************************/
-void CoreVision::updateAutoBackground()
+void CoreVision::updateAutoBackground( bool hasBlobs )
 {
     if( imageFilters_->isAutoBackgroundActive() ) {
-        if( !contourFinder_.isEmpty() ) { // Learn slow if blobs present.
+        if( hasBlobs ) { // Learn slow if blobs present.
             imageFilters_->setBackgroundLearnRate( backgroundLearnRate_ * 0.0001f );
         }
         else {
@@ -540,22 +1061,43 @@ void CoreVision::sendTuio()
 /***************************************************************************//**
 If time to update, calls on the ImageTimer to save the next frame as background.
 *******************************************************************************/
-void CoreVision::checkPeriodicBackground()
+void CoreVision::checkPeriodicBackground( bool hasBlobsInScreenArea )
 {
-    if( !blobTracker_->hasBlobsInScreenArea() ) {
+    if( !hasBlobsInScreenArea ) {
         imageFilters_->checkPeriodicBackground();
     }
 }
 
 /***************************************************************************//**
-Use this function to check if the last call to update() found a new video camera
-or video player frame to process.
+Called by the GUI thread (once per repaint) to pick up the most recent frame
+published by the vision thread.  Returns true if a new frame was obtained.  The
+frame stays valid until the next call to this function.
+*******************************************************************************/
+bool CoreVision::fetchLatestFrame()
+{
+    hasNewDisplayFrame_ = visionFrames_->fetch();
+    return hasNewDisplayFrame_;
+}
+
+/***************************************************************************//**
+Returns the frame obtained by the last call to fetchLatestFrame().  Its image
+buffers are NULL until the vision thread has processed its first frame.
+*******************************************************************************/
+blobCore::VisionFrame * CoreVision::latestFrame()
+{
+    return &visionFrames_->frontBuffer();
+}
+
+/***************************************************************************//**
+Use this function to check if the last call to fetchLatestFrame() found a new
+frame from the vision thread.
 *******************************************************************************/
 bool CoreVision::hasNewFrame()
 {
-    return hasNewFrame_;
+    return hasNewDisplayFrame_;
 }
 
+#ifndef BLOBBY_HEADLESS
 /*******************************************************************************
 Calls on each Blob object to draw its contour (outline) and a set of cross-hairs
 that run through its centroid.
@@ -565,13 +1107,14 @@ void CoreVision::drawBlobOutlines()
     if( hasExited_ ) { return; }
 
     if( showBlobOutlines_ || showBlobBoundingBoxes_ || showBlobCrosshairs_ || showBlobAreas_ ) {
-        std::vector<blobTracker::Blob> & blobs = contourFinder_.getBlobs();
+        std::vector<blobTracker::Blob> & blobs = latestFrame()->blobs();
+        const std::vector<ofPoint> & contourPoints = latestFrame()->contourPoints();
         int length = blobs.size();
 
         for( int i = 0; i < length; ++i ) {
             blobTracker::Blob & blob = blobs[i];
 
-            if( showBlobOutlines_ )      { blob.drawContourPoints(); }
+            if( showBlobOutlines_ )      { blob.drawContourPoints( contourPoints ); }
             if( showBlobBoundingBoxes_ ) { blob.drawAngularBoundingBox(); }
             if( showBlobCrosshairs_ )    { blob.drawCrosshairs(); }
 
@@ -597,6 +1140,7 @@ void CoreVision::drawCalibrationWireframe()
     if( hasExited_ ) { return; }
 
     if( showCalibrationWireframe_ ) {
+        ScopedLock lock( *this );
         blobCalibration_.drawCalibrationWireframe( videoWidth_, videoHeight_ );
     }
 }
@@ -610,6 +1154,7 @@ void CoreVision::drawCalibrationPointsWithIntensities()
     if( hasExited_ ) { return; }
 
     if( showCalibrationIntensities_ ) {
+        ScopedLock lock( *this );
         blobCalibration_.drawCalibrationPointsWithIntensities( videoWidth_, videoHeight_ );
     }
 }
@@ -623,7 +1168,7 @@ void CoreVision::drawBlobIdNumbers()
     if( hasExited_ ) { return; }
 
     if( showBlobLabels_ ) {
-        std::vector<blobTracker::Blob> & blobs = contourFinder_.getBlobs();
+        std::vector<blobTracker::Blob> & blobs = latestFrame()->blobs();
         int length = blobs.size();
 
         for( int i = 0; i < length; ++i ) {
@@ -639,26 +1184,25 @@ void CoreVision::drawBlobIdNumbers()
         ofSetColor( 0xFFFFFF );
     }
 }
+#endif
 
 /***************************************************************************//**
 Returns true if it is time to update the frames per second shown in the GUI.
 *******************************************************************************/
 bool CoreVision::needToDisplayUpdatedFps()
 {
-    if( needToDisplayUpdatedFps_ ) {
-        needToDisplayUpdatedFps_ = false;
-        return true;
-    }
-    return needToDisplayUpdatedFps_;
+    return needToDisplayUpdatedFps_.exchange( false );
 }
 
 /***************************************************************************//**
-Returns frames per second and other key info.
+Returns frames per second, frames dropped per second by the FramePipeline, and 
+other key info.
 *******************************************************************************/
 std::string CoreVision::getUpdatedFps()
 {
+    ScopedLock lock( *this );
     stats_->showProcessingTime( true );
-    return stats_->fpsStats( fps_, videoWidth_, videoHeight_ );
+    return stats_->fpsStats( fps_, droppedFps_, videoWidth_, videoHeight_ );
 }
 
 /***************************************************************************//**
@@ -666,6 +1210,7 @@ Returns network and filter timing info.
 *******************************************************************************/
 std::string CoreVision::getNetworkAndFiltersInfo()
 {
+    ScopedLock lock( *this );
     stats_->showProcessingTime( true );
     return stats_->networkAndFilterStats( tuioChannels_->getOutputSummary(),
                                           imageFilters_->calculateStats(),
@@ -688,6 +1233,7 @@ and height along with a reference to the BlobTracker object.
 *******************************************************************************/
 void CoreVision::setUpBlobCalibration()
 {
+    ScopedLock lock( *this );
     blobCalibration_.setup( videoWidth_, videoHeight_, blobTracker_ );
     imageFilters_->setMaskCalibrationGridPoints( blobCalibration_.copyOfGridPoints() );
     imageFilters_->setSignalFishEyeGrid( blobCalibration_.copyOfFishEyeGrid() );
@@ -700,6 +1246,7 @@ calibration routine.
 void CoreVision::startCalibrationRoutine()
 {
     debug_.printLn( "CoreVision::startCalibrationRoutine() called..." );
+    ScopedLock lock( *this );
 
     //Enter/Exit Calibration
     isCalibrating_ = true; // Stop sending TUIO messages on second channel.
@@ -710,6 +1257,7 @@ void CoreVision::startCalibrationRoutine()
 
 void CoreVision::onCalibrationEnded()
 {
+    ScopedLock lock( *this );
     isCalibrating_ = false; // Send TUIO messages on second channel again.
     blobTracker_->setCalibrating( false );
     blobCalibration_.checkForIncompleteCalibration();
@@ -718,11 +1266,13 @@ void CoreVision::onCalibrationEnded()
     imageFilters_->setSignalFishEyeGrid( blobCalibration_.copyOfFishEyeGrid() );
 }
 
+#ifndef BLOBBY_HEADLESS
 /***************************************************************************//**
 Uses OpenGL code to draw the calibration screen.
 *******************************************************************************/
 void CoreVision::drawCalibration( int screenWidth, int screenHeight )
 {
+    ScopedLock lock( *this );
     glMatrixMode( GL_MODELVIEW );
     glPushMatrix();
         glTranslatef( 0.0f, screenHeight, 0.0f );
@@ -730,14 +1280,15 @@ void CoreVision::drawCalibration( int screenWidth, int screenHeight )
         blobCalibration_.doCalibration( screenWidth, screenHeight );
     glPopMatrix();
 }
+#endif
 
 /***************************************************************************//**
-Clears the source image (ofxCvColorImage) and the processed image
-(CPUImageFilter).
+Clears the blobs and the ContourFinder's labelling buffers.
 *******************************************************************************/
 void CoreVision::clear()
 {
-    processedImage_.clear();
+    ScopedLock lock( *this );
+    contourFinder_.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -765,6 +1316,23 @@ int CoreVision::getDeviceID()
     return deviceID_;
 }
 
+/***************************************************************************//**
+Name of the shared memory (for example, &quot;/bigblobby&quot;) that another 
+process writes camera frames into (see blobVideo::SharedFrameSource).  Takes 
+the place of the camera when it is set, but only on Linux.  An empty string 
+means use the camera.  Takes effect the next time the camera is started.
+*******************************************************************************/
+void CoreVision::setSharedFrameRing( const std::string & name )
+{
+    sharedFrameRing_ = name;
+    debug_.printLn( "CoreVision::setSharedFrameRing(" + sharedFrameRing_ + ") called." );
+}
+
+std::string CoreVision::getSharedFrameRing()
+{
+    return sharedFrameRing_;
+}
+
 /***************************************************************************//**
 The requested video rate is usually 30 or 60 frames per second.  If the number
 is much higher than the camera or blob detection code can handle, the actually
@@ -899,6 +1467,7 @@ vertically so that the image can be flipped back.
 *******************************************************************************/
 bool CoreVision::startVideoWriter( const std::string & filename )
 {
+    ScopedLock lock( *this );
     //std::cout << "\nCoreVision::startVideoWriter( " << filename << " ) called.\n\n";
     videoWriter_->flipImageVertical( imageFilters_->flipImageVertical() );
     videoWriter_->flipImageHorizontal( imageFilters_->flipImageHorizontal() );
@@ -911,6 +1480,7 @@ Clears the video writer.
 *******************************************************************************/
 void CoreVision::stopVideoWriter()
 {
+    ScopedLock lock( *this );
     //std::cout << "\nCoreVision::stopVideoWriter() called.\n\n";
     recordSourceImages_ = false;
     videoWriter_->clear();
@@ -921,10 +1491,12 @@ Sets up the video player to start the next time that update() is called.
 *******************************************************************************/
 void CoreVision::playTestVideo( const std::string & filename )
 {
+    ScopedLock lock( *this );
     videoFileName_ = filename;
     startVideoPlayer_ = true;
     useCamera_ = false;
     startVideoCamera_ = false;
+    frameSignal_->notify();
 
     debug_.printLn( "\nCoreVision::playTestVideo() called.\n" );
     debug_.printLn( "filename = " + filename );
@@ -938,9 +1510,11 @@ Sets up the camera to start the next time that update() is called.
 *******************************************************************************/
 void CoreVision::stopTestVideo()
 {
+    ScopedLock lock( *this );
     startVideoCamera_ = true;
     useCamera_ = true;
     startVideoPlayer_ = false;
+    frameSignal_->notify();
         
     debug_.printLn( "CoreVision::stopTestVideo() called.\n" );
     debug_.printLn( "startVideoCamera_ = true" );
@@ -1266,6 +1840,7 @@ void CoreVision::setupTuio( const std::string & localHost,
                             int flashXmlChannelPort,
                             int binaryTcpChannelPort )
 {
+    ScopedLock lock( *this );
     tuioChannels_->setupTuio( localHost, 
                               tuioUdpChannelOnePort, 
                               tuioUdpChannelTwoPort, 
@@ -1440,6 +2015,7 @@ Passes the key pressed event on to the BlobCalibration object.
 *******************************************************************************/
 void CoreVision::keyPressed( KeyEnum::Enum key )
 {
+    ScopedLock lock( *this );
     blobCalibration_.keyPressed( key );
 }
 
@@ -1448,6 +2024,7 @@ Passes the key released event on to the BlobCalibration object.
 *******************************************************************************/
 void CoreVision::keyReleased( KeyEnum::Enum key )
 {
+    ScopedLock lock( *this );
     blobCalibration_.keyReleased( key );
 }
 
@@ -57,9 +57,13 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobEnums/TuioProfileEnum.h"
 #include "blobIO/DebugPrint.h"
 #include "blobTracker/BlobTracker.h"
-#include "blobTracker/CPUImageFilter.h"
+#include "blobTracker/ContourFinder.h"
 #include <ofVideoGrabber.h>
-#include <ofTrueTypeFont.h>
+#ifndef BLOBBY_HEADLESS
+    #include <ofTrueTypeFont.h>
+#endif
+#include <boost/atomic.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 #include <string>
 
 #ifdef TARGET_WIN32
@@ -68,13 +72,23 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     #include <ofxDSVL.h>
 #endif
 
+namespace boost { class thread; }
+namespace blobBuffers { class GrayBuffer; }
+namespace blobBuffers { class BitBuffer; }
+namespace blobCore { class FramePipeline; }
+namespace blobCore { class VisionFrame; }
 namespace blobTuio { class TuioChannels; }
 namespace blobFilters { class ImageFilters; }
+namespace blobUtils { class FrameSignal; }
 namespace blobUtils { class FunctionTimer; }
 namespace blobUtils { class StopWatch; }
+namespace blobUtils { template <typename T> class TripleBuffer; }
 namespace blobStats { class Stats; }
 namespace blobVideo { class SimpleVideoWriter; }
+namespace blobVideo { class FrameSource; }
 namespace blobVideo { class SimpleVideoReader; }
+namespace blobVideo { class SharedFrameSource; }
+namespace blobVideo { class V4l2FrameSource; }
 
 /***************************************************************************//** 
 Contains classes for blob detection and screen calibration using code from CCV 
@@ -93,6 +107,27 @@ namespace blobCore
      not know anything about the Qt GUI classes or anything else in the Qt
      library.
 
+     Camera capture, filtering, blob detection, tracking, and TUIO output all
+     run on a vision thread owned by this class (see startVisionThread()), so a
+     busy GUI thread cannot stall the touch output.  The vision thread sleeps
+     until the camera (or video player) has a frame rather than being driven
+     by the GUI repaint timer.  After each frame, the
+     vision thread publishes a VisionFrame snapshot through a lock-free
+     TripleBuffer, and the GUI thread only ever renders the latest snapshot
+     obtained with fetchLatestFrame().  Settings that replace objects used by
+     the vision thread (calibration grids, video writer, camera restarts) are
+     applied while holding a CoreVision::ScopedLock, and so are all other 
+     settings changed while the vision thread is running (the GUI slots take
+     the lock before calling any setter here or on the ImageFilters), since 
+     the filters, the pipeline stages, and the strip threads read them in the
+     middle of a frame.
+
+     In pipelined mode (see usePipelinedProcessing()), the vision thread only
+     captures frames, and filtering, contour finding/tracking, and output 
+     (TUIO and video recording) each run on their own FramePipeline thread, so
+     frame N+1 can be filtered while frame N is tracked and sent.  Holding a
+     ScopedLock also pauses the pipeline stages.
+
      The CoreVision class is based on code from the Community Core Vision
      ofxNCoreVision class (files ofxNCoreVision.h, ofxNCoreVision.cpp, and
      gui.h), but does not include any of the GLUT graphical user interface code.
@@ -147,15 +182,59 @@ namespace blobCore
                              VIDEO_HEIGHT,
                              VIDEO_RATE,
                              MAX_NUMBER_BLOBS,
-                             BACKGROUND_FRAMES_COUNT;
+                             BACKGROUND_FRAMES_COUNT,
+                             CAMERA_WAIT_MILLIS;
+            static const double GRABBER_POLL_SECONDS;
+
+            /*******************************************************************//**
+             Locks the vision thread and pauses the pipeline stages for as long
+             as it is in scope.  Can be nested.
+            ***********************************************************************/
+            class ScopedLock
+            {
+            public:
+                ScopedLock( CoreVision & coreVision ) : coreVision_( coreVision ) { coreVision_.lockVision(); }
+                ~ScopedLock() { coreVision_.unlockVision(); }
+
+            private:
+                ScopedLock( const ScopedLock & );
+                ScopedLock & operator=( const ScopedLock & );
+
+                CoreVision & coreVision_;
+            };
 
             CoreVision();
             ~CoreVision();
+#ifndef BLOBBY_HEADLESS
             void loadFontForBlobIDNumbers();
+#endif
+            void startVisionThread();
+            void stopVisionThread();
+            bool isVisionThreadRunning();
+            void lockVision();
+            void unlockVision();
+            void usePipelinedProcessing( bool b );
+            bool usePipelinedProcessing();
+            void useStripFilterProcessing( bool b );
+            bool useStripFilterProcessing();
+            void usePackedTrackedOutput( bool b );
+            bool usePackedTrackedOutput();
+            void useOptimalBlobAssignment( bool b );
+            bool useOptimalBlobAssignment();
+            void useWeightedBlobCentroids( bool b );
+            bool useWeightedBlobCentroids();
+            void useWeightedBlobAngles( bool b );
+            bool useWeightedBlobAngles();
+            void writeFilterImages( bool b );
+            bool writeFilterImages();
             void update();
+            bool fetchLatestFrame();
+            blobCore::VisionFrame * latestFrame();
             bool hasNewFrame();
+#ifndef BLOBBY_HEADLESS
             void drawBlobIdNumbers();
             void drawBlobOutlines();
+#endif
 
             bool needToDisplayUpdatedFps();
             std::string getUpdatedFps();
@@ -165,13 +244,17 @@ namespace blobCore
             void setUpBlobCalibration();
             void startCalibrationRoutine();
             void onCalibrationEnded();
+#ifndef BLOBBY_HEADLESS
             void drawCalibration( int screenWidth, int screenHeight );
             void drawCalibrationWireframe();
             void drawCalibrationPointsWithIntensities();
+#endif
             void clear();
 
             void setDeviceID( int id );
             int getDeviceID();
+            void setSharedFrameRing( const std::string & name );
+            std::string getSharedFrameRing();
             void setVideoRate( int rate );
             int getVideoRate();
             void setVideoWidth( int width );
@@ -260,20 +343,40 @@ namespace blobCore
             void keyReleased( blobEnums::KeyEnum::Enum key );
 
         private:
+            void runVisionThread();
+            void waitForVideoFrame();
             void stopVideoPlayer();
-            void clearVideoFrame();
             void initVideoCamera();
-            void setUpProcessedImage();
             void initVideoPlayer();
 
             void processVideoFrame();
             void calculateFps();
-            void checkPeriodicBackground();
+            void checkPeriodicBackground( bool hasBlobsInScreenArea );
+            blobVideo::FrameSource * frameSource();
+            void updateCameraFrameSource();
+            #ifdef TARGET_LINUX
+                bool openSharedFrameSource();
+                bool openV4l2Camera();
+            #endif
             void filterCameraImage();
-            void findAndTrackBlobs();
-            void updateAutoBackground();
+            void updateNormalizationIfRequested();
+            void findAndTrackBlobs( blobBuffers::GrayBuffer * grayOutputBuffer,
+                                    blobBuffers::BitBuffer * trackedBits,
+                                    blobBuffers::GrayBuffer * signalBuffer,
+                                    CvRect trackedRegion,
+                                    bool useCalibrationBuffers,
+                                    int frameCount );
+            void updateAutoBackground( bool hasBlobs );
             void sendTuio();
             void writeVideoIfRequested();
+            void publishVisionFrame();
+
+            // Pipeline
+            void updatePipelineState();
+            void captureVideoFrame();
+            blobCore::VisionFrame * filterStage( blobCore::VisionFrame * frame );
+            blobCore::VisionFrame * trackingStage( blobCore::VisionFrame * frame );
+            blobCore::VisionFrame * outputStage( blobCore::VisionFrame * frame );
 
             // Private Debugging Functions
             void debugPrintVideoWidthAndHeight( int width, int height );
@@ -285,12 +388,14 @@ namespace blobCore
 
             // Camera
             ofVideoGrabber * videoGrabber_;
+            blobVideo::FrameSource * cameraFrameSource_;
             bool useCamera_,
                  startVideoCamera_;
             int deviceID_,
                 videoRate_,
                 videoWidth_,
                 videoHeight_;
+            std::string sharedFrameRing_;
 
             // VideoPlayer
             blobVideo::SimpleVideoReader * videoReader_;
@@ -313,12 +418,13 @@ namespace blobCore
                  showBlobLabels_,
                  showCalibrationWireframe_,
                  showCalibrationIntensities_;
+#ifndef BLOBBY_HEADLESS
             ofTrueTypeFont verdana_;
+#endif
 
             // Filters, Network, and Calibration
             blobFilters::ImageFilters * imageFilters_;
             float backgroundLearnRate_;
-            CPUImageFilter processedImage_;
             bool useGpuShaders_;
             blobTuio::TuioChannels * tuioChannels_;
             blobCalibration::BlobCalibration blobCalibration_;
@@ -332,10 +438,29 @@ namespace blobCore
             blobUtils::FunctionTimer * contourFinderTimer_,
                                      * blobTrackerTimer_,
                                      * processTimer_;
-            bool hasNewFrame_,
-                 needToDisplayUpdatedFps_;
-            int frames_;
-            double fps_;
+            bool hasNewFrame_;
+            boost::atomic<bool> needToDisplayUpdatedFps_;
+            int frames_,
+                frameNumber_,
+                lastDroppedFrames_;
+            double fps_,
+                   droppedFps_;
+
+            // Vision thread and the frames it hands over to the GUI thread
+            boost::thread * visionThread_;
+            boost::atomic<bool> isVisionThreadRunning_;
+            boost::recursive_mutex visionMutex_;
+            blobUtils::TripleBuffer<blobCore::VisionFrame> * visionFrames_;
+            bool hasNewDisplayFrame_;
+            int visionLockDepth_;
+            blobUtils::FrameSignal * frameSignal_;
+            bool hasCapturedFrame_;
+
+            // Pipelined processing (filter, tracking, and output stage threads)
+            blobCore::FramePipeline * framePipeline_;
+            bool usePipelinedProcessing_;
+            boost::atomic<bool> hasBlobs_,
+                                hasBlobsInScreenArea_;
 
             bool hasExited_; // Used in ofxNCoreVision.  Not needed with Qt?
 
@@ -348,6 +473,12 @@ namespace blobCore
                     ofxPS3 * ps3Camera_;
                     ofxDSVL * dsvlCamera_;
             #endif
+
+            // Linux-Specific Video Capture Devices
+            #ifdef TARGET_LINUX
+                    blobVideo::SharedFrameSource * sharedFrameSource_;
+                    blobVideo::V4l2FrameSource * v4l2Camera_;
+            #endif
     };
 }
 
@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+// FramePipeline
+//
+// PURPOSE: Runs the stages of blob detection on separate threads, joined by
+//          bounded single-producer/single-consumer queues of pooled frames.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobCore/FramePipeline.h"
+#include "blobCore/VisionFrame.h"
+#include "blobUtils/SpscQueue.h"
+#include <boost/thread/thread.hpp>
+#include <boost/thread/locks.hpp>
+
+using blobCore::FramePipeline;
+using blobCore::VisionFrame;
+
+// Two queued frames per link are enough to keep every stage busy, and any 
+// more would only add latency (older frames get dropped anyway).
+const int FramePipeline::QUEUE_CAPACITY = 2;
+
+FramePipeline::FramePipeline() :
+  stages_(),
+  queues_(),
+  wakeMutexes_(),
+  wakeConditions_(),
+  threads_(),
+  pool_(),
+  poolMutex_(),
+  poolSize_( 0 ),
+  stageMutex_(),
+  isRunning_( false ),
+  droppedFrames_( 0 )
+{
+}
+
+FramePipeline::~FramePipeline()
+{
+    stop();
+
+    for( size_t i = 0; i < stages_.size(); ++i ) {
+        delete queues_[i];
+        delete wakeMutexes_[i];
+        delete wakeConditions_[i];
+    }
+    for( size_t i = 0; i < pool_.size(); ++i ) {
+        delete pool_[i];
+    }
+}
+
+/***************************************************************************//**
+Appends a stage to the end of the chain.  Stages can only be added while the
+pipeline is stopped.
+*******************************************************************************/
+void FramePipeline::addStage( const StageFunction & stage )
+{
+    if( !isRunning_ ) {
+        stages_.push_back( stage );
+        queues_.push_back( new blobUtils::SpscQueue<VisionFrame *>( QUEUE_CAPACITY ) );
+        wakeMutexes_.push_back( new boost::mutex() );
+        wakeConditions_.push_back( new boost::condition_variable() );
+    }
+}
+
+/***************************************************************************//**
+Tops up the frame pool and starts one thread per stage.
+*******************************************************************************/
+void FramePipeline::start()
+{
+    if( !isRunning_ && !stages_.empty() ) {
+        fillPool();
+        isRunning_ = true;
+
+        for( size_t i = 0; i < stages_.size(); ++i ) {
+            threads_.push_back( new boost::thread( &FramePipeline::runStage, this, (int)i ) );
+        }
+    }
+}
+
+/***************************************************************************//**
+Wakes up and joins the stage threads.  Frames still waiting in the queues are
+returned to the pool without being processed.
+*******************************************************************************/
+void FramePipeline::stop()
+{
+    if( isRunning_ ) {
+        isRunning_ = false;
+
+        for( size_t i = 0; i < stages_.size(); ++i ) {
+            { boost::lock_guard<boost::mutex> lock( *wakeMutexes_[i] ); }
+            wakeConditions_[i]->notify_all();
+        }
+        for( size_t i = 0; i < threads_.size(); ++i ) {
+            threads_[i]->join();
+            delete threads_[i];
+        }
+        threads_.clear();
+        drainQueues();
+    }
+}
+
+bool FramePipeline::isRunning()
+{
+    return isRunning_;
+}
+
+/***************************************************************************//**
+Blocks until no stage function is running and keeps new stage calls from 
+starting until resume() is called.  Must not be called from a stage thread.
+*******************************************************************************/
+void FramePipeline::pause()
+{
+    stageMutex_.lock();
+}
+
+void FramePipeline::resume()
+{
+    stageMutex_.unlock();
+}
+
+/***************************************************************************//**
+Returns a free frame from the pool, or NULL (counted as a dropped frame) if 
+every frame is still in flight.
+*******************************************************************************/
+VisionFrame * FramePipeline::acquireFrame()
+{
+    boost::lock_guard<boost::mutex> lock( poolMutex_ );
+
+    if( pool_.empty() ) {
+        ++droppedFrames_;
+        return NULL;
+    }
+    VisionFrame * frame = pool_.back();
+    pool_.pop_back();
+    return frame;
+}
+
+/***************************************************************************//**
+Hands a frame from acquireFrame() to the first stage.  Only one thread (the 
+capture thread) may call this function.
+*******************************************************************************/
+void FramePipeline::submitFrame( VisionFrame * frame )
+{
+    if( frame != NULL ) {
+        if( isRunning_ ) {
+            passToStage( 0, frame );
+        }
+        else {
+            recycleFrame( frame );
+        }
+    }
+}
+
+/***************************************************************************//**
+Total number of frames dropped since the pipeline was created.
+*******************************************************************************/
+int FramePipeline::droppedFrames()
+{
+    return droppedFrames_;
+}
+
+void FramePipeline::runStage( int index )
+{
+    int numberOfStages = stages_.size();
+
+    while( isRunning_ ) {
+        VisionFrame * frame = waitForLatestFrame( index );
+
+        if( frame != NULL ) {
+            {
+                boost::shared_lock<boost::shared_mutex> lock( stageMutex_ );
+                frame = stages_[index]( frame );
+            }
+            if( frame != NULL ) {
+                if( index + 1 < numberOfStages ) {
+                    passToStage( index + 1, frame );
+                }
+                else {
+                    recycleFrame( frame );
+                }
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+Empties the queue for the stage and returns the newest frame, recycling any 
+older ones (latest frame wins).  Sleeps on the stage's condition variable while
+the queue is empty.  Returns NULL only when the pipeline is stopping.
+*******************************************************************************/
+VisionFrame * FramePipeline::waitForLatestFrame( int index )
+{
+    blobUtils::SpscQueue<VisionFrame *> * queue = queues_[index];
+    VisionFrame * latest = NULL,
+                * frame = NULL;
+
+    while( latest == NULL && isRunning_ ) {
+        while( queue->tryPop( frame ) ) {
+            if( latest != NULL ) {
+                recycleFrame( latest );
+                ++droppedFrames_;
+            }
+            latest = frame;
+        }
+        if( latest == NULL ) {
+            boost::unique_lock<boost::mutex> lock( *wakeMutexes_[index] );
+
+            if( queue->isEmpty() && isRunning_ ) {
+                wakeConditions_[index]->wait( lock );
+            }
+        }
+    }
+    return latest;
+}
+
+/***************************************************************************//**
+Queues the frame for the stage at the index and wakes that stage up.  If the 
+queue is full, the frame is dropped rather than waiting for the stage.
+*******************************************************************************/
+void FramePipeline::passToStage( int index, VisionFrame * frame )
+{
+    if( queues_[index]->tryPush( frame ) ) {
+        { boost::lock_guard<boost::mutex> lock( *wakeMutexes_[index] ); }
+        wakeConditions_[index]->notify_one();
+    }
+    else {
+        recycleFrame( frame );
+        ++droppedFrames_;
+    }
+}
+
+void FramePipeline::recycleFrame( VisionFrame * frame )
+{
+    boost::lock_guard<boost::mutex> lock( poolMutex_ );
+    pool_.push_back( frame );
+}
+
+/***************************************************************************//**
+Makes sure there are enough frames for every queue to be full while every 
+stage (and the capture thread) is working on one more.  The frames are never 
+deleted until the pipeline is, so their GrayBuffers are reused frame after 
+frame.
+*******************************************************************************/
+void FramePipeline::fillPool()
+{
+    int needed = (int)stages_.size() * (QUEUE_CAPACITY + 1) + 1;
+    boost::lock_guard<boost::mutex> lock( poolMutex_ );
+
+    while( poolSize_ < needed ) {
+        pool_.push_back( new VisionFrame() );
+        ++poolSize_;
+    }
+}
+
+void FramePipeline::drainQueues()
+{
+    VisionFrame * frame = NULL;
+
+    for( size_t i = 0; i < queues_.size(); ++i ) {
+        while( queues_[i]->tryPop( frame ) ) {
+            recycleFrame( frame );
+        }
+    }
+}
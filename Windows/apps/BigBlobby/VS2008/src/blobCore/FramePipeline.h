@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+// FramePipeline
+//
+// PURPOSE: Runs the stages of blob detection on separate threads, joined by
+//          bounded single-producer/single-consumer queues of pooled frames.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBCORE_FRAMEPIPELINE_H
+#define BLOBCORE_FRAMEPIPELINE_H
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <vector>
+
+namespace boost { class thread; }
+namespace blobCore { class VisionFrame; }
+namespace blobUtils { template <typename T> class SpscQueue; }
+
+namespace blobCore
+{
+    /***********************************************************************//**
+    A chain of processing stages, each running on its own thread, so that frame
+    N+1 can be filtered while frame N is being tracked and sent out.
+
+    The thread that owns the camera calls acquireFrame() to get a free frame 
+    from the pool, fills in the source image, and calls submitFrame().  Each 
+    stage function receives a frame and returns the frame to pass on to the
+    next stage (normally the same one).  Whatever the last stage returns goes 
+    back into the pool.
+
+    Every link between two stages is a bounded SpscQueue with a "latest frame
+    wins" drop policy: a stage that falls behind skips straight to the newest
+    queued frame and recycles the older ones, and a producer that finds the 
+    next queue full drops its frame instead of waiting.  A slow stage therefore
+    costs frames, never latency.  The number of dropped frames is available 
+    from droppedFrames().
+
+    Stage functions run while holding a shared lock on the pipeline, so pause()
+    can be used to wait for all in-flight stage calls to finish before changing
+    objects that the stages use.
+    ***************************************************************************/
+    class FramePipeline
+    {
+    public:
+        typedef boost::function<blobCore::VisionFrame * (blobCore::VisionFrame *)> StageFunction;
+
+        static const int QUEUE_CAPACITY;
+
+        FramePipeline();
+        ~FramePipeline();
+
+        void addStage( const StageFunction & stage );
+        void start();
+        void stop();
+        bool isRunning();
+        void pause();
+        void resume();
+
+        blobCore::VisionFrame * acquireFrame();
+        void submitFrame( blobCore::VisionFrame * frame );
+        int droppedFrames();
+
+    private:
+        void runStage( int index );
+        blobCore::VisionFrame * waitForLatestFrame( int index );
+        void passToStage( int index, blobCore::VisionFrame * frame );
+        void recycleFrame( blobCore::VisionFrame * frame );
+        void fillPool();
+        void drainQueues();
+
+        std::vector<StageFunction> stages_;
+        std::vector<blobUtils::SpscQueue<blobCore::VisionFrame *> *> queues_;
+        std::vector<boost::mutex *> wakeMutexes_;
+        std::vector<boost::condition_variable *> wakeConditions_;
+        std::vector<boost::thread *> threads_;
+
+        std::vector<blobCore::VisionFrame *> pool_;
+        boost::mutex poolMutex_;
+        int poolSize_;
+
+        boost::shared_mutex stageMutex_;
+        boost::atomic<bool> isRunning_;
+        boost::atomic<int> droppedFrames_;
+    };
+}
+
+#endif
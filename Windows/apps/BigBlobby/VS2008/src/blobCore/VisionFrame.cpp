@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////////////////////////
+// VisionFrame
+//
+// PURPOSE: Holds a snapshot of the images and blobs from one processed camera
+//          frame so that the GUI can render them while the next frame is processed.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobCore/VisionFrame.h"
+#include "blobBuffers/GrayBuffer.h"
+#include "blobBuffers/BitBuffer.h"
+#include "blobFilters/ImageFilters.h"
+#include "blobFilters/DisplayTaps.h"
+#include <algorithm>
+
+using blobCore::VisionFrame;
+using blobEnums::FilterEnum;
+
+const int VisionFrame::NUMBER_OF_IMAGES = FilterEnum::SMOOTH + 1;
+
+VisionFrame::VisionFrame() :
+  grayBuffers_( NUMBER_OF_IMAGES, (blobBuffers::GrayBuffer *)NULL ),
+  isNewImage_( NUMBER_OF_IMAGES, false ),
+  trackedBits_( NULL ),
+  hasTrackedBits_( false ),
+  signalBuffer_( NULL ),
+  hasSignalBuffer_( false ),
+  blobs_(),
+  contourPoints_(),
+  trackedBlobs_(),
+  trackedRegion_(),
+  frameNumber_( 0 ),
+  processingTime_( 0.0 )
+{
+}
+
+VisionFrame::~VisionFrame()
+{
+    for( int i = 0; i < NUMBER_OF_IMAGES; ++i ) {
+        delete grayBuffers_[i];
+    }
+    delete trackedBits_;
+    delete signalBuffer_;
+}
+
+/***************************************************************************//**
+Copies the Source image and every filter image that has a display tap due 
+for this frame (see ImageFilters::displayTaps()) from the ImageFilters object, 
+along with the blobs (and contour points) from the last call to the 
+ContourFinder.  This function is called on the vision thread right after a 
+frame has been processed.
+*******************************************************************************/
+void VisionFrame::copyFrom( blobFilters::ImageFilters * imageFilters,
+                            const std::vector<blobTracker::Blob> & blobs,
+                            const std::vector<ofPoint> & contourPoints,
+                            int frameNumber )
+{
+    copyBuffer( FilterEnum::SOURCE, imageFilters->grayBuffer( FilterEnum::SOURCE ) );
+    copyTappedImagesFrom( imageFilters );
+    setBlobs( blobs, contourPoints );
+    frameNumber_ = frameNumber;
+}
+
+/***************************************************************************//**
+Copies the filter images for the pipelined filter stage.  The Source image 
+has already been written by the capture stage with sourceBuffer().  The 
+tracking stage finds the blobs in the bit-packed tracked output if the filters 
+write it, so then only the bits are always copied (an eighth of the bytes).  
+Otherwise the Tracked image is always copied.  The other images are only 
+copied when their display taps are due.  The signal image is copied whenever
+the filters keep it.
+*******************************************************************************/
+void VisionFrame::copyFilterImagesFrom( blobFilters::ImageFilters * imageFilters )
+{
+    copyTappedImagesFrom( imageFilters );
+    trackedRegion_ = imageFilters->trackedRegion();
+    const blobBuffers::BitBuffer * bits = imageFilters->trackedBits();
+    hasTrackedBits_ = (bits != NULL);
+
+    if( hasTrackedBits_ ) {
+        copyTrackedBits( bits );
+    }
+    else if( !isNewImage_[FilterEnum::TRACKED] ) {
+        copyBuffer( FilterEnum::TRACKED, imageFilters->grayBuffer( FilterEnum::TRACKED ) );
+    }
+    const blobBuffers::GrayBuffer * signal = imageFilters->signalBuffer();
+    hasSignalBuffer_ = (signal != NULL);
+
+    if( hasSignalBuffer_ ) {
+        copySignalBuffer( signal );
+    }
+}
+
+/***************************************************************************//**
+Copies the filter images whose display taps are due.  The images that are not
+copied keep the pixels of some earlier frame, and are marked as not new.
+*******************************************************************************/
+void VisionFrame::copyTappedImagesFrom( blobFilters::ImageFilters * imageFilters )
+{
+    for( int i = 0; i < NUMBER_OF_IMAGES; ++i ) {
+        if( i != FilterEnum::SOURCE ) {
+            isNewImage_[i] = false;
+
+            if( imageFilters->displayTaps()->isDue( (FilterEnum::Enum)i ) ) {
+                copyBuffer( i, imageFilters->grayBuffer( (FilterEnum::Enum)i ) );
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+The contour points have to be the ContourFinder's contourPoints() from the 
+same frame as the blobs, since each blob only holds its span of them.
+*******************************************************************************/
+void VisionFrame::setBlobs( const std::vector<blobTracker::Blob> & blobs,
+                            const std::vector<ofPoint> & contourPoints )
+{
+    blobs_ = blobs;
+    contourPoints_ = contourPoints;
+}
+
+void VisionFrame::setTrackedBlobs( const std::vector<blobTracker::Blob> & trackedBlobs )
+{
+    trackedBlobs_ = trackedBlobs;
+}
+
+void VisionFrame::setFrameNumber( int frameNumber )
+{
+    frameNumber_ = frameNumber;
+}
+
+/***************************************************************************//**
+Seconds that the pipeline stages have spent on this frame so far.  The capture
+stage sets it, and each later stage adds its own time.
+*******************************************************************************/
+void VisionFrame::setProcessingTime( double seconds )
+{
+    processingTime_ = seconds;
+}
+
+void VisionFrame::addProcessingTime( double seconds )
+{
+    processingTime_ += seconds;
+}
+
+/***************************************************************************//**
+Exchanges all buffers and blobs with the other frame without copying any pixels.
+*******************************************************************************/
+void VisionFrame::swap( VisionFrame & other )
+{
+    grayBuffers_.swap( other.grayBuffers_ );
+    isNewImage_.swap( other.isNewImage_ );
+    std::swap( trackedBits_, other.trackedBits_ );
+    std::swap( hasTrackedBits_, other.hasTrackedBits_ );
+    std::swap( signalBuffer_, other.signalBuffer_ );
+    std::swap( hasSignalBuffer_, other.hasSignalBuffer_ );
+    blobs_.swap( other.blobs_ );
+    contourPoints_.swap( other.contourPoints_ );
+    trackedBlobs_.swap( other.trackedBlobs_ );
+    std::swap( trackedRegion_, other.trackedRegion_ );
+    std::swap( frameNumber_, other.frameNumber_ );
+    std::swap( processingTime_, other.processingTime_ );
+}
+
+/***************************************************************************//**
+Returns the Source image buffer, (re)allocating it first if it does not have 
+the requested width and height.
+*******************************************************************************/
+blobBuffers::GrayBuffer * VisionFrame::sourceBuffer( int width, int height )
+{
+    blobBuffers::GrayBuffer * & buffer = grayBuffers_[FilterEnum::SOURCE];
+
+    if( buffer == NULL || buffer->width() != width || buffer->height() != height ) {
+        delete buffer;
+        buffer = new blobBuffers::GrayBuffer( width, height );
+    }
+    isNewImage_[FilterEnum::SOURCE] = true;
+    return buffer;
+}
+
+/***************************************************************************//**
+Reallocates the GrayBuffer at the index if the source image has changed size 
+(for example, when switching from the camera to the video player).
+*******************************************************************************/
+void VisionFrame::copyBuffer( int index, const blobBuffers::GrayBuffer * source )
+{
+    blobBuffers::GrayBuffer * & buffer = grayBuffers_[index];
+
+    if( source == NULL ) {
+        return;
+    }
+    if( buffer == NULL || !buffer->isSameWidthAndHeight( source ) ) {
+        delete buffer;
+        buffer = new blobBuffers::GrayBuffer( source->width(), source->height() );
+    }
+    buffer->copyPixels( source );
+    isNewImage_[index] = true;
+}
+
+/***************************************************************************//**
+Same as copyBuffer() for the bit-packed tracked output.
+*******************************************************************************/
+void VisionFrame::copyTrackedBits( const blobBuffers::BitBuffer * source )
+{
+    if( trackedBits_ == NULL || !trackedBits_->isSameWidthAndHeight( source ) ) {
+        delete trackedBits_;
+        trackedBits_ = new blobBuffers::BitBuffer( source->width(), source->height() );
+    }
+    trackedBits_->copyBits( source );
+}
+
+/***************************************************************************//**
+Same as copyBuffer() for the signal image.
+*******************************************************************************/
+void VisionFrame::copySignalBuffer( const blobBuffers::GrayBuffer * source )
+{
+    if( signalBuffer_ == NULL || !signalBuffer_->isSameWidthAndHeight( source ) ) {
+        delete signalBuffer_;
+        signalBuffer_ = new blobBuffers::GrayBuffer( source->width(), source->height() );
+    }
+    signalBuffer_->copyPixels( source );
+}
+
+/***************************************************************************//**
+Returns the copy of the image for the filter type, or NULL if no frame has been
+processed yet.
+*******************************************************************************/
+blobBuffers::GrayBuffer * VisionFrame::grayBuffer( blobEnums::FilterEnum::Enum filterType )
+{
+    int index = (int)filterType;
+
+    if( index >= 0 && index < NUMBER_OF_IMAGES ) {
+        return grayBuffers_[index];
+    }
+    return NULL;
+}
+
+/***************************************************************************//**
+Returns the copy of the bit-packed tracked output, or NULL if the filters 
+were not writing it when copyFilterImagesFrom() was last called (the blobs 
+are then found in the Tracked image).
+*******************************************************************************/
+blobBuffers::BitBuffer * VisionFrame::trackedBits()
+{
+    return hasTrackedBits_ ? trackedBits_ : NULL;
+}
+
+/***************************************************************************//**
+Returns the copy of the pre-threshold signal image, or NULL if the filters 
+were not keeping it when copyFilterImagesFrom() was last called.
+*******************************************************************************/
+blobBuffers::GrayBuffer * VisionFrame::signalBuffer()
+{
+    return hasSignalBuffer_ ? signalBuffer_ : NULL;
+}
+
+/***************************************************************************//**
+True if the image for the filter type was copied for this frame.  Filter 
+images without a display tap that was due still hold an older frame.
+*******************************************************************************/
+bool VisionFrame::isNewImage( blobEnums::FilterEnum::Enum filterType )
+{
+    int index = (int)filterType;
+    return index >= 0 && index < NUMBER_OF_IMAGES && isNewImage_[index];
+}
+
+std::vector<blobTracker::Blob> & VisionFrame::blobs()
+{
+    return blobs_;
+}
+
+/***************************************************************************//**
+The contour points that the spans of the blobs() refer to.
+*******************************************************************************/
+const std::vector<ofPoint> & VisionFrame::contourPoints()
+{
+    return contourPoints_;
+}
+
+/***************************************************************************//**
+Screen-space (calibrated) tracked blobs sorted by ID, as sent out over TUIO.  
+Only filled in pipelined mode.
+*******************************************************************************/
+std::vector<blobTracker::Blob> & VisionFrame::trackedBlobs()
+{
+    return trackedBlobs_;
+}
+
+/***************************************************************************//**
+The part of the Tracked image that can have blobs in it, as of the last call 
+to copyFilterImagesFrom() (see ImageFilters::trackedRegion()).
+*******************************************************************************/
+cv::Rect VisionFrame::trackedRegion()
+{
+    return trackedRegion_;
+}
+
+int VisionFrame::frameNumber()
+{
+    return frameNumber_;
+}
+
+double VisionFrame::processingTime()
+{
+    return processingTime_;
+}
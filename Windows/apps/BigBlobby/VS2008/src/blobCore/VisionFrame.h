@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+// VisionFrame
+//
+// PURPOSE: Holds a snapshot of the images and blobs from one processed camera
+//          frame so that the GUI can render them while the next frame is processed.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBCORE_VISIONFRAME_H
+#define BLOBCORE_VISIONFRAME_H
+
+#include "blobEnums/FilterEnum.h"
+#include "blobTracker/Blob.h"
+#include <opencv2/core/core.hpp>
+#include <vector>
+
+namespace blobBuffers { class GrayBuffer; }
+namespace blobBuffers { class BitBuffer; }
+namespace blobFilters { class ImageFilters; }
+
+namespace blobCore
+{
+    /***********************************************************************//**
+    A snapshot of one processed frame: a copy of each image shown by the GUI 
+    (Source, Tracked, and the intermediate filter images) plus a copy of the 
+    blobs found by the ContourFinder and their contour points.  Filter images are only copied when a 
+    widget showing them has a display tap that is due (see 
+    blobFilters::DisplayTaps), and isNewImage() tells which ones were.  The vision thread fills one of these 
+    after every frame and hands it to the GUI thread through a TripleBuffer, 
+    so the GUI never reads buffers that are being overwritten.
+
+    In pipelined mode, VisionFrames are also the pooled units of work handed 
+    from stage to stage by the FramePipeline.  The capture stage fills the 
+    source image, the filter stage the filter images, and the tracking stage 
+    the blobs and the calibrated tracked blobs used for TUIO output.  The output
+    stage then swap()s the frame into the TripleBuffer, so a finished frame 
+    reaches the GUI without being copied again.  Each stage adds the time it
+    spent on the frame to processingTime(), so the output stage knows how long
+    the frame took in all.
+
+    When the filters write bit-packed tracked output (see 
+    ImageFilters::usePackedOutput()), the filter stage copies those bits for
+    the tracking stage instead of the 8-bit Tracked image, which is then only 
+    copied when it is being displayed.  If the filters keep the pre-threshold
+    signal image (see ImageFilters::signalBuffer()), it is copied too, so the
+    tracking stage can weight the blob centroids by it.
+
+    The GrayBuffers are allocated on first use and then reused for as long as 
+    the camera width and height stay the same.  The blob vectors keep their 
+    storage too, and Blobs hold no heap memory, so copying the blobs only 
+    allocates when there are more of them than ever before.
+    ***************************************************************************/
+    class VisionFrame
+    {
+    public:
+        static const int NUMBER_OF_IMAGES;
+
+        VisionFrame();
+        ~VisionFrame();
+
+        void copyFrom( blobFilters::ImageFilters * imageFilters,
+                       const std::vector<blobTracker::Blob> & blobs,
+                       const std::vector<ofPoint> & contourPoints,
+                       int frameNumber );
+        void copyFilterImagesFrom( blobFilters::ImageFilters * imageFilters );
+        void setBlobs( const std::vector<blobTracker::Blob> & blobs,
+                       const std::vector<ofPoint> & contourPoints );
+        void setTrackedBlobs( const std::vector<blobTracker::Blob> & trackedBlobs );
+        void setFrameNumber( int frameNumber );
+        void setProcessingTime( double seconds );
+        void addProcessingTime( double seconds );
+        void swap( VisionFrame & other );
+
+        blobBuffers::GrayBuffer * sourceBuffer( int width, int height );
+        blobBuffers::GrayBuffer * grayBuffer( blobEnums::FilterEnum::Enum filterType );
+        blobBuffers::BitBuffer * trackedBits();
+        blobBuffers::GrayBuffer * signalBuffer();
+        bool isNewImage( blobEnums::FilterEnum::Enum filterType );
+        cv::Rect trackedRegion();
+        std::vector<blobTracker::Blob> & blobs();
+        const std::vector<ofPoint> & contourPoints();
+        std::vector<blobTracker::Blob> & trackedBlobs();
+        int frameNumber();
+        double processingTime();
+
+    private:
+        void copyTappedImagesFrom( blobFilters::ImageFilters * imageFilters );
+        void copyBuffer( int index, const blobBuffers::GrayBuffer * source );
+        void copyTrackedBits( const blobBuffers::BitBuffer * source );
+        void copySignalBuffer( const blobBuffers::GrayBuffer * source );
+
+        // Not copyable (owns its GrayBuffers).
+        VisionFrame( const VisionFrame & );
+        VisionFrame & operator=( const VisionFrame & );
+
+        std::vector<blobBuffers::GrayBuffer *> grayBuffers_;
+        std::vector<bool> isNewImage_;
+        blobBuffers::BitBuffer * trackedBits_;
+        bool hasTrackedBits_;
+        blobBuffers::GrayBuffer * signalBuffer_;
+        bool hasSignalBuffer_;
+        std::vector<blobTracker::Blob> blobs_;
+        std::vector<ofPoint> contourPoints_;
+        std::vector<blobTracker::Blob> trackedBlobs_;
+        cv::Rect trackedRegion_;
+        int frameNumber_;
+        double processingTime_;
+    };
+}
+
+#endif
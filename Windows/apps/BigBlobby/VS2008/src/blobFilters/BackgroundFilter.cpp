@@ -45,28 +45,31 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobFilters/BackgroundFilter.h"
 #include "blobBuffers/GrayBuffer.h"
 #include "blobBuffers/GrayBufferShort.h"
+#include "blobKernels/GrayKernels.h"
 #include "blobUtils/BackgroundTimer.h"
 #include <opencv2/imgproc/imgproc.hpp>
 #include <iostream>
 
 using blobFilters::BackgroundFilter;
+using blobKernels::GrayKernels;
+
+// Learn rates are fixed point with 16 fractional bits, so this rate replaces 
+// the background with the source image.
+const int BackgroundFilter::FULL_LEARN_RATE = 65536;
 
 BackgroundFilter::BackgroundFilter() :
   bufferWidth_( 0 ),
   bufferHeight_( 0 ),
-  srcCopy_( NULL ),
-  backgroundImage_( NULL ),
-  backgroundImageShort_( NULL ),
-  backgroundImageShortTemp_( NULL ),
-
-  srcCopyM_( NULL ),
-  backgroundM_( NULL ),
-  backgroundShortM_( NULL ),
-  backgroundShortTempM_( NULL ),
+  sourceImage_( NULL ),
+  backgroundAccumulator_( NULL ),
+  backgroundAccumulatorM_( NULL ),
 
   learnRate_( 0.0f ),
+  learnRateRemainder_( 0.0f ),
+  frameLearnRate_( 0 ),
   frameCountDown_( 0 ),
   saveNextFrame_( false ),
+  saveThisFrame_( false ),
   isAutoBackgroundActive_( false ),
   useDarkBlobs_( false ),
   useBlur_( true ),
@@ -93,33 +96,60 @@ void BackgroundFilter::clear()
 
 void BackgroundFilter::clearMatrices()
 {
-    delete srcCopyM_;
-    delete backgroundM_;
-    delete backgroundShortM_;
-    delete backgroundShortTempM_;
-
-    srcCopyM_ = NULL;
-    backgroundM_ = NULL;
-    backgroundShortM_ = NULL;
-    backgroundShortTempM_ = NULL;
+    delete backgroundAccumulatorM_;
+    backgroundAccumulatorM_ = NULL;
 }
 
 void BackgroundFilter::clearBuffers()
 {
-    delete srcCopy_;
-    delete backgroundImage_;
-    delete backgroundImageShort_;
-    delete backgroundImageShortTemp_;
+    delete backgroundAccumulator_;
+    backgroundAccumulator_ = NULL;
+}
+
+/***************************************************************************//**
+Writes the current 8-bit background image (the rounded running average) into
+the given image, which must be the same size as the filter's images.
+*******************************************************************************/
+void BackgroundFilter::copyBackgroundImage( blobBuffers::GrayBuffer * dstImage )
+{
+    if( backgroundAccumulatorM_ != NULL && dstImage != NULL 
+        && dstImage->width() == bufferWidth_ && dstImage->height() == bufferHeight_ ) 
+    {
+        for( int row = 0; row < bufferHeight_; ++row ) {
+            GrayKernels::roundAccumulator( backgroundAccumulatorM_->ptr<unsigned short>( row ),
+                                           dstImage->row( row ), bufferWidth_ );
+        }
+    }
+}
+
+/***************************************************************************//**
+Row access for the fused point-wise filter, which does this filter's work 
+row by row.  Only valid after prepareRows() has been called for the current 
+frame.
+*******************************************************************************/
+unsigned short * BackgroundFilter::backgroundAccumulatorRow( int row )
+{
+    return backgroundAccumulatorM_->ptr<unsigned short>( row );
+}
 
-    srcCopy_ = NULL;
-    backgroundImage_ = NULL;
-    backgroundImageShort_ = NULL;
-    backgroundImageShortTemp_ = NULL;
+/***************************************************************************//**
+The image that checkPeriodicBackground() blends into the background: the 
+source image of the row-by-row paths, which do not pass the whole buffer to
+this filter.  The filter does not own it.
+*******************************************************************************/
+void BackgroundFilter::setSourceImage( const blobBuffers::GrayBuffer * srcImage )
+{
+    sourceImage_ = srcImage;
 }
 
-blobBuffers::GrayBuffer * BackgroundFilter::backgroundImage()
+/***************************************************************************//**
+The fixed-point (16 fractional bits) rate at which the current frame is 
+blended into the background: zero when the background is left alone, and 
+FULL_LEARN_RATE when the frame replaces the background.  Set by prepareRows().
+*******************************************************************************/
+int BackgroundFilter::frameLearnRate()
 {
-    return backgroundImage_;
+    return frameLearnRate_;
 }
 
 void BackgroundFilter::process( blobBuffers::GrayBuffer * srcImage,
@@ -128,47 +158,86 @@ void BackgroundFilter::process( blobBuffers::GrayBuffer * srcImage,
     if( srcImage != NULL && srcImage->isSameWidthAndHeight( dstImage ) ) {
         int cols = srcImage->width(),
             rows = srcImage->height();
-        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), cols );
-        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), cols );
+        prepareRows( cols, rows );
+        sourceImage_ = srcImage;
 
-        if( bufferWidth_ != cols || bufferHeight_ != rows ) {
-            initialize( cols, rows );
-            saveNextFrame_ = true;
-        }
-        if( isAutoBackgroundActive_ ) {
-            updateWeightedBackground( srcM, rows, cols );
-        }
-        if( frameCountDown_ > 0 ) {
-            --frameCountDown_;
-            saveNextFrame_ = true;
-        }
-        if( saveNextFrame_ ) {
-            updateBackground( srcM, rows, cols );
-            saveNextFrame_ = false;
+        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), srcImage->stride() );
+        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), dstImage->stride() );
+        processRegion( srcM, dstM, 0 );
+    }
+}
+
+/***************************************************************************//**
+Decides once per frame whether the incoming frame replaces the background, 
+and at what rate it is blended in otherwise, so that every strip of the frame
+makes the same decision.
+*******************************************************************************/
+void BackgroundFilter::prepareRows( int width, int height )
+{
+    if( bufferWidth_ != width || bufferHeight_ != height ) {
+        initialize( width, height );
+        saveNextFrame_ = true;
+    }
+    if( frameCountDown_ > 0 ) {
+        --frameCountDown_;
+        saveNextFrame_ = true;
+    }
+    saveThisFrame_ = saveNextFrame_;
+    saveNextFrame_ = false;
+    updateFrameLearnRate();
+}
+
+/***************************************************************************//**
+The learn rates set by CoreVision are tiny (down to 0.0001 or less), which 
+is only a few steps of a 16-bit fixed-point fraction.  Rather than round each
+frame's rate the same way, the rounding error is carried over to the next 
+frame, so that over a few frames the background learns at exactly the rate 
+that was asked for.
+*******************************************************************************/
+void BackgroundFilter::updateFrameLearnRate()
+{
+    if( saveThisFrame_ ) {
+        frameLearnRate_ = FULL_LEARN_RATE;
+    }
+    else if( isAutoBackgroundActive_ ) {
+        float rate = (learnRate_ > 1.0f) ? 1.0f : ((learnRate_ < 0.0f) ? 0.0f : learnRate_);
+        learnRateRemainder_ += rate * FULL_LEARN_RATE;
+        frameLearnRate_ = (int)learnRateRemainder_;
+        learnRateRemainder_ -= frameLearnRate_;
+    }
+    else {
+        frameLearnRate_ = 0;
+    }
+}
+
+int BackgroundFilter::toFixedPointRate( float rate )
+{
+    if( rate <= 0 ) { return 0; }
+    if( rate >= 1 ) { return FULL_LEARN_RATE; }
+    return (int)(rate * FULL_LEARN_RATE + 0.5f);
+}
+
+void BackgroundFilter::processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol )
+{
+    for( int row = 0; row < srcM.rows; ++row ) {
+        const unsigned char * src = srcM.ptr<unsigned char>( row );
+        unsigned short * background = backgroundAccumulatorM_->ptr<unsigned short>( firstRow + row ) + firstCol;
+
+        if( frameLearnRate_ > 0 ) {
+            GrayKernels::accumulateWeighted( src, background, srcM.cols, frameLearnRate_ );
         }
         if( useDarkBlobs_ ) {
-            cv::subtract( *backgroundM_, srcM, dstM );
+            GrayKernels::subtractFromAccumulator( src, background, dstM.ptr<unsigned char>( row ), srcM.cols );
         }
         else {
-            cv::subtract( srcM, *backgroundM_, dstM );
+            GrayKernels::subtractAccumulator( src, background, dstM.ptr<unsigned char>( row ), srcM.cols );
         }
-        srcCopy_->copyPixels( srcImage ); // Save copy for periodic background.
     }
 }
 
-void BackgroundFilter::updateWeightedBackground( cv::Mat & srcM,  int rows, int cols )
+bool BackgroundFilter::changesPixels()
 {
-    srcM.convertTo( *backgroundShortTempM_, CV_16U, (65535.0f / 255.0f), 0 );
-    cv::addWeighted( *backgroundShortTempM_, learnRate_, 
-                     *backgroundShortM_, 1.0f - learnRate_,
-                     0, *backgroundShortM_ );
-    backgroundShortM_->convertTo( *backgroundM_, CV_8U, (255.0f / 65535.0f), 0 );
-}
-
-void BackgroundFilter::updateBackground( cv::Mat & srcM, int rows, int cols )
-{
-    srcM.copyTo( *backgroundM_ );
-    srcM.convertTo( *backgroundShortM_, CV_16U, (65535.0f / 255.0f), 0 );
+    return true;
 }
 
 bool BackgroundFilter::isWithinBufferSize( const std::vector<cv::Point> & quad )
@@ -197,10 +266,7 @@ void BackgroundFilter::initialize( int width, int height )
 
 void BackgroundFilter::initializeBuffers()
 {
-    srcCopy_ =  new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    backgroundImage_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    backgroundImageShort_ = new blobBuffers::GrayBufferShort( bufferWidth_, bufferHeight_ );
-    backgroundImageShortTemp_ = new blobBuffers::GrayBufferShort( bufferWidth_, bufferHeight_ );
+    backgroundAccumulator_ = new blobBuffers::GrayBufferShort( bufferWidth_, bufferHeight_ );
 }
 
 void BackgroundFilter::initializeMatrices()
@@ -208,10 +274,7 @@ void BackgroundFilter::initializeMatrices()
     int rows = bufferHeight_,
         cols = bufferWidth_;
 
-    srcCopyM_ = new cv::Mat( rows, cols, CV_8U, srcCopy_->pixels(), cols );
-    backgroundM_ = new cv::Mat( rows, cols, CV_8U, backgroundImage_->pixels(), cols );
-    backgroundShortM_ = new cv::Mat( rows, cols, CV_16U, backgroundImageShort_->pixels(), cols * 2 );
-    backgroundShortTempM_ = new cv::Mat( rows, cols, CV_16U, backgroundImageShortTemp_->pixels(), cols * 2 );
+    backgroundAccumulatorM_ = new cv::Mat( rows, cols, CV_16U, backgroundAccumulator_->pixels(), cols * 2 );
 }
 
 void BackgroundFilter::saveNextFrameAsBackground()
@@ -287,11 +350,17 @@ void BackgroundFilter::checkPeriodicBackground()
 {
     if( periodicBackgroundTimer_->needToUpdate() ) {
         // Use weighted average of last source image and background image.
-        if( bufferWidth_ > 0 && bufferHeight_ > 0 && srcCopyM_ != NULL && backgroundM_ != NULL ) {
-            float alpha = periodicBackgroundFraction_,
-                  beta = 1.0f - alpha;
-            cv::addWeighted( *srcCopyM_, alpha, *backgroundM_, beta, 0.0, *backgroundM_ );
-            //std::cout << "(alpha, beta) = (" << alpha << ", " << beta << ")\n";
+        if( bufferWidth_ > 0 && bufferHeight_ > 0 && backgroundAccumulatorM_ != NULL
+            && sourceImage_ != NULL && sourceImage_->width() == bufferWidth_ 
+            && sourceImage_->height() == bufferHeight_ ) 
+        {
+            int rate = toFixedPointRate( periodicBackgroundFraction_ );
+
+            for( int row = 0; row < bufferHeight_; ++row ) {
+                GrayKernels::accumulateWeighted( sourceImage_->row( row ),
+                                                 backgroundAccumulatorM_->ptr<unsigned short>( row ),
+                                                 bufferWidth_, rate );
+            }
         }
     }
 }
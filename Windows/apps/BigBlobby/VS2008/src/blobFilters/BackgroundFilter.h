@@ -56,16 +56,34 @@ namespace blobUtils { class BackgroundTimer; }
 
 namespace blobFilters
 {
+    /***********************************************************************//**
+    Subtracts a background image from the source image.  The background is 
+    kept as a 16-bit fixed-point running average (the 8-bit value times 257),
+    which is updated in place with the GrayKernels accumulate and subtracted
+    directly, so the 8-bit background image is only made when something 
+    wants to display it (copyBackgroundImage()).
+
+    The periodic background blends in the last source image.  That image is
+    not copied; the filter keeps a pointer to the caller's source buffer 
+    (setSourceImage(), or the srcImage of the last process() call), which 
+    must be left alone until checkPeriodicBackground() has been called.
+    ***************************************************************************/
     class BackgroundFilter : public BlobFilter
     {
     public:
+        static const int FULL_LEARN_RATE;
+
         BackgroundFilter();
         virtual ~BackgroundFilter();
 
         virtual void process( blobBuffers::GrayBuffer * srcImage,
                               blobBuffers::GrayBuffer * dstImage );
+        virtual void prepareRows( int width, int height );
         
-        blobBuffers::GrayBuffer * backgroundImage();
+        void copyBackgroundImage( blobBuffers::GrayBuffer * dstImage );
+        unsigned short * backgroundAccumulatorRow( int row );
+        void setSourceImage( const blobBuffers::GrayBuffer * srcImage );
+        int frameLearnRate();
         void saveNextFrameAsBackground();
         void saveFramesAsBackground( int count );
         void setBackgroundLearnRate( float rate );
@@ -82,6 +100,10 @@ namespace blobFilters
         float getPeriodicBackgroundPercent();
         void checkPeriodicBackground();
 
+    protected:
+        virtual void processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol );
+        virtual bool changesPixels();
+
     private:
         void clear();
         void clearMatrices();
@@ -89,23 +111,21 @@ namespace blobFilters
         void initialize( int width, int height );
         void initializeBuffers();
         void initializeMatrices();
-        void updateWeightedBackground( cv::Mat & srcM, int rows, int cols );
-        void updateBackground( cv::Mat & srcM, int rows, int cols );
+        void updateFrameLearnRate();
+        int toFixedPointRate( float rate );
         bool isWithinBufferSize( const std::vector<cv::Point> & quad );
 
         int bufferWidth_,
             bufferHeight_;
-        blobBuffers::GrayBuffer * srcCopy_,
-                                * backgroundImage_;
-        blobBuffers::GrayBufferShort * backgroundImageShort_,
-                                     * backgroundImageShortTemp_;
-        cv::Mat * srcCopyM_,
-                * backgroundM_,
-                * backgroundShortM_,
-                * backgroundShortTempM_;
-        float learnRate_;
-        int frameCountDown_;
+        const blobBuffers::GrayBuffer * sourceImage_;
+        blobBuffers::GrayBufferShort * backgroundAccumulator_;
+        cv::Mat * backgroundAccumulatorM_;
+        float learnRate_,
+              learnRateRemainder_;
+        int frameLearnRate_,
+            frameCountDown_;
         bool saveNextFrame_,
+             saveThisFrame_,
              isAutoBackgroundActive_,
              useDarkBlobs_,
              useBlur_;
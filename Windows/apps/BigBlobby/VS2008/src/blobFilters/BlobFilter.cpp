@@ -46,14 +46,20 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobFilters/BlobFilter.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobFilters/MaskSpans.h"
+#include "blobKernels/GrayKernels.h"
 #include "blobUtils/FunctionTimer.h"
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <cstring>
 
 using blobFilters::BlobFilter;
+using blobKernels::GrayKernels;
 
 BlobFilter::BlobFilter() :
   processTimer_( new blobUtils::FunctionTimer() ),
+  maskSpans_( NULL ),
+  regionMargin_( 0 ),
   isAmplifyActive_( false ),
   amplifyLevel_( 0 ),
   amplifyScale_( 0.0 )
@@ -65,21 +71,131 @@ BlobFilter::~BlobFilter()
     delete processTimer_;
 }
 
+/***************************************************************************//**
+Filters the whole image.  The filter's process() function does the work, and
+amplifies the part of the image that it filtered.
+*******************************************************************************/
 void BlobFilter::processImage( blobBuffers::GrayBuffer * src, blobBuffers::GrayBuffer * dst )
 {
     processTimer_->startTiming();
     process( src, dst );
-    amplify( dst );
     processTimer_->stopTiming();
 }
 
-void BlobFilter::amplify( blobBuffers::GrayBuffer * grayBuffer )
+/***************************************************************************//**
+Called once per frame, before any processRows() calls for that frame, so that
+a filter can (re)build whatever per-frame state it keeps for an image of the 
+given size.  The default does nothing.
+*******************************************************************************/
+void BlobFilter::prepareRows( int width, int height )
 {
-    if( isAmplifyActive_ && amplifyScale_ > 0 && grayBuffer != NULL ) {
-        int cols = grayBuffer->width(),
-            rows = grayBuffer->height();
-        cv::Mat matrix( rows, cols, CV_8U, grayBuffer->pixels(), cols );
-        cv::multiply( matrix, matrix, matrix, amplifyScale_ );
+}
+
+/***************************************************************************//**
+Filters one horizontal strip of the image.  The matrices are row ranges of 
+the full-size images (or of scratch images laid out the same way), and 
+firstRow is the image row that their first row corresponds to.  Neighbourhood
+filters read the rows just above and below the range from the parent image,
+so those rows must already hold valid data.
+
+Strips of the same frame may be processed at the same time on different 
+threads, so nothing here is timed.  The caller times each strip and passes 
+the frame's total to addRowsTime().
+*******************************************************************************/
+void BlobFilter::processRows( cv::Mat & srcM, cv::Mat & dstM, int firstRow )
+{
+    processRegion( srcM, dstM, firstRow );
+}
+
+/***************************************************************************//**
+Limits the filter to the bounding rectangle of the calibration mask, grown by
+margin pixels, and writes zeros everywhere else.  The margin is how far 
+outside of the mask the filter's input can be non-zero, plus how far its own
+blur reaches (see kernelRadius()), so the output is the same as filtering the
+whole image.  Passing NULL (the default) filters the whole image.
+*******************************************************************************/
+void BlobFilter::setRegion( const blobFilters::MaskSpans * maskSpans, int margin )
+{
+    maskSpans_ = maskSpans;
+    regionMargin_ = margin;
+}
+
+/***************************************************************************//**
+Number of rows and columns around a pixel that its output depends on.  The 
+default is zero (a point-wise filter).
+*******************************************************************************/
+int BlobFilter::kernelRadius()
+{
+    return 0;
+}
+
+/***************************************************************************//**
+Runs processRowRange() and amplify() on the part of the rows that is inside 
+the region (see setRegion()), and sets the rest of dstM to zero.  The rows 
+start at image row firstRow and are always whole rows of the image.
+*******************************************************************************/
+void BlobFilter::processRegion( cv::Mat & srcM, cv::Mat & dstM, int firstRow )
+{
+    cv::Rect rect = regionRect( srcM.rows, srcM.cols, firstRow );
+    zeroOutside( dstM, rect );
+
+    if( rect.area() > 0 ) {
+        cv::Mat srcRegionM = srcM( rect ),
+                dstRegionM = dstM( rect );
+        processRowRange( srcRegionM, dstRegionM, firstRow + rect.y, rect.x );
+        amplify( dstRegionM );
+    }
+}
+
+/***************************************************************************//**
+The part of a block of rows (starting at image row firstRow) that is inside 
+the region, relative to the block.  The whole block if there is no region.
+*******************************************************************************/
+cv::Rect BlobFilter::regionRect( int rows, int cols, int firstRow )
+{
+    cv::Rect block( 0, 0, cols, rows );
+
+    if( maskSpans_ == NULL ) {
+        return block;
+    }
+    cv::Rect region = maskSpans_->roi( regionMargin_ );
+    region.y -= firstRow;
+    return region & block;
+}
+
+/***************************************************************************//**
+Sets the rows above and below the rectangle, and the pixels to its left and 
+right, to zero.
+*******************************************************************************/
+void BlobFilter::zeroOutside( cv::Mat & dstM, const cv::Rect & rect )
+{
+    if( rect.area() == 0 ) {
+        dstM.setTo( cv::Scalar( 0 ) );
+        return;
+    }
+    int endRow = rect.y + rect.height,
+        endCol = rect.x + rect.width;
+
+    for( int row = 0; row < dstM.rows; ++row ) {
+        unsigned char * pixels = dstM.ptr<unsigned char>( row );
+
+        if( row < rect.y || row >= endRow ) {
+            std::memset( pixels, 0, dstM.cols );
+        }
+        else {
+            std::memset( pixels, 0, rect.x );
+            std::memset( pixels + endCol, 0, dstM.cols - endCol );
+        }
+    }
+}
+
+void BlobFilter::amplify( cv::Mat & matrix )
+{
+    if( isAmplifyActive_ && amplifyScale_ > 0 ) {
+        for( int row = 0; row < matrix.rows; ++row ) {
+            unsigned char * pixels = matrix.ptr<unsigned char>( row );
+            GrayKernels::amplifySquare( pixels, pixels, matrix.cols, amplifyScale_ );
+        }
     }
 }
 
@@ -88,6 +204,24 @@ double BlobFilter::calculateAverageTime()
     return processTimer_->calculateAverageTime();
 }
 
+/***************************************************************************//**
+Counts the time that processRows() took over all the strips of one frame 
+(added up across threads) as one call in calculateAverageTime().
+*******************************************************************************/
+void BlobFilter::addRowsTime( double seconds )
+{
+    processTimer_->addTime( seconds );
+}
+
+/***************************************************************************//**
+The timer behind calculateAverageTime(), for subclasses that filter whole 
+images some other way than through processImage().
+*******************************************************************************/
+blobUtils::FunctionTimer * BlobFilter::processTimer()
+{
+    return processTimer_;
+}
+
 void BlobFilter::setAmplifyActive( bool active )
 {
     isAmplifyActive_ = active;
@@ -108,3 +242,22 @@ int BlobFilter::amplifyLevel()
 {
     return amplifyLevel_;
 }
+
+/***************************************************************************//**
+Returns the scale that amplify() multiplies the squared pixel values by, or 
+zero if amplification is turned off.
+*******************************************************************************/
+float BlobFilter::activeAmplifyScale()
+{
+    return (isAmplifyActive_ && amplifyScale_ > 0) ? amplifyScale_ : 0.0f;
+}
+
+/***************************************************************************//**
+True if the filter's output would be a copy of its input: the filter itself 
+is turned off (changesPixels() is false) and so is amplify.  The FilterGraph
+leaves such filters out of the chain.
+*******************************************************************************/
+bool BlobFilter::isPassThrough()
+{
+    return !changesPixels() && activeAmplifyScale() <= 0;
+}
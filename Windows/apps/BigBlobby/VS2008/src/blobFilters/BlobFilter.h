@@ -47,7 +47,10 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BLOBFILTERS_BLOBFILTER_H
 #define BLOBFILTERS_BLOBFILTER_H
 
+#include <opencv2/core/core.hpp>
+
 namespace blobBuffers { class GrayBuffer; }
+namespace blobFilters { class MaskSpans; }
 namespace blobUtils { class FunctionTimer; }
 
 namespace blobFilters
@@ -59,20 +62,34 @@ namespace blobFilters
         virtual ~BlobFilter();
 
         void processImage( blobBuffers::GrayBuffer * src, blobBuffers::GrayBuffer * dst );
+        virtual void prepareRows( int width, int height );
+        void processRows( cv::Mat & srcM, cv::Mat & dstM, int firstRow );
         double calculateAverageTime();
+        void addRowsTime( double seconds );
+        void setRegion( const blobFilters::MaskSpans * maskSpans, int margin );
+        virtual int kernelRadius();
 
         void setAmplifyActive( bool active );
         bool isAmplifyActive();
         void setAmplifyLevel( int level );
         int amplifyLevel();
+        float activeAmplifyScale();
+        bool isPassThrough();
 
     protected:
         virtual void process( blobBuffers::GrayBuffer * src, blobBuffers::GrayBuffer * dst ) = 0;
+        virtual void processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol ) = 0;
+        virtual bool changesPixels() = 0;
+        void processRegion( cv::Mat & srcM, cv::Mat & dstM, int firstRow );
+        cv::Rect regionRect( int rows, int cols, int firstRow );
+        void zeroOutside( cv::Mat & dstM, const cv::Rect & rect );
+        void amplify( cv::Mat & matrix );
+        blobUtils::FunctionTimer * processTimer();
 
     private:
-        void amplify( blobBuffers::GrayBuffer * grayBuffer );
-
         blobUtils::FunctionTimer * processTimer_;
+        const blobFilters::MaskSpans * maskSpans_;
+        int regionMargin_;
         bool isAmplifyActive_;
         int amplifyLevel_;
         float amplifyScale_;
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+// BoxFilter
+//
+// PURPOSE: Normalized box blur whose cost per pixel does not depend on the size
+//          of the box (running column sums plus a running window along each row).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobFilters/BoxFilter.h"
+#include "blobKernels/GrayKernels.h"
+#include <opencv2/core/core.hpp>
+#include <boost/thread/tss.hpp>
+
+using blobFilters::BoxFilter;
+using blobKernels::GrayKernels;
+
+namespace
+{
+    // Column sums for the blur running on this thread (the strip threads 
+    // live as long as the program, so the sums are only allocated when a 
+    // frame needs more of them than before).
+    boost::thread_specific_ptr< std::vector<unsigned int> > threadSums;
+}
+
+BoxFilter::BoxFilter() :
+  radius_( 0 )
+{
+}
+
+BoxFilter::~BoxFilter()
+{
+}
+
+/***************************************************************************//**
+Sets the number of pixels on each side of the center, so the box is 
+(2 * radius + 1) pixels on a side.  A radius of zero just copies the image.
+*******************************************************************************/
+void BoxFilter::setRadius( int radius )
+{
+    radius_ = (radius > 0) ? radius : 0;
+}
+
+int BoxFilter::radius() const
+{
+    return radius_;
+}
+
+/***************************************************************************//**
+Blurs the 8-bit srcM into dstM, which must be the same size and must not 
+share pixels with srcM.  Either one may be a submatrix (see the class 
+comments for how the border is handled).
+*******************************************************************************/
+void BoxFilter::blur( const cv::Mat & srcM, cv::Mat & dstM ) const
+{
+    int radius = radius_; // Read once (see the class comments).
+
+    if( srcM.rows == 0 || srcM.cols == 0 ) {
+        return;
+    }
+    if( radius == 0 ) {
+        srcM.copyTo( dstM );
+        return;
+    }
+    cv::Size parentSize;
+    cv::Point offset;
+    srcM.locateROI( parentSize, offset );
+
+    // Pointer to the parent image's first pixel, worked out from the 
+    // submatrix rather than taken from datastart (which may have padding).
+    const unsigned char * srcStart = srcM.data - offset.y * srcM.step - offset.x;
+
+    blur( radius, srcStart, (int)srcM.step, parentSize.height, parentSize.width,
+          offset.y, offset.x, srcM.rows, srcM.cols,
+          dstM.data, (int)dstM.step );
+}
+
+/***************************************************************************//**
+Maps an index outside [0, size) back into it the way BORDER_REFLECT_101 does
+(for size 5: ... 2 1 | 0 1 2 3 4 | 3 2 ...), reflecting as many times as it 
+takes for boxes bigger than the image.
+*******************************************************************************/
+int BoxFilter::reflect101( int index, int size )
+{
+    if( size == 1 ) {
+        return 0;
+    }
+    while( index < 0 || index >= size ) {
+        index = (index < 0) ? -index : 2 * (size - 1) - index;
+    }
+    return index;
+}
+
+/***************************************************************************//**
+The column sums are kept for every column of the parent image, with radius
+extra entries on each side that are filled in by reflection for each row (so 
+the border costs O(radius) per row, not per pixel).
+*******************************************************************************/
+void BoxFilter::blur( int radius,
+                      const unsigned char * srcStart, 
+                      int srcStep, 
+                      int parentRows,
+                      int parentCols,
+                      int firstRow, 
+                      int firstCol, 
+                      int rows, 
+                      int cols,
+                      unsigned char * dstStart, 
+                      int dstStep ) const
+{
+    if( threadSums.get() == NULL ) {
+        threadSums.reset( new std::vector<unsigned int>() );
+    }
+    std::vector<unsigned int> & sums = *threadSums;
+    sums.assign( parentCols + 2 * radius, 0 );
+
+    int boxSize = 2 * radius + 1;
+    double scale = 1.0 / ((double)boxSize * boxSize);
+    unsigned int * columnSums = &sums[radius];
+
+    for( int i = -radius; i <= radius; ++i ) {
+        int srcRow = reflect101( firstRow + i, parentRows );
+        GrayKernels::addRowToSums( srcStart + srcRow * srcStep, columnSums, parentCols );
+    }
+    for( int row = 0; row < rows; ++row ) {
+        int centerRow = firstRow + row;
+
+        if( row > 0 ) {
+            int leavingRow = reflect101( centerRow - radius - 1, parentRows ),
+                enteringRow = reflect101( centerRow + radius, parentRows );
+            GrayKernels::subtractRowFromSums( srcStart + leavingRow * srcStep, columnSums, parentCols );
+            GrayKernels::addRowToSums( srcStart + enteringRow * srcStep, columnSums, parentCols );
+        }
+        fillBorderSums( sums, radius, parentCols );
+        GrayKernels::averageSums( &sums[firstCol], dstStart + row * dstStep, cols, boxSize, scale );
+    }
+}
+
+void BoxFilter::fillBorderSums( std::vector<unsigned int> & sums, int radius, int parentCols ) const
+{
+    unsigned int * columnSums = &sums[radius];
+
+    for( int i = 1; i <= radius; ++i ) {
+        columnSums[-i] = columnSums[reflect101( -i, parentCols )];
+        columnSums[parentCols - 1 + i] = columnSums[reflect101( parentCols - 1 + i, parentCols )];
+    }
+}
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// BoxFilter
+//
+// PURPOSE: Normalized box blur whose cost per pixel does not depend on the size
+//          of the box (running column sums plus a running window along each row).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBFILTERS_BOXFILTER_H
+#define BLOBFILTERS_BOXFILTER_H
+
+#include <vector>
+
+namespace cv { class Mat; }
+
+namespace blobFilters
+{
+    /***********************************************************************//**
+    Replaces cv::blur() for the square, odd-sized boxes used by the highpass
+    and smoothing filters.  Each output row costs one row added to and one 
+    row subtracted from a set of running column sums (GrayKernels), plus a 
+    running sum along the row, so a 401x401 box costs about the same as a 
+    3x3 one.  The averages are rounded exactly.
+
+    Borders are handled as cv::blur() does by default (BORDER_REFLECT_101), 
+    and in the same way for a submatrix: rows and columns outside the 
+    submatrix are read from the parent image where it has them, and only the
+    parent image's own edges are reflected.  That is what lets a strip of rows
+    be blurred on its own with the same result as the full frame.
+
+    One BoxFilter may be used from several threads at once (on different 
+    rows).  blur() reads the radius once, so a setRadius() in the middle of a
+    blur only takes effect on the next one, and the column sums go in a 
+    buffer that each thread keeps for all of its blurs.
+    ***************************************************************************/
+    class BoxFilter
+    {
+    public:
+        BoxFilter();
+        ~BoxFilter();
+
+        void setRadius( int radius );
+        int radius() const;
+        void blur( const cv::Mat & srcM, cv::Mat & dstM ) const;
+
+        static int reflect101( int index, int size );
+
+    private:
+        void blur( int radius,
+                   const unsigned char * srcStart, 
+                   int srcStep, 
+                   int parentRows,
+                   int parentCols,
+                   int firstRow, 
+                   int firstCol, 
+                   int rows, 
+                   int cols,
+                   unsigned char * dstStart, 
+                   int dstStep ) const;
+        void fillBorderSums( std::vector<unsigned int> & sums, int radius, int parentCols ) const;
+
+        int radius_;
+    };
+}
+
+#endif
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// DisplayTaps
+//
+// PURPOSE: Keeps track of which filter images the GUI is showing, and how often
+//          each one needs to be refreshed, so the filter chain only writes and
+//          copies the intermediate images that someone is looking at.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobFilters/DisplayTaps.h"
+#include "blobUtils/StopWatch.h"
+#include <boost/thread/locks.hpp>
+#include <algorithm>
+
+using blobFilters::DisplayTaps;
+using blobEnums::FilterEnum;
+
+const double DisplayTaps::EVERY_FRAME = 0.0;
+
+DisplayTaps::DisplayTaps() :
+  mutex_(),
+  subscriptions_(),
+  isDue_( FilterEnum::SMOOTH + 1, false ),
+  stopWatch_( new blobUtils::StopWatch() ),
+  nextSubscriptionId_( 1 )
+{
+}
+
+DisplayTaps::~DisplayTaps()
+{
+    delete stopWatch_;
+}
+
+/***************************************************************************//**
+Subscribes to the filter image at the given preview rate (EVERY_FRAME, or 
+any rate at or below zero, for every frame).  Returns the id to pass to 
+unsubscribe().
+*******************************************************************************/
+int DisplayTaps::subscribe( blobEnums::FilterEnum::Enum filterType, double framesPerSecond )
+{
+    boost::lock_guard<boost::mutex> lock( mutex_ );
+    Subscription subscription;
+    subscription.id = nextSubscriptionId_++;
+    subscription.filterType = filterType;
+    subscription.interval = (framesPerSecond > 0.0) ? (1.0 / framesPerSecond) : 0.0;
+    subscription.lastTapTime = -subscription.interval;
+    subscriptions_.push_back( subscription );
+    return subscription.id;
+}
+
+void DisplayTaps::unsubscribe( int subscriptionId )
+{
+    boost::lock_guard<boost::mutex> lock( mutex_ );
+
+    for( size_t i = 0; i < subscriptions_.size(); ++i ) {
+        if( subscriptions_[i].id == subscriptionId ) {
+            subscriptions_.erase( subscriptions_.begin() + i );
+            return;
+        }
+    }
+}
+
+bool DisplayTaps::isSubscribed( blobEnums::FilterEnum::Enum filterType )
+{
+    boost::lock_guard<boost::mutex> lock( mutex_ );
+
+    for( size_t i = 0; i < subscriptions_.size(); ++i ) {
+        if( subscriptions_[i].filterType == filterType ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/***************************************************************************//**
+Works out which filter images are due for this frame.  Every subscriber 
+whose interval has passed is counted as served, so two widgets showing the
+same image at different rates each get their own rate.
+*******************************************************************************/
+void DisplayTaps::beginFrame()
+{
+    double now = stopWatch_->elapsed();
+    std::fill( isDue_.begin(), isDue_.end(), false );
+    boost::lock_guard<boost::mutex> lock( mutex_ );
+
+    for( size_t i = 0; i < subscriptions_.size(); ++i ) {
+        Subscription & subscription = subscriptions_[i];
+
+        if( now - subscription.lastTapTime >= subscription.interval ) {
+            subscription.lastTapTime = now;
+            isDue_[subscription.filterType] = true;
+        }
+    }
+}
+
+/***************************************************************************//**
+True if the filter image has to be written (and copied for the GUI) this 
+frame.  Only valid after beginFrame() has been called for the frame.
+*******************************************************************************/
+bool DisplayTaps::isDue( blobEnums::FilterEnum::Enum filterType )
+{
+    int index = (int)filterType;
+    return index >= 0 && index < (int)isDue_.size() && isDue_[index];
+}
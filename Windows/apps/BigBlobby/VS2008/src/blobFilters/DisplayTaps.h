@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+// DisplayTaps
+//
+// PURPOSE: Keeps track of which filter images the GUI is showing, and how often
+//          each one needs to be refreshed, so the filter chain only writes and
+//          copies the intermediate images that someone is looking at.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBFILTERS_DISPLAYTAPS_H
+#define BLOBFILTERS_DISPLAYTAPS_H
+
+#include "blobEnums/FilterEnum.h"
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+namespace blobUtils { class StopWatch; }
+
+namespace blobFilters
+{
+    /***********************************************************************//**
+    A display tap is a subscription to one filter image (a FilterEnum type) at
+    a preview rate.  Widgets subscribe while they can actually be seen, and 
+    unsubscribe when they are hidden, minimized, or scrolled out of view.
+
+    Once per frame, the filter thread calls beginFrame(), which works out 
+    which images are due to be refreshed.  An image is due when at least one
+    of its subscribers has waited for its preview interval (a preview rate of
+    EVERY_FRAME makes it due on every frame).  The filter chain only writes 
+    the display-only images (background, difference, subtraction images, 
+    etc.) and the VisionFrame only copies images when they are due, so with 
+    no subscribers the intermediate images stay in the filters' scratch 
+    buffers.
+
+    subscribe() and unsubscribe() can be called from any thread.  
+    beginFrame() and isDue() are meant to be called from the filter thread 
+    only.
+    ***************************************************************************/
+    class DisplayTaps
+    {
+    public:
+        static const double EVERY_FRAME;
+
+        DisplayTaps();
+        ~DisplayTaps();
+
+        int subscribe( blobEnums::FilterEnum::Enum filterType, double framesPerSecond );
+        void unsubscribe( int subscriptionId );
+        bool isSubscribed( blobEnums::FilterEnum::Enum filterType );
+
+        void beginFrame();
+        bool isDue( blobEnums::FilterEnum::Enum filterType );
+
+    private:
+        // Not copyable.
+        DisplayTaps( const DisplayTaps & );
+        DisplayTaps & operator=( const DisplayTaps & );
+
+        struct Subscription
+        {
+            int id;
+            blobEnums::FilterEnum::Enum filterType;
+            double interval;
+            double lastTapTime;
+        };
+
+        boost::mutex mutex_;
+        std::vector<Subscription> subscriptions_;
+        std::vector<bool> isDue_;
+        blobUtils::StopWatch * stopWatch_;
+        int nextSubscriptionId_;
+    };
+}
+
+#endif
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+// FilterGraph
+//
+// PURPOSE: Works out which stages of the ImageFilters chain need to run and
+//          which image buffer each stage reads and writes, so that stages that
+//          would only copy their input are left out.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobFilters/FilterGraph.h"
+#include "blobFilters/BlobFilter.h"
+#include "blobBuffers/GrayBuffer.h"
+#include "blobBuffers/GrayBufferPool.h"
+#include <cstddef>
+
+using blobFilters::FilterGraph;
+
+FilterGraph::FilterGraph( blobBuffers::GrayBufferPool * bufferPool ) :
+  bufferPool_( bufferPool ),
+  activeStages_( 0 ),
+  isBuilt_( false )
+{
+    for( int node = 0; node < NUMBER_OF_NODES; ++node ) {
+        stageFilters_[node] = NULL;
+        ownBuffers_[node] = NULL;
+        bufferNodes_[node] = SOURCE_NODE;
+    }
+}
+
+FilterGraph::~FilterGraph()
+{
+    clear();
+}
+
+/***************************************************************************//**
+Sets the filter of the stage that writes the node.  The graph does not own 
+the filters.
+*******************************************************************************/
+void FilterGraph::setStageFilter( Node node, blobFilters::BlobFilter * filter )
+{
+    if( node > SOURCE_NODE && node < NUMBER_OF_NODES ) {
+        stageFilters_[node] = filter;
+        isBuilt_ = false;
+    }
+}
+
+/***************************************************************************//**
+The image that the chain starts from.  It is only read, and it can be a 
+different buffer every frame (it does not cause a rebuild).
+*******************************************************************************/
+void FilterGraph::setSourceBuffer( blobBuffers::GrayBuffer * sourceBuffer )
+{
+    ownBuffers_[SOURCE_NODE] = sourceBuffer;
+}
+
+/***************************************************************************//**
+Rebuilds the graph if any stage has been turned on or off (or the graph has 
+been cleared).  Returns true if it was rebuilt.  Call once per frame, before
+the stages are run.
+*******************************************************************************/
+bool FilterGraph::update()
+{
+    int stages = activeStages();
+
+    if( isBuilt_ && stages == activeStages_ ) {
+        return false;
+    }
+    rebuild( stages );
+    return true;
+}
+
+/***************************************************************************//**
+Gives every buffer back to the pool.  The next update() rebuilds the graph.
+*******************************************************************************/
+void FilterGraph::clear()
+{
+    for( int node = SOURCE_NODE + 1; node < NUMBER_OF_NODES; ++node ) {
+        releaseBuffer( node );
+        bufferNodes_[node] = SOURCE_NODE;
+    }
+    ownBuffers_[SOURCE_NODE] = NULL;
+    activeStages_ = 0;
+    isBuilt_ = false;
+}
+
+/***************************************************************************//**
+One bit per node, set if the stage that writes the node has to run.  A stage
+without a filter never runs.
+*******************************************************************************/
+int FilterGraph::activeStages()
+{
+    int stages = 0;
+
+    for( int node = SOURCE_NODE + 1; node < NUMBER_OF_NODES; ++node ) {
+        if( stageFilters_[node] != NULL && !stageFilters_[node]->isPassThrough() ) {
+            stages |= (1 << node);
+        }
+    }
+    return stages;
+}
+
+void FilterGraph::rebuild( int activeStages )
+{
+    activeStages_ = activeStages;
+    isBuilt_ = true;
+
+    for( int node = SOURCE_NODE + 1; node < NUMBER_OF_NODES; ++node ) {
+        int inputNode = bufferNodes_[node - 1];
+
+        if( !isStageActive( (Node)node ) ) {
+            bufferNodes_[node] = inputNode;
+            releaseBuffer( node );
+        }
+        else if( node == MASKED_NODE && inputNode == SMOOTHED_NODE ) {
+            bufferNodes_[node] = inputNode;
+            releaseBuffer( node );
+        }
+        else {
+            bufferNodes_[node] = node;
+
+            if( ownBuffers_[node] == NULL ) {
+                ownBuffers_[node] = bufferPool_->acquire();
+            }
+        }
+    }
+}
+
+void FilterGraph::releaseBuffer( int node )
+{
+    if( node != SOURCE_NODE && ownBuffers_[node] != NULL ) {
+        bufferPool_->release( ownBuffers_[node] );
+        ownBuffers_[node] = NULL;
+    }
+}
+
+bool FilterGraph::isStageActive( Node node ) const
+{
+    return (activeStages_ & (1 << node)) != 0;
+}
+
+/***************************************************************************//**
+The filter that writes the node (NULL for the source node).
+*******************************************************************************/
+blobFilters::BlobFilter * FilterGraph::stageFilter( Node node ) const
+{
+    return (node > SOURCE_NODE && node < NUMBER_OF_NODES) ? stageFilters_[node] : NULL;
+}
+
+/***************************************************************************//**
+True if the node has no buffer of its own (its stage was dropped, or works 
+in place), and so shares the buffer of an earlier node.
+*******************************************************************************/
+bool FilterGraph::isAlias( Node node ) const
+{
+    return bufferNodes_[node] != node;
+}
+
+blobBuffers::GrayBuffer * FilterGraph::buffer( Node node ) const
+{
+    return ownBuffers_[bufferNodes_[node]];
+}
+
+/***************************************************************************//**
+The buffer that the stage that writes the node reads from.
+*******************************************************************************/
+blobBuffers::GrayBuffer * FilterGraph::inputBuffer( Node node ) const
+{
+    return (node > SOURCE_NODE) ? buffer( (Node)(node - 1) ) : NULL;
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+// FilterGraph
+//
+// PURPOSE: Works out which stages of the ImageFilters chain need to run and
+//          which image buffer each stage reads and writes, so that stages that
+//          would only copy their input are left out.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBFILTERS_FILTERGRAPH_H
+#define BLOBFILTERS_FILTERGRAPH_H
+
+namespace blobBuffers { class GrayBuffer; }
+namespace blobBuffers { class GrayBufferPool; }
+namespace blobFilters { class BlobFilter; }
+
+namespace blobFilters
+{
+    /***********************************************************************//**
+    The filter chain is a line of stages, each of which reads the image of 
+    the node before it and writes the image of its own node.  A stage whose 
+    filter would leave the pixels as they are (see 
+    BlobFilter::isPassThrough()) is dropped, and its node becomes an alias 
+    of the node before it, so the image is neither copied nor stored twice.
+    Nodes that are written get a buffer from the GrayBufferPool, and give it
+    back when they become aliases.
+
+    The only stage that works in place is the mask, which writes into the 
+    smoothed image when there is one (as the chain always did).  Nothing 
+    ever writes to the source node, so its buffer can belong to the caller.
+
+    update() reads the pass-through state of every stage and rebuilds the 
+    graph only if it has changed since the last call.
+    ***************************************************************************/
+    class FilterGraph
+    {
+    public:
+        enum Node
+        {
+            SOURCE_NODE,
+            SMOOTHED_NODE,
+            MASKED_NODE,
+            DIFF_NODE,
+            NORMALIZED_NODE,
+            HIGHPASS_NODE,
+            HIGHPASS_TWO_NODE,
+            SMOOTH_NODE,
+            TRACKED_NODE,
+            NUMBER_OF_NODES
+        };
+
+        FilterGraph( blobBuffers::GrayBufferPool * bufferPool );
+        ~FilterGraph();
+
+        void setStageFilter( Node node, blobFilters::BlobFilter * filter );
+        void setSourceBuffer( blobBuffers::GrayBuffer * sourceBuffer );
+        bool update();
+        void clear();
+
+        bool isStageActive( Node node ) const;
+        blobFilters::BlobFilter * stageFilter( Node node ) const;
+        bool isAlias( Node node ) const;
+        blobBuffers::GrayBuffer * buffer( Node node ) const;
+        blobBuffers::GrayBuffer * inputBuffer( Node node ) const;
+
+    private:
+        // Not copyable.
+        FilterGraph( const FilterGraph & );
+        FilterGraph & operator=( const FilterGraph & );
+
+        int activeStages();
+        void rebuild( int activeStages );
+        void releaseBuffer( int node );
+
+        blobBuffers::GrayBufferPool * bufferPool_;
+        blobFilters::BlobFilter * stageFilters_[NUMBER_OF_NODES];
+        blobBuffers::GrayBuffer * ownBuffers_[NUMBER_OF_NODES];
+        int bufferNodes_[NUMBER_OF_NODES];
+        int activeStages_;
+        bool isBuilt_;
+    };
+}
+
+#endif
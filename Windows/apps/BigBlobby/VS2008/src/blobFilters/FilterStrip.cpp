@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+// FilterStrip
+//
+// PURPOSE: One horizontal band of the image as seen by the strip-mined filter
+//          chain, with the extra (halo) rows that the neighbourhood filters need
+//          and the scratch images that hold those rows.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobFilters/FilterStrip.h"
+#include "blobBuffers/GrayBuffer.h"
+#include "blobBuffers/GrayBufferView.h"
+#include <algorithm>
+
+using blobFilters::FilterStrip;
+using blobFilters::FilterGraph;
+
+FilterStrip::FilterStrip( int firstRow, 
+                          int endRow, 
+                          int width, 
+                          int height, 
+                          int highpassTwoRadius, 
+                          int smoothingRadius ) :
+  firstRow_( firstRow ),
+  endRow_( endRow ),
+  highpassFirstRow_( std::max( 0, firstRow - highpassTwoRadius - smoothingRadius ) ),
+  highpassEndRow_( std::min( height, endRow + highpassTwoRadius + smoothingRadius ) ),
+  highpassTwoFirstRow_( std::max( 0, firstRow - smoothingRadius ) ),
+  highpassTwoEndRow_( std::min( height, endRow + smoothingRadius ) ),
+  highpassRows_( NULL ),
+  highpassTwoRows_( NULL )
+{
+    int stride = blobBuffers::GrayBuffer::alignedStride( width );
+    highpassRows_ = new blobBuffers::GrayBuffer( width, highpassEndRow_ - highpassFirstRow_, stride );
+    highpassTwoRows_ = new blobBuffers::GrayBuffer( width, highpassTwoEndRow_ - highpassTwoFirstRow_, stride );
+    std::fill( stageTimes_, stageTimes_ + FilterGraph::NUMBER_OF_NODES, 0.0 );
+}
+
+FilterStrip::~FilterStrip()
+{
+    delete highpassRows_;
+    delete highpassTwoRows_;
+}
+
+int FilterStrip::firstRow() const
+{
+    return firstRow_;
+}
+
+int FilterStrip::endRow() const
+{
+    return endRow_;
+}
+
+int FilterStrip::highpassFirstRow() const
+{
+    return highpassFirstRow_;
+}
+
+int FilterStrip::highpassEndRow() const
+{
+    return highpassEndRow_;
+}
+
+int FilterStrip::highpassTwoFirstRow() const
+{
+    return highpassTwoFirstRow_;
+}
+
+int FilterStrip::highpassTwoEndRow() const
+{
+    return highpassTwoEndRow_;
+}
+
+/***************************************************************************//**
+Scratch image for the first highpass output.  Row 0 is image row 
+highpassFirstRow().
+*******************************************************************************/
+cv::Mat FilterStrip::highpassRowsM()
+{
+    return imageRows( highpassRows_, 0, highpassRows_->height() );
+}
+
+/***************************************************************************//**
+Scratch image for the second highpass output.  Row 0 is image row 
+highpassTwoFirstRow().
+*******************************************************************************/
+cv::Mat FilterStrip::highpassTwoRowsM()
+{
+    return imageRows( highpassTwoRows_, 0, highpassTwoRows_->height() );
+}
+
+/***************************************************************************//**
+Adds to the time that the stage that writes the node took on this strip.
+*******************************************************************************/
+void FilterStrip::addStageTime( FilterGraph::Node node, double seconds )
+{
+    stageTimes_[node] += seconds;
+}
+
+/***************************************************************************//**
+Returns the time that the stage took on this strip since the last call, and
+starts it over from zero.
+*******************************************************************************/
+double FilterStrip::takeStageTime( FilterGraph::Node node )
+{
+    double seconds = stageTimes_[node];
+    stageTimes_[node] = 0.0;
+    return seconds;
+}
+
+/***************************************************************************//**
+Returns the rows [firstRow, endRow) of the image as a sub-matrix.  OpenCV 
+filters applied to a sub-matrix read the rows just outside of it from the 
+rest of the image (rather than treating its edges as the image border), which
+is what lets each strip be blurred on its own.
+*******************************************************************************/
+cv::Mat FilterStrip::imageRows( blobBuffers::GrayBuffer * image, int firstRow, int endRow )
+{
+    blobBuffers::GrayBufferView view( image );
+    cv::Mat imageM( view.height(), view.width(), CV_8U, view.pixels(), view.stride() );
+    return imageM.rowRange( firstRow, endRow );
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// FilterStrip
+//
+// PURPOSE: One horizontal band of the image as seen by the strip-mined filter
+//          chain, with the extra (halo) rows that the neighbourhood filters need
+//          and the scratch images that hold those rows.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBFILTERS_FILTERSTRIP_H
+#define BLOBFILTERS_FILTERSTRIP_H
+
+#include "blobFilters/FilterGraph.h"
+#include <opencv2/core/core.hpp>
+
+namespace blobBuffers { class GrayBuffer; }
+
+namespace blobFilters
+{
+    /***********************************************************************//**
+    Describes the rows [firstRow(), endRow()) of the image, which is the part
+    of every filter buffer that this strip writes.  
+
+    The second highpass filter and the smoothing filter look at rows above 
+    and below the strip, and those rows belong to neighbouring strips that
+    may be running at the same time on other threads.  So the first highpass
+    output is computed over the wider range [highpassFirstRow(), 
+    highpassEndRow()) and the second over [highpassTwoFirstRow(), 
+    highpassTwoEndRow()), into scratch images that belong to this strip.  The
+    ranges are clipped to the image, so a strip at the top or bottom edge sees
+    the same border as a full-frame blur would.
+
+    The strip also keeps the time that each filter stage took on it for the
+    current frame, which the ImageFilters adds up over the strips once they
+    are all done.
+    ***************************************************************************/
+    class FilterStrip
+    {
+    public:
+        FilterStrip( int firstRow, 
+                     int endRow, 
+                     int width, 
+                     int height, 
+                     int highpassTwoRadius, 
+                     int smoothingRadius );
+        ~FilterStrip();
+
+        int firstRow() const;
+        int endRow() const;
+        int highpassFirstRow() const;
+        int highpassEndRow() const;
+        int highpassTwoFirstRow() const;
+        int highpassTwoEndRow() const;
+        cv::Mat highpassRowsM();
+        cv::Mat highpassTwoRowsM();
+        void addStageTime( blobFilters::FilterGraph::Node node, double seconds );
+        double takeStageTime( blobFilters::FilterGraph::Node node );
+
+        static cv::Mat imageRows( blobBuffers::GrayBuffer * image, int firstRow, int endRow );
+
+    private:
+        // Not copyable.
+        FilterStrip( const FilterStrip & );
+        FilterStrip & operator=( const FilterStrip & );
+
+        int firstRow_,
+            endRow_,
+            highpassFirstRow_,
+            highpassEndRow_,
+            highpassTwoFirstRow_,
+            highpassTwoEndRow_;
+        blobBuffers::GrayBuffer * highpassRows_,
+                                * highpassTwoRows_;
+        double stageTimes_[blobFilters::FilterGraph::NUMBER_OF_NODES];
+    };
+}
+
+#endif
@@ -0,0 +1,339 @@
+////////////////////////////////////////////////////////////////////////////////
+// FusedPointwiseFilter
+//
+// PURPOSE: Applies the mask, background subtraction, signal normalization, and
+//          (when no blur follows them) the amplify and threshold steps to each
+//          pixel in a single pass, instead of one full-image pass per filter.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobFilters/FusedPointwiseFilter.h"
+#include "blobFilters/MaskFilter.h"
+#include "blobFilters/MaskSpans.h"
+#include "blobFilters/BackgroundFilter.h"
+#include "blobFilters/SignalNormalizationFilter.h"
+#include "blobFilters/HighpassFilter.h"
+#include "blobFilters/SmoothingFilter.h"
+#include "blobFilters/ThresholdFilter.h"
+#include "blobBuffers/GrayBuffer.h"
+#include "blobBuffers/BitBuffer.h"
+#include "blobKernels/GrayKernels.h"
+#include <cstring>
+
+using blobFilters::FusedPointwiseFilter;
+using blobKernels::GrayKernels;
+
+FusedPointwiseFilter::FusedPointwiseFilter( blobFilters::MaskFilter * maskFilter,
+                                            blobFilters::BackgroundFilter * backgroundFilter,
+                                            blobFilters::SignalNormalizationFilter * signalNormalizationFilter,
+                                            blobFilters::HighpassFilter * highpassFilter,
+                                            blobFilters::HighpassFilter * highpassTwoFilter,
+                                            blobFilters::SmoothingFilter * smoothingFilter,
+                                            blobFilters::ThresholdFilter * thresholdFilter ) :
+  maskFilter_( maskFilter ),
+  backgroundFilter_( backgroundFilter ),
+  signalNormalizationFilter_( signalNormalizationFilter ),
+  highpassFilter_( highpassFilter ),
+  highpassTwoFilter_( highpassTwoFilter ),
+  smoothingFilter_( smoothingFilter ),
+  thresholdFilter_( thresholdFilter ),
+  sourceBuffer_( NULL ),
+  maskedBuffer_( NULL ),
+  diffBuffer_( NULL ),
+  normalizeBuffer_( NULL ),
+  highpassBuffer_( NULL ),
+  highpassTwoBuffer_( NULL ),
+  smoothingBuffer_( NULL ),
+  outputBuffer_( NULL ),
+  signalBuffer_( NULL ),
+  outputBits_( NULL ),
+  writeOutputImage_( true ),
+  maskSpans_( NULL ),
+  writeFilterImages_( true ),
+  width_( 0 ),
+  backgroundLearnRate_( 0 ),
+  includesThreshold_( false ),
+  useDarkBlobs_( false ),
+  highpassAmplifyScale_( 0.0f ),
+  highpassTwoAmplifyScale_( 0.0f ),
+  smoothingAmplifyScale_( 0.0f ),
+  threshold_( 0 )
+{
+}
+
+FusedPointwiseFilter::~FusedPointwiseFilter()
+{
+}
+
+/***************************************************************************//**
+Sets the ImageFilters buffers to read from and write to (none are owned).  
+The source (pre-background smoothing output) buffer is the input, and it is 
+masked into the masked buffer, which may be the same buffer (masking in 
+place, like the MaskFilter does).  Buffers of stages that the FilterGraph has
+dropped are shared with the stage before.  The display-only buffers (diff, 
+highpass, highpassTwo, and smoothing) can be NULL, and are then not written.
+
+When outputBits is not NULL and the fused pass goes through the threshold, the
+thresholded output also goes to outputBits, straight from the unthresholded 
+row.  The output image is then only thresholded when writeOutputImage is true
+(when it is false, it is just the scratch row the pass works in).
+*******************************************************************************/
+void FusedPointwiseFilter::setBuffers( blobBuffers::GrayBuffer * sourceBuffer,
+                                       blobBuffers::GrayBuffer * maskedBuffer,
+                                       blobBuffers::GrayBuffer * diffBuffer,
+                                       blobBuffers::GrayBuffer * normalizeBuffer,
+                                       blobBuffers::GrayBuffer * highpassBuffer,
+                                       blobBuffers::GrayBuffer * highpassTwoBuffer,
+                                       blobBuffers::GrayBuffer * smoothingBuffer,
+                                       blobBuffers::GrayBuffer * outputBuffer,
+                                       blobBuffers::BitBuffer * outputBits,
+                                       bool writeOutputImage )
+{
+    sourceBuffer_ = sourceBuffer;
+    maskedBuffer_ = maskedBuffer;
+    diffBuffer_ = diffBuffer;
+    normalizeBuffer_ = normalizeBuffer;
+    highpassBuffer_ = highpassBuffer;
+    highpassTwoBuffer_ = highpassTwoBuffer;
+    smoothingBuffer_ = smoothingBuffer;
+    outputBuffer_ = outputBuffer;
+    outputBits_ = outputBits;
+    writeOutputImage_ = writeOutputImage || outputBits == NULL;
+}
+
+/***************************************************************************//**
+Sets the buffer (not owned) that, when the fused pass goes through the 
+threshold, gets a copy of each row just before it is thresholded (for the 
+weighted blob centroids, see ImageFilters::signalBuffer()).  Passing NULL 
+turns the copy off.
+*******************************************************************************/
+void FusedPointwiseFilter::setSignalBuffer( blobBuffers::GrayBuffer * signalBuffer )
+{
+    signalBuffer_ = signalBuffer;
+}
+
+/***************************************************************************//**
+When false, only the images that later filters or the blob finder read are
+written, and the display-only intermediate images are left as they are.
+*******************************************************************************/
+void FusedPointwiseFilter::setWriteFilterImages( bool b )
+{
+    writeFilterImages_ = b;
+}
+
+bool FusedPointwiseFilter::writeFilterImages()
+{
+    return writeFilterImages_;
+}
+
+/***************************************************************************//**
+Captures the current filter settings.  Must be called once per frame, after 
+prepareRows() has been called on the mask, background, and normalization 
+filters, and before any processRows() calls for that frame.
+*******************************************************************************/
+void FusedPointwiseFilter::prepareFrame()
+{
+    width_ = (sourceBuffer_ != NULL) ? sourceBuffer_->width() : 0;
+    maskSpans_ = maskFilter_->activeSpans();
+    includesThreshold_ = highpassFilter_->kernelRadius() == 0
+                      && highpassTwoFilter_->kernelRadius() == 0
+                      && smoothingFilter_->kernelRadius() == 0;
+    backgroundLearnRate_ = backgroundFilter_->frameLearnRate();
+    useDarkBlobs_ = backgroundFilter_->useDarkBlobs();
+    highpassAmplifyScale_ = highpassFilter_->activeAmplifyScale();
+    highpassTwoAmplifyScale_ = highpassTwoFilter_->activeAmplifyScale();
+    smoothingAmplifyScale_ = smoothingFilter_->activeAmplifyScale();
+    threshold_ = (thresholdFilter_->isActive() && thresholdFilter_->threshold() > 0) 
+               ? thresholdFilter_->threshold() 
+               : 0;
+}
+
+/***************************************************************************//**
+True if the fused pass goes all the way to the thresholded output image (no
+highpass or smoothing blur is turned on).  Otherwise it stops at the 
+normalized image.
+*******************************************************************************/
+bool FusedPointwiseFilter::includesThreshold()
+{
+    return includesThreshold_;
+}
+
+/***************************************************************************//**
+Processes the rows [firstRow, endRow).  Different row ranges of the same 
+frame may be processed at the same time on different threads.
+*******************************************************************************/
+void FusedPointwiseFilter::processRows( int firstRow, int endRow )
+{
+    for( int row = firstRow; row < endRow; ++row ) {
+        processRow( row );
+    }
+}
+
+/***************************************************************************//**
+Runs the filters one after another over a single row, which is still in the
+cache from one step to the next.  The steps are the same GrayKernels calls 
+that the separate filters make, so the results are the same.  When the mask 
+is on, only the row's span of the mask is filtered, and the pixels on either
+side of it are set to zero (see MaskSpans).
+*******************************************************************************/
+void FusedPointwiseFilter::processRow( int row )
+{
+    unsigned char * src = rowOf( maskedBuffer_, row ),
+                  * mask = maskFilter_->maskRow( row ),
+                  * dst = includesThreshold_ ? rowOf( outputBuffer_, row ) : rowOf( normalizeBuffer_, row ),
+                  * lastDisplay = dst;
+    unsigned short * background = backgroundFilter_->backgroundAccumulatorRow( row );
+    int start = 0,
+        end = width_;
+
+    if( mask != NULL && maskSpans_ != NULL ) {
+        start = maskSpans_->spanStart( row );
+        end = maskSpans_->spanEnd( row );
+        zeroOutsideSpan( src, start, end );
+        zeroOutsideSpan( dst, start, end );
+    }
+    int n = end - start;
+
+    // The masked image is always written, because the periodic background 
+    // reads it after the frame is done.
+    if( mask != NULL ) {
+        GrayKernels::mask( rowOf( sourceBuffer_, row ) + start, mask + start, src + start, n );
+    }
+    else if( maskedBuffer_ != sourceBuffer_ ) {
+        std::memcpy( src, rowOf( sourceBuffer_, row ), width_ );
+    }
+    if( backgroundLearnRate_ > 0 ) {
+        GrayKernels::accumulateWeighted( src + start, background + start, n, backgroundLearnRate_ );
+    }
+    if( useDarkBlobs_ ) {
+        GrayKernels::subtractFromAccumulator( src + start, background + start, dst + start, n );
+    }
+    else {
+        GrayKernels::subtractAccumulator( src + start, background + start, dst + start, n );
+    }
+    copyToDisplayRow( dst, diffBuffer_, row, lastDisplay );
+    if( normalizeRow( dst, row, start, n ) ) {
+        lastDisplay = dst;
+    }
+
+    if( includesThreshold_ ) {
+        amplifyRow( dst, start, n, highpassAmplifyScale_, highpassBuffer_, row, lastDisplay );
+        amplifyRow( dst, start, n, highpassTwoAmplifyScale_, highpassTwoBuffer_, row, lastDisplay );
+        amplifyRow( dst, start, n, smoothingAmplifyScale_, smoothingBuffer_, row, lastDisplay );
+
+        if( signalBuffer_ != NULL ) {
+            std::memcpy( rowOf( signalBuffer_, row ), dst, width_ );
+        }
+
+        // Outside of the span the row is already zero, so the whole row can 
+        // be packed.  A threshold of zero sets the non-zero pixels.
+        if( outputBits_ != NULL ) {
+            GrayKernels::thresholdBits( dst, outputBits_->row( row ), width_, threshold_ );
+        }
+        if( threshold_ > 0 && writeOutputImage_ ) {
+            GrayKernels::threshold( dst + start, dst + start, n, threshold_ );
+        }
+    }
+}
+
+/***************************************************************************//**
+Sets the pixels of the row before start and from end on to zero.
+*******************************************************************************/
+void FusedPointwiseFilter::zeroOutsideSpan( unsigned char * pixels, int start, int end )
+{
+    std::memset( pixels, 0, start );
+    std::memset( pixels + end, 0, width_ - end );
+}
+
+/***************************************************************************//**
+Normalizes the n pixels from start.  Returns false if normalization is turned
+off (and the row was left as is).
+*******************************************************************************/
+bool FusedPointwiseFilter::normalizeRow( unsigned char * pixels, int row, int start, int n )
+{
+    unsigned short * gains = signalNormalizationFilter_->gainRow( row );
+
+    if( gains != NULL ) {
+        GrayKernels::applyGain( pixels + start, gains + start, pixels + start, n );
+        return true;
+    }
+    return false;
+}
+
+/***************************************************************************//**
+Amplifies the n pixels from start in place (if the scale is non-zero), and 
+copies the whole row to the given display image if filter images are being 
+written.
+*******************************************************************************/
+void FusedPointwiseFilter::amplifyRow( unsigned char * pixels, int start, int n, float scale,
+                                       blobBuffers::GrayBuffer * displayBuffer, int row,
+                                       unsigned char * & lastDisplay )
+{
+    if( scale > 0 ) {
+        GrayKernels::amplifySquare( pixels + start, pixels + start, n, scale );
+        lastDisplay = pixels;
+    }
+    copyToDisplayRow( pixels, displayBuffer, row, lastDisplay );
+}
+
+/***************************************************************************//**
+Copies the row to the display image, if there is one and filter images are
+being written.  Display images of stages that the FilterGraph dropped share 
+the buffer of the stage before, which already holds the same pixels, so a 
+row is not copied again to the row it was last copied to (or computed in).
+*******************************************************************************/
+void FusedPointwiseFilter::copyToDisplayRow( unsigned char * pixels, 
+                                             blobBuffers::GrayBuffer * displayBuffer, int row,
+                                             unsigned char * & lastDisplay )
+{
+    if( displayBuffer != NULL && writeFilterImages_ ) {
+        unsigned char * displayRow = rowOf( displayBuffer, row );
+
+        if( displayRow != lastDisplay && displayRow != pixels ) {
+            std::memcpy( displayRow, pixels, width_ );
+            lastDisplay = displayRow;
+        }
+    }
+}
+
+unsigned char * FusedPointwiseFilter::rowOf( blobBuffers::GrayBuffer * buffer, int row )
+{
+    return buffer->row( row );
+}
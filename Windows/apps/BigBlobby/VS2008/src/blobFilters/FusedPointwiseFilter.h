@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// FusedPointwiseFilter
+//
+// PURPOSE: Applies the mask, background subtraction, signal normalization, and
+//          (when no blur follows them) the amplify and threshold steps to each
+//          pixel in a single pass, instead of one full-image pass per filter.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBFILTERS_FUSEDPOINTWISEFILTER_H
+#define BLOBFILTERS_FUSEDPOINTWISEFILTER_H
+
+namespace blobBuffers { class GrayBuffer; }
+namespace blobBuffers { class BitBuffer; }
+namespace blobFilters { class MaskFilter; }
+namespace blobFilters { class MaskSpans; }
+namespace blobFilters { class BackgroundFilter; }
+namespace blobFilters { class SignalNormalizationFilter; }
+namespace blobFilters { class HighpassFilter; }
+namespace blobFilters { class SmoothingFilter; }
+namespace blobFilters { class ThresholdFilter; }
+
+namespace blobFilters
+{
+    /***********************************************************************//**
+    Does the work of the point-wise filters in the ImageFilters chain in one
+    pass over the image, a row at a time, using the settings and state (mask,
+    background, normalization factors) of the filter objects it is given.  The
+    arithmetic is the same as that of the filters themselves, so the output 
+    is identical.
+
+    The mask, background, and normalization filters are always point-wise.  
+    The two highpass filters and the smoothing filter are neighbourhood 
+    filters, but when all three are turned off they only copy the image (and
+    maybe amplify it), so then the fused pass carries on through their 
+    amplify steps and the threshold and writes the final output image.  
+    Otherwise it stops after normalization and the caller runs the rest of 
+    the chain as usual.
+
+    The intermediate images (difference, and the highpass/smoothing images 
+    when they are passed through) are only needed for display, so writing 
+    them can be turned off with setWriteFilterImages().  The masked image is
+    always written, since the periodic background reads it.
+    ***************************************************************************/
+    class FusedPointwiseFilter
+    {
+    public:
+        FusedPointwiseFilter( blobFilters::MaskFilter * maskFilter,
+                              blobFilters::BackgroundFilter * backgroundFilter,
+                              blobFilters::SignalNormalizationFilter * signalNormalizationFilter,
+                              blobFilters::HighpassFilter * highpassFilter,
+                              blobFilters::HighpassFilter * highpassTwoFilter,
+                              blobFilters::SmoothingFilter * smoothingFilter,
+                              blobFilters::ThresholdFilter * thresholdFilter );
+        ~FusedPointwiseFilter();
+
+        void setBuffers( blobBuffers::GrayBuffer * sourceBuffer,
+                         blobBuffers::GrayBuffer * maskedBuffer,
+                         blobBuffers::GrayBuffer * diffBuffer,
+                         blobBuffers::GrayBuffer * normalizeBuffer,
+                         blobBuffers::GrayBuffer * highpassBuffer,
+                         blobBuffers::GrayBuffer * highpassTwoBuffer,
+                         blobBuffers::GrayBuffer * smoothingBuffer,
+                         blobBuffers::GrayBuffer * outputBuffer,
+                         blobBuffers::BitBuffer * outputBits,
+                         bool writeOutputImage );
+        void setSignalBuffer( blobBuffers::GrayBuffer * signalBuffer );
+        void setWriteFilterImages( bool b );
+        bool writeFilterImages();
+
+        void prepareFrame();
+        bool includesThreshold();
+        void processRows( int firstRow, int endRow );
+
+    private:
+        void processRow( int row );
+        void zeroOutsideSpan( unsigned char * pixels, int start, int end );
+        bool normalizeRow( unsigned char * pixels, int row, int start, int n );
+        void amplifyRow( unsigned char * pixels, int start, int n, float scale, 
+                         blobBuffers::GrayBuffer * displayBuffer, int row,
+                         unsigned char * & lastDisplay );
+        void copyToDisplayRow( unsigned char * pixels, 
+                               blobBuffers::GrayBuffer * displayBuffer, int row,
+                               unsigned char * & lastDisplay );
+        unsigned char * rowOf( blobBuffers::GrayBuffer * buffer, int row );
+
+        blobFilters::MaskFilter * maskFilter_;
+        blobFilters::BackgroundFilter * backgroundFilter_;
+        blobFilters::SignalNormalizationFilter * signalNormalizationFilter_;
+        blobFilters::HighpassFilter * highpassFilter_,
+                                    * highpassTwoFilter_;
+        blobFilters::SmoothingFilter * smoothingFilter_;
+        blobFilters::ThresholdFilter * thresholdFilter_;
+
+        blobBuffers::GrayBuffer * sourceBuffer_,
+                                * maskedBuffer_,
+                                * diffBuffer_,
+                                * normalizeBuffer_,
+                                * highpassBuffer_,
+                                * highpassTwoBuffer_,
+                                * smoothingBuffer_,
+                                * outputBuffer_,
+                                * signalBuffer_;
+        blobBuffers::BitBuffer * outputBits_;
+        bool writeOutputImage_;
+        const blobFilters::MaskSpans * maskSpans_;
+        bool writeFilterImages_;
+
+        // Settings captured by prepareFrame() so that every row of a frame
+        // is processed the same way.
+        int width_,
+            backgroundLearnRate_;
+        bool includesThreshold_,
+             useDarkBlobs_;
+        float highpassAmplifyScale_,
+              highpassTwoAmplifyScale_,
+              smoothingAmplifyScale_;
+        int threshold_;
+    };
+}
+
+#endif
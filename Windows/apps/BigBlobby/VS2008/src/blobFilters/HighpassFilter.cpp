@@ -44,18 +44,21 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobFilters/HighpassFilter.h"
+#include "blobFilters/BoxFilter.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobKernels/GrayKernels.h"
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <iostream>
 
 using blobFilters::HighpassFilter;
+using blobKernels::GrayKernels;
 
 HighpassFilter::HighpassFilter() :
   bufferWidth_( 0 ),
   bufferHeight_( 0 ),
   blurredImage_( NULL ),
-  blurredImageM_( NULL ),
+  boxFilter_( new blobFilters::BoxFilter() ),
   blurSize_( 0 ),
   isActive_( false ),
   showSubtractionImage_( false )
@@ -65,6 +68,7 @@ HighpassFilter::HighpassFilter() :
 HighpassFilter::~HighpassFilter()
 {
     clear();
+    delete boxFilter_;
 }
 
 void HighpassFilter::clear()
@@ -72,9 +76,7 @@ void HighpassFilter::clear()
     bufferWidth_ = 0;
     bufferHeight_ = 0;
     delete blurredImage_;
-    delete blurredImageM_;
     blurredImage_ = NULL;
-    blurredImageM_ = NULL;
 }
 
 void HighpassFilter::process( blobBuffers::GrayBuffer * srcImage,
@@ -87,21 +89,87 @@ void HighpassFilter::process( blobBuffers::GrayBuffer * srcImage,
         if( bufferWidth_ != cols || bufferHeight_ != rows ) {
             initialize( cols, rows );
         }
-        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), cols );
-        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), cols );
-
-        if( isActive_ && blurSize_ > 0 ) {
-            int oddBlurSize = (blurSize_ * 2) + 1; // Always use odd number.
-            cv::Size kernelSize( oddBlurSize, oddBlurSize );
-            cv::blur( srcM, *blurredImageM_, kernelSize );
-            cv::subtract( srcM, *blurredImageM_, dstM );
+        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), srcImage->stride() );
+        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), dstImage->stride() );
+
+        if( showSubtractionImage_ && kernelRadius() > 0 ) {
+            // The whole blurred image is kept for display.
+            cv::Mat blurredM( rows, cols, CV_8U, blurredImage_->pixels(), blurredImage_->stride() );
+            boxFilter_->blur( srcM, blurredM ); // Box is (2 * blurSize_ + 1) wide.
+            subtractRows( srcM, blurredM, dstM );
+            amplify( dstM );
         }
         else {
-            srcM.copyTo( dstM );
+            processRegion( srcM, dstM, 0 );
         }
     }
 }
 
+/***************************************************************************//**
+Makes sure that the full-size blurred image exists, since the row-strip 
+callers copy the rows of it that they blur into it for display.
+*******************************************************************************/
+void HighpassFilter::prepareRows( int width, int height )
+{
+    if( bufferWidth_ != width || bufferHeight_ != height ) {
+        initialize( width, height );
+    }
+}
+
+/***************************************************************************//**
+Row-strip version of process().  The blurred image is written straight into 
+dstM and then subtracted in place, so no scratch image is needed; callers 
+that want to display the subtraction image use blurRows() for it.
+*******************************************************************************/
+void HighpassFilter::processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol )
+{
+    if( isActive_ && blurSize_ > 0 ) {
+        blurRows( srcM, dstM );
+        subtractRows( srcM, dstM, dstM );
+    }
+    else {
+        srcM.copyTo( dstM );
+    }
+}
+
+bool HighpassFilter::changesPixels()
+{
+    return kernelRadius() > 0;
+}
+
+void HighpassFilter::blurRows( cv::Mat & srcM, cv::Mat & dstM )
+{
+    boxFilter_->blur( srcM, dstM );
+}
+
+/***************************************************************************//**
+Finishes processRows() for rows that the caller has already blurred with 
+blurRows() (to show the blurred image without blurring twice).  The blurred
+rows are replaced by the (amplified) highpass rows.
+*******************************************************************************/
+void HighpassFilter::processBlurredRows( cv::Mat & srcM, cv::Mat & blurredM )
+{
+    subtractRows( srcM, blurredM, blurredM );
+    amplify( blurredM );
+}
+
+void HighpassFilter::subtractRows( cv::Mat & srcM, cv::Mat & blurredM, cv::Mat & dstM )
+{
+    for( int row = 0; row < srcM.rows; ++row ) {
+        GrayKernels::subtract( srcM.ptr<unsigned char>( row ), blurredM.ptr<unsigned char>( row ),
+                               dstM.ptr<unsigned char>( row ), srcM.cols );
+    }
+}
+
+/***************************************************************************//**
+Number of rows above and below a pixel that its output depends on (zero when
+the filter just copies its input).
+*******************************************************************************/
+int HighpassFilter::kernelRadius()
+{
+    return (isActive_ && blurSize_ > 0) ? blurSize_ : 0;
+}
+
 blobBuffers::GrayBuffer * HighpassFilter::blurredImage()
 {
     return blurredImage_;
@@ -112,16 +180,14 @@ void HighpassFilter::initialize( int width, int height )
     clear();
     bufferWidth_ = width;
     bufferHeight_ = height;
-    blurredImage_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-
-    int rows = bufferHeight_,
-        cols = bufferWidth_;
-    blurredImageM_ = new cv::Mat( rows, cols, CV_8U, blurredImage_->pixels(), cols );
+    blurredImage_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_, 
+                                                 blobBuffers::GrayBuffer::alignedStride( bufferWidth_ ) );
 }
 
 void HighpassFilter::setBlurSize( int blurSize )
 {
     blurSize_ = blurSize;
+    boxFilter_->setRadius( blurSize );
 }
 
 int HighpassFilter::blurSize()
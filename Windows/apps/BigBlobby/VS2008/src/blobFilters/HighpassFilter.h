@@ -49,6 +49,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobFilters/BlobFilter.h"
 
 namespace blobBuffers { class GrayBuffer; }
+namespace blobFilters { class BoxFilter; }
 namespace cv { class Mat; }
 
 namespace blobFilters
@@ -62,6 +63,11 @@ namespace blobFilters
         void clear();
         virtual void process( blobBuffers::GrayBuffer * srcImage,
                               blobBuffers::GrayBuffer * dstImage );
+        virtual void prepareRows( int width, int height );
+
+        void blurRows( cv::Mat & srcM, cv::Mat & dstM );
+        void processBlurredRows( cv::Mat & srcM, cv::Mat & blurredM );
+        virtual int kernelRadius();
 
         blobBuffers::GrayBuffer * blurredImage();
         void setBlurSize( int size );
@@ -71,13 +77,18 @@ namespace blobFilters
         void showSubtractionImage( bool show );
         bool showSubtractionImage();
 
+    protected:
+        virtual void processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol );
+        virtual bool changesPixels();
+
     private:
         void initialize( int width, int height );
+        void subtractRows( cv::Mat & srcM, cv::Mat & blurredM, cv::Mat & dstM );
 
         int bufferWidth_,
             bufferHeight_;
         blobBuffers::GrayBuffer * blurredImage_;
-        cv::Mat * blurredImageM_;
+        blobFilters::BoxFilter * boxFilter_;
         int blurSize_;
         bool isActive_,
              showSubtractionImage_;
@@ -48,29 +48,51 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobFilters/BackgroundFilter.h"
 #include "blobFilters/SignalNormalizationFilter.h"
 #include "blobFilters/MaskFilter.h"
+#include "blobFilters/MaskSpans.h"
 #include "blobFilters/HighpassFilter.h"
 #include "blobFilters/SmoothingFilter.h"
 #include "blobFilters/ThresholdFilter.h"
+#include "blobFilters/FilterStrip.h"
+#include "blobFilters/FusedPointwiseFilter.h"
+#include "blobFilters/DisplayTaps.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobBuffers/BitBuffer.h"
+#include "blobBuffers/GrayBufferPool.h"
 #include "blobStats/FilterStats.h"
+#include "blobVideo/FrameSource.h"
 #include "blobUtils/FunctionTimer.h"
+#include "blobUtils/StopWatch.h"
+#include "blobUtils/WorkStealingPool.h"
+#include <opencv2/core/core.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
 #include <iostream>
 
 using blobFilters::ImageFilters;
+using blobFilters::FilterStrip;
+using blobFilters::FilterGraph;
 using blobEnums::FilterEnum;
 
+// A strip is sized so that its rows of all the buffers that the chain reads
+// and writes (about 16 bytes per pixel: eight 8-bit images, the 16-bit 
+// background, and the 32-bit normalization factors) fit in a typical 256 KB 
+// L2 cache.  Strips are never thinner than MIN_STRIP_ROWS, or than twice the
+// halo that the second highpass and smoothing filters need, so that the 
+// halo rows (which are filtered once for each strip that needs them) stay a
+// small part of the work.
+const int ImageFilters::STRIP_CACHE_BYTES = 256 * 1024;
+const int ImageFilters::STRIP_BYTES_PER_PIXEL = 16;
+const int ImageFilters::MIN_STRIP_ROWS = 16;
+
 ImageFilters::ImageFilters() :
   bufferWidth_( 0 ),
   bufferHeight_( 0 ),
   inputBuffer_( NULL ),
-  preBackgroundSmoothingBuffer_( NULL ),
+  frameView_( NULL ),
   backgroundBufferCopy_( NULL ),
-  diffBuffer_( NULL ),
-  normalizeBuffer_( NULL ),
-  highpassBuffer_( NULL ),
-  highpassTwoBuffer_( NULL ),
-  smoothingBuffer_( NULL ),
-  grayOutputBuffer_( NULL ),
+  signalBufferCopy_( NULL ),
+  bufferPool_( new blobBuffers::GrayBufferPool() ),
+  filterGraph_( NULL ),
   bufferUtility_( new blobBuffers::BufferUtility() ),
   preBackgroundSmoothingFilter_( new blobFilters::SmoothingFilter() ),
   maskFilter_( new blobFilters::MaskFilter() ),
@@ -80,17 +102,48 @@ ImageFilters::ImageFilters() :
   highpassTwoFilter_( new blobFilters::HighpassFilter() ),
   smoothingFilter_( new blobFilters::SmoothingFilter() ),
   thresholdFilter_( new blobFilters::ThresholdFilter() ),
+  fusedPointwiseFilter_( NULL ),
+  useFusedFilters_( true ),
+  displayTaps_( new blobFilters::DisplayTaps() ),
+  trackedBits_( NULL ),
+  usePackedOutput_( true ),
+  writeTrackedImage_( true ),
+  keepSignalImage_( false ),
+  useStripProcessing_( true ),
+  stripPool_( new blobUtils::WorkStealingPool() ),
+  filterStrips_(),
+  stripHighpassTwoRadius_( 0 ),
+  stripSmoothingRadius_( 0 ),
   processTimer_( new blobUtils::FunctionTimer() ),
   copyCameraPixelsTimer_( new blobUtils::FunctionTimer() ),
   filterStats_( new blobStats::FilterStats() )
 {
     thresholdFilter_->setActive( true );
+    signalNormalizationFilter_->setThreadPool( stripPool_ );
+    filterGraph_ = new blobFilters::FilterGraph( bufferPool_ );
+    filterGraph_->setStageFilter( FilterGraph::SMOOTHED_NODE, preBackgroundSmoothingFilter_ );
+    filterGraph_->setStageFilter( FilterGraph::MASKED_NODE, maskFilter_ );
+    filterGraph_->setStageFilter( FilterGraph::DIFF_NODE, backgroundFilter_ );
+    filterGraph_->setStageFilter( FilterGraph::NORMALIZED_NODE, signalNormalizationFilter_ );
+    filterGraph_->setStageFilter( FilterGraph::HIGHPASS_NODE, highpassFilter_ );
+    filterGraph_->setStageFilter( FilterGraph::HIGHPASS_TWO_NODE, highpassTwoFilter_ );
+    filterGraph_->setStageFilter( FilterGraph::SMOOTH_NODE, smoothingFilter_ );
+    filterGraph_->setStageFilter( FilterGraph::TRACKED_NODE, thresholdFilter_ );
+    fusedPointwiseFilter_ = new blobFilters::FusedPointwiseFilter( maskFilter_,
+                                                                   backgroundFilter_,
+                                                                   signalNormalizationFilter_,
+                                                                   highpassFilter_,
+                                                                   highpassTwoFilter_,
+                                                                   smoothingFilter_,
+                                                                   thresholdFilter_ );
 }
 
 ImageFilters::~ImageFilters()
 {
     delete filterStats_;
     clearBuffers();
+    delete filterGraph_;
+    delete bufferPool_;
     deleteTimers();
     deleteFilters();
 }
@@ -104,24 +157,25 @@ void ImageFilters::clearBuffers()
 
 void ImageFilters::clearFilterBuffers()
 {
-    delete inputBuffer_;
-    delete preBackgroundSmoothingBuffer_;
-    delete backgroundBufferCopy_;
-    delete diffBuffer_;
-    delete normalizeBuffer_;
-    delete highpassBuffer_;
-    delete highpassTwoBuffer_;
-    delete smoothingBuffer_;
-    delete grayOutputBuffer_;
-    inputBuffer_ = NULL;
-    preBackgroundSmoothingBuffer_ = NULL;
-    backgroundBufferCopy_ = NULL;
-    diffBuffer_ = NULL;
-    normalizeBuffer_ = NULL;
-    highpassBuffer_ = NULL;
-    highpassTwoBuffer_ = NULL;
-    smoothingBuffer_ = NULL;
-    grayOutputBuffer_ = NULL;
+    clearFilterStrips();
+    backgroundFilter_->setSourceImage( NULL );
+    filterGraph_->clear();
+    releaseBuffer( inputBuffer_ );
+    releaseBuffer( backgroundBufferCopy_ );
+    releaseBuffer( signalBufferCopy_ );
+    delete frameView_;
+    frameView_ = NULL;
+    delete trackedBits_;
+    trackedBits_ = NULL;
+}
+
+/***************************************************************************//**
+Gives the buffer back to the pool and sets the pointer to NULL.
+*******************************************************************************/
+void ImageFilters::releaseBuffer( blobBuffers::GrayBuffer * & buffer )
+{
+    bufferPool_->release( buffer );
+    buffer = NULL;
 }
 
 void ImageFilters::deleteTimers()
@@ -141,32 +195,130 @@ void ImageFilters::deleteFilters()
     delete highpassTwoFilter_;
     delete smoothingFilter_;
     delete thresholdFilter_;
+    delete fusedPointwiseFilter_;
+    delete displayTaps_;
+    delete stripPool_;
 }
 
-void ImageFilters::processGrayscaleImage( unsigned char * grayPixels, int width, int height )
+/***************************************************************************//**
+Runs the filter chain on the current frame of a camera or video file.  A gray
+frame that does not have to be flipped is filtered where it is, and any other
+frame is converted and flipped into the input buffer first (see copyFrame()).
+*******************************************************************************/
+void ImageFilters::processFrame( blobVideo::FrameSource * frameSource )
 {
     processTimer_->startTiming();
-    processImage( grayPixels, width, height, blobBuffers::BufferUtility::GRAY_CHANNEL );
+
+    if( frameSource->hasFrame() ) {
+        int width = frameSource->width(),
+            height = frameSource->height();
+
+        if( bufferWidth_ != width || bufferHeight_ != height ) {
+            initializeBuffers( width, height );
+        }
+        blobBuffers::GrayBuffer * sourceImage = frameBuffer( frameSource );
+        displayTaps_->beginFrame();
+        applyFilterChain( sourceImage );
+    }
+    else {
+        clearBuffers();
+    }
     processTimer_->stopTiming();
 }
 
-void ImageFilters::processRgbImage( unsigned char * colorPixels, int width, int height )
+/***************************************************************************//**
+Converts (and flips, if requested) the current frame into the grayscale 
+destination buffer without running any filters.  Used by the capture side of
+the frame pipeline, which then passes the buffer to processSourceBuffer() on
+the filter thread.
+*******************************************************************************/
+void ImageFilters::copyFrame( blobVideo::FrameSource * frameSource,
+                              blobBuffers::GrayBuffer * dstImage )
 {
-    processTimer_->startTiming();
-    processImage( colorPixels, width, height, blobBuffers::BufferUtility::RGB_CHANNELS );
-    processTimer_->stopTiming();
+    copyCameraPixelsTimer_->startTiming();
+    bufferUtility_->copyFrame( frameSource->pixels(), 
+                               frameSource->width(), 
+                               frameSource->height(), 
+                               frameSource->stride(),
+                               frameSource->pixelFormat(), 
+                               dstImage );
+    copyCameraPixelsTimer_->stopTiming();
+}
+
+/***************************************************************************//**
+The frame as a gray image.  When the frame is already gray and is not to be 
+flipped, this is a buffer around the frame's own pixels (which is only made 
+again when the source moves them); otherwise the frame is copied into the 
+input buffer.
+*******************************************************************************/
+blobBuffers::GrayBuffer * ImageFilters::frameBuffer( blobVideo::FrameSource * frameSource )
+{
+    if( bufferUtility_->needsCopy( frameSource->pixelFormat() ) ) {
+        copyFrame( frameSource, inputBuffer_ );
+        return inputBuffer_;
+    }
+    unsigned char * pixels = frameSource->pixels();
+    int stride = frameSource->stride();
+
+    if( frameView_ == NULL 
+        || frameView_->pixels() != pixels 
+        || frameView_->stride() != stride 
+        || frameView_->width() != bufferWidth_ 
+        || frameView_->height() != bufferHeight_ ) 
+    {
+        delete frameView_;
+        frameView_ = new blobBuffers::GrayBuffer( pixels, bufferWidth_, bufferHeight_, stride );
+    }
+    return frameView_;
 }
 
-void ImageFilters::processImage( unsigned char * pixels, 
-                                 int width, 
-                                 int height, 
-                                 int channels )
+/***************************************************************************//**
+Runs the filter chain on a source image that has already been converted to
+grayscale and flipped by copyFrame().  The source image is read in 
+place (it is not copied or changed), so it must be left alone until the 
+frame's filter images have been used.
+*******************************************************************************/
+void ImageFilters::processSourceBuffer( blobBuffers::GrayBuffer * sourceImage )
 {
+    int width = sourceImage->width(),
+        height = sourceImage->height();
+
+    processTimer_->startTiming();
+
     if( width > 0 && height > 0 ) {
         if( bufferWidth_ != width || bufferHeight_ != height ) {
             initializeBuffers( width, height );
         }
-        copyPixelsToInputBuffer( pixels, width, height, channels );
+        displayTaps_->beginFrame();
+        applyFilterChain( sourceImage );
+    }
+    else {
+        clearBuffers();
+    }
+    processTimer_->stopTiming();
+}
+
+void ImageFilters::applyFilterChain( blobBuffers::GrayBuffer * sourceImage )
+{
+    updateFilterGraph( sourceImage );
+    maskFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    updateFilterRegions();
+
+    if( useStripProcessing_ ) {
+        applyFilterChainInStrips();
+    }
+    else if( useFusedFilters_ ) {
+        applyPreBackgroundSmoothingFilter();
+        applyFusedPointwiseFilter();
+
+        if( !isFusedThroughThreshold() ) {
+            applyHighpassFilter();
+            applyHighpassTwoFilter();
+            applySmoothingFilter();
+            applyThresholdFilter();
+        }
+    }
+    else {
         applyPreBackgroundSmoothingFilter();
         applyMaskFilter();
         applyBackgroundFilter();
@@ -176,70 +328,546 @@ void ImageFilters::processImage( unsigned char * pixels,
         applySmoothingFilter();
         applyThresholdFilter();
     }
-    else {
-        clearBuffers();
+}
+
+/***************************************************************************//**
+Points the filter graph at this frame's source image, and rebuilds it if a 
+filter has been turned on or off since the last frame.  The source buffer 
+(and so every node that is an alias of it) can change from frame to frame, 
+and so can the display taps that are due, so the fused filter and the 
+periodic background are given their buffers again every frame.  The fused 
+filter gets NULL for the display-only images that nobody is looking at, and 
+with packed output, the 8-bit tracked image is one of them.
+*******************************************************************************/
+void ImageFilters::updateFilterGraph( blobBuffers::GrayBuffer * sourceImage )
+{
+    writeTrackedImage_ = !usePackedOutput_ || writeFilterImage( FilterEnum::TRACKED );
+    filterGraph_->setSourceBuffer( sourceImage );
+    filterGraph_->update();
+    backgroundFilter_->setSourceImage( filterGraph_->buffer( FilterGraph::MASKED_NODE ) );
+    fusedPointwiseFilter_->setBuffers( filterGraph_->buffer( FilterGraph::SMOOTHED_NODE ),
+                                       filterGraph_->buffer( FilterGraph::MASKED_NODE ),
+                                       tappedBuffer( FilterEnum::DIFF_BUFFER, FilterGraph::DIFF_NODE ),
+                                       filterGraph_->buffer( FilterGraph::NORMALIZED_NODE ),
+                                       tappedBuffer( FilterEnum::HIGHPASS, FilterGraph::HIGHPASS_NODE ),
+                                       tappedBuffer( FilterEnum::HIGHPASS_TWO, FilterGraph::HIGHPASS_TWO_NODE ),
+                                       tappedBuffer( FilterEnum::SMOOTH, FilterGraph::SMOOTH_NODE ),
+                                       filterGraph_->buffer( FilterGraph::TRACKED_NODE ),
+                                       trackedBits(),
+                                       writeTrackedImage_ );
+    fusedPointwiseFilter_->setSignalBuffer( keepSignalImage_ ? signalBufferCopy_ : NULL );
+}
+
+/***************************************************************************//**
+Limits every filter to the part of the image inside the calibration mask (see
+MaskSpans), when the mask is turned on.  The pre-background smoothing runs 
+before the mask, so it only has to be right inside the mask, which takes its
+own blur radius.  The mask, background, and normalization filters work inside
+the mask, and so do the highpass filters, since subtracting a blurred image
+from zero leaves zero; they only need their blur radius to read the zeros 
+around the mask.  The smoothing filter spreads the signal out by its radius,
+and the threshold filter has to cover the same area.
+*******************************************************************************/
+void ImageFilters::updateFilterRegions()
+{
+    const blobFilters::MaskSpans * maskSpans = maskFilter_->activeSpans();
+    int smoothingRadius = smoothingFilter_->kernelRadius();
+
+    preBackgroundSmoothingFilter_->setRegion( maskSpans, preBackgroundSmoothingFilter_->kernelRadius() );
+    maskFilter_->setRegion( maskSpans, 0 );
+    backgroundFilter_->setRegion( maskSpans, 0 );
+    signalNormalizationFilter_->setRegion( maskSpans, 0 );
+    highpassFilter_->setRegion( maskSpans, highpassFilter_->kernelRadius() );
+    highpassTwoFilter_->setRegion( maskSpans, highpassTwoFilter_->kernelRadius() );
+    smoothingFilter_->setRegion( maskSpans, smoothingRadius );
+    thresholdFilter_->setRegion( maskSpans, smoothingRadius );
+}
+
+/***************************************************************************//**
+The part of the tracked image that can have blobs in it: the area that the 
+threshold filter wrote (see updateFilterRegions()), plus a row and column of 
+zeros all the way around, or the whole image if the mask is turned off.  Only
+valid for the frame that was last filtered.
+*******************************************************************************/
+cv::Rect ImageFilters::trackedRegion()
+{
+    const blobFilters::MaskSpans * maskSpans = maskFilter_->activeSpans();
+
+    if( maskSpans != NULL ) {
+        return maskSpans->roi( smoothingFilter_->kernelRadius() + 1 );
     }
+    return cv::Rect( 0, 0, bufferWidth_, bufferHeight_ );
 }
 
-void ImageFilters::copyPixelsToInputBuffer( unsigned char * grayPixels, 
-                                            int width, 
-                                            int height, 
-                                            int channels )
+blobBuffers::GrayBuffer * ImageFilters::tappedBuffer( blobEnums::FilterEnum::Enum filterType, 
+                                                      FilterGraph::Node node )
 {
-    copyCameraPixelsTimer_->startTiming();
-    bufferUtility_->process( grayPixels, width, height, channels, inputBuffer_ );
-    copyCameraPixelsTimer_->stopTiming();
+    return writeFilterImage( filterType ) ? filterGraph_->buffer( node ) : NULL;
+}
+
+/***************************************************************************//**
+Runs the stage that writes the node on whole images, unless the filter graph
+has dropped it.
+*******************************************************************************/
+void ImageFilters::applyStage( blobFilters::BlobFilter * filter, FilterGraph::Node node )
+{
+    if( filterGraph_->isStageActive( node ) ) {
+        filter->processImage( filterGraph_->inputBuffer( node ), filterGraph_->buffer( node ) );
+    }
+}
+
+/***************************************************************************//**
+Row-strip version of applyStage(), for the rows of the strip.  The time it 
+takes is kept by the strip (see addStripTimes()).
+*******************************************************************************/
+void ImageFilters::processStageRows( blobFilters::BlobFilter * filter, 
+                                     FilterGraph::Node node, 
+                                     blobFilters::FilterStrip * strip )
+{
+    if( filterGraph_->isStageActive( node ) ) {
+        blobUtils::StopWatch stopWatch;
+        int firstRow = strip->firstRow(),
+            endRow = strip->endRow();
+        cv::Mat srcM = FilterStrip::imageRows( filterGraph_->inputBuffer( node ), firstRow, endRow ),
+                dstM = nodeRows( node, firstRow, endRow );
+        filter->processRows( srcM, dstM, firstRow );
+        strip->addStageTime( node, stopWatch.elapsed() );
+    }
+}
+
+cv::Mat ImageFilters::nodeRows( FilterGraph::Node node, int firstRow, int endRow )
+{
+    return FilterStrip::imageRows( filterGraph_->buffer( node ), firstRow, endRow );
+}
+
+/***************************************************************************//**
+Turns strip-mined filtering on or off.  When on (the default), the image is 
+cut into horizontal strips that are filtered in parallel on a work-stealing 
+thread pool, and each strip is taken through several filters in a row while 
+its pixels are still in the cache, instead of streaming the whole frame 
+through memory once per filter.  The output is the same either way.
+*******************************************************************************/
+void ImageFilters::useStripProcessing( bool b )
+{
+    useStripProcessing_ = b;
+}
+
+bool ImageFilters::useStripProcessing()
+{
+    return useStripProcessing_;
+}
+
+/***************************************************************************//**
+Returns the thread pool (still owned by the ImageFilters) that the strips are
+processed on, so that other stages can share its worker threads.
+*******************************************************************************/
+blobUtils::WorkStealingPool * ImageFilters::stripPool()
+{
+    return stripPool_;
+}
+
+/***************************************************************************//**
+Turns the fused point-wise pass on or off.  When on (the default), the mask,
+background, and normalization filters are applied in a single pass over the
+pixels, which also takes in the amplify and threshold steps whenever the 
+highpass and smoothing filters are turned off (see FusedPointwiseFilter).  
+The output is the same either way.
+*******************************************************************************/
+void ImageFilters::useFusedFilters( bool b )
+{
+    useFusedFilters_ = b;
+}
+
+bool ImageFilters::useFusedFilters()
+{
+    return useFusedFilters_;
+}
+
+/***************************************************************************//**
+Turns the bit-packed output on or off.  When on (the default), the threshold 
+step writes the tracked image one bit per pixel (see trackedBits()), which is
+what the blob finder reads, and the 8-bit tracked image is only written when
+its display tap is due.  The blobs are the same either way.
+*******************************************************************************/
+void ImageFilters::usePackedOutput( bool b )
+{
+    usePackedOutput_ = b;
+}
+
+bool ImageFilters::usePackedOutput()
+{
+    return usePackedOutput_;
+}
+
+/***************************************************************************//**
+Turns keeping the image that the threshold step reads (see signalBuffer()) on
+or off.  It is always there when the whole-image filters are used, but the 
+fused pass and the strips only hold it a row or a strip at a time, so when 
+this is on, they also copy it into a buffer of its own.
+*******************************************************************************/
+void ImageFilters::keepSignalImage( bool b )
+{
+    keepSignalImage_ = b;
+}
+
+bool ImageFilters::keepSignalImage()
+{
+    return keepSignalImage_;
+}
+
+/***************************************************************************//**
+When false, the fused pass skips writing the intermediate filter images that 
+are only used for display, whether or not they have display taps.  The 
+headless engine turns this off.
+*******************************************************************************/
+void ImageFilters::writeFilterImages( bool b )
+{
+    fusedPointwiseFilter_->setWriteFilterImages( b );
+}
+
+bool ImageFilters::writeFilterImages()
+{
+    return fusedPointwiseFilter_->writeFilterImages();
+}
+
+/***************************************************************************//**
+True if the display-only image of the filter type has to be written for this
+frame: filter images are being written, and the image has a display tap that
+is due (see DisplayTaps).
+*******************************************************************************/
+bool ImageFilters::writeFilterImage( blobEnums::FilterEnum::Enum filterType )
+{
+    return writeFilterImages() && displayTaps_->isDue( filterType );
+}
+
+/***************************************************************************//**
+The subscriptions to the filter images.  Widgets that show a filter image 
+subscribe to it while they can be seen.
+*******************************************************************************/
+blobFilters::DisplayTaps * ImageFilters::displayTaps()
+{
+    return displayTaps_;
+}
+
+/***************************************************************************//**
+The fused pass is timed as the background filter (it is mostly the background
+subtraction), since the filters that it takes in cannot be timed apart.
+*******************************************************************************/
+void ImageFilters::applyFusedPointwiseFilter()
+{
+    blobUtils::StopWatch stopWatch;
+    prepareFiltersForRows();
+    fusedPointwiseFilter_->processRows( 0, bufferHeight_ );
+    backgroundFilter_->addRowsTime( stopWatch.elapsed() );
+    copyBackgroundImage();
+}
+
+bool ImageFilters::isFusedThroughThreshold()
+{
+    return useFusedFilters_ && fusedPointwiseFilter_->includesThreshold();
+}
+
+/***************************************************************************//**
+Runs the filter chain in two parallel passes over the strips.  The first pass
+(pre-background smoothing, mask, background, and normalization) only reads 
+neighbouring rows from the source image, so each strip just writes its own
+rows.  The second pass (both highpass filters, smoothing, and threshold) 
+needs the normalized rows around each strip, so it waits for the first pass
+to finish and then recomputes the halo rows it needs into per-strip scratch 
+images.
+
+Each strip times its own stages, and the per-filter average times in the 
+stats are the totals over the strips of a frame (so they add up to more than
+the total processing time when the strips run in parallel).
+*******************************************************************************/
+void ImageFilters::applyFilterChainInStrips()
+{
+    prepareFiltersForRows();
+    updateFilterStrips();
+    int numStrips = (int)filterStrips_.size();
+
+    stripPool_->parallelFor( numStrips, boost::bind( &ImageFilters::processSourceStrip, this, _1 ) );
+    copyBackgroundImage();
+
+    if( !isFusedThroughThreshold() ) {
+        stripPool_->parallelFor( numStrips, boost::bind( &ImageFilters::processHighpassStrip, this, _1 ) );
+    }
+    addStripTimes();
+}
+
+/***************************************************************************//**
+Adds up the time that each stage took over all of the strips, and counts it 
+as one call of that stage's filter.  The fused pass is counted as the 
+background filter (see applyFusedPointwiseFilter()).
+*******************************************************************************/
+void ImageFilters::addStripTimes()
+{
+    for( int node = FilterGraph::SOURCE_NODE + 1; node < FilterGraph::NUMBER_OF_NODES; ++node ) {
+        double seconds = 0.0;
+
+        for( size_t i = 0; i < filterStrips_.size(); ++i ) {
+            seconds += filterStrips_[i]->takeStageTime( (FilterGraph::Node)node );
+        }
+        if( seconds > 0.0 ) {
+            filterGraph_->stageFilter( (FilterGraph::Node)node )->addRowsTime( seconds );
+        }
+    }
+}
+
+/***************************************************************************//**
+Lets each filter set up its per-frame state before the frame is processed a 
+few rows at a time.
+*******************************************************************************/
+void ImageFilters::prepareFiltersForRows()
+{
+    preBackgroundSmoothingFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    maskFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    backgroundFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    signalNormalizationFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    highpassFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    highpassTwoFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    smoothingFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    thresholdFilter_->prepareRows( bufferWidth_, bufferHeight_ );
+    fusedPointwiseFilter_->prepareFrame();
+}
+
+/***************************************************************************//**
+Rebuilds the strips if the halo that they need has changed (the strips are 
+also thrown away whenever the image size changes).
+*******************************************************************************/
+void ImageFilters::updateFilterStrips()
+{
+    int highpassTwoRadius = highpassTwoFilter_->kernelRadius(),
+        smoothingRadius = smoothingFilter_->kernelRadius();
+
+    if( filterStrips_.empty() 
+        || stripHighpassTwoRadius_ != highpassTwoRadius 
+        || stripSmoothingRadius_ != smoothingRadius ) 
+    {
+        clearFilterStrips();
+        stripHighpassTwoRadius_ = highpassTwoRadius;
+        stripSmoothingRadius_ = smoothingRadius;
+        int stripRows = stripHeight();
+
+        for( int firstRow = 0; firstRow < bufferHeight_; firstRow += stripRows ) {
+            int endRow = std::min( firstRow + stripRows, bufferHeight_ );
+            filterStrips_.push_back( new FilterStrip( firstRow, 
+                                                      endRow, 
+                                                      bufferWidth_, 
+                                                      bufferHeight_, 
+                                                      highpassTwoRadius, 
+                                                      smoothingRadius ) );
+        }
+    }
+}
+
+void ImageFilters::clearFilterStrips()
+{
+    for( size_t i = 0; i < filterStrips_.size(); ++i ) {
+        delete filterStrips_[i];
+    }
+    filterStrips_.clear();
+}
+
+int ImageFilters::stripHeight()
+{
+    int haloRows = stripHighpassTwoRadius_ + stripSmoothingRadius_,
+        stripRows = STRIP_CACHE_BYTES / (STRIP_BYTES_PER_PIXEL * std::max( bufferWidth_, 1 ));
+    stripRows = std::max( stripRows, MIN_STRIP_ROWS );
+    stripRows = std::max( stripRows, 2 * haloRows );
+    return stripRows;
+}
+
+/***************************************************************************//**
+First pass: pre-background smoothing, mask, background, and normalization for
+the rows of one strip.  With the fused filter turned on, everything after the
+smoothing is one pass over the pixels, and that pass also finishes the chain
+(so there is no second pass) when the highpass and smoothing filters are off.
+*******************************************************************************/
+void ImageFilters::processSourceStrip( int index )
+{
+    FilterStrip * strip = filterStrips_[index];
+
+    processStageRows( preBackgroundSmoothingFilter_, FilterGraph::SMOOTHED_NODE, strip );
+
+    if( useFusedFilters_ ) {
+        blobUtils::StopWatch stopWatch;
+        fusedPointwiseFilter_->processRows( strip->firstRow(), strip->endRow() );
+        strip->addStageTime( FilterGraph::DIFF_NODE, stopWatch.elapsed() );
+    }
+    else {
+        processStageRows( maskFilter_, FilterGraph::MASKED_NODE, strip );
+        processStageRows( backgroundFilter_, FilterGraph::DIFF_NODE, strip );
+        processStageRows( signalNormalizationFilter_, FilterGraph::NORMALIZED_NODE, strip );
+    }
+}
+
+/***************************************************************************//**
+Second pass: both highpass filters, smoothing, and threshold for the rows of 
+one strip, skipping the stages that the filter graph has dropped.  The 
+highpass outputs (including the halo rows) go to the strip's scratch images,
+so the strip's own rows are only copied into the highpass buffers when they 
+have a display tap that is due, or when the tracked image is an alias of them.  When a 
+highpass filter is to show its blurred (subtraction) image, the blur is done
+once, the strip's rows of it are copied into the filter's blurred image for 
+display, and then it is turned into the highpass image in place.
+*******************************************************************************/
+void ImageFilters::processHighpassStrip( int index )
+{
+    FilterStrip * strip = filterStrips_[index];
+    int firstRow = strip->firstRow(),
+        endRow = strip->endRow(),
+        highpassFirstRow = strip->highpassFirstRow(),
+        highpassTwoFirstRow = strip->highpassTwoFirstRow();
+    blobUtils::StopWatch stopWatch;
+
+    // Row 0 of rowsM is image row highpassFirstRow, then highpassTwoFirstRow,
+    // then firstRow, as the halo needed by the later stages shrinks.
+    cv::Mat rowsM = nodeRows( FilterGraph::NORMALIZED_NODE, highpassFirstRow, strip->highpassEndRow() );
+
+    if( filterGraph_->isStageActive( FilterGraph::HIGHPASS_NODE ) ) {
+        cv::Mat highpassM = strip->highpassRowsM();
+        processHighpassRows( highpassFilter_, FilterEnum::HIGHPASS, FilterGraph::HIGHPASS_NODE, 
+                             rowsM, highpassM, highpassFirstRow, strip );
+        rowsM = highpassM;
+        strip->addStageTime( FilterGraph::HIGHPASS_NODE, stopWatch.restart() );
+    }
+    rowsM = rowsM.rowRange( highpassTwoFirstRow - highpassFirstRow, 
+                            strip->highpassTwoEndRow() - highpassFirstRow );
+
+    if( filterGraph_->isStageActive( FilterGraph::HIGHPASS_TWO_NODE ) ) {
+        cv::Mat highpassTwoM = strip->highpassTwoRowsM();
+        processHighpassRows( highpassTwoFilter_, FilterEnum::HIGHPASS_TWO, FilterGraph::HIGHPASS_TWO_NODE, 
+                             rowsM, highpassTwoM, highpassTwoFirstRow, strip );
+        rowsM = highpassTwoM;
+        strip->addStageTime( FilterGraph::HIGHPASS_TWO_NODE, stopWatch.restart() );
+    }
+    rowsM = rowsM.rowRange( firstRow - highpassTwoFirstRow, endRow - highpassTwoFirstRow );
+
+    if( filterGraph_->isStageActive( FilterGraph::SMOOTH_NODE ) ) {
+        cv::Mat smoothM = nodeRows( FilterGraph::SMOOTH_NODE, firstRow, endRow );
+        smoothingFilter_->processRows( rowsM, smoothM, firstRow );
+        rowsM = smoothM;
+        strip->addStageTime( FilterGraph::SMOOTH_NODE, stopWatch.restart() );
+    }
+    // With the threshold turned off, rowsM is the tracked image, and packing
+    // it sets its non-zero pixels.
+    if( keepSignalImage_ ) {
+        cv::Mat signalM = FilterStrip::imageRows( signalBufferCopy_, firstRow, endRow );
+        rowsM.copyTo( signalM );
+    }
+    stopWatch.start();
+
+    if( usePackedOutput_ ) {
+        thresholdFilter_->processRowsToBits( rowsM, trackedBits_, firstRow );
+    }
+    if( writeTrackedImage_ && filterGraph_->isStageActive( FilterGraph::TRACKED_NODE ) ) {
+        cv::Mat outputM = nodeRows( FilterGraph::TRACKED_NODE, firstRow, endRow );
+        thresholdFilter_->processRows( rowsM, outputM, firstRow );
+    }
+    strip->addStageTime( FilterGraph::TRACKED_NODE, stopWatch.elapsed() );
+}
+
+/***************************************************************************//**
+Runs one highpass filter over a strip's rows (from firstRow) into the strip's
+scratch image dstM, and writes the strip's own rows of the result to the 
+node's buffer if anything will look at them.
+*******************************************************************************/
+void ImageFilters::processHighpassRows( blobFilters::HighpassFilter * highpassFilter,
+                                        blobEnums::FilterEnum::Enum filterType,
+                                        FilterGraph::Node node,
+                                        cv::Mat & srcM, 
+                                        cv::Mat & dstM, 
+                                        int firstRow,
+                                        blobFilters::FilterStrip * strip )
+{
+    cv::Mat stripRowsM = dstM.rowRange( strip->firstRow() - firstRow, strip->endRow() - firstRow );
+
+    if( writeFilterImage( filterType ) && highpassFilter->showSubtractionImage() && highpassFilter->kernelRadius() > 0 ) {
+        cv::Mat blurredM = FilterStrip::imageRows( highpassFilter->blurredImage(), strip->firstRow(), strip->endRow() );
+        highpassFilter->blurRows( srcM, dstM );
+        stripRowsM.copyTo( blurredM );
+        highpassFilter->processBlurredRows( srcM, dstM );
+    }
+    else {
+        highpassFilter->processRows( srcM, dstM, firstRow );
+    }
+    if( writeFilterImage( filterType ) 
+        || filterGraph_->buffer( node ) == filterGraph_->buffer( FilterGraph::TRACKED_NODE ) ) 
+    {
+        cv::Mat nodeM = nodeRows( node, strip->firstRow(), strip->endRow() );
+        stripRowsM.copyTo( nodeM );
+    }
 }
 
 void ImageFilters::applyPreBackgroundSmoothingFilter()
 {
-    preBackgroundSmoothingFilter_->processImage( inputBuffer_, preBackgroundSmoothingBuffer_ );
+    applyStage( preBackgroundSmoothingFilter_, FilterGraph::SMOOTHED_NODE );
 }
 
 void ImageFilters::applyMaskFilter()
 {
-    maskFilter_->processImage( preBackgroundSmoothingBuffer_, preBackgroundSmoothingBuffer_ );
+    applyStage( maskFilter_, FilterGraph::MASKED_NODE );
 }
 
 void ImageFilters::applyBackgroundFilter()
 {
-    backgroundFilter_->processImage( preBackgroundSmoothingBuffer_, diffBuffer_ );
-    backgroundBufferCopy_->copyPixels( backgroundFilter_->backgroundImage() );
+    applyStage( backgroundFilter_, FilterGraph::DIFF_NODE );
+    copyBackgroundImage();
+}
+
+/***************************************************************************//**
+The background filter keeps its background as a 16-bit running average, so 
+the 8-bit background image is only made for display, when its display tap is
+due.
+*******************************************************************************/
+void ImageFilters::copyBackgroundImage()
+{
+    if( writeFilterImage( FilterEnum::BACKGROUND ) ) {
+        backgroundFilter_->copyBackgroundImage( backgroundBufferCopy_ );
+    }
 }
 
 void ImageFilters::applySignalNormalizationFilter()
 {
-    signalNormalizationFilter_->processImage( diffBuffer_, normalizeBuffer_ );
+    applyStage( signalNormalizationFilter_, FilterGraph::NORMALIZED_NODE );
 }
 
 void ImageFilters::applyHighpassFilter()
 {
-    highpassFilter_->processImage( normalizeBuffer_, highpassBuffer_ );
+    applyStage( highpassFilter_, FilterGraph::HIGHPASS_NODE );
 }
 
 void ImageFilters::applyHighpassTwoFilter()
 {
-    highpassTwoFilter_->processImage( highpassBuffer_, highpassTwoBuffer_ );
-
-    // Copy blurred (subtraction) image for display.
-    if( highpassFilter_->showSubtractionImage() ) {
-        highpassBuffer_->copyPixels( highpassFilter_->blurredImage() );
-    }
+    applyStage( highpassTwoFilter_, FilterGraph::HIGHPASS_TWO_NODE );
 }
 
 void ImageFilters::applySmoothingFilter()
 {
-    smoothingFilter_->processImage( highpassTwoBuffer_, smoothingBuffer_ );
-
-    // Copy blurred (subtraction) image for display.
-    if( highpassTwoFilter_->showSubtractionImage() ) {
-        highpassTwoBuffer_->copyPixels( highpassTwoFilter_->blurredImage() );
-    }
+    applyStage( smoothingFilter_, FilterGraph::SMOOTH_NODE );
 }
 
+/***************************************************************************//**
+With packed output, the threshold reads the image before the tracked node 
+(which is the tracked image itself when the threshold is turned off) and 
+writes the bits, and the 8-bit image only when it is to be displayed.
+*******************************************************************************/
 void ImageFilters::applyThresholdFilter()
 {
-    thresholdFilter_->processImage( smoothingBuffer_, grayOutputBuffer_ );
+    if( usePackedOutput_ ) {
+        blobBuffers::GrayBuffer * trackedImage = NULL;
+
+        if( writeTrackedImage_ && filterGraph_->isStageActive( FilterGraph::TRACKED_NODE ) ) {
+            trackedImage = filterGraph_->buffer( FilterGraph::TRACKED_NODE );
+        }
+        thresholdFilter_->processImageToBits( filterGraph_->inputBuffer( FilterGraph::TRACKED_NODE ),
+                                              trackedImage, 
+                                              trackedBits_ );
+    }
+    else {
+        applyStage( thresholdFilter_, FilterGraph::TRACKED_NODE );
+    }
 }
 
 blobStats::FilterStats * ImageFilters::calculateStats()
@@ -264,21 +892,17 @@ void ImageFilters::initializeBuffers( int width, int height )
     if( width > 0 && height > 0 ) {
         bufferWidth_ = width;
         bufferHeight_ = height;
+        bufferPool_->setSize( width, height );
         initializeFilterBuffers();
     }
 }
 
 void ImageFilters::initializeFilterBuffers()
 {
-    inputBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    preBackgroundSmoothingBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    backgroundBufferCopy_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    diffBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    normalizeBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    highpassBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    highpassTwoBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    smoothingBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
-    grayOutputBuffer_ = new blobBuffers::GrayBuffer( bufferWidth_, bufferHeight_ );
+    inputBuffer_ = bufferPool_->acquire();
+    backgroundBufferCopy_ = bufferPool_->acquire();
+    signalBufferCopy_ = bufferPool_->acquire();
+    trackedBits_ = new blobBuffers::BitBuffer( bufferWidth_, bufferHeight_ );
 }
 
 void ImageFilters::saveNextFrameAsBackground()
@@ -628,42 +1252,88 @@ int ImageFilters::imageThreshold()
     return thresholdFilter_->threshold();
 }
 
+/***************************************************************************//**
+The image to display for the filter type.  Images of stages that the filter 
+graph has dropped are the image of the stage before, and a highpass filter 
+that is to show its subtraction image returns its blurred image.
+*******************************************************************************/
 blobBuffers::GrayBuffer * ImageFilters::grayBuffer( blobEnums::FilterEnum::Enum filterType )
 {
     switch( filterType ) {
-        case FilterEnum::SOURCE:            return inputBuffer_;
-        case FilterEnum::PRE_BKGRD_SMOOTH:  return preBackgroundSmoothingBuffer_;
+        case FilterEnum::SOURCE:            return filterGraph_->buffer( FilterGraph::SOURCE_NODE );
+        case FilterEnum::PRE_BKGRD_SMOOTH:  return filterGraph_->buffer( FilterGraph::MASKED_NODE );
         case FilterEnum::BACKGROUND:        return backgroundBufferCopy_;
-        case FilterEnum::DIFF_BUFFER:       return diffBuffer_;
-        case FilterEnum::HIGHPASS:          return highpassBuffer_;
-        case FilterEnum::HIGHPASS_TWO:      return highpassTwoBuffer_;
-        case FilterEnum::SMOOTH:            return smoothingBuffer_;
-        case FilterEnum::TRACKED:           return grayOutputBuffer_;
+        case FilterEnum::DIFF_BUFFER:       return filterGraph_->buffer( FilterGraph::DIFF_NODE );
+        case FilterEnum::HIGHPASS:          return highpassDisplayBuffer( highpassFilter_, FilterGraph::HIGHPASS_NODE );
+        case FilterEnum::HIGHPASS_TWO:      return highpassDisplayBuffer( highpassTwoFilter_, FilterGraph::HIGHPASS_TWO_NODE );
+        case FilterEnum::SMOOTH:            return filterGraph_->buffer( FilterGraph::SMOOTH_NODE );
+        case FilterEnum::TRACKED:           return filterGraph_->buffer( FilterGraph::TRACKED_NODE );
     }
     return NULL;
 }
 
+blobBuffers::GrayBuffer * ImageFilters::highpassDisplayBuffer( blobFilters::HighpassFilter * highpassFilter,
+                                                               FilterGraph::Node node )
+{
+    if( highpassFilter->showSubtractionImage() && highpassFilter->kernelRadius() > 0 ) {
+        return highpassFilter->blurredImage();
+    }
+    return filterGraph_->buffer( node );
+}
+
 blobBuffers::GrayBuffer * ImageFilters::graySourceBuffer()
 {
-    return inputBuffer_;
+    return filterGraph_->buffer( FilterGraph::SOURCE_NODE );
 }
 
 blobBuffers::GrayBuffer * ImageFilters::grayOutputBuffer()
 {
-    return grayOutputBuffer_;
+    return filterGraph_->buffer( FilterGraph::TRACKED_NODE );
+}
+
+/***************************************************************************//**
+The bit-packed tracked image of the last frame, or NULL if packed output is 
+turned off (or no frame has been filtered yet).
+*******************************************************************************/
+blobBuffers::BitBuffer * ImageFilters::trackedBits()
+{
+    return usePackedOutput_ ? trackedBits_ : NULL;
 }
 
 blobBuffers::GrayBuffer * ImageFilters::differenceBuffer()
 {
-    return diffBuffer_;
+    return filterGraph_->buffer( FilterGraph::DIFF_NODE );
 }
 
 blobBuffers::GrayBuffer * ImageFilters::smoothedSourceBuffer()
 {
-    return preBackgroundSmoothingBuffer_;
+    return filterGraph_->buffer( FilterGraph::MASKED_NODE );
 }
 
+/***************************************************************************//**
+The 8-bit background image, brought up to date first, since it is otherwise 
+only written when its display tap is due.  For the calibration and signal 
+normalization code, which read the background outside the filter chain.
+*******************************************************************************/
 blobBuffers::GrayBuffer * ImageFilters::backgroundBuffer()
 {
+    backgroundFilter_->copyBackgroundImage( backgroundBufferCopy_ );
     return backgroundBufferCopy_;
 }
+
+/***************************************************************************//**
+The image that the threshold step read for the last frame (the pre-threshold 
+signal), which the ContourFinder can weight the blob centroids by, or NULL if
+keepSignalImage() is off.  The fused pass and the strips copy it into a 
+buffer of their own; otherwise it is the input of the tracked node.
+*******************************************************************************/
+blobBuffers::GrayBuffer * ImageFilters::signalBuffer()
+{
+    if( !keepSignalImage_ || bufferWidth_ == 0 ) {
+        return NULL;
+    }
+    if( useStripProcessing_ || isFusedThroughThreshold() ) {
+        return signalBufferCopy_;
+    }
+    return filterGraph_->inputBuffer( FilterGraph::TRACKED_NODE );
+}
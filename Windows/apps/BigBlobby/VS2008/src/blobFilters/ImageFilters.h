@@ -47,30 +47,61 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BLOBFILTERS_IMAGEFILTERS_H
 
 #include "blobEnums/FilterEnum.h"
+#include "blobFilters/FilterGraph.h"
+#include <opencv2/core/core.hpp>
+#include <vector>
 
 namespace blobBuffers { class GrayBuffer; }
+namespace blobBuffers { class BitBuffer; }
+namespace blobBuffers { class GrayBufferPool; }
 namespace blobBuffers { class BufferUtility; }
+namespace blobFilters { class BlobFilter; }
 namespace blobFilters { class BackgroundFilter; }
 namespace blobFilters { class SignalNormalizationFilter; }
 namespace blobFilters { class MaskFilter; }
 namespace blobFilters { class HighpassFilter; }
 namespace blobFilters { class SmoothingFilter; }
 namespace blobFilters { class ThresholdFilter; }
+namespace blobFilters { class FilterStrip; }
+namespace blobFilters { class FusedPointwiseFilter; }
+namespace blobFilters { class DisplayTaps; }
 namespace blobStats { class FilterStats; }
 namespace blobUtils { class FunctionTimer; }
+namespace blobUtils { class WorkStealingPool; }
 namespace blobNormalize { class CalibrationGridPoints; }
 namespace blobNormalize { class FishEyeGrid; }
+namespace blobVideo { class FrameSource; }
 
 namespace blobFilters
 {
     class ImageFilters
     {
     public:
+        static const int STRIP_CACHE_BYTES;
+        static const int STRIP_BYTES_PER_PIXEL;
+        static const int MIN_STRIP_ROWS;
+
         ImageFilters();
         virtual ~ImageFilters();
 
-        void processGrayscaleImage( unsigned char * grayPixels, int width, int height );
-        void processRgbImage( unsigned char * colorPixels, int width, int height );
+        void processFrame( blobVideo::FrameSource * frameSource );
+        void copyFrame( blobVideo::FrameSource * frameSource, blobBuffers::GrayBuffer * dstImage );
+        void processSourceBuffer( blobBuffers::GrayBuffer * sourceImage );
+
+        void useStripProcessing( bool b );
+        bool useStripProcessing();
+        blobUtils::WorkStealingPool * stripPool();
+        void useFusedFilters( bool b );
+        bool useFusedFilters();
+        void usePackedOutput( bool b );
+        bool usePackedOutput();
+        void keepSignalImage( bool b );
+        bool keepSignalImage();
+        void writeFilterImages( bool b );
+        bool writeFilterImages();
+        bool writeFilterImage( blobEnums::FilterEnum::Enum filterType );
+        blobFilters::DisplayTaps * displayTaps();
+        cv::Rect trackedRegion();
 
         blobStats::FilterStats * calculateStats();
         void saveNextFrameAsBackground();
@@ -154,41 +185,71 @@ namespace blobFilters
         blobBuffers::GrayBuffer * grayBuffer( blobEnums::FilterEnum::Enum filterType );
         blobBuffers::GrayBuffer * graySourceBuffer();
         blobBuffers::GrayBuffer * grayOutputBuffer();
+        blobBuffers::BitBuffer * trackedBits();
         blobBuffers::GrayBuffer * differenceBuffer();
         blobBuffers::GrayBuffer * smoothedSourceBuffer();
         blobBuffers::GrayBuffer * backgroundBuffer();
+        blobBuffers::GrayBuffer * signalBuffer();
 
     private:
         void clearBuffers();
         void clearFilterBuffers();
+        void releaseBuffer( blobBuffers::GrayBuffer * & buffer );
         void deleteTimers();
         void deleteFilters();
         void initializeBuffers( int width, int height );
         void initializeFilterBuffers();
 
-        void processImage( unsigned char * pixels, int width, int height, int channels );
-        void copyPixelsToInputBuffer( unsigned char * pixels, int width, int height, int channels );
+        blobBuffers::GrayBuffer * frameBuffer( blobVideo::FrameSource * frameSource );
+        void applyFilterChain( blobBuffers::GrayBuffer * sourceImage );
+        void updateFilterGraph( blobBuffers::GrayBuffer * sourceImage );
+        void updateFilterRegions();
+        void applyStage( blobFilters::BlobFilter * filter, blobFilters::FilterGraph::Node node );
+        void processStageRows( blobFilters::BlobFilter * filter, 
+                               blobFilters::FilterGraph::Node node, 
+                               blobFilters::FilterStrip * strip );
+        cv::Mat nodeRows( blobFilters::FilterGraph::Node node, int firstRow, int endRow );
+        blobBuffers::GrayBuffer * tappedBuffer( blobEnums::FilterEnum::Enum filterType, 
+                                                blobFilters::FilterGraph::Node node );
         void applyPreBackgroundSmoothingFilter();
         void applyMaskFilter();
         void applyBackgroundFilter();
+        void copyBackgroundImage();
         void applySignalNormalizationFilter();
         void applyHighpassFilter();
         void applyHighpassTwoFilter();
         void applySmoothingFilter();
         void applyThresholdFilter();
 
+        void applyFusedPointwiseFilter();
+        bool isFusedThroughThreshold();
+        void applyFilterChainInStrips();
+        void prepareFiltersForRows();
+        void updateFilterStrips();
+        void clearFilterStrips();
+        int stripHeight();
+        void processSourceStrip( int index );
+        void processHighpassStrip( int index );
+        void addStripTimes();
+        void processHighpassRows( blobFilters::HighpassFilter * highpassFilter,
+                                  blobEnums::FilterEnum::Enum filterType,
+                                  blobFilters::FilterGraph::Node node,
+                                  cv::Mat & srcM, 
+                                  cv::Mat & dstM, 
+                                  int firstRow,
+                                  blobFilters::FilterStrip * strip );
+        blobBuffers::GrayBuffer * highpassDisplayBuffer( blobFilters::HighpassFilter * highpassFilter,
+                                                         blobFilters::FilterGraph::Node node );
+
         int bufferWidth_,
             bufferHeight_;
 
         blobBuffers::GrayBuffer * inputBuffer_,
-                                * preBackgroundSmoothingBuffer_,
+                                * frameView_,
                                 * backgroundBufferCopy_,
-                                * diffBuffer_,
-                                * normalizeBuffer_,
-                                * highpassBuffer_,
-                                * highpassTwoBuffer_,
-                                * smoothingBuffer_,
-                                * grayOutputBuffer_;
+                                * signalBufferCopy_;
+        blobBuffers::GrayBufferPool * bufferPool_;
+        blobFilters::FilterGraph * filterGraph_;
 
         blobBuffers::BufferUtility * bufferUtility_;
         blobFilters::SmoothingFilter * preBackgroundSmoothingFilter_;
@@ -199,6 +260,19 @@ namespace blobFilters
         blobFilters::HighpassFilter * highpassTwoFilter_;
         blobFilters::SmoothingFilter * smoothingFilter_;
         blobFilters::ThresholdFilter * thresholdFilter_;
+        blobFilters::FusedPointwiseFilter * fusedPointwiseFilter_;
+        bool useFusedFilters_;
+        blobFilters::DisplayTaps * displayTaps_;
+        blobBuffers::BitBuffer * trackedBits_;
+        bool usePackedOutput_,
+             writeTrackedImage_,
+             keepSignalImage_;
+
+        bool useStripProcessing_;
+        blobUtils::WorkStealingPool * stripPool_;
+        std::vector<blobFilters::FilterStrip *> filterStrips_;
+        int stripHighpassTwoRadius_,
+            stripSmoothingRadius_;
 
         blobUtils::FunctionTimer * processTimer_,
                                  * copyCameraPixelsTimer_;
@@ -44,12 +44,15 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobFilters/MaskFilter.h"
+#include "blobFilters/MaskSpans.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobKernels/GrayKernels.h"
 #include "blobNormalize/CalibrationGridPoints.h"
 #include <opencv2/imgproc/imgproc.hpp>
 #include <iostream>
 
 using blobFilters::MaskFilter;
+using blobKernels::GrayKernels;
 
 MaskFilter::MaskFilter() :
   isActive_( false ),
@@ -57,6 +60,7 @@ MaskFilter::MaskFilter() :
   bufferHeight_( 0 ),
   calibrationMask_( NULL ),
   calibrationMaskM_( NULL ),
+  maskSpans_( new blobFilters::MaskSpans() ),
   calGridPoints_( NULL ),
   maskPoints_( NULL ),
   widthPadding_( 0 ),
@@ -68,6 +72,7 @@ MaskFilter::MaskFilter() :
 MaskFilter::~MaskFilter()
 {
     clear();
+    delete maskSpans_;
     delete calGridPoints_;
     delete maskPoints_;
 }
@@ -80,6 +85,7 @@ void MaskFilter::clear()
     delete calibrationMaskM_;
     calibrationMask_ = NULL;
     calibrationMaskM_ = NULL;
+    maskSpans_->clear();
 }
 
 void MaskFilter::process( blobBuffers::GrayBuffer * srcImage,
@@ -88,24 +94,69 @@ void MaskFilter::process( blobBuffers::GrayBuffer * srcImage,
     if( srcImage != NULL && srcImage->isSameWidthAndHeight( dstImage ) ) {
         int cols = srcImage->width(),
             rows = srcImage->height();
+        prepareRows( cols, rows );
 
-        if( bufferWidth_ != cols || bufferHeight_ != rows ) {
-            initialize( cols, rows );
-        }
-        if( needToUpdateMask_ ) {
-            updateCalibrationGridMask();
-            needToUpdateMask_ = false;
-        }
-        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), cols );
-        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), cols );
+        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), srcImage->stride() );
+        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), dstImage->stride() );
+        processRegion( srcM, dstM, 0 );
+    }
+}
 
-        if( isActive_ && maskPoints_ != NULL ) {
-            cv::multiply( srcM, *calibrationMaskM_, dstM );
-        }
-        else {
-            srcM.copyTo( dstM );
+void MaskFilter::prepareRows( int width, int height )
+{
+    if( bufferWidth_ != width || bufferHeight_ != height ) {
+        initialize( width, height );
+    }
+    if( needToUpdateMask_ ) {
+        updateCalibrationGridMask();
+        needToUpdateMask_ = false;
+    }
+}
+
+void MaskFilter::processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol )
+{
+    if( isActive_ && maskPoints_ != NULL ) {
+        cv::Mat maskM = calibrationMaskM_->rowRange( firstRow, firstRow + srcM.rows );
+
+        for( int row = 0; row < srcM.rows; ++row ) {
+            GrayKernels::mask( srcM.ptr<unsigned char>( row ), maskM.ptr<unsigned char>( row ) + firstCol,
+                               dstM.ptr<unsigned char>( row ), srcM.cols );
         }
     }
+    else {
+        srcM.copyTo( dstM );
+    }
+}
+
+bool MaskFilter::changesPixels()
+{
+    return isActive_ && maskPoints_ != NULL;
+}
+
+/***************************************************************************//**
+Returns the given row of the 0/1 mask, or NULL if the mask is turned off (or 
+there are no calibration points to build it from yet).  Only valid after 
+prepareRows() has been called for the current frame.
+*******************************************************************************/
+unsigned char * MaskFilter::maskRow( int row )
+{
+    if( isActive_ && maskPoints_ != NULL && calibrationMaskM_ != NULL ) {
+        return calibrationMaskM_->ptr<unsigned char>( row );
+    }
+    return NULL;
+}
+
+/***************************************************************************//**
+Returns the row spans of the mask, or NULL if the mask is turned off (in which
+case every pixel is live).  Only valid after prepareRows() has been called for 
+the current frame.
+*******************************************************************************/
+const blobFilters::MaskSpans * MaskFilter::activeSpans()
+{
+    if( isActive_ && maskPoints_ != NULL && maskSpans_->height() == bufferHeight_ ) {
+        return maskSpans_;
+    }
+    return NULL;
 }
 
 void MaskFilter::initialize( int width, int height )
@@ -117,7 +168,10 @@ void MaskFilter::initialize( int width, int height )
 
     int rows = bufferHeight_,
         cols = bufferWidth_;
-    calibrationMaskM_ = new cv::Mat( rows, cols, CV_8U, calibrationMask_->pixels(), cols );
+    calibrationMaskM_ = new cv::Mat( rows, cols, CV_8U, calibrationMask_->pixels(), calibrationMask_->stride() );
+
+    // The mask (and its spans) has to be generated again at the new size.
+    needToUpdateMask_ = (maskPoints_ != NULL);
 }
 
 void MaskFilter::setActive( bool active )
@@ -226,6 +280,7 @@ void MaskFilter::generateMask()
                 fillConvexPoly( row, col );
             }
         }
+        maskSpans_->build( calibrationMask_ );
     }
 }
 
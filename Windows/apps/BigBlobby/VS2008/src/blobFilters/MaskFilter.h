@@ -51,6 +51,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 namespace blobBuffers { class GrayBuffer; }
+namespace blobFilters { class MaskSpans; }
 namespace blobNormalize { class CalibrationGridPoints; }
 namespace cv { class Mat; }
 
@@ -63,8 +64,11 @@ namespace blobFilters
         virtual ~MaskFilter();
 
         void clear();
+        unsigned char * maskRow( int row );
+        const blobFilters::MaskSpans * activeSpans();
         virtual void process( blobBuffers::GrayBuffer * srcImage,
                               blobBuffers::GrayBuffer * dstImage );
+        virtual void prepareRows( int width, int height );
         void setActive( bool active );
         bool isActive();
         void setCalibrationGridPoints( blobNormalize::CalibrationGridPoints * calGridPoints );
@@ -73,6 +77,10 @@ namespace blobFilters
         void setHeightPadding( int pixels );
         int heightPadding();
 
+    protected:
+        virtual void processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol );
+        virtual bool changesPixels();
+
     private:
         void initialize( int width, int height );
         void updateCalibrationGridMask();
@@ -88,6 +96,7 @@ namespace blobFilters
             bufferHeight_;
         blobBuffers::GrayBuffer * calibrationMask_;
         cv::Mat * calibrationMaskM_;
+        blobFilters::MaskSpans * maskSpans_;
         blobNormalize::CalibrationGridPoints * calGridPoints_,
                                                * maskPoints_;
         int widthPadding_,
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+// MaskSpans
+//
+// PURPOSE: Row spans and bounding rectangle of the calibration mask, so the
+//          filters can skip the pixels outside of the touch surface.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobFilters/MaskSpans.h"
+#include "blobBuffers/GrayBuffer.h"
+#include <algorithm>
+
+using blobFilters::MaskSpans;
+
+MaskSpans::MaskSpans() :
+  width_( 0 ),
+  height_( 0 ),
+  spanStarts_(),
+  spanEnds_(),
+  roi_()
+{
+}
+
+MaskSpans::~MaskSpans()
+{
+}
+
+/***************************************************************************//**
+Finds the span of every row of the mask.  Only called when the mask changes.
+*******************************************************************************/
+void MaskSpans::build( const blobBuffers::GrayBuffer * mask )
+{
+    clear();
+
+    if( mask != NULL ) {
+        width_ = mask->width();
+        height_ = mask->height();
+        spanStarts_.assign( height_, 0 );
+        spanEnds_.assign( height_, 0 );
+        int left = width_,
+            right = 0,
+            top = height_,
+            bottom = 0;
+
+        for( int row = 0; row < height_; ++row ) {
+            const unsigned char * pixels = mask->row( row );
+            int start = 0,
+                end = width_;
+
+            while( start < end && pixels[start] == 0 ) {
+                ++start;
+            }
+            while( end > start && pixels[end - 1] == 0 ) {
+                --end;
+            }
+            if( start < end ) {
+                spanStarts_[row] = start;
+                spanEnds_[row] = end;
+                left = std::min( left, start );
+                right = std::max( right, end );
+                top = std::min( top, row );
+                bottom = row + 1;
+            }
+        }
+        if( left < right ) {
+            roi_ = cv::Rect( left, top, right - left, bottom - top );
+        }
+    }
+}
+
+void MaskSpans::clear()
+{
+    width_ = 0;
+    height_ = 0;
+    spanStarts_.clear();
+    spanEnds_.clear();
+    roi_ = cv::Rect();
+}
+
+int MaskSpans::width() const
+{
+    return width_;
+}
+
+int MaskSpans::height() const
+{
+    return height_;
+}
+
+int MaskSpans::spanStart( int row ) const
+{
+    return spanStarts_[row];
+}
+
+int MaskSpans::spanEnd( int row ) const
+{
+    return spanEnds_[row];
+}
+
+/***************************************************************************//**
+The bounding rectangle of the spans (empty if the mask is all zeros).
+*******************************************************************************/
+cv::Rect MaskSpans::roi() const
+{
+    return roi_;
+}
+
+/***************************************************************************//**
+The bounding rectangle grown by margin pixels on every side, and clipped to 
+the mask image.  A filter whose blur reaches margin pixels only changes the 
+pixels in this rectangle (given that its input is zero outside roi()).
+*******************************************************************************/
+cv::Rect MaskSpans::roi( int margin ) const
+{
+    if( roi_.area() == 0 ) {
+        return roi_;
+    }
+    cv::Rect grown( roi_.x - margin, roi_.y - margin, 
+                    roi_.width + 2 * margin, roi_.height + 2 * margin );
+    return grown & cv::Rect( 0, 0, width_, height_ );
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// MaskSpans
+//
+// PURPOSE: Row spans and bounding rectangle of the calibration mask, so the
+//          filters can skip the pixels outside of the touch surface.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBFILTERS_MASKSPANS_H
+#define BLOBFILTERS_MASKSPANS_H
+
+#include <opencv2/core/core.hpp>
+#include <vector>
+
+namespace blobBuffers { class GrayBuffer; }
+
+namespace blobFilters
+{
+    /***********************************************************************//**
+    For each row of a 0/1 mask image, the span [spanStart(), spanEnd()) from
+    the first to just past the last non-zero pixel (an empty span for a row
+    with no mask pixels), along with the bounding rectangle of all the spans.
+    The calibration grid mask has one span per row (the grid's outline is 
+    convex from left to right), so every pixel outside of the spans is masked
+    out.
+
+    Filters after the mask only need to work on the spans (or on the 
+    bounding rectangle, grown by how far their blur can spread a pixel), 
+    since everything else is zero.
+    ***************************************************************************/
+    class MaskSpans
+    {
+    public:
+        MaskSpans();
+        ~MaskSpans();
+
+        void build( const blobBuffers::GrayBuffer * mask );
+        void clear();
+        int width() const;
+        int height() const;
+        int spanStart( int row ) const;
+        int spanEnd( int row ) const;
+        cv::Rect roi() const;
+        cv::Rect roi( int margin ) const;
+
+    private:
+        int width_,
+            height_;
+        std::vector<int> spanStarts_,
+                         spanEnds_;
+        cv::Rect roi_;
+    };
+}
+
+#endif
@@ -50,22 +50,41 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobFilters/SignalNormalizationFilter.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobKernels/GrayKernels.h"
 #include "blobNormalize/FishEyeGrid.h"
+#include "blobUtils/WorkStealingPool.h"
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <boost/bind.hpp>
 #include <iostream>
 #include <iomanip>
 
 using blobFilters::SignalNormalizationFilter;
+using blobKernels::GrayKernels;
+
+// Gains are fixed point with 8 fractional bits, so a gain of 1.0 is 256.  The
+// normalization factors are between 1.0 and about 2.0, far below the largest
+// gain that GrayKernels::applyGain() accepts.
+const int SignalNormalizationFilter::GAIN_FRACTION_BITS = 8;
+const int SignalNormalizationFilter::MAX_GAIN = 0x7FFF;
 
 SignalNormalizationFilter::SignalNormalizationFilter() :
   isActive_( false ),
   bufferWidth_( 0 ),
   bufferHeight_( 0 ),
   fishEyeGrid_( NULL ),
-  temp32fMat_( NULL ),
-  normalization32fMat_( NULL ),
-  needToUpdateNormalization_( false )
+  threadPool_( NULL ),
+  gainMapM_( NULL ),
+  colCells_(),
+  rowCells_(),
+  colRunStarts_(),
+  rowRunStarts_(),
+  changedTiles_(),
+  colDeltas_(),
+  rowDeltas_(),
+  gridNormalizations_(),
+  needToUpdateNormalization_( false ),
+  needToUpdateCells_( true )
 {
 }
 
@@ -79,10 +98,8 @@ void SignalNormalizationFilter::clear()
 {
     bufferWidth_ = 0;
     bufferHeight_ = 0;
-    delete temp32fMat_;
-    delete normalization32fMat_;
-    temp32fMat_ = NULL;
-    normalization32fMat_ = NULL;
+    delete gainMapM_;
+    gainMapM_ = NULL;
 }
 
 void SignalNormalizationFilter::process( blobBuffers::GrayBuffer * srcImage,
@@ -91,26 +108,55 @@ void SignalNormalizationFilter::process( blobBuffers::GrayBuffer * srcImage,
     if( srcImage != NULL && srcImage->isSameWidthAndHeight( dstImage ) ) {
         int cols = srcImage->width(),
             rows = srcImage->height();
+        prepareRows( cols, rows );
 
-        if( bufferWidth_ != cols || bufferHeight_ != rows ) {
-            initialize( cols, rows );
-        }
-        if( needToUpdateNormalization_ ) {
-            updateNormalizationMatrix();
-            needToUpdateNormalization_ = false;
-        }
-        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), cols );
-        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), cols );
+        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), srcImage->stride() );
+        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), dstImage->stride() );
+        processRegion( srcM, dstM, 0 );
+    }
+}
 
-        if( isActive_ && fishEyeGrid_ != NULL ) {
-            srcM.convertTo( *temp32fMat_, CV_32F, 1.0 / 255.0 );
-            cv::multiply( *temp32fMat_, *normalization32fMat_, *temp32fMat_ );
-            temp32fMat_->convertTo( dstM, CV_8U, 255.0 );
-        }
-        else {
-            srcM.copyTo( dstM );
+void SignalNormalizationFilter::prepareRows( int width, int height )
+{
+    if( bufferWidth_ != width || bufferHeight_ != height ) {
+        initialize( width, height );
+    }
+    if( needToUpdateNormalization_ ) {
+        updateGainMap();
+        needToUpdateNormalization_ = false;
+    }
+}
+
+void SignalNormalizationFilter::processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol )
+{
+    if( isActive_ && fishEyeGrid_ != NULL ) {
+        for( int row = 0; row < srcM.rows; ++row ) {
+            GrayKernels::applyGain( srcM.ptr<unsigned char>( row ), 
+                                    gainMapM_->ptr<unsigned short>( firstRow + row ) + firstCol,
+                                    dstM.ptr<unsigned char>( row ), srcM.cols );
         }
     }
+    else {
+        srcM.copyTo( dstM );
+    }
+}
+
+bool SignalNormalizationFilter::changesPixels()
+{
+    return isActive_ && fishEyeGrid_ != NULL;
+}
+
+/***************************************************************************//**
+Returns the given row of fixed-point gains, or NULL if normalization is 
+turned off.  Only valid after prepareRows() has been called for the current
+frame.
+*******************************************************************************/
+unsigned short * SignalNormalizationFilter::gainRow( int row )
+{
+    if( isActive_ && fishEyeGrid_ != NULL && gainMapM_ != NULL ) {
+        return gainMapM_->ptr<unsigned short>( row );
+    }
+    return NULL;
 }
 
 void SignalNormalizationFilter::initialize( int width, int height )
@@ -121,28 +167,162 @@ void SignalNormalizationFilter::initialize( int width, int height )
 
     int rows = bufferHeight_,
         cols = bufferWidth_;
-    temp32fMat_ = new cv::Mat( rows, cols, CV_32F );
-    normalization32fMat_ = new cv::Mat( rows, cols, CV_32F );
+    gainMapM_ = new cv::Mat( rows, cols, CV_16U );
+
+    // The grid has to be rasterized again at the new size.
+    needToUpdateNormalization_ = (fishEyeGrid_ != NULL);
+    needToUpdateCells_ = true;
 }
 
-void SignalNormalizationFilter::updateNormalizationMatrix()
+/***************************************************************************//**
+Works out the gains of the FishEyeGrid cells that changed, one tile (the 
+pixels of one cell) per task on the thread pool (or all on this thread if 
+there is no pool).  The FishEyeGrid is only read and the tiles do not 
+overlap, so the tiles can be done at the same time.
+*******************************************************************************/
+void SignalNormalizationFilter::updateGainMap()
 {
-    if( fishEyeGrid_ != NULL && normalization32fMat_ != NULL ) {
-        int numRows = normalization32fMat_->rows,
-            numCols = normalization32fMat_->cols;
+    if( fishEyeGrid_ != NULL && gainMapM_ != NULL ) {
+        if( needToUpdateCells_ ) {
+            updatePixelCells();
+        }
+        findChangedTiles();
+        int numTiles = changedTiles_.size();
 
-        for( int row = 0; row < numRows; ++row ) {
-            for( int col = 0; col < numCols; ++col ) {
-                float x = (float)col,
-                      y = (float)row;
-                float intensityNorm = fishEyeGrid_->intensityNormalizationFactor( x, y );
-                normalization32fMat_->at<float>( row, col ) = intensityNorm;
+        if( threadPool_ != NULL ) {
+            threadPool_->parallelFor( numTiles, boost::bind( &SignalNormalizationFilter::updateGainTile, this, _1 ) );
+        }
+        else {
+            for( int i = 0; i < numTiles; ++i ) {
+                updateGainTile( i );
             }
         }
+        saveGridNormalizations();
         //debugPrintFishEyeGrid();
     }
 }
 
+/***************************************************************************//**
+Looks up the FishEyeGrid cell and delta of every column and row of the gain 
+map, and splits the columns and rows into runs that fall in the same cell.  
+Since every tile has to be filled after this, the saved grid normalizations
+are thrown away.
+*******************************************************************************/
+void SignalNormalizationFilter::updatePixelCells()
+{
+    fishEyeGrid_->cellColsAndDeltas( gainMapM_->cols, colCells_, colDeltas_ );
+    fishEyeGrid_->cellRowsAndDeltas( gainMapM_->rows, rowCells_, rowDeltas_ );
+    findRunStarts( colCells_, colRunStarts_ );
+    findRunStarts( rowCells_, rowRunStarts_ );
+    gridNormalizations_.clear();
+    needToUpdateCells_ = false;
+}
+
+/***************************************************************************//**
+Stores the index where each run of equal cell numbers starts, followed by the
+size of the list (so run i goes from runStarts[i] up to runStarts[i + 1]).
+*******************************************************************************/
+void SignalNormalizationFilter::findRunStarts( const std::vector<int> & cells, std::vector<int> & runStarts )
+{
+    int size = cells.size();
+    runStarts.clear();
+
+    for( int i = 0; i < size; ++i ) {
+        if( i == 0 || cells[i] != cells[i - 1] ) {
+            runStarts.push_back( i );
+        }
+    }
+    runStarts.push_back( size );
+}
+
+/***************************************************************************//**
+Lists the tiles (one run of rows by one run of columns) whose cell has a 
+corner that is different from when the gain map was last filled.
+*******************************************************************************/
+void SignalNormalizationFilter::findChangedTiles()
+{
+    int numRowRuns = rowRunStarts_.size() - 1,
+        numColRuns = colRunStarts_.size() - 1;
+    changedTiles_.clear();
+
+    for( int rowRun = 0; rowRun < numRowRuns; ++rowRun ) {
+        int row = rowCells_[rowRunStarts_[rowRun]];
+
+        for( int colRun = 0; colRun < numColRuns; ++colRun ) {
+            int col = colCells_[colRunStarts_[colRun]];
+
+            if( isCellChanged( row, col ) ) {
+                changedTiles_.push_back( rowRun * numColRuns + colRun );
+            }
+        }
+    }
+}
+
+bool SignalNormalizationFilter::isCellChanged( int row, int col )
+{
+    int numCols = fishEyeGrid_->numCols(),
+        index = (row * numCols) + col;
+
+    if( (int)gridNormalizations_.size() != fishEyeGrid_->numPoints() ) {
+        return true;
+    }
+    return gridNormalizations_[index] != fishEyeGrid_->intensityNormalization( row, col )
+        || gridNormalizations_[index + 1] != fishEyeGrid_->intensityNormalization( row, col + 1 )
+        || gridNormalizations_[index + numCols] != fishEyeGrid_->intensityNormalization( row + 1, col )
+        || gridNormalizations_[index + numCols + 1] != fishEyeGrid_->intensityNormalization( row + 1, col + 1 );
+}
+
+void SignalNormalizationFilter::saveGridNormalizations()
+{
+    int numRows = fishEyeGrid_->numRows(),
+        numCols = fishEyeGrid_->numCols();
+    gridNormalizations_.resize( numRows * numCols );
+
+    for( int row = 0; row < numRows; ++row ) {
+        for( int col = 0; col < numCols; ++col ) {
+            gridNormalizations_[(row * numCols) + col] = fishEyeGrid_->intensityNormalization( row, col );
+        }
+    }
+}
+
+/***************************************************************************//**
+Fills one changed tile with the same bilinear blend as 
+FishEyeGrid::intensityNormalizationFactor(), but with the cell corners and 
+the deltas already looked up.
+*******************************************************************************/
+void SignalNormalizationFilter::updateGainTile( int index )
+{
+    int numColRuns = colRunStarts_.size() - 1,
+        tile = changedTiles_[index],
+        rowRun = tile / numColRuns,
+        colRun = tile % numColRuns,
+        firstRow = rowRunStarts_[rowRun],
+        endRow = rowRunStarts_[rowRun + 1],
+        firstCol = colRunStarts_[colRun],
+        endCol = colRunStarts_[colRun + 1],
+        row = rowCells_[firstRow],
+        col = colCells_[firstCol];
+    float p0 = fishEyeGrid_->intensityNormalization( row, col ),
+          p1 = fishEyeGrid_->intensityNormalization( row, col + 1 ),
+          p2 = fishEyeGrid_->intensityNormalization( row + 1, col ),
+          p3 = fishEyeGrid_->intensityNormalization( row + 1, col + 1 ),
+          one = (float)(1 << GAIN_FRACTION_BITS);
+    const float * deltasX = &colDeltas_[0];
+
+    for( int y = firstRow; y < endRow; ++y ) {
+        unsigned short * gains = gainMapM_->ptr<unsigned short>( y );
+        float deltaY = rowDeltas_[y];
+
+        for( int x = firstCol; x < endCol; ++x ) {
+            float lowerEdge = p0 + deltasX[x] * (p1 - p0),
+                  higherEdge = p2 + deltasX[x] * (p3 - p2),
+                  intensityNorm = lowerEdge + deltaY * (higherEdge - lowerEdge);
+            int gain = (int)(intensityNorm * one + 0.5f);
+            gains[x] = (unsigned short)((gain < 0) ? 0 : ((gain > MAX_GAIN) ? MAX_GAIN : gain));
+        }
+    }
+}
+
 void SignalNormalizationFilter::setActive( bool active )
 {
     isActive_ = active;
@@ -153,9 +333,22 @@ bool SignalNormalizationFilter::isActive()
     return isActive_;
 }
 
+/***************************************************************************//**
+Sets the pool (not owned) used to work out the gain map when the FishEyeGrid
+changes.  Passing NULL does the work on the filter thread.
+*******************************************************************************/
+void SignalNormalizationFilter::setThreadPool( blobUtils::WorkStealingPool * threadPool )
+{
+    threadPool_ = threadPool;
+}
+
 void SignalNormalizationFilter::setFishEyeGrid( blobNormalize::FishEyeGrid * fishEyeGrid )
 {
     if( fishEyeGrid != NULL ) {
+        // Only the changed cells need filling if every pixel stays in its cell.
+        if( !fishEyeGrid->hasSameCells( fishEyeGrid_ ) ) {
+            needToUpdateCells_ = true;
+        }
         delete fishEyeGrid_;
         fishEyeGrid_ = fishEyeGrid;
         needToUpdateNormalization_ = true;
@@ -176,14 +369,14 @@ void SignalNormalizationFilter::debugPrintFishEyeGridDimensions()
 
 void SignalNormalizationFilter::debugPrintFishEyeGrid()
 {
-    if( normalization32fMat_ != NULL ) {
-        int numRows = normalization32fMat_->rows,
-            numCols = normalization32fMat_->cols;
+    if( gainMapM_ != NULL ) {
+        int numRows = gainMapM_->rows,
+            numCols = gainMapM_->cols;
         std::cout << "\nSignalNormalizationFilter::debugPrintFishEyeGrid()...\n\n";
 
         for( int row = 0; row < numRows; ++row ) {
             for( int col = 0; col < numCols; ++col ) {
-                float n = normalization32fMat_->at<float>( row, col );
+                float n = gainMapM_->at<unsigned short>( row, col ) / (float)(1 << GAIN_FRACTION_BITS);
                 std::cout << std::fixed << std::setprecision( 2 ) << n << "  ";
             }
             std::cout << "\n";
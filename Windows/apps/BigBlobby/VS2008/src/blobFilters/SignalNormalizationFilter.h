@@ -52,29 +52,60 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BLOBFILTERS_SIGNALNORMALIZATIONFILTER_H
 
 #include "blobFilters/BlobFilter.h"
+#include <vector>
 
 namespace blobBuffers { class GrayBuffer; }
 namespace blobNormalize { class FishEyeGrid; }
+namespace blobUtils { class WorkStealingPool; }
 namespace cv { class Mat; }
 
 namespace blobFilters
 {
+    /***********************************************************************//**
+    Multiplies each pixel by the intensity normalization factor from the 
+    FishEyeGrid (brightening the dimmer parts of the screen).  The factors are
+    kept as a map of 16-bit fixed-point gains with 8 fractional bits, which 
+    is worked out (on several threads, if a thread pool has been set) only
+    when the grid changes, and applied with an integer multiply and shift.
+
+    The gain map is filled one grid cell at a time.  The cell and delta of 
+    every pixel column and row are looked up once, so filling a cell is just
+    a bilinear blend of its four corners in a straight loop.  When a new grid
+    has the same cells as the last one (the usual case after the background
+    changes), only the cells with a corner whose factor changed are filled.
+    ***************************************************************************/
     class SignalNormalizationFilter : public BlobFilter
     {
     public:
+        static const int GAIN_FRACTION_BITS;
+        static const int MAX_GAIN;
+
         SignalNormalizationFilter();
         virtual ~SignalNormalizationFilter();
 
         void clear();
+        unsigned short * gainRow( int row );
         virtual void process( blobBuffers::GrayBuffer * srcImage,
                               blobBuffers::GrayBuffer * dstImage );
+        virtual void prepareRows( int width, int height );
         void setActive( bool active );
         bool isActive();
         void setFishEyeGrid( blobNormalize::FishEyeGrid * fishEyeGrid );
+        void setThreadPool( blobUtils::WorkStealingPool * threadPool );
+
+    protected:
+        virtual void processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol );
+        virtual bool changesPixels();
 
     private:
         void initialize( int width, int height );
-        void updateNormalizationMatrix();
+        void updateGainMap();
+        void updatePixelCells();
+        void findRunStarts( const std::vector<int> & cells, std::vector<int> & runStarts );
+        void findChangedTiles();
+        bool isCellChanged( int row, int col );
+        void saveGridNormalizations();
+        void updateGainTile( int index );
 
         void debugPrintFishEyeGridDimensions();
         void debugPrintFishEyeGrid();
@@ -83,9 +114,18 @@ namespace blobFilters
         int bufferWidth_,
             bufferHeight_;
         blobNormalize::FishEyeGrid * fishEyeGrid_;
-        cv::Mat * temp32fMat_,
-                * normalization32fMat_;
-        bool needToUpdateNormalization_;
+        blobUtils::WorkStealingPool * threadPool_;
+        cv::Mat * gainMapM_;
+        std::vector<int> colCells_,
+                         rowCells_,
+                         colRunStarts_,
+                         rowRunStarts_,
+                         changedTiles_;
+        std::vector<float> colDeltas_,
+                           rowDeltas_,
+                           gridNormalizations_;
+        bool needToUpdateNormalization_,
+             needToUpdateCells_;
     };
 }
 
@@ -43,6 +43,7 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobFilters/SmoothingFilter.h"
+#include "blobFilters/BoxFilter.h"
 #include "blobBuffers/GrayBuffer.h"
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
@@ -55,12 +56,14 @@ SmoothingFilter::SmoothingFilter() :
   blurSize_( 0 ),
   gaussianSigma_( 2.0 ),
   isActive_( false ),
-  useGaussianBlur_( false )
+  useGaussianBlur_( false ),
+  boxFilter_( new blobFilters::BoxFilter() )
 {
 }
 
 SmoothingFilter::~SmoothingFilter()
 {
+    delete boxFilter_;
 }
 
 void SmoothingFilter::process( blobBuffers::GrayBuffer * srcImage,
@@ -69,21 +72,39 @@ void SmoothingFilter::process( blobBuffers::GrayBuffer * srcImage,
     if( srcImage != NULL && srcImage->isSameWidthAndHeight( dstImage ) ) {
         int rows = srcImage->height(),
             cols = srcImage->width();
-        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), cols );
-        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), cols );
-
-        if( isActive_ && blurSize_ > 0 ) {
-            if( useGaussianBlur_ ) {
-                useGaussianBlur( srcM, dstM );
-            }
-            else {
-                useNormalizedBoxFilterBlur( srcM, dstM );
-            }
+        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), srcImage->stride() );
+        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), dstImage->stride() );
+        processRegion( srcM, dstM, 0 );
+    }
+}
+
+void SmoothingFilter::processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol )
+{
+    if( isActive_ && blurSize_ > 0 ) {
+        if( useGaussianBlur_ ) {
+            useGaussianBlur( srcM, dstM );
         }
         else {
-            srcM.copyTo( dstM );
+            useNormalizedBoxFilterBlur( srcM, dstM );
         }
     }
+    else {
+        srcM.copyTo( dstM );
+    }
+}
+
+bool SmoothingFilter::changesPixels()
+{
+    return kernelRadius() > 0;
+}
+
+/***************************************************************************//**
+Number of rows above and below a pixel that its output depends on (zero when
+the filter just copies its input).
+*******************************************************************************/
+int SmoothingFilter::kernelRadius()
+{
+    return (isActive_ && blurSize_ > 0) ? blurSize_ / 2 : 0;
 }
 
 void SmoothingFilter::useGaussianBlur( cv::Mat & srcM, cv::Mat & dstM )
@@ -94,8 +115,7 @@ void SmoothingFilter::useGaussianBlur( cv::Mat & srcM, cv::Mat & dstM )
 
 void SmoothingFilter::useNormalizedBoxFilterBlur( cv::Mat & srcM, cv::Mat & dstM )
 {
-    cv::Size kernelSize( blurSize_, blurSize_ );
-    cv::blur( srcM, dstM, kernelSize );
+    boxFilter_->blur( srcM, dstM );
 }
 
 void SmoothingFilter::setBlurSize( int blurSize )
@@ -103,6 +123,7 @@ void SmoothingFilter::setBlurSize( int blurSize )
     // The blur size for the box filter must be an odd number (or zero).
     requestedBlurSize_ = blurSize;
     blurSize_ = (blurSize > 0) ? (blurSize * 2 + 1) : 0;
+    boxFilter_->setRadius( blurSize_ / 2 );
 }
 
 int SmoothingFilter::blurSize()
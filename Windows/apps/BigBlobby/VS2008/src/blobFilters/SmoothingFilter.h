@@ -62,6 +62,7 @@ namespace blobFilters
         virtual void process( blobBuffers::GrayBuffer * srcImage,
                               blobBuffers::GrayBuffer * dstImage );
 
+        virtual int kernelRadius();
         void setBlurSize( int size );
         int blurSize();
         void setActive( bool active );
@@ -71,6 +72,10 @@ namespace blobFilters
         bool useGaussianBlur();
         double gaussianBlurSigma();
 
+    protected:
+        virtual void processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol );
+        virtual bool changesPixels();
+
     private:
         void useNormalizedBoxFilterBlur( cv::Mat & srcM, cv::Mat & dstM );
         void useGaussianBlur( cv::Mat & srcM, cv::Mat & dstM );
@@ -80,6 +85,7 @@ namespace blobFilters
         double gaussianSigma_;
         bool isActive_,
              useGaussianBlur_;
+        blobFilters::BoxFilter * boxFilter_;
     };
 }
 
@@ -44,11 +44,16 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobFilters/ThresholdFilter.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobBuffers/BitBuffer.h"
+#include "blobKernels/GrayKernels.h"
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include "blobUtils/FunctionTimer.h"
+#include <cstring>
 #include <iostream>
 
 using blobFilters::ThresholdFilter;
+using blobKernels::GrayKernels;
 
 ThresholdFilter::ThresholdFilter() :
   threshold_( 50 ),
@@ -67,21 +72,92 @@ void ThresholdFilter::process( blobBuffers::GrayBuffer * srcImage,
         int cols = srcImage->width(),
             rows = srcImage->height();
 
-        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), cols );
-        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), cols );
+        cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), srcImage->stride() );
+        cv::Mat dstM( rows, cols, CV_8U, dstImage->pixels(), dstImage->stride() );
+        processRegion( srcM, dstM, 0 );
+    }
+}
+
+void ThresholdFilter::processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol )
+{
+    if( isActive_ && threshold_ > 0 ) {
+        for( int row = 0; row < srcM.rows; ++row ) {
+            GrayKernels::threshold( srcM.ptr<unsigned char>( row ), dstM.ptr<unsigned char>( row ),
+                                    srcM.cols, threshold_ );
+        }
 
-        if( isActive_ && threshold_ > 0 ) {
-            cv::threshold( srcM, dstM, threshold_, 255.0, cv::THRESH_BINARY );
+        //int blockSize = 71;
+        //cv::adaptiveThreshold( srcM, dstM, 255.0, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, blockSize, -threshold_ );
+    }
+    else {
+        srcM.copyTo( dstM );
+    }
+}
+
+/***************************************************************************//**
+Thresholds the whole image into the bit-packed image, and also into dstImage
+unless it is NULL (the 8-bit image is only needed for display).  When the 
+threshold is turned off, every non-zero pixel is set, which is what the blob 
+finder would have seen in the 8-bit image.
+*******************************************************************************/
+void ThresholdFilter::processImageToBits( blobBuffers::GrayBuffer * srcImage,
+                                          blobBuffers::GrayBuffer * dstImage,
+                                          blobBuffers::BitBuffer * dstBits )
+{
+    if( srcImage != NULL && dstBits != NULL 
+        && srcImage->width() == dstBits->width() && srcImage->height() == dstBits->height() ) 
+    {
+        processTimer()->startTiming();
 
-            //int blockSize = 71;
-            //cv::adaptiveThreshold( srcM, dstM, 255.0, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, blockSize, -threshold_ );
+        if( dstImage != NULL ) {
+            process( srcImage, dstImage );
         }
-        else {
-            srcM.copyTo( dstM );
+        cv::Mat srcM( srcImage->height(), srcImage->width(), CV_8U, srcImage->pixels(), srcImage->stride() );
+        processRowsToBits( srcM, dstBits, 0 );
+        processTimer()->stopTiming();
+    }
+}
+
+/***************************************************************************//**
+Bit-packed version of processRows(): thresholds the part of the rows that is 
+inside the region into the rows of dstBits from firstRow on, and clears the
+bits everywhere else.  Like processRows(), it is not timed, so strips can be 
+done at the same time.
+*******************************************************************************/
+void ThresholdFilter::processRowsToBits( cv::Mat & srcM, blobBuffers::BitBuffer * dstBits, int firstRow )
+{
+    typedef blobBuffers::BitBuffer::Word Word;
+    const int BITS = blobBuffers::BitBuffer::BITS_PER_WORD;
+
+    cv::Rect rect = regionRect( srcM.rows, srcM.cols, firstRow );
+    int level = changesPixels() ? threshold_ : 0,
+        wordsPerRow = dstBits->wordsPerRow(),
+        firstWord = rect.x / BITS,
+        endWord = blobBuffers::BitBuffer::wordsForWidth( rect.x + rect.width ),
+        start = firstWord * BITS;
+
+    for( int row = 0; row < srcM.rows; ++row ) {
+        Word * bits = dstBits->row( firstRow + row );
+
+        if( row < rect.y || row >= rect.y + rect.height || rect.width <= 0 ) {
+            dstBits->zeroRow( firstRow + row );
+            continue;
         }
+        // The words are filled from the start of the word that holds the 
+        // region's first pixel, so the pixels before it are cleared again.
+        std::memset( bits, 0, firstWord * sizeof( Word ) );
+        GrayKernels::thresholdBits( srcM.ptr<unsigned char>( row ) + start, bits + firstWord, 
+                                    rect.x + rect.width - start, level );
+        bits[firstWord] &= ~(Word)0 << (rect.x % BITS);
+        std::memset( bits + endWord, 0, (wordsPerRow - endWord) * sizeof( Word ) );
     }
 }
 
+bool ThresholdFilter::changesPixels()
+{
+    return isActive_ && threshold_ > 0;
+}
+
 void ThresholdFilter::setThreshold( int level )
 {
     // A level of zero results in way too many false blobs, so don't allow.
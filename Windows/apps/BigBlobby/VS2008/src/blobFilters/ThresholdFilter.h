@@ -48,6 +48,8 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobFilters/BlobFilter.h"
 
 namespace blobBuffers { class GrayBuffer; }
+namespace blobBuffers { class BitBuffer; }
+namespace cv { class Mat; }
 
 namespace blobFilters
 {
@@ -59,12 +61,20 @@ namespace blobFilters
         
         virtual void process( blobBuffers::GrayBuffer * srcImage,
                               blobBuffers::GrayBuffer * dstImage );
+        void processImageToBits( blobBuffers::GrayBuffer * srcImage,
+                                 blobBuffers::GrayBuffer * dstImage,
+                                 blobBuffers::BitBuffer * dstBits );
+        void processRowsToBits( cv::Mat & srcM, blobBuffers::BitBuffer * dstBits, int firstRow );
 
         void setThreshold( int level );
         int threshold();
         void setActive( bool active );
         bool isActive();
 
+    protected:
+        virtual void processRowRange( cv::Mat & srcM, cv::Mat & dstM, int firstRow, int firstCol );
+        virtual bool changesPixels();
+
     private:
         int threshold_;
         bool isActive_;
@@ -2,8 +2,8 @@
 // BigBlobby
 //
 // PURPOSE:  Creates an instance of BlobMainWindow, a QMainWindow subclass,
-//           along with the timer that will control the frame rate for the
-//           camera images used for blob (fingertip) detection.
+//           along with the timer that will control how often the GUI is
+//           repainted.
 //
 // CREATED:  4/13/2011
 ////////////////////////////////////////////////////////////////////////////////
@@ -49,7 +49,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using blobGui::BigBlobby;
 
-const int BigBlobby::FPS = 125;
+const int BigBlobby::FPS = 60; // GUI repaints only (not camera frames).
 const double BigBlobby::FRAME_TIME_SECS = 1.0 / BigBlobby::FPS;
 
 /***************************************************************************//**
@@ -90,8 +90,9 @@ void BigBlobby::loadSettingsFromXmlFile()
 /***************************************************************************//**
 Connects the timer object to the frame() function and then starts the timer.
 The value of FRAME_TIME_SECS determines how often the frame() function will
-be called.  This function also starts the clock that will be used to calculate
-the actual time difference between function calls.
+be called, which only repaints the GUI with the latest processed frame.  This
+function also starts the clock that will be used to calculate the actual time
+difference between function calls.
 *******************************************************************************/
 void BigBlobby::setUpTimerForFrameCalls()
 {
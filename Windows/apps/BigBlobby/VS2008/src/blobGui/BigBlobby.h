@@ -2,8 +2,8 @@
 // BigBlobby
 //
 // PURPOSE:  Creates an instance of BlobMainWindow, a QMainWindow subclass,
-//           along with the timer that will control the frame rate for the
-//           camera images used for blob (fingertip) detection.
+//           along with the timer that will control how often the GUI is
+//           repainted.
 //
 // CREATED:  4/13/2011
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,9 +80,11 @@ namespace blobGui
 {
     /***********************************************************************//**
     Creates an instance of BlobMainWindow, a QMainWindow subclass, along with 
-    the timer that will control the frame rate for the camera images used for 
-    blob (fingertip) detection.  Before starting the timer, the function to
-    load settings from XML files should be called.
+    the timer that will control how often the GUI is repainted.  Camera images
+    are processed by the CoreVision vision thread as soon as they arrive, so 
+    the timer does not limit the blob (fingertip) detection frame rate.  Before
+    starting the timer, the function to load settings from XML files should be
+    called.
     ***************************************************************************/
     class BigBlobby : public QObject
     {
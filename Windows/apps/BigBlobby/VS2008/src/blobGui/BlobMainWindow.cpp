@@ -53,6 +53,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobGui/BlobSignalsToSlots.h"
 #include "blobGui/CustomZoomDialog.h"
 #include "blobGui/FactorySettingsDialog.h"
+#include "blobFilters/DisplayTaps.h"
 #include "blobExceptions/FileNotFoundException.h"
 #include "blobExceptions/BlobXmlReaderException.h"
 #include "blobExceptions/BlobParamsException.h"
@@ -239,6 +240,7 @@ determined in the CoreVision class, and should be about every one second.
 void BlobMainWindow::frame( double deltaFrameTime )
 {
     sourceGLWidget_->frame( deltaFrameTime );
+    updateDisplayTaps();
 
     if( needToCalibrate_ ) {
         calibrationGLWidget_->frame( deltaFrameTime );
@@ -270,6 +272,29 @@ bool BlobMainWindow::isAtLeastOneImageVisible()
     return (effectiveWidth > MIN_WIDTH_FOR_RENDERING) && !isMinimized();
 }
 
+/*******************************************************************************
+Lets each filter widget subscribe to its image only while it can be seen, so
+the vision thread does not write or copy filter images that nobody is 
+looking at (for example, while the window is minimized or the filter tabs
+are scrolled away).
+*******************************************************************************/
+void BlobMainWindow::updateDisplayTaps()
+{
+    bool isShowingImages = !needToCalibrate_ && isAtLeastOneImageVisible();
+
+    trackedGLWidget_->updateDisplayTap( isShowingImages );
+    preBkSmoothingGLWidget1_->updateDisplayTap( isShowingImages );
+    preBkSmoothingGLWidget2_->updateDisplayTap( isShowingImages );
+    backgroundGLWidget1_->updateDisplayTap( isShowingImages );
+    backgroundGLWidget2_->updateDisplayTap( isShowingImages );
+    highpassGLWidget1_->updateDisplayTap( isShowingImages );
+    highpassGLWidget2_->updateDisplayTap( isShowingImages );
+    highpassTwoGLWidget1_->updateDisplayTap( isShowingImages );
+    highpassTwoGLWidget2_->updateDisplayTap( isShowingImages );
+    smoothingGLWidget1_->updateDisplayTap( isShowingImages );
+    smoothingGLWidget2_->updateDisplayTap( isShowingImages );
+}
+
 void BlobMainWindow::displayFpsMessage()
 {
     // Update fps.
@@ -856,6 +881,7 @@ void BlobMainWindow::addTrackedGLWidget()
                                         sourceGLWidget_->getCoreVision(),
                                         blobEnums::FilterEnum::TRACKED );
     trackedGLWidget_->setHelpImage( image );
+    trackedGLWidget_->setPreviewRate( blobFilters::DisplayTaps::EVERY_FRAME );
     ui_.horizontalLayout_trackedImage->addWidget( trackedGLWidget_ );
 }
 
@@ -148,6 +148,7 @@ namespace blobGui
 
     private:
         bool isAtLeastOneImageVisible();
+        void updateDisplayTaps();
 
         void setWidgetColors();
         void setWidgetColor( QWidget * w, const QColor & color );
@@ -270,6 +270,21 @@ void BlobSignalsToSlots::connectBlobsMenu()
              SIGNAL( toggled( bool ) ),
              sourceGLWidget_,
              SLOT( useDarkBlobs( bool ) ) );
+
+    connect( mainWindowUi_->action_weightBlobCentroids,
+             SIGNAL( toggled( bool ) ),
+             sourceGLWidget_,
+             SLOT( useWeightedBlobCentroids( bool ) ) );
+
+    connect( mainWindowUi_->action_weightBlobAngles,
+             SIGNAL( toggled( bool ) ),
+             sourceGLWidget_,
+             SLOT( useWeightedBlobAngles( bool ) ) );
+
+    connect( mainWindowUi_->action_optimalBlobAssignment,
+             SIGNAL( toggled( bool ) ),
+             sourceGLWidget_,
+             SLOT( useOptimalBlobAssignment( bool ) ) );
 }
 
 void BlobSignalsToSlots::connectNetworkMenu()
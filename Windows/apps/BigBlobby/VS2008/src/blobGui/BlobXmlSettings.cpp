@@ -327,6 +327,9 @@ void BlobXmlSettings::quietlyUpdateBlobsMenu( blobIO::BlobParamsValidator * vali
     mainWindowUi_->action_showBlobBoundingBox->blockSignals( true );
     mainWindowUi_->action_showIdNumbers->blockSignals( true );
     mainWindowUi_->action_trackDarkBlobs->blockSignals( true );
+    mainWindowUi_->action_weightBlobCentroids->blockSignals( true );
+    mainWindowUi_->action_weightBlobAngles->blockSignals( true );
+    mainWindowUi_->action_optimalBlobAssignment->blockSignals( true );
 
     mainWindowUi_->action_showCalibrationWireframe->setChecked( validator->isShowCalibrationGridOn() );
     mainWindowUi_->action_showBlobAreas->setChecked( validator->isShowBlobAreasOn() );
@@ -336,6 +339,9 @@ void BlobXmlSettings::quietlyUpdateBlobsMenu( blobIO::BlobParamsValidator * vali
     mainWindowUi_->action_normalizeBlobIntensities->setChecked( validator->isNormalizeBlobIntensitiesOn() );
     mainWindowUi_->action_showIdNumbers->setChecked( validator->isShowBlobLabelsOn() );
     mainWindowUi_->action_trackDarkBlobs->setChecked( validator->useDarkBlobs() );
+    mainWindowUi_->action_weightBlobCentroids->setChecked( validator->useWeightedBlobCentroids() );
+    mainWindowUi_->action_weightBlobAngles->setChecked( validator->useWeightedBlobAngles() );
+    mainWindowUi_->action_optimalBlobAssignment->setChecked( validator->useOptimalBlobAssignment() );
 
     mainWindowUi_->action_showCalibrationWireframe->blockSignals( false );
     mainWindowUi_->action_showBlobAreas->blockSignals( false );
@@ -344,6 +350,9 @@ void BlobXmlSettings::quietlyUpdateBlobsMenu( blobIO::BlobParamsValidator * vali
     mainWindowUi_->action_showBlobBoundingBox->blockSignals( false );
     mainWindowUi_->action_showIdNumbers->blockSignals( false );
     mainWindowUi_->action_trackDarkBlobs->blockSignals( false );
+    mainWindowUi_->action_weightBlobCentroids->blockSignals( false );
+    mainWindowUi_->action_weightBlobAngles->blockSignals( false );
+    mainWindowUi_->action_optimalBlobAssignment->blockSignals( false );
 }
 
 /***************************************************************************//**
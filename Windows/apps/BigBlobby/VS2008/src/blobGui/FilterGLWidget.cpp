@@ -46,12 +46,15 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobGui/FilterGLWidget.h"
 #include "blobFilters/ImageFilters.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobCore/VisionFrame.h"
+#include "blobFilters/DisplayTaps.h"
 
 using blobGui::FilterGLWidget;
 using blobEnums::FilterEnum;
 
 const int FilterGLWidget::VIDEO_WIDTH = 320,
           FilterGLWidget::VIDEO_HEIGHT = 240;
+const double FilterGLWidget::PREVIEW_FRAMES_PER_SECOND = 15.0;
 
 /***************************************************************************//**
 The filterType argument will determine what image is rendered on the surface of
@@ -79,6 +82,8 @@ FilterGLWidget::FilterGLWidget( QWidget * parent,
   viewportHeight_( VIDEO_HEIGHT ),
   videoWidth_( VIDEO_WIDTH ),
   videoHeight_( VIDEO_HEIGHT ),
+  previewRate_( PREVIEW_FRAMES_PER_SECOND ),
+  displayTapId_( 0 ),
   showHelpImage_( false ),
   helpImage_(),
   helpTextureName_( 0 ),
@@ -90,21 +95,61 @@ FilterGLWidget::FilterGLWidget( QWidget * parent,
 
 FilterGLWidget::~FilterGLWidget()
 {
+    unsubscribeDisplayTap();
 }
 
 /***************************************************************************//**
 Calls on updateGL(), which will set up the OpenGL context and then call on 
-paintGL().  
+paintGL(), if the latest frame has a new copy of this widget's image (which 
+is only made at the preview rate, see setPreviewRate()).
 
 This function does not block.
 *******************************************************************************/
 void FilterGLWidget::frame( double deltaFrameTime )
 {
-    if( isVisible() ) {
+    if( isVisible() && coreVision_->latestFrame()->isNewImage( filterType_ ) ) {
         updateGL();
     }
 }
 
+/***************************************************************************//**
+Subscribes to this widget's filter image while the widget can actually be 
+seen, and unsubscribes when it cannot (its tab is not showing, it has been 
+scrolled out of view, or the window is not showing images at all).  Without
+a subscription, the filter chain does not write or copy the image for 
+display.  Should be called on every GUI frame.
+*******************************************************************************/
+void FilterGLWidget::updateDisplayTap( bool isWindowShowingImages )
+{
+    bool canBeSeen = isWindowShowingImages && isVisible() && !visibleRegion().isEmpty();
+
+    if( canBeSeen && displayTapId_ == 0 ) {
+        displayTapId_ = imageFilters_->displayTaps()->subscribe( filterType_, previewRate_ );
+    }
+    else if( !canBeSeen ) {
+        unsubscribeDisplayTap();
+    }
+}
+
+/***************************************************************************//**
+Sets how many times per second the image is refreshed while the widget can be 
+seen (the default is PREVIEW_FRAMES_PER_SECOND).  DisplayTaps::EVERY_FRAME 
+refreshes it on every camera frame.
+*******************************************************************************/
+void FilterGLWidget::setPreviewRate( double framesPerSecond )
+{
+    previewRate_ = framesPerSecond;
+    unsubscribeDisplayTap();
+}
+
+void FilterGLWidget::unsubscribeDisplayTap()
+{
+    if( displayTapId_ != 0 ) {
+        imageFilters_->displayTaps()->unsubscribe( displayTapId_ );
+        displayTapId_ = 0;
+    }
+}
+
 void FilterGLWidget::setHelpImage( QImage & helpImage )
 {
     helpImage_ = helpImage;
@@ -178,17 +223,18 @@ void FilterGLWidget::resizeGL( int viewportWidth, int viewportHeight )
 }
 
 /***************************************************************************//**
-Obtains the GrayBuffer corresponding to the filter type of this widget and
-renders it using an OpenGL Texture object.  If the filter type is TRACKED,
-then the CoreVision object will be asked to render blob ID numbers on top of 
-the filter image.  If requested, an image displaying help info can be drawn
-instead.
+Obtains the GrayBuffer corresponding to the filter type of this widget from the
+latest CoreVision frame and renders it using an OpenGL Texture object.  If the
+filter type is TRACKED, then the CoreVision object will be asked to render 
+blob ID numbers on top of the filter image.  If requested, an image displaying
+help info can be drawn instead.  The texture is only loaded from the GrayBuffer if the frame has a 
+new copy of the image; otherwise the last image loaded is drawn again.
 *******************************************************************************/
 void FilterGLWidget::paintGL()
 {
     glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
-    blobBuffers::GrayBuffer * grayBuffer = NULL;
-    grayBuffer = imageFilters_->grayBuffer( filterType_ );
+    blobCore::VisionFrame * latestFrame = coreVision_->latestFrame();
+    blobBuffers::GrayBuffer * grayBuffer = latestFrame->grayBuffer( filterType_ );
 
     if( grayBuffer != NULL ) {
         if( cameraSizeHasChanged( grayBuffer ) ) {
@@ -198,7 +244,7 @@ void FilterGLWidget::paintGL()
             drawHelpImage( grayBuffer->width(), grayBuffer->height() );
         }
         else {
-            drawFilterImage( grayBuffer );
+            drawFilterImage( grayBuffer, latestFrame->isNewImage( filterType_ ) );
         }
     }
 }
@@ -244,13 +290,13 @@ void FilterGLWidget::drawHelpImage( int width, int height )
 Rotates and translates the image to be drawn to account for OpenGL using 
 positive y as upwards, while Qt widgets use positive y as downwards.
 *******************************************************************************/
-void FilterGLWidget::drawFilterImage( blobBuffers::GrayBuffer * grayBuffer )
+void FilterGLWidget::drawFilterImage( blobBuffers::GrayBuffer * grayBuffer, bool isNewImage )
 {
     glMatrixMode( GL_MODELVIEW );
     glPushMatrix();
         glTranslatef( 0.0f, coreVision_->getVideoHeight(), 0.0f );
         glRotatef( 180.0f, 1.0f, 0.0f, 0.0f );
-        drawTexture( grayBuffer );
+        drawTexture( grayBuffer, isNewImage );
 
         if( filterType_ == FilterEnum::TRACKED ) {
             coreVision_->drawBlobIdNumbers();
@@ -259,20 +305,25 @@ void FilterGLWidget::drawFilterImage( blobBuffers::GrayBuffer * grayBuffer )
 }
 
 /*******************************************************************************
-Uses an OpenGL Texture object to render the GrayBuffer.
+Uses an OpenGL Texture object to render the GrayBuffer.  The pixels are only
+loaded into the texture if they are new (or the texture has just been made).
 *******************************************************************************/
-void FilterGLWidget::drawTexture( blobBuffers::GrayBuffer * grayBuffer )
+void FilterGLWidget::drawTexture( blobBuffers::GrayBuffer * grayBuffer, bool isNewImage )
 {
     int bufferWidth = grayBuffer->width(),
         bufferHeight = grayBuffer->height();
 
     if( bufferWidth != textureWidth_ || bufferHeight != textureHeight_ ) {
         initializeTexture( bufferWidth, bufferHeight );
+        isNewImage = true;
     }
     glEnable( GL_TEXTURE_2D );
         glBindTexture( GL_TEXTURE_2D, textureName_ );
-        glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, bufferWidth, bufferHeight,
-                         GL_LUMINANCE, GL_UNSIGNED_BYTE, grayBuffer->pixels() );
+
+        if( isNewImage ) {
+            glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, bufferWidth, bufferHeight,
+                             GL_LUMINANCE, GL_UNSIGNED_BYTE, grayBuffer->pixels() );
+        }
         glBegin( GL_QUADS );
             glTexCoord2f( 0, 0 );
             glVertex2f( 0, 0 );
@@ -80,6 +80,7 @@ namespace blobGui
     public:
         static const int VIDEO_WIDTH,
                          VIDEO_HEIGHT;
+        static const double PREVIEW_FRAMES_PER_SECOND;
 
         FilterGLWidget( QWidget * parent,
                           blobGui::SourceGLWidget * sourceGLWidget,
@@ -87,6 +88,8 @@ namespace blobGui
                           blobEnums::FilterEnum::Enum filterType );
         ~FilterGLWidget();
         void frame( double deltaFrameTime );
+        void updateDisplayTap( bool isWindowShowingImages );
+        void setPreviewRate( double framesPerSecond );
         void setHelpImage( QImage & helpImage );
         void showHelpImage( bool show );
 
@@ -98,8 +101,9 @@ namespace blobGui
     private:
         void initBackgroundColor();
         void drawHelpImage( int width, int height );
-        void drawFilterImage( blobBuffers::GrayBuffer * grayBuffer );
-        void drawTexture( blobBuffers::GrayBuffer * grayBuffer );
+        void drawFilterImage( blobBuffers::GrayBuffer * grayBuffer, bool isNewImage );
+        void drawTexture( blobBuffers::GrayBuffer * grayBuffer, bool isNewImage );
+        void unsubscribeDisplayTap();
         void initializeTexture( int width, int height );
         bool cameraSizeHasChanged( blobBuffers::GrayBuffer * grayBuffer );
         void debugPrintBackgroundColor();
@@ -119,6 +123,8 @@ namespace blobGui
             viewportHeight_,
             videoWidth_,
             videoHeight_;
+        double previewRate_;
+        int displayTapId_;
         bool showHelpImage_;
         QImage helpImage_;
         GLuint helpTextureName_;
@@ -47,6 +47,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobIO/BlobParamsValidator.h"
 #include "blobFilters/ImageFilters.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobCore/VisionFrame.h"
 #include "blobVideo/SimpleVideoWriter.h"
 #include <QPalette>
 #include <QColor>
@@ -93,6 +94,7 @@ SourceGLWidget::SourceGLWidget( QWidget * parent ) :
 
 SourceGLWidget::~SourceGLWidget()
 {
+    coreVision_.stopVisionThread();
     makeCurrent();
     coreVision_.clear();
 }
@@ -112,7 +114,8 @@ void SourceGLWidget::showHelpImage( bool show )
 }
 
 /***************************************************************************//**
-Asks the CoreVision object if the camera has a new frame.
+Asks the CoreVision object if the last repaint picked up a new frame from the 
+vision thread.
 *******************************************************************************/
 bool SourceGLWidget::hasNewFrame()
 {
@@ -172,11 +175,9 @@ info in the validator object given as an argument is copied over to a persistent
 validator object owned by this class, and the updateCoreVision_ boolean data
 member will be set to true.  That boolean value will be seen the next time the
 paintGL() function is called, and that is when the resetCoreVsion() function will
-be called to update all settings from the persistent validator object.  This
-approach was taken to avoid any potential threading issues.  By updating the
-settings as the first action within paintGL(), all settings are guaranteed to be
-set before the call to process the next image for blob detection and then render
-the new image.
+be called to update all settings from the persistent validator object.  The 
+settings are applied while holding the CoreVision vision mutex, so the vision 
+thread never processes a frame with only part of the new settings.
 *******************************************************************************/
 void SourceGLWidget::initializeCoreVisionParams( blobIO::BlobParamsValidator * validator )
 {
@@ -199,6 +200,7 @@ void SourceGLWidget::intitializeCoreVision()
     setVideoRate( paramsValidator_.getVideoRate() );
     setVideoWidth( paramsValidator_.getVideoWidth() );
     setVideoHeight( paramsValidator_.getVideoHeight() );
+    coreVision_.setSharedFrameRing( paramsValidator_.getSharedFrameRing() );
 
     resetCoreVision();
 
@@ -223,6 +225,9 @@ void SourceGLWidget::resetCoreVision()
     setMaxBlobSize( paramsValidator_.getMaxBlobSize() );
     setMaxNumberBlobs( paramsValidator_.getMaxNumberBlobs() );
     useDarkBlobs( paramsValidator_.useDarkBlobs() );
+    useWeightedBlobCentroids( paramsValidator_.useWeightedBlobCentroids() );
+    useWeightedBlobAngles( paramsValidator_.useWeightedBlobAngles() );
+    useOptimalBlobAssignment( paramsValidator_.useOptimalBlobAssignment() );
 
     showCalibrationWireframe( paramsValidator_.isShowCalibrationGridOn() );
     showBlobAreas( paramsValidator_.isShowBlobAreasOn() );
@@ -298,6 +303,7 @@ void SourceGLWidget::getCoreVisionParams( blobIO::BlobParamsValidator * validato
     validator->setVideoHeight( paramsValidator_.getVideoHeight() );
     validator->flipImageVertically( coreVision_.flipImageVertical() );
     validator->flipImageHorizontally( coreVision_.flipImageHorizontal() );
+    validator->setSharedFrameRing( coreVision_.getSharedFrameRing() );
 
     // Blobs unchecked setters
     validator->setImageThreshold( coreVision_.getImageThreshold() );
@@ -305,6 +311,9 @@ void SourceGLWidget::getCoreVisionParams( blobIO::BlobParamsValidator * validato
     validator->setMaxBlobSize( coreVision_.getMaxBlobSize() );
     validator->setMaxNumberBlobs( coreVision_.getMaxNumberBlobs() );
     validator->useDarkBlobs( imageFilters_->useDarkBlobs() );
+    validator->useWeightedBlobCentroids( coreVision_.useWeightedBlobCentroids() );
+    validator->useWeightedBlobAngles( coreVision_.useWeightedBlobAngles() );
+    validator->useOptimalBlobAssignment( coreVision_.useOptimalBlobAssignment() );
 
     validator->showCalibrationGrid( coreVision_.isShowCalibrationWireframeOn() );
     validator->showBlobAreas( coreVision_.isShowBlobAreasOn() );
@@ -408,6 +417,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setDeviceID( int id )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setDeviceID( id );
 }
 
@@ -416,6 +426,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setVideoRate( int rate )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setVideoRate( rate );
 }
 
@@ -424,6 +435,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setVideoWidth( int width )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setVideoWidth( width );
 }
 
@@ -432,6 +444,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setVideoHeight( int height )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setVideoHeight( height );
 }
 
@@ -440,6 +453,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::flipImageHorizontal( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.flipImageHorizontal( b );
 }
 
@@ -448,6 +462,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::flipImageVertical( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.flipImageVertical( b );
 }
 
@@ -516,6 +531,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setImageThreshold( int imageThreshold )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setImageThreshold( imageThreshold );
 }
 
@@ -524,6 +540,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setMinBlobSize( int min )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setMinBlobSize( min );
 }
 
@@ -532,6 +549,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setMaxBlobSize( int max )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setMaxBlobSize( max );
 }
 
@@ -540,6 +558,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setMaxNumberBlobs( int max )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setMaxNumberBlobs( max );
 }
 
@@ -548,14 +567,43 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::useDarkBlobs( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->useDarkBlobs( b );
 }
 
+/***************************************************************************//**
+Slot to call on CoreVision function of the same name.
+*******************************************************************************/
+void SourceGLWidget::useWeightedBlobCentroids( bool b )
+{
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
+    coreVision_.useWeightedBlobCentroids( b );
+}
+
+/***************************************************************************//**
+Slot to call on CoreVision function of the same name.
+*******************************************************************************/
+void SourceGLWidget::useWeightedBlobAngles( bool b )
+{
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
+    coreVision_.useWeightedBlobAngles( b );
+}
+
+/***************************************************************************//**
+Slot to call on CoreVision function of the same name.
+*******************************************************************************/
+void SourceGLWidget::useOptimalBlobAssignment( bool b )
+{
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
+    coreVision_.useOptimalBlobAssignment( b );
+}
+
 /***************************************************************************//**
 Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::showBlobAreas( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.showBlobAreas( b );
 }
 
@@ -564,6 +612,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::showBlobOutlines( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.showBlobOutlines( b );
 }
 
@@ -572,6 +621,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::showBlobCrosshairs( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.showBlobCrosshairs( b );
 }
 /***************************************************************************//**
@@ -579,6 +629,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::showBlobBoundingBoxes( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.showBlobBoundingBoxes( b );
 }
 
@@ -587,6 +638,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::normalizeBlobIntensities( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setSignalNormalizationActive( b );
 }
 
@@ -595,6 +647,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::showBlobLabels( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.showBlobLabels( b );
 }
 
@@ -603,6 +656,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::showCalibrationWireframe( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.showCalibrationWireframe( b );
 }
 
@@ -611,6 +665,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::showCalibrationIntensities( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.showCalibrationIntensities( b );
 }
 
@@ -619,6 +674,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::correctForSignalVariation( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setSignalNormalizationActive( b );
 }
 
@@ -632,6 +688,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::learnBackground()
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.learnBackground();
 }
 
@@ -640,6 +697,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::useAutoBackground( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.useAutoBackground( b );
 }
 
@@ -648,6 +706,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setBackgroundLearnRate( float rate )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setBackgroundLearnRate( rate );
 }
 
@@ -656,6 +715,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setBackgroundLearnRate( int rate )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setBackgroundLearnRate( rate );
 }
 
@@ -664,6 +724,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::usePeriodicBackground( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->usePeriodicBackground( b );
     usePeriodicSubtraction_ = b;
 }
@@ -673,6 +734,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setPeriodicBackgroundSeconds( float t )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setPeriodicBackgroundSeconds( t );
 }
 
@@ -681,6 +743,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setPeriodicBackgroundSeconds( int t )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setPeriodicBackgroundSeconds( t );
 }
 
@@ -689,6 +752,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setPeriodicBackgroundPercent( float percent )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setPeriodicBackgroundPercent( percent );
 }
 
@@ -697,6 +761,7 @@ Slot to call on CoreVision function of the same name.
 *******************************************************************************/
 void SourceGLWidget::setPeriodicBackgroundPercent( int percent )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setPeriodicBackgroundPercent( percent );
 }
 
@@ -711,6 +776,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::usePreBkSmoothing( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setPreBackgroundSmoothingActive( b );
 }
 
@@ -719,6 +785,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setPreBkSmoothingBlur( int blur )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setPreBackgroundSmoothingBlurSize( blur );
 }
 
@@ -727,6 +794,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useGaussianPreBkSmoothing( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->useGaussianPreBackgroundSmoothing( b );
 }
 
@@ -735,21 +803,25 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setGaussianPreBkSmoothingSigma( double sigma )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setGaussianPreBackgroundSmoothingSigma( sigma );
 }
 
 void SourceGLWidget::useMask( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setMaskActive( b );
 }
 
 void SourceGLWidget::setMaskWidthPadding( int pixels )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setMaskWidthPadding( pixels );
 }
 
 void SourceGLWidget::setMaskHeightPadding( int pixels )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setMaskHeightPadding( pixels );
 }
 
@@ -758,6 +830,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useHighpass( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassActive( b );
 }
 
@@ -766,6 +839,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setHighpassBlur( int blur )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassBlurSize( blur );
 }
 
@@ -774,6 +848,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::showHighpassSubtractionImage( bool show )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->showHighpassSubtractionImage( show );
 }
 
@@ -782,6 +857,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useHighpassAmplify( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassAmplifyActive( b );
 }
 
@@ -790,6 +866,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setHighpassAmplifyLevel( int level )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassAmplifyLevel( level );
 }
 
@@ -798,6 +875,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useHighpassTwo( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassTwoActive( b );
 }
 
@@ -806,6 +884,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setHighpassTwoKernel( int size )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassTwoKernel( size );
 }
 
@@ -814,6 +893,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::showHighpassTwoSubtractionImage( bool show )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->showHighpassTwoSubtractionImage( show );
 }
 
@@ -822,6 +902,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useHighpassTwoAmplify( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassTwoAmplifyActive( b );
 }
 
@@ -830,6 +911,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setHighpassTwoAmplifyLevel( int amplify )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setHighpassTwoAmplifyLevel( amplify );
 }
 
@@ -838,6 +920,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useSmoothing( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setSmoothingActive( b );
 }
 
@@ -846,6 +929,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setSmoothingBlur( int blur )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setSmoothingBlurSize( blur );
 }
 
@@ -854,6 +938,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useGaussianSmoothing( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->useGaussianSmoothing( b );
 }
 
@@ -862,6 +947,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setGaussianSmoothingSigma( double sigma )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setGaussianSmoothingSigma( sigma );
 }
 
@@ -870,6 +956,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::useSmoothingAmplify( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setSmoothingAmplifyActive( b );
 }
 
@@ -878,6 +965,7 @@ Slot to call on ImageFilters function.
 *******************************************************************************/
 void SourceGLWidget::setSmoothingAmplifyLevel( int amplify )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     imageFilters_->setSmoothingAmplifyLevel( amplify );
 }
 
@@ -891,6 +979,7 @@ If arg is true, this slot calls on CoreVision function setUseTuioUdpChannelOne()
 *******************************************************************************/
 void SourceGLWidget::setNetworkSilentMode( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     //std::cout << "SourceGLWidget::setNetworkSilentMode(" << b << ") called.\n";
     coreVision_.setNetworkSilentMode( b );
 }
@@ -900,6 +989,7 @@ Calls on CoreVision to turn TUIO UDP channel 1 output on/off.
 *******************************************************************************/
 void SourceGLWidget::useTuioUdpChannelOne( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     debug_.printLn( "SourceGLWidget::useTuioUdpChannelOne(" + debug_.boolToStr( b ) + ")\n" );
     coreVision_.setUseTuioUdpChannelOne( b );
 }
@@ -909,6 +999,7 @@ Calls on CoreVision to turn TUIO UDP channel 2 output on/off.
 *******************************************************************************/
 void SourceGLWidget::useTuioUdpChannelTwo( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     debug_.printLn( "SourceGLWidget::useTuioUdpChannelTwo( " + debug_.boolToStr( b ) + " )\n" );
     coreVision_.setUseTuioUdpChannelTwo( b );
 }
@@ -918,6 +1009,7 @@ Calls on CoreVision to turn Flash XML output on/off.
 *******************************************************************************/
 void SourceGLWidget::useFlashXmlChannel( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     debug_.printLn( "SourceGLWidget::useFlashXmlChannel(" + debug_.boolToStr( b ) + ")\n" );
     coreVision_.setUseFlashXmlChannel( b );
 }
@@ -927,6 +1019,7 @@ If arg is true, this slot calls on CoreVision function setUseBinaryTcpChannel().
 *******************************************************************************/
 void SourceGLWidget::useBinaryTcpChannel( bool b )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     debug_.printLn( "SourceGLWidget::useBinaryTcpChannel(" + debug_.boolToStr( b ) + ")\n" );
     coreVision_.setUseBinaryTcpChannel( b );
 }
@@ -969,6 +1062,7 @@ Calls on the CoreVision class to set the TUIO profile used for TUIO UDP.
 *******************************************************************************/
 void SourceGLWidget::setTuioUdpProfile( blobEnums::TuioProfileEnum::Enum profile )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setTuioUdpProfile( profile );
 }
 
@@ -1010,6 +1104,7 @@ Calls on the CoreVision class to set the TUIO profile used for Flash XML.
 *******************************************************************************/
 void SourceGLWidget::setFlashXmlProfile( blobEnums::TuioProfileEnum::Enum profile )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setFlashXmlProfile( profile );
 }
 
@@ -1099,12 +1194,13 @@ void SourceGLWidget::resizeGL( int viewportWidth, int viewportHeight )
 }
 
 /***************************************************************************//**
-Calls on the CoreVision object to check if there is a new image from the camera.
-If so, it will be processed for blob detection and then the Source image will
-be rendered on this widget.<br />
+Picks up the latest frame published by the CoreVision vision thread and renders
+its Source image on this widget.  Blob detection itself runs on the vision 
+thread, so a slow repaint here never delays the TUIO output.<br />
 
 If new program settings have been loaded from an XML file, this function will
-reset the CoreVison object.
+reset the CoreVison object.  The vision thread is started after the first set
+of settings has been applied, so the camera opens with the requested size.
 
 WARNING:<br />
 This function should never be called directly.  Call on frame(), which will use
@@ -1116,14 +1212,17 @@ void SourceGLWidget::paintGL()
     glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
     if( initializeCoreVision_ ) {
+        blobCore::CoreVision::ScopedLock lock( coreVision_ );
         intitializeCoreVision(); // Use copy of validator to update CoreVision object.
         initializeCoreVision_ = false;
+        coreVision_.startVisionThread();
     }
     else if( updateCoreVision_ ) {
+        blobCore::CoreVision::ScopedLock lock( coreVision_ );
         resetCoreVision(); // Use copy of validator to update CoreVision object.
         updateCoreVision_ = false;
     }
-    coreVision_.update();
+    coreVision_.fetchLatestFrame();
 
     if( isVisible() && !isMinimized() ) {
         drawSourceImage();
@@ -1132,7 +1231,7 @@ void SourceGLWidget::paintGL()
 }
 
 /*******************************************************************************
-Obtains a copy of the source image from the ImageFilters object and renders it.
+Obtains the source image from the latest CoreVision frame and renders it.
 Then it has to call on the CoreVision object to render blob outlines if they
 have been requested.  Eventually, the blob outline info should be handed over
 to this class, which should do all of the OpenGL rendering.
@@ -1140,7 +1239,7 @@ to this class, which should do all of the OpenGL rendering.
 void SourceGLWidget::drawSourceImage()
 {
     blobBuffers::GrayBuffer * grayBuffer = NULL;
-    grayBuffer = imageFilters_->grayBuffer( FilterEnum::SOURCE );
+    grayBuffer = coreVision_.latestFrame()->grayBuffer( FilterEnum::SOURCE );
 
     if( grayBuffer != NULL ) {
         if( cameraSizeHasChanged( grayBuffer ) ) {
@@ -1351,6 +1450,7 @@ before it is killed off in the the BlobTracker::track() function.
 *******************************************************************************/
 void SourceGLWidget::setUnmatchedBlobFramesToSkip( int frames )
 {
+    blobCore::CoreVision::ScopedLock lock( coreVision_ );
     coreVision_.setUnmatchedBlobFramesToSkip( frames );
 }
 
@@ -87,7 +87,9 @@ namespace blobGui
     GUI.  Therefore, ideally, CoreVision should not know anything about the Qt 
     GUI.  For that reason, this class has a large number of public slots that 
     simply call on the CoreVision function of the same name (<i>i.e.</i>, slots 
-    are a Qt concept that CoreVision should not know about).
+    are a Qt concept that CoreVision should not know about).  Each of the 
+    setting slots holds a CoreVision::ScopedLock, so a setting never changes 
+    while the vision thread is in the middle of a frame.
     <br />
 
     Although CoreVision was written to be as separate as possible from the 
@@ -149,6 +151,9 @@ namespace blobGui
             void setMaxBlobSize( int max );
             void setMaxNumberBlobs( int max );
             void useDarkBlobs( bool b );
+            void useWeightedBlobCentroids( bool b );
+            void useWeightedBlobAngles( bool b );
+            void useOptimalBlobAssignment( bool b );
 
             void showBlobAreas( bool b );
             void showBlobOutlines( bool b );
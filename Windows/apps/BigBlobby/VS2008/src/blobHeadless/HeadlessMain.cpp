@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// HeadlessMain
+//
+// PURPOSE: Entry point for the headless BigBlobby tracker (no Qt GUI and
+//          no OpenGL).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobHeadless/HeadlessVision.h"
+#include "blobHeadless/TrackerBenchmark.h"
+#include "blobKernels/GrayKernels.h"
+#include <boost/thread/thread.hpp>
+#include <csignal>
+#include <iostream>
+
+/** @file */ 
+
+namespace
+{
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    void requestStop( int )
+    {
+        stopRequested = 1;
+    }
+}
+
+/***************************************************************************//**
+Loads the settings (from the XML file named on the command line, or else from 
+data/settings/DefaultBlobParams.xml) and then runs blob detection and TUIO 
+output until the process gets SIGINT or SIGTERM (Ctrl+C).  The frame rate and
+filter timings are printed about once a second.
+
+--weighted-centroids and --weighted-angles turn on the brightness weighting of
+the blob centroids and angles, and --optimal-assignment turns on the optimal
+matching of blob IDs, whatever the settings file says.
+
+With --benchmark-tracker as the only argument, the BlobTracker is timed on 
+synthetic touches instead (see TrackerBenchmark) and no camera is opened.
+ ******************************************************************************/
+int main( int argc, char *argv[] )
+{
+    if( argc > 1 && std::string( argv[1] ) == "--benchmark-tracker" ) {
+        blobHeadless::TrackerBenchmark trackerBenchmark;
+        trackerBenchmark.run( std::cout );
+        return 0;
+    }
+    std::string xmlFile = blobHeadless::HeadlessVision::DEFAULT_CONFIG_FILE;
+    bool useWeightedCentroids = false,
+         useWeightedAngles = false,
+         useOptimalAssignment = false;
+
+    for( int i = 1; i < argc; ++i ) {
+        std::string arg( argv[i] );
+
+        if(      arg == "--weighted-centroids" ) { useWeightedCentroids = true; }
+        else if( arg == "--weighted-angles" )    { useWeightedAngles = true; }
+        else if( arg == "--optimal-assignment" ) { useOptimalAssignment = true; }
+        else                                     { xmlFile = arg; }
+    }
+
+    std::signal( SIGINT, requestStop );
+    std::signal( SIGTERM, requestStop );
+
+    blobHeadless::HeadlessVision headlessVision;
+    headlessVision.loadSettingsFromXmlFile( xmlFile );
+
+    if( useWeightedCentroids ) {
+        headlessVision.useWeightedBlobCentroids( true );
+    }
+    if( useWeightedAngles ) {
+        headlessVision.useWeightedBlobAngles( true );
+    }
+    if( useOptimalAssignment ) {
+        headlessVision.useOptimalBlobAssignment( true );
+    }
+    headlessVision.start();
+    std::cout << "Image kernels: " 
+              << blobEnums::SimdEnum::convertToString( blobKernels::GrayKernels::instructionSet() ) << "\n"
+              << "BigBlobby headless tracker running (Ctrl+C to stop)...\n" << std::flush;
+
+    while( !stopRequested ) {
+        boost::this_thread::sleep_for( boost::chrono::milliseconds( 250 ) );
+        headlessVision.printStatsIfUpdated();
+    }
+    std::cout << "Stopping...\n" << std::flush;
+    headlessVision.stop();
+    return 0;
+}
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+// HeadlessTexture
+//
+// PURPOSE: Stands in for openFrameworks' ofTexture.cpp in the headless build,
+//          so that the tracker does not link (or need) libGL at run time.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "ofTexture.h"
+
+/** @file */ 
+
+/*******************************************************************************
+The ofxOpenCv images and ofVideoGrabber each own an ofTexture that they upload
+their pixels into when drawn.  Nothing is drawn in the headless build, so these
+definitions keep the texture's size and allocation state (which the images 
+check before uploading) but make no OpenGL calls.  ofTexture.cpp is left out
+of BigBlobbyHeadless.pro in favour of this file.
+*******************************************************************************/
+
+void ofEnableTextureEdgeHack()
+{
+}
+
+void ofDisableTectureEdgeHack()
+{
+}
+
+ofTexture::ofTexture()
+{
+    texData.bAllocated = false;
+    texData.textureName[0] = 0;
+    texData.textureID = 0;
+    texData.bFlipTexture = false;
+    texData.textureTarget = GL_TEXTURE_2D;
+    texData.glTypeInternal = 0;
+    texData.glType = 0;
+    texData.width = 0;
+    texData.height = 0;
+    texData.tex_w = 0;
+    texData.tex_h = 0;
+    texData.tex_t = 0;
+    texData.tex_u = 0;
+
+    resetAnchor();
+}
+
+ofTexture::ofTexture( const ofTexture & mom )
+{
+    texData = mom.texData;
+    anchor = mom.anchor;
+    bAnchorIsPct = mom.bAnchorIsPct;
+}
+
+ofTexture & ofTexture::operator=( const ofTexture & mom )
+{
+    texData = mom.texData;
+    anchor = mom.anchor;
+    bAnchorIsPct = mom.bAnchorIsPct;
+    return *this;
+}
+
+ofTexture::~ofTexture()
+{
+}
+
+bool ofTexture::bAllocated()
+{
+    return texData.bAllocated;
+}
+
+ofTextureData ofTexture::getTextureData()
+{
+    return texData;
+}
+
+void ofTexture::clear()
+{
+    texData.bAllocated = false;
+}
+
+void ofTexture::allocate( int w, int h, int internalGlDataType )
+{
+    allocate( w, h, internalGlDataType, false );
+}
+
+void ofTexture::allocate( int w, int h, int internalGlDataType, bool )
+{
+    texData.width = (float)w;
+    texData.height = (float)h;
+    texData.tex_w = (float)w;
+    texData.tex_h = (float)h;
+    texData.glTypeInternal = internalGlDataType;
+    texData.bAllocated = true;
+}
+
+void ofTexture::loadData( unsigned char *, int, int, int glDataType )
+{
+    texData.glType = glDataType;
+}
+
+void ofTexture::loadScreenData( int, int, int, int )
+{
+}
+
+void ofTexture::setAnchorPercent( float xPct, float yPct )
+{
+    anchor.x = xPct;
+    anchor.y = yPct;
+    bAnchorIsPct = true;
+}
+
+void ofTexture::setAnchorPoint( int x, int y )
+{
+    anchor.x = (float)x;
+    anchor.y = (float)y;
+    bAnchorIsPct = false;
+}
+
+void ofTexture::resetAnchor()
+{
+    anchor.x = 0;
+    anchor.y = 0;
+    bAnchorIsPct = false;
+}
+
+void ofTexture::bind()
+{
+}
+
+void ofTexture::unbind()
+{
+}
+
+void ofTexture::draw( float, float, float, float )
+{
+}
+
+void ofTexture::draw( float, float )
+{
+}
+
+float ofTexture::getHeight()
+{
+    return texData.height;
+}
+
+float ofTexture::getWidth()
+{
+    return texData.width;
+}
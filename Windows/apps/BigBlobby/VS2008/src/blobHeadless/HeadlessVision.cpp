@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+// HeadlessVision
+//
+// PURPOSE: Runs the CoreVision blob detection and TUIO output without the
+//          Qt GUI or OpenGL, using the same XML settings files as the GUI.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobHeadless/HeadlessVision.h"
+#include "blobIO/BlobParamsXmlReader.h"
+#include "blobIO/BlobParamsValidator.h"
+#include "blobFilters/ImageFilters.h"
+#include "blobExceptions/BlobException.h"
+#include "blobExceptions/UnknownXmlTagException.h"
+#include "blobExceptions/BlobParamsException.h"
+#include <iostream>
+
+using blobHeadless::HeadlessVision;
+using blobExceptions::BlobException;
+using blobExceptions::UnknownXmlTagException;
+using blobExceptions::BlobParamsException;
+
+const std::string HeadlessVision::DEFAULT_CONFIG_FILE( "data/settings/DefaultBlobParams.xml" );
+
+HeadlessVision::HeadlessVision() :
+  coreVision_(),
+  blobParamsXmlReader_( new blobIO::BlobParamsXmlReader() )
+{
+    // Nothing displays the intermediate filter images.
+    coreVision_.writeFilterImages( false );
+}
+
+HeadlessVision::~HeadlessVision()
+{
+    stop();
+    delete blobParamsXmlReader_;
+}
+
+/***************************************************************************//**
+Reads the settings from the XML file and applies them to the CoreVision object.
+Should be called once, before start().
+<br />
+
+ERROR HANDLING:<br />
+If the XML file is missing, corrupted, or has an unrecognized XML tag or an
+unacceptable value, the error is printed to the console, and the built-in
+default settings of the BlobParamsValidator class are used instead.
+*******************************************************************************/
+void HeadlessVision::loadSettingsFromXmlFile( const std::string & xmlFile )
+{
+    blobIO::BlobParamsValidator * validator = createValidator( xmlFile );
+
+    if( validator == NULL ) {
+        std::cerr << "Built-in default settings will be used instead of settings from\n'"
+                  << xmlFile << "'.\n\n";
+        validator = new blobIO::BlobParamsValidator();
+    }
+    applyCameraParams( validator );
+    applyBlobParams( validator );
+    applyBackgroundParams( validator );
+    applyFilterParams( validator );
+    applyNetworkParams( validator );
+    coreVision_.setUpBlobCalibration();
+    delete validator;
+}
+
+/***************************************************************************//**
+Overrides the setting from the XML file (see CoreVision function of the same 
+name).
+*******************************************************************************/
+void HeadlessVision::useWeightedBlobCentroids( bool b )
+{
+    coreVision_.useWeightedBlobCentroids( b );
+}
+
+/***************************************************************************//**
+Overrides the setting from the XML file (see CoreVision function of the same 
+name).
+*******************************************************************************/
+void HeadlessVision::useWeightedBlobAngles( bool b )
+{
+    coreVision_.useWeightedBlobAngles( b );
+}
+
+/***************************************************************************//**
+Overrides the setting from the XML file (see CoreVision function of the same 
+name).
+*******************************************************************************/
+void HeadlessVision::useOptimalBlobAssignment( bool b )
+{
+    coreVision_.useOptimalBlobAssignment( b );
+}
+
+blobIO::BlobParamsValidator * HeadlessVision::createValidator( const std::string & xmlFile )
+{
+    blobIO::BlobParamsValidator * validator = NULL;
+
+    try {
+        validator = blobParamsXmlReader_->read( xmlFile );
+    }
+    catch( BlobException e ) {
+        std::cerr << "Warning: " << e.getMessage() << "\n";
+    }
+    catch( ... ) {
+        std::cerr << "An unexpected error occurred while trying to read \n'" 
+                  << xmlFile << "'.\n";
+    }
+    printUnreportedExceptions();
+    return validator;
+}
+
+/***************************************************************************//**
+Prints the unknown tags and bad values that the reader skipped over (it uses
+the default value for those and keeps reading).
+*******************************************************************************/
+void HeadlessVision::printUnreportedExceptions()
+{
+    if( blobParamsXmlReader_->hasUnknownXmlTagExceptions() ) {
+        std::vector<UnknownXmlTagException> exceptions = blobParamsXmlReader_->unknownXmlTagExceptions();
+
+        for( size_t i = 0; i < exceptions.size(); ++i ) {
+            std::cerr << "Warning: " << exceptions[i].getMessage() 
+                      << " Unknown Tag = <" << exceptions[i].getTagName() << ">"
+                      << " Parent Tag = <" << exceptions[i].getParentTagName() << ">\n";
+        }
+    }
+    if( blobParamsXmlReader_->hasBlobParamsExceptions() ) {
+        std::vector<BlobParamsException> exceptions = blobParamsXmlReader_->blobParamsExceptions();
+
+        for( size_t i = 0; i < exceptions.size(); ++i ) {
+            std::cerr << "Warning: " << exceptions[i].getMessage() 
+                      << " Tag = <" << exceptions[i].getParamName() << ">"
+                      << " Expected value = " << exceptions[i].getExpectedValue()
+                      << " Actual value = " << exceptions[i].getParamValue() << "\n";
+        }
+    }
+}
+
+/***************************************************************************//**
+Starts the CoreVision vision thread, which opens the camera and starts 
+streaming TUIO.
+*******************************************************************************/
+void HeadlessVision::start()
+{
+    coreVision_.startVisionThread();
+}
+
+void HeadlessVision::stop()
+{
+    coreVision_.stopVisionThread();
+}
+
+bool HeadlessVision::isRunning()
+{
+    return coreVision_.isVisionThreadRunning();
+}
+
+/***************************************************************************//**
+Prints the frame rate and filter timings about once a second (whenever the 
+CoreVision object has updated them).
+*******************************************************************************/
+void HeadlessVision::printStatsIfUpdated()
+{
+    if( coreVision_.needToDisplayUpdatedFps() ) {
+        std::cout << coreVision_.getUpdatedFps() << "\n" << std::flush;
+    }
+}
+
+void HeadlessVision::applyCameraParams( blobIO::BlobParamsValidator * validator )
+{
+    coreVision_.setDeviceID( validator->getDeviceID() );
+    coreVision_.setVideoRate( validator->getVideoRate() );
+    coreVision_.setVideoWidth( validator->getVideoWidth() );
+    coreVision_.setVideoHeight( validator->getVideoHeight() );
+    coreVision_.flipImageHorizontal( validator->flipImageHorizontally() );
+    coreVision_.flipImageVertical( validator->flipImageVertically() );
+    coreVision_.setSharedFrameRing( validator->getSharedFrameRing() );
+}
+
+void HeadlessVision::applyBlobParams( blobIO::BlobParamsValidator * validator )
+{
+    blobFilters::ImageFilters * imageFilters = coreVision_.imageFilters();
+
+    coreVision_.setImageThreshold( validator->getImageThreshold() );
+    coreVision_.setMinBlobSize( validator->getMinBlobSize() );
+    coreVision_.setMaxBlobSize( validator->getMaxBlobSize() );
+    coreVision_.setMaxNumberBlobs( validator->getMaxNumberBlobs() );
+    imageFilters->useDarkBlobs( validator->useDarkBlobs() );
+    coreVision_.useWeightedBlobCentroids( validator->useWeightedBlobCentroids() );
+    coreVision_.useWeightedBlobAngles( validator->useWeightedBlobAngles() );
+    coreVision_.useOptimalBlobAssignment( validator->useOptimalBlobAssignment() );
+    imageFilters->setSignalNormalizationActive( validator->isNormalizeBlobIntensitiesOn() );
+}
+
+void HeadlessVision::applyBackgroundParams( blobIO::BlobParamsValidator * validator )
+{
+    blobFilters::ImageFilters * imageFilters = coreVision_.imageFilters();
+
+    coreVision_.learnBackground();
+    coreVision_.useAutoBackground( validator->useAutoBackground() );
+    coreVision_.setBackgroundLearnRate( validator->getBackgroundLearnRate() );
+    imageFilters->usePeriodicBackground( validator->usePeriodicBackground() );
+    imageFilters->setPeriodicBackgroundSeconds( validator->getPeriodicBackgroundSeconds() );
+    imageFilters->setPeriodicBackgroundPercent( validator->getPeriodicBackgroundPercent() );
+}
+
+void HeadlessVision::applyFilterParams( blobIO::BlobParamsValidator * validator )
+{
+    blobFilters::ImageFilters * imageFilters = coreVision_.imageFilters();
+
+    imageFilters->setPreBackgroundSmoothingActive( validator->usePreBkSmoothing() );
+    imageFilters->setPreBackgroundSmoothingBlurSize( validator->getPreBkSmoothingBlur() );
+    imageFilters->useGaussianPreBackgroundSmoothing( validator->useGaussianPreBkSmoothing() );
+    imageFilters->setGaussianPreBackgroundSmoothingSigma( validator->getGaussianPreBkSigma() );
+
+    imageFilters->setMaskActive( validator->useMask() );
+    imageFilters->setMaskWidthPadding( validator->getMaskWidthPadding() );
+    imageFilters->setMaskHeightPadding( validator->getMaskHeightPadding() );
+
+    imageFilters->setHighpassActive( validator->useHighpass() );
+    imageFilters->setHighpassBlurSize( validator->getHighpassBlur() );
+    imageFilters->setHighpassAmplifyActive( validator->useHighpassAmplify() );
+    imageFilters->setHighpassAmplifyLevel( validator->getHighpassAmplifyLevel() );
+
+    imageFilters->setHighpassTwoActive( validator->useHighpassTwo() );
+    imageFilters->setHighpassTwoKernel( validator->getHighpassTwoKernel() );
+    imageFilters->setHighpassTwoAmplifyActive( validator->useHighpassTwoAmplify() );
+    imageFilters->setHighpassTwoAmplifyLevel( validator->getHighpassTwoAmplifyLevel() );
+
+    imageFilters->setSmoothingActive( validator->useSmoothing() );
+    imageFilters->setSmoothingBlurSize( validator->getSmoothingBlur() );
+    imageFilters->useGaussianSmoothing( validator->useGaussianSmoothing() );
+    imageFilters->setGaussianSmoothingSigma( validator->getGaussianSigma() );
+    imageFilters->setSmoothingAmplifyActive( validator->useSmoothingAmplify() );
+    imageFilters->setSmoothingAmplifyLevel( validator->getSmoothingAmplifyLevel() );
+}
+
+/***************************************************************************//**
+setupTuio() only has an effect the first time it is called, so the channels
+and profiles are set first.
+*******************************************************************************/
+void HeadlessVision::applyNetworkParams( blobIO::BlobParamsValidator * validator )
+{
+    coreVision_.setNetworkSilentMode( validator->useNetworkSilentMode() );
+    coreVision_.setUseTuioUdpChannelOne( validator->useTuioUdpChannelOne() );
+    coreVision_.setUseTuioUdpChannelTwo( validator->useTuioUdpChannelTwo() );
+    coreVision_.setUseFlashXmlChannel( validator->useFlashXmlChannel() );
+    coreVision_.setUseBinaryTcpChannel( validator->useBinaryTcpChannel() );
+    coreVision_.setTuioUdpProfile( validator->getTuioUdpProfile() );
+    coreVision_.setFlashXmlProfile( validator->getFlashXmlProfile() );
+    coreVision_.setupTuio( validator->getLocalHost(),
+                           validator->getTuioUdpChannelOnePort(),
+                           validator->getTuioUdpChannelTwoPort(),
+                           validator->getFlashXmlChannelPort(),
+                           validator->getBinaryTcpChannelPort() );
+}
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// HeadlessVision
+//
+// PURPOSE: Runs the CoreVision blob detection and TUIO output without the
+//          Qt GUI or OpenGL, using the same XML settings files as the GUI.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBHEADLESS_HEADLESSVISION_H
+#define BLOBHEADLESS_HEADLESSVISION_H
+
+#include "blobCore/CoreVision.h"
+#include <string>
+
+namespace blobIO { class BlobParamsValidator; }
+namespace blobIO { class BlobParamsXmlReader; }
+
+/***************************************************************************//** 
+Contains the classes for running BigBlobby as a headless tracker (no GUI and no
+OpenGL), as on a touch table whose tracking computer has no display.
+*******************************************************************************/
+namespace blobHeadless
+{
+    /***********************************************************************//**
+    Loads the program settings with the same BlobParamsXmlReader and 
+    BlobParamsValidator used by the GUI, applies them to a CoreVision object
+    (the same way that blobGui::SourceGLWidget does), and then runs the 
+    CoreVision vision thread, which streams TUIO until stop() is called.
+    <br />
+
+    Errors in the XML file are printed to the console instead of being shown in
+    dialog boxes, and the built-in default settings are used if the file cannot
+    be read.  The calibration is loaded from the calibration.xml file written
+    by the GUI (the calibration routine needs a display, so it is not 
+    available here).
+    ***************************************************************************/
+    class HeadlessVision
+    {
+    public:
+        static const std::string DEFAULT_CONFIG_FILE;
+
+        HeadlessVision();
+        ~HeadlessVision();
+
+        void loadSettingsFromXmlFile( const std::string & xmlFile );
+        void useWeightedBlobCentroids( bool b );
+        void useWeightedBlobAngles( bool b );
+        void useOptimalBlobAssignment( bool b );
+        void start();
+        void stop();
+        bool isRunning();
+        void printStatsIfUpdated();
+
+    private:
+        blobIO::BlobParamsValidator * createValidator( const std::string & xmlFile );
+        void printUnreportedExceptions();
+        void applyCameraParams( blobIO::BlobParamsValidator * validator );
+        void applyBlobParams( blobIO::BlobParamsValidator * validator );
+        void applyBackgroundParams( blobIO::BlobParamsValidator * validator );
+        void applyFilterParams( blobIO::BlobParamsValidator * validator );
+        void applyNetworkParams( blobIO::BlobParamsValidator * validator );
+
+        blobCore::CoreVision coreVision_;
+        blobIO::BlobParamsXmlReader * blobParamsXmlReader_;
+    };
+}
+
+#endif
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////////////////
+// TrackerBenchmark
+//
+// PURPOSE: Times the BlobTracker on synthetic frames of many moving fingertips and
+//          counts the ID swaps, with greedy and with optimal matching.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobHeadless/TrackerBenchmark.h"
+#include "blobTracker/BlobTracker.h"
+#include "blobCalibration/CalibrationUtils.h"
+#include "blobUtils/StopWatch.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+using blobHeadless::TrackerBenchmark;
+
+// A 4:3 camera the size of those on our larger tables.
+const int TrackerBenchmark::CAMERA_WIDTH = 1280;
+const int TrackerBenchmark::CAMERA_HEIGHT = 960;
+const int TrackerBenchmark::WARM_UP_FRAMES = 30;
+const int TrackerBenchmark::TIMED_FRAMES = 300;
+
+// Pixels per frame.
+const float TrackerBenchmark::MAX_SPEED = 12.0f;
+const float TrackerBenchmark::JITTER = 1.5f;
+
+namespace
+{
+    const int NUMBERS_OF_FINGERS[] = { 1, 2, 10, 25, 50, 100, 200, 400 };
+    const int NUMBER_OF_CASES = sizeof( NUMBERS_OF_FINGERS ) / sizeof( NUMBERS_OF_FINGERS[0] );
+}
+
+TrackerBenchmark::TrackerBenchmark() :
+  calibrationUtils_( new CalibrationUtils() ),
+  fingers_(),
+  fingerOfBlob_(),
+  blobs_(),
+  randomState_( 12345 )
+{
+    // A plain 4 x 3 grid that maps the camera image onto the unit square.
+    rect2df screenBox( 0.0f, 0.0f, 1.0f, 1.0f );
+    calibrationUtils_->setCamRes( CAMERA_WIDTH, CAMERA_HEIGHT );
+    calibrationUtils_->setGrid( 4, 3 );
+    calibrationUtils_->setScreenBBox( screenBox );
+    calibrationUtils_->initCameraPoints( CAMERA_WIDTH, CAMERA_HEIGHT );
+    calibrationUtils_->calculateBox();
+}
+
+TrackerBenchmark::~TrackerBenchmark()
+{
+    delete calibrationUtils_;
+}
+
+void TrackerBenchmark::run( std::ostream & out )
+{
+    out << "BlobTracker benchmark: " << CAMERA_WIDTH << " x " << CAMERA_HEIGHT 
+        << " camera, " << TIMED_FRAMES << " frames per case\n\n"
+        << "           ------ greedy ------    ------ optimal -----\n"
+        << "fingers    us/frame   ID swaps    us/frame   ID swaps\n";
+
+    for( int i = 0; i < NUMBER_OF_CASES; ++i ) {
+        out << std::setw( 7 ) << NUMBERS_OF_FINGERS[i];
+        runCase( NUMBERS_OF_FINGERS[i], false, out );
+        runCase( NUMBERS_OF_FINGERS[i], true, out );
+        out << "\n" << std::flush;
+    }
+}
+
+/***************************************************************************//**
+Tracks the same made-up fingers (the random numbers start over each time) with
+a new BlobTracker, and prints the time per frame and the number of ID swaps.
+*******************************************************************************/
+void TrackerBenchmark::runCase( int numFingers, bool useOptimalAssignment, std::ostream & out )
+{
+    blobTracker::BlobTracker blobTracker;
+    blobTracker.passInCalibration( calibrationUtils_ );
+    blobTracker.setMaxBlobDistance( CAMERA_WIDTH );
+    blobTracker.useOptimalAssignment( useOptimalAssignment );
+    randomState_ = 12345;
+    placeFingers( numFingers );
+
+    blobUtils::StopWatch stopWatch;
+    double seconds = 0.0;
+    int idSwaps = 0;
+
+    for( int frame = 0; frame < WARM_UP_FRAMES + TIMED_FRAMES; ++frame ) {
+        moveFingers();
+        makeBlobs();
+        stopWatch.start();
+        blobTracker.track( blobs_ );
+        double elapsed = stopWatch.elapsed();
+        int swaps = countIdSwaps();
+
+        if( frame >= WARM_UP_FRAMES ) {
+            seconds += elapsed;
+            idSwaps += swaps;
+        }
+    }
+    out << std::fixed << std::setprecision( 1 ) 
+        << std::setw( 12 ) << seconds * 1.0e6 / TIMED_FRAMES 
+        << std::setw( 11 ) << idSwaps;
+}
+
+void TrackerBenchmark::placeFingers( int numFingers )
+{
+    fingers_.resize( numFingers );
+
+    for( int i = 0; i < numFingers; ++i ) {
+        Finger & finger = fingers_[i];
+        finger.x = random( 0.0f, (float)CAMERA_WIDTH );
+        finger.y = random( 0.0f, (float)CAMERA_HEIGHT );
+        finger.dx = random( -MAX_SPEED, MAX_SPEED );
+        finger.dy = random( -MAX_SPEED, MAX_SPEED );
+        finger.trackedId = -1;
+    }
+}
+
+void TrackerBenchmark::moveFingers()
+{
+    int numFingers = fingers_.size();
+
+    for( int i = 0; i < numFingers; ++i ) {
+        Finger & finger = fingers_[i];
+        finger.x += finger.dx + random( -JITTER, JITTER );
+        finger.y += finger.dy + random( -JITTER, JITTER );
+
+        if( finger.x < 0.0f || finger.x >= CAMERA_WIDTH ) {
+            finger.dx = -finger.dx;
+            finger.x = (finger.x < 0.0f) ? -finger.x : 2.0f * (CAMERA_WIDTH - 1) - finger.x;
+        }
+        if( finger.y < 0.0f || finger.y >= CAMERA_HEIGHT ) {
+            finger.dy = -finger.dy;
+            finger.y = (finger.y < 0.0f) ? -finger.y : 2.0f * (CAMERA_HEIGHT - 1) - finger.y;
+        }
+    }
+}
+
+/***************************************************************************//**
+Makes a small round blob for each finger, in a shuffled order.
+*******************************************************************************/
+void TrackerBenchmark::makeBlobs()
+{
+    int numFingers = fingers_.size();
+    fingerOfBlob_.resize( numFingers );
+
+    for( int i = 0; i < numFingers; ++i ) {
+        fingerOfBlob_[i] = i;
+    }
+    for( int i = numFingers - 1; i > 0; --i ) {
+        std::swap( fingerOfBlob_[i], fingerOfBlob_[random( i + 1 )] );
+    }
+    blobs_.resize( numFingers );
+
+    for( int i = 0; i < numFingers; ++i ) {
+        const Finger & finger = fingers_[fingerOfBlob_[i]];
+        blobTracker::Blob & blob = blobs_[i];
+        blob = blobTracker::Blob();
+        blob.centroid.x = finger.x;
+        blob.centroid.y = finger.y;
+        blob.cameraCentroid = blob.centroid;
+        blob.area = 80.0f;
+        blob.boundingRect.x = finger.x - 5.0f;
+        blob.boundingRect.y = finger.y - 5.0f;
+        blob.boundingRect.width = 10.0f;
+        blob.boundingRect.height = 10.0f;
+    }
+}
+
+/***************************************************************************//**
+Counts the fingers whose blob got a different ID than in the last frame.  A 
+finger's first ID does not count as a swap.
+*******************************************************************************/
+int TrackerBenchmark::countIdSwaps()
+{
+    int numBlobs = blobs_.size(),
+        swaps = 0;
+
+    for( int i = 0; i < numBlobs; ++i ) {
+        Finger & finger = fingers_[fingerOfBlob_[i]];
+
+        if( finger.trackedId != -1 && finger.trackedId != blobs_[i].id ) {
+            ++swaps;
+        }
+        finger.trackedId = blobs_[i].id;
+    }
+    return swaps;
+}
+
+/***************************************************************************//**
+A small linear congruential generator, so every run (and both matching modes)
+sees exactly the same fingers.
+*******************************************************************************/
+float TrackerBenchmark::random( float low, float high )
+{
+    randomState_ = randomState_ * 1103515245u + 12345u;
+    return low + (high - low) * (float)((randomState_ >> 8) & 0xFFFFFF) / (float)0x1000000;
+}
+
+int TrackerBenchmark::random( int n )
+{
+    randomState_ = randomState_ * 1103515245u + 12345u;
+    return (int)((randomState_ >> 8) % (unsigned int)n);
+}
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+// TrackerBenchmark
+//
+// PURPOSE: Times the BlobTracker on synthetic frames of many moving fingertips and
+//          counts the ID swaps, with greedy and with optimal matching.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBHEADLESS_TRACKERBENCHMARK_H
+#define BLOBHEADLESS_TRACKERBENCHMARK_H
+
+#include "blobTracker/Blob.h"
+#include <iosfwd>
+#include <vector>
+
+class CalibrationUtils;
+
+namespace blobHeadless
+{
+    /***********************************************************************//**
+    Runs the BlobTracker on made-up frames, with no camera and no filters.  
+    Each frame, every simulated finger moves a few pixels (with some jitter)
+    and bounces off the edges of the image, and the blobs are handed to the 
+    tracker in a shuffled order, as the ContourFinder might give them.  For 
+    each number of fingers, run() prints the average time of 
+    BlobTracker::track() and the number of times a finger's ID changed (an 
+    ID swap), first with greedy matching and then with optimal assignment.
+    Run with "BigBlobbyHeadless --benchmark-tracker".
+    ***************************************************************************/
+    class TrackerBenchmark
+    {
+    public:
+        static const int CAMERA_WIDTH,
+                         CAMERA_HEIGHT,
+                         WARM_UP_FRAMES,
+                         TIMED_FRAMES;
+        static const float MAX_SPEED,
+                           JITTER;
+
+        TrackerBenchmark();
+        ~TrackerBenchmark();
+
+        void run( std::ostream & out );
+
+    private:
+        struct Finger
+        {
+            float x,
+                  y,
+                  dx,
+                  dy;
+            int trackedId;
+        };
+
+        void runCase( int numFingers, bool useOptimalAssignment, std::ostream & out );
+        void placeFingers( int numFingers );
+        void moveFingers();
+        void makeBlobs();
+        int countIdSwaps();
+        float random( float low, float high );
+        int random( int n );
+
+        // Not copyable.
+        TrackerBenchmark( const TrackerBenchmark & );
+        TrackerBenchmark & operator=( const TrackerBenchmark & );
+
+        CalibrationUtils * calibrationUtils_;
+        std::vector<Finger> fingers_;
+        std::vector<int> fingerOfBlob_;
+        std::vector<blobTracker::Blob> blobs_;
+        unsigned int randomState_;
+    };
+}
+
+#endif
@@ -104,6 +104,7 @@ void BlobParamsValidator::init()
     videoHeight_ = 240;
     flipImageVertically_ = false;
     flipImageHorizontally_ = true;
+    sharedFrameRing_ = "";
 
     // Blobs
     imageThreshold_ = 19;
@@ -111,6 +112,9 @@ void BlobParamsValidator::init()
     maxBlobSize_ = 200;
     maxNumberBlobs_ = 20;
     useDarkBlobs_ = false;
+    useWeightedBlobCentroids_ = false;
+    useWeightedBlobAngles_ = false;
+    useOptimalBlobAssignment_ = false;
 
     showCalibrationGrid_ = true;
     showBlobAreas_ = true;
@@ -190,6 +194,7 @@ BlobParamsValidator & BlobParamsValidator::operator=( const BlobParamsValidator
         videoHeight_ = rhs.videoHeight_;
         flipImageVertically_ = rhs.flipImageVertically_;
         flipImageHorizontally_ = rhs.flipImageHorizontally_;
+        sharedFrameRing_ = rhs.sharedFrameRing_;
 
         // Blobs
         imageThreshold_ = rhs.imageThreshold_;
@@ -197,6 +202,9 @@ BlobParamsValidator & BlobParamsValidator::operator=( const BlobParamsValidator
         maxBlobSize_ = rhs.maxBlobSize_;
         maxNumberBlobs_ = rhs.maxNumberBlobs_;
         useDarkBlobs_ = rhs.useDarkBlobs_;
+        useWeightedBlobCentroids_ = rhs.useWeightedBlobCentroids_;
+        useWeightedBlobAngles_ = rhs.useWeightedBlobAngles_;
+        useOptimalBlobAssignment_ = rhs.useOptimalBlobAssignment_;
 
         showCalibrationGrid_ = rhs.showCalibrationGrid_;
         showBlobAreas_ = rhs.showBlobAreas_;
@@ -399,6 +407,25 @@ void BlobParamsValidator::flipImageHorizontally( const QString & s )
     }
 }
 
+/***************************************************************************//**
+The name of a POSIX shared memory ring that another process writes camera 
+frames into, such as &quot;/bigblobby&quot; (a slash followed by a name with 
+no more slashes).  Empty (the default) means read frames from the camera.
+*******************************************************************************/
+void BlobParamsValidator::setSharedFrameRing( const QString & s )
+{
+    QString name( s.trimmed() );
+
+    if( name.size() > 0 && (name.size() < 2 || !name.startsWith( "/" ) || name.count( "/" ) > 1) ) {
+        throw BlobParamsException( "sharedFrameRing",
+                                   s.toStdString(),
+                                   "empty, or a slash followed by a name (such as /bigblobby)",
+                                   getBlobParamsXmlFilename(),
+                                   CLASS_NAME + "setSharedFrameRing()" );
+    }
+    sharedFrameRing_ = name.toStdString();
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 //                              Blobs Setters
@@ -499,6 +526,72 @@ void BlobParamsValidator::useDarkBlobs( const QString & s )
     }
 }
 
+/***************************************************************************//**
+Expects &quot;true&quot; or &quot;false&quot; as an argument (case insensitive).
+*******************************************************************************/
+void BlobParamsValidator::useWeightedBlobCentroids( const QString & s )
+{
+    QString b = s.trimmed().toLower();
+
+    if( b == "true" ) {
+        useWeightedBlobCentroids_ = true;
+    }
+    else if( b == "false" ) {
+        useWeightedBlobCentroids_ = false;
+    }
+    else {
+        throw BlobParamsException( "useWeightedCentroids",
+                                   s.toStdString(),
+                                   "true or false",
+                                   getBlobParamsXmlFilename(),
+                                   CLASS_NAME + "useWeightedBlobCentroids()" );
+    }
+}
+
+/***************************************************************************//**
+Expects &quot;true&quot; or &quot;false&quot; as an argument (case insensitive).
+*******************************************************************************/
+void BlobParamsValidator::useWeightedBlobAngles( const QString & s )
+{
+    QString b = s.trimmed().toLower();
+
+    if( b == "true" ) {
+        useWeightedBlobAngles_ = true;
+    }
+    else if( b == "false" ) {
+        useWeightedBlobAngles_ = false;
+    }
+    else {
+        throw BlobParamsException( "useWeightedAngles",
+                                   s.toStdString(),
+                                   "true or false",
+                                   getBlobParamsXmlFilename(),
+                                   CLASS_NAME + "useWeightedBlobAngles()" );
+    }
+}
+
+/***************************************************************************//**
+Expects &quot;true&quot; or &quot;false&quot; as an argument (case insensitive).
+*******************************************************************************/
+void BlobParamsValidator::useOptimalBlobAssignment( const QString & s )
+{
+    QString b = s.trimmed().toLower();
+
+    if( b == "true" ) {
+        useOptimalBlobAssignment_ = true;
+    }
+    else if( b == "false" ) {
+        useOptimalBlobAssignment_ = false;
+    }
+    else {
+        throw BlobParamsException( "useOptimalAssignment",
+                                   s.toStdString(),
+                                   "true or false",
+                                   getBlobParamsXmlFilename(),
+                                   CLASS_NAME + "useOptimalBlobAssignment()" );
+    }
+}
+
 /***************************************************************************//**
 Expects &quot;true&quot; or &quot;false&quot; as an argument (case insensitive).
 *******************************************************************************/
@@ -1553,6 +1646,7 @@ int BlobParamsValidator::getVideoWidth() { return videoWidth_; }
 int BlobParamsValidator::getVideoHeight() { return videoHeight_; }
 bool BlobParamsValidator::flipImageVertically() { return flipImageVertically_; }
 bool BlobParamsValidator::flipImageHorizontally() { return flipImageHorizontally_; }
+std::string BlobParamsValidator::getSharedFrameRing() { return sharedFrameRing_; }
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -1564,6 +1658,9 @@ int BlobParamsValidator::getMinBlobSize() { return minBlobSize_; }
 int BlobParamsValidator::getMaxBlobSize() { return maxBlobSize_; }
 int BlobParamsValidator::getMaxNumberBlobs() { return maxNumberBlobs_; }
 bool BlobParamsValidator::useDarkBlobs() { return useDarkBlobs_; }
+bool BlobParamsValidator::useWeightedBlobCentroids() { return useWeightedBlobCentroids_; }
+bool BlobParamsValidator::useWeightedBlobAngles() { return useWeightedBlobAngles_; }
+bool BlobParamsValidator::useOptimalBlobAssignment() { return useOptimalBlobAssignment_; }
 
 bool BlobParamsValidator::isShowCalibrationGridOn() { return showCalibrationGrid_; }
 bool BlobParamsValidator::isShowBlobAreasOn() { return showBlobAreas_; }
@@ -1666,6 +1763,7 @@ void BlobParamsValidator::setVideoWidth( int width ) { videoWidth_ = width; }
 void BlobParamsValidator::setVideoHeight( int height ) { videoHeight_ = height; }
 void BlobParamsValidator::flipImageVertically( bool b ) { flipImageVertically_ = b; }
 void BlobParamsValidator::flipImageHorizontally( bool b ) { flipImageHorizontally_ = b; }
+void BlobParamsValidator::setSharedFrameRing( const std::string & name ) { sharedFrameRing_ = name; }
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -1677,6 +1775,9 @@ void BlobParamsValidator::setMinBlobSize( int min ) { minBlobSize_ = min; }
 void BlobParamsValidator::setMaxBlobSize( int max ) { maxBlobSize_ = max; }
 void BlobParamsValidator::setMaxNumberBlobs( int max ) { maxNumberBlobs_ = max; }
 void BlobParamsValidator::useDarkBlobs( bool b ) { useDarkBlobs_ = b; }
+void BlobParamsValidator::useWeightedBlobCentroids( bool b ) { useWeightedBlobCentroids_ = b; }
+void BlobParamsValidator::useWeightedBlobAngles( bool b ) { useWeightedBlobAngles_ = b; }
+void BlobParamsValidator::useOptimalBlobAssignment( bool b ) { useOptimalBlobAssignment_ = b; }
 
 void BlobParamsValidator::showCalibrationGrid( bool b ) { showCalibrationGrid_ = b; }
 void BlobParamsValidator::showBlobAreas( bool b ) { showBlobAreas_ = b; }
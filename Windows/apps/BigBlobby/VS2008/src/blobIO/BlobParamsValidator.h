@@ -117,6 +117,7 @@ namespace blobIO
         void setVideoHeight( const QString & s );
         void flipImageVertically( const QString & s );
         void flipImageHorizontally( const QString & s );
+        void setSharedFrameRing( const QString & s );
 
         // Blobs Setters
         void setImageThreshold( const QString & s );
@@ -124,6 +125,9 @@ namespace blobIO
         void setMaxBlobSize( const QString & s );
         void setMaxNumberBlobs( const QString & s );
         void useDarkBlobs( const QString & s );
+        void useWeightedBlobCentroids( const QString & s );
+        void useWeightedBlobAngles( const QString & s );
+        void useOptimalBlobAssignment( const QString & s );
 
         void showCalibrationGrid( const QString & s );
         void showBlobAreas( const QString & s );
@@ -198,6 +202,7 @@ namespace blobIO
         int getVideoHeight();
         bool flipImageVertically();
         bool flipImageHorizontally();
+        std::string getSharedFrameRing();
 
         // Video Player Getters
         std::string getVideoFileName();
@@ -208,6 +213,9 @@ namespace blobIO
         int getMaxBlobSize();
         int getMaxNumberBlobs();
         bool useDarkBlobs();
+        bool useWeightedBlobCentroids();
+        bool useWeightedBlobAngles();
+        bool useOptimalBlobAssignment();
 
         bool isShowCalibrationGridOn();
         bool isShowBlobAreasOn();
@@ -284,6 +292,7 @@ namespace blobIO
         void setVideoHeight( int height );
         void flipImageVertically( bool b );
         void flipImageHorizontally( bool b );
+        void setSharedFrameRing( const std::string & name );
 
         // Blobs Unchecked Setters
         void setImageThreshold( int threshold );
@@ -291,6 +300,9 @@ namespace blobIO
         void setMaxBlobSize( int max );
         void setMaxNumberBlobs( int max );
         void useDarkBlobs( bool b );
+        void useWeightedBlobCentroids( bool b );
+        void useWeightedBlobAngles( bool b );
+        void useOptimalBlobAssignment( bool b );
 
         void showCalibrationGrid( bool b );
         void showBlobAreas( bool b );
@@ -367,6 +379,7 @@ namespace blobIO
             videoHeight_;
         bool flipImageVertically_,
              flipImageHorizontally_;
+        std::string sharedFrameRing_;
 
         // Blobs
         int imageThreshold_,
@@ -374,6 +387,9 @@ namespace blobIO
             maxBlobSize_,
             maxNumberBlobs_;
         bool useDarkBlobs_,
+             useWeightedBlobCentroids_,
+             useWeightedBlobAngles_,
+             useOptimalBlobAssignment_,
              showCalibrationGrid_,
              showBlobAreas_,
              showBlobOutlines_,
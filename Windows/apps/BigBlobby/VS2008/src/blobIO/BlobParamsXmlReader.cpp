@@ -214,7 +214,8 @@ videoRate                <br />
 videoWidth               <br />
 videoHeight              <br />
 flipImageVertically      <br />
-flipImageHorizontally    <br /><br />
+flipImageHorizontally    <br />
+sharedFrameRing          <br /><br />
 
 ERROR HANDLING:    <br />
 An unrecognized tag will result in an UnknownXmlTagException being added to a
@@ -240,6 +241,7 @@ void BlobParamsXmlReader::storeCameraParams( QDomNode & node,
                 else if( tag == "videoheight" ) { validator->setVideoHeight( text ); }
                 else if( tag == "flipimagevertically" )   { validator->flipImageVertically( text ); }
                 else if( tag == "flipimagehorizontally" ) { validator->flipImageHorizontally( text ); }
+                else if( tag == "sharedframering" )       { validator->setSharedFrameRing( text ); }
                 else { 
                     if( tag.size() == 0 ) { tag = "NO VALUE GIVEN"; }
                     UnknownXmlTagException e( tag.toStdString(),
@@ -265,6 +267,9 @@ minBlobSize             <br />
 maxBlobSize             <br />
 maxNumberBlobs          <br />
 useDarkBlobs            <br />
+useWeightedCentroids    <br />
+useWeightedAngles       <br />
+useOptimalAssignment    <br />
 showPressure            <br />
 showOutlines            <br />
 showAreas               <br />
@@ -293,6 +298,9 @@ void BlobParamsXmlReader::storeBlobParams( QDomNode & node,
                 else if( tag == "maxblobsize" )    { validator->setMaxBlobSize( text ); }
                 else if( tag == "maxnumberblobs" )       { validator->setMaxNumberBlobs( text ); }
                 else if( tag == "usedarkblobs" )         { validator->useDarkBlobs( text ); }
+                else if( tag == "useweightedcentroids" ) { validator->useWeightedBlobCentroids( text ); }
+                else if( tag == "useweightedangles" )    { validator->useWeightedBlobAngles( text ); }
+                else if( tag == "useoptimalassignment" ) { validator->useOptimalBlobAssignment( text ); }
 
                 else if( tag == "showcalibrationgrid" )  { validator->showCalibrationGrid( text ); }
                 else if( tag == "showareas" )            { validator->showBlobAreas( text ); }
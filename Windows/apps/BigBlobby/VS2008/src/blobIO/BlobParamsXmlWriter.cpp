@@ -132,6 +132,7 @@ QString BlobParamsXmlWriter::getVideoCameraXml( blobIO::BlobParamsValidator * va
     xml.append( createXmlFromInt( "videoHeight", validator->getVideoHeight() ) );
     xml.append( createXmlFromBool( "flipImageVertically", validator->flipImageVertically() ) );
     xml.append( createXmlFromBool( "flipImageHorizontally", validator->flipImageHorizontally() ) );
+    xml.append( createXmlFromString( "sharedFrameRing", validator->getSharedFrameRing().c_str() ) );
     xml.append( "    </Camera>\n\n" );
     return xml;
 }
@@ -147,6 +148,9 @@ QString BlobParamsXmlWriter::getBlobsXml( blobIO::BlobParamsValidator * validato
     xml.append( createXmlFromInt( "maxBlobSize", validator->getMaxBlobSize() ) );
     xml.append( createXmlFromInt( "maxNumberBlobs", validator->getMaxNumberBlobs() ) );
     xml.append( createXmlFromBool( "useDarkBlobs", validator->useDarkBlobs() ) );
+    xml.append( createXmlFromBool( "useWeightedCentroids", validator->useWeightedBlobCentroids() ) );
+    xml.append( createXmlFromBool( "useWeightedAngles", validator->useWeightedBlobAngles() ) );
+    xml.append( createXmlFromBool( "useOptimalAssignment", validator->useOptimalBlobAssignment() ) );
     xml.append( createXmlFromBool( "showCalibrationGrid", validator->isShowCalibrationGridOn() ) );
     xml.append( createXmlFromBool( "showAreas", validator->isShowBlobAreasOn() ) );
     xml.append( createXmlFromBool( "showOutlines", validator->isShowBlobOutlinesOn() ) );
@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+// Avx2Kernels
+//
+// PURPOSE: AVX2 versions of the GrayKernels functions (32 pixels at a time).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobKernels/KernelTable.h"
+
+#ifdef BLOBKERNELS_HAVE_AVX2
+#include <immintrin.h>
+
+namespace blobKernels
+{
+    namespace avx2
+    {
+        BLOBKERNELS_TARGET( "avx2" )
+        void subtract( const unsigned char * a, const unsigned char * b, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 32 <= n; i += 32 ) {
+                __m256i va = _mm256_loadu_si256( (const __m256i *)(a + i) ),
+                        vb = _mm256_loadu_si256( (const __m256i *)(b + i) );
+                _mm256_storeu_si256( (__m256i *)(dst + i), _mm256_subs_epu8( va, vb ) );
+            }
+            scalar::subtract( a + i, b + i, dst + i, n - i );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void mask( const unsigned char * src, const unsigned char * mask, unsigned char * dst, int n )
+        {
+            __m256i zero = _mm256_setzero_si256();
+            int i = 0;
+
+            for( ; i + 32 <= n; i += 32 ) {
+                __m256i v = _mm256_loadu_si256( (const __m256i *)(src + i) ),
+                        m = _mm256_loadu_si256( (const __m256i *)(mask + i) ),
+                        masked = _mm256_cmpeq_epi8( m, zero );
+                _mm256_storeu_si256( (__m256i *)(dst + i), _mm256_andnot_si256( masked, v ) );
+            }
+            scalar::mask( src + i, mask + i, dst + i, n - i );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void amplifySquare( const unsigned char * src, unsigned char * dst, int n, float scale )
+        {
+            __m256 s = _mm256_set1_ps( scale );
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) );
+                __m256 f0 = _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( v ) ),
+                       f1 = _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( _mm_srli_si128( v, 8 ) ) );
+                __m256i r0 = _mm256_cvtps_epi32( _mm256_mul_ps( _mm256_mul_ps( s, f0 ), f0 ) ),
+                        r1 = _mm256_cvtps_epi32( _mm256_mul_ps( _mm256_mul_ps( s, f1 ), f1 ) );
+                __m128i w0 = _mm_packs_epi32( _mm256_castsi256_si128( r0 ), _mm256_extracti128_si256( r0, 1 ) ),
+                        w1 = _mm_packs_epi32( _mm256_castsi256_si128( r1 ), _mm256_extracti128_si256( r1, 1 ) );
+                _mm_storeu_si128( (__m128i *)(dst + i), _mm_packus_epi16( w0, w1 ) );
+            }
+            scalar::amplifySquare( src + i, dst + i, n - i, scale );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void threshold( const unsigned char * src, unsigned char * dst, int n, int level )
+        {
+            int i = 0;
+
+            if( level >= 0 && level < 255 ) {
+                __m256i t = _mm256_set1_epi8( (char)(level + 1) );
+
+                for( ; i + 32 <= n; i += 32 ) {
+                    __m256i v = _mm256_loadu_si256( (const __m256i *)(src + i) ),
+                            above = _mm256_cmpeq_epi8( _mm256_max_epu8( v, t ), v );
+                    _mm256_storeu_si256( (__m256i *)(dst + i), above );
+                }
+            }
+            scalar::threshold( src + i, dst + i, n - i, level );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void thresholdBits( const unsigned char * src, boost::uint64_t * bits, int n, int level )
+        {
+            int i = 0;
+
+            if( level >= 0 && level < 255 ) {
+                __m256i t = _mm256_set1_epi8( (char)(level + 1) );
+
+                for( ; i + 64 <= n; i += 64 ) {
+                    __m256i v0 = _mm256_loadu_si256( (const __m256i *)(src + i) ),
+                            v1 = _mm256_loadu_si256( (const __m256i *)(src + i + 32) ),
+                            above0 = _mm256_cmpeq_epi8( _mm256_max_epu8( v0, t ), v0 ),
+                            above1 = _mm256_cmpeq_epi8( _mm256_max_epu8( v1, t ), v1 );
+                    bits[i / 64] = (boost::uint64_t)(unsigned int)_mm256_movemask_epi8( above0 )
+                                 | ((boost::uint64_t)(unsigned int)_mm256_movemask_epi8( above1 ) << 32);
+                }
+            }
+            scalar::thresholdBits( src + i, bits + i / 64, n - i, level );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void addRowToSums( const unsigned char * row, unsigned int * sums, int n )
+        {
+            int i = 0;
+
+            for( ; i + 8 <= n; i += 8 ) {
+                __m256i v = _mm256_cvtepu8_epi32( _mm_loadl_epi64( (const __m128i *)(row + i) ) );
+                __m256i * s = (__m256i *)(sums + i);
+                _mm256_storeu_si256( s, _mm256_add_epi32( _mm256_loadu_si256( s ), v ) );
+            }
+            scalar::addRowToSums( row + i, sums + i, n - i );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void subtractRowFromSums( const unsigned char * row, unsigned int * sums, int n )
+        {
+            int i = 0;
+
+            for( ; i + 8 <= n; i += 8 ) {
+                __m256i v = _mm256_cvtepu8_epi32( _mm_loadl_epi64( (const __m128i *)(row + i) ) );
+                __m256i * s = (__m256i *)(sums + i);
+                _mm256_storeu_si256( s, _mm256_sub_epi32( _mm256_loadu_si256( s ), v ) );
+            }
+            scalar::subtractRowFromSums( row + i, sums + i, n - i );
+        }
+
+        // (x * rate + 32768) >> 16 for sixteen unsigned 16-bit values.
+        BLOBKERNELS_TARGET( "avx2" )
+        static __m256i mulRound( __m256i x, __m256i rate )
+        {
+            __m256i hi = _mm256_mulhi_epu16( x, rate ),
+                    lo = _mm256_mullo_epi16( x, rate );
+            return _mm256_add_epi16( hi, _mm256_srli_epi16( lo, 15 ) );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void accumulateWeighted( const unsigned char * src, unsigned short * acc, int n, int rate )
+        {
+            int i = 0;
+
+            if( rate > 0 && rate < 65536 ) {
+                __m256i r = _mm256_set1_epi16( (short)rate );
+
+                for( ; i + 16 <= n; i += 16 ) {
+                    __m256i v = _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i *)(src + i) ) ),
+                            target = _mm256_or_si256( _mm256_slli_epi16( v, 8 ), v ); // v * 257
+                    __m256i * a = (__m256i *)(acc + i);
+                    __m256i current = _mm256_loadu_si256( a ),
+                            up = _mm256_subs_epu16( target, current ),
+                            down = _mm256_subs_epu16( current, target );
+                    current = _mm256_sub_epi16( _mm256_add_epi16( current, mulRound( up, r ) ), mulRound( down, r ) );
+                    _mm256_storeu_si256( a, current );
+                }
+            }
+            scalar::accumulateWeighted( src + i, acc + i, n - i, rate );
+        }
+
+        // Thirty-two accumulators rounded to 8 bits (see the SSE2 version).
+        BLOBKERNELS_TARGET( "avx2" )
+        static __m256i roundThirtyTwo( const unsigned short * acc )
+        {
+            __m256i m = _mm256_set1_epi16( (short)65281 ),
+                    half = _mm256_set1_epi16( 128 ),
+                    lo = _mm256_loadu_si256( (const __m256i *)acc ),
+                    hi = _mm256_loadu_si256( (const __m256i *)(acc + 16) );
+            lo = _mm256_srli_epi16( _mm256_add_epi16( _mm256_mulhi_epu16( lo, m ), half ), 8 );
+            hi = _mm256_srli_epi16( _mm256_add_epi16( _mm256_mulhi_epu16( hi, m ), half ), 8 );
+            // packus works within 128-bit lanes, so put the quarters back in order.
+            return _mm256_permute4x64_epi64( _mm256_packus_epi16( lo, hi ), 0xD8 );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void roundAccumulator( const unsigned short * acc, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 32 <= n; i += 32 ) {
+                _mm256_storeu_si256( (__m256i *)(dst + i), roundThirtyTwo( acc + i ) );
+            }
+            scalar::roundAccumulator( acc + i, dst + i, n - i );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void subtractAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 32 <= n; i += 32 ) {
+                __m256i v = _mm256_loadu_si256( (const __m256i *)(src + i) );
+                _mm256_storeu_si256( (__m256i *)(dst + i), _mm256_subs_epu8( v, roundThirtyTwo( acc + i ) ) );
+            }
+            scalar::subtractAccumulator( src + i, acc + i, dst + i, n - i );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void subtractFromAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 32 <= n; i += 32 ) {
+                __m256i v = _mm256_loadu_si256( (const __m256i *)(src + i) );
+                _mm256_storeu_si256( (__m256i *)(dst + i), _mm256_subs_epu8( roundThirtyTwo( acc + i ), v ) );
+            }
+            scalar::subtractFromAccumulator( src + i, acc + i, dst + i, n - i );
+        }
+
+        // (v * gain + 128) >> 8 for sixteen 16-bit pixel values (see the SSE2
+        // version).
+        BLOBKERNELS_TARGET( "avx2" )
+        static __m256i gainSixteen( __m256i v, __m256i gain )
+        {
+            __m256i hi = _mm256_mulhi_epu16( v, gain ),
+                    lo = _mm256_mullo_epi16( v, gain ),
+                    roundBit = _mm256_and_si256( _mm256_srli_epi16( lo, 7 ), _mm256_set1_epi16( 1 ) );
+            return _mm256_add_epi16( _mm256_add_epi16( _mm256_slli_epi16( hi, 8 ), _mm256_srli_epi16( lo, 8 ) ), roundBit );
+        }
+
+        BLOBKERNELS_TARGET( "avx2" )
+        void applyGain( const unsigned char * src, const unsigned short * gain, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 32 <= n; i += 32 ) {
+                __m256i r0 = gainSixteen( _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i *)(src + i) ) ),
+                                          _mm256_loadu_si256( (const __m256i *)(gain + i) ) ),
+                        r1 = gainSixteen( _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i *)(src + i + 16) ) ),
+                                          _mm256_loadu_si256( (const __m256i *)(gain + i + 16) ) );
+                __m256i packed = _mm256_permute4x64_epi64( _mm256_packus_epi16( r0, r1 ), 0xD8 );
+                _mm256_storeu_si256( (__m256i *)(dst + i), packed );
+            }
+            scalar::applyGain( src + i, gain + i, dst + i, n - i );
+        }
+    }
+
+    const KernelTable * avx2Kernels()
+    {
+        static const KernelTable table = {
+            avx2::subtract,
+            avx2::mask,
+            avx2::amplifySquare,
+            avx2::threshold,
+            avx2::thresholdBits,
+            avx2::addRowToSums,
+            avx2::subtractRowFromSums,
+            avx2::accumulateWeighted,
+            avx2::roundAccumulator,
+            avx2::subtractAccumulator,
+            avx2::subtractFromAccumulator,
+            avx2::applyGain
+        };
+        return &table;
+    }
+}
+
+#else
+
+namespace blobKernels
+{
+    const KernelTable * avx2Kernels()
+    {
+        return NULL;
+    }
+}
+
+#endif
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// CpuFeatures
+//
+// PURPOSE: Asks the CPU (through the cpuid instruction) which of the vector
+//          instruction sets used by GrayKernels it supports.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobKernels/CpuFeatures.h"
+#include "blobKernels/KernelTable.h"
+
+#if defined(BLOBKERNELS_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(BLOBKERNELS_X86)
+#include <cpuid.h>
+#endif
+
+using blobKernels::CpuFeatures;
+
+namespace
+{
+    const unsigned int SSE2_EDX_BIT = 1u << 26,
+                       SSE41_ECX_BIT = 1u << 19,
+                       OSXSAVE_ECX_BIT = 1u << 27,
+                       AVX_ECX_BIT = 1u << 28,
+                       AVX2_EBX_BIT = 1u << 5;
+
+    // Fills registers[] with eax, ebx, ecx, and edx for the given cpuid 
+    // leaf (and subleaf).  Returns false if the CPU lacks that leaf.
+    bool cpuid( unsigned int leaf, unsigned int subleaf, unsigned int registers[4] )
+    {
+        registers[0] = registers[1] = registers[2] = registers[3] = 0;
+#if defined(BLOBKERNELS_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid( info, 0 );
+
+        if( (unsigned int)info[0] < leaf ) {
+            return false;
+        }
+#if _MSC_VER >= 1600
+        __cpuidex( info, (int)leaf, (int)subleaf );
+#else
+        if( subleaf != 0 ) {
+            return false;
+        }
+        __cpuid( info, (int)leaf );
+#endif
+        for( int i = 0; i < 4; ++i ) {
+            registers[i] = (unsigned int)info[i];
+        }
+        return true;
+#elif defined(BLOBKERNELS_X86)
+        if( __get_cpuid_max( 0, 0 ) < leaf ) {
+            return false;
+        }
+        __cpuid_count( leaf, subleaf, registers[0], registers[1], registers[2], registers[3] );
+        return true;
+#else
+        (void)leaf;
+        (void)subleaf;
+        return false;
+#endif
+    }
+
+    // True if the operating system saves the SSE and AVX registers on a
+    // context switch (XCR0 bits 1 and 2), without which AVX cannot be used.
+    bool osSavesAvxRegisters()
+    {
+#if defined(BLOBKERNELS_X86) && defined(_MSC_VER) && _MSC_VER >= 1600
+        return (_xgetbv( 0 ) & 6) == 6;
+#elif defined(BLOBKERNELS_X86) && defined(__GNUC__)
+        unsigned int eax = 0,
+                     edx = 0;
+        __asm__ __volatile__( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+        return (eax & 6) == 6;
+#else
+        return false;
+#endif
+    }
+}
+
+bool CpuFeatures::hasSse2()
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;
+#else
+    unsigned int registers[4];
+    return cpuid( 1, 0, registers ) && (registers[3] & SSE2_EDX_BIT) != 0;
+#endif
+}
+
+bool CpuFeatures::hasSse41()
+{
+    unsigned int registers[4];
+    return cpuid( 1, 0, registers ) && (registers[2] & SSE41_ECX_BIT) != 0;
+}
+
+bool CpuFeatures::hasAvx2()
+{
+    unsigned int registers[4];
+
+    if( !cpuid( 1, 0, registers ) ) {
+        return false;
+    }
+    if( (registers[2] & OSXSAVE_ECX_BIT) == 0 || (registers[2] & AVX_ECX_BIT) == 0 ) {
+        return false;
+    }
+    if( !osSavesAvxRegisters() ) {
+        return false;
+    }
+    return cpuid( 7, 0, registers ) && (registers[1] & AVX2_EBX_BIT) != 0;
+}
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// GrayKernels
+//
+// PURPOSE: Vectorized (SSE2, SSE4.1, or AVX2) versions of the 8-bit image
+//          operations used by the blobFilters classes.  The fastest version the
+//          CPU supports is picked at startup, and a scalar version is kept as the
+//          reference for verifying the others.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobKernels/GrayKernels.h"
+#include "blobKernels/CpuFeatures.h"
+#include "blobKernels/KernelTable.h"
+
+using blobKernels::GrayKernels;
+using blobKernels::CpuFeatures;
+using blobKernels::KernelTable;
+using blobEnums::SimdEnum;
+
+SimdEnum::Enum GrayKernels::instructionSet_ = GrayKernels::bestInstructionSet();
+const KernelTable * GrayKernels::kernels_ = GrayKernels::kernelTable( GrayKernels::instructionSet_ );
+
+void GrayKernels::subtract( const unsigned char * a, const unsigned char * b, unsigned char * dst, int n )
+{
+    kernels_->subtract( a, b, dst, n );
+}
+
+void GrayKernels::mask( const unsigned char * src, const unsigned char * mask, unsigned char * dst, int n )
+{
+    kernels_->mask( src, mask, dst, n );
+}
+
+void GrayKernels::amplifySquare( const unsigned char * src, unsigned char * dst, int n, float scale )
+{
+    kernels_->amplifySquare( src, dst, n, scale );
+}
+
+void GrayKernels::threshold( const unsigned char * src, unsigned char * dst, int n, int level )
+{
+    kernels_->threshold( src, dst, n, level );
+}
+
+void GrayKernels::thresholdBits( const unsigned char * src, boost::uint64_t * bits, int n, int level )
+{
+    kernels_->thresholdBits( src, bits, n, level );
+}
+
+void GrayKernels::addRowToSums( const unsigned char * row, unsigned int * sums, int n )
+{
+    kernels_->addRowToSums( row, sums, n );
+}
+
+void GrayKernels::subtractRowFromSums( const unsigned char * row, unsigned int * sums, int n )
+{
+    kernels_->subtractRowFromSums( row, sums, n );
+}
+
+void GrayKernels::averageSums( const unsigned int * sums, unsigned char * dst, int n, int windowWidth, double scale )
+{
+    scalar::averageSums( sums, dst, n, windowWidth, scale );
+}
+
+void GrayKernels::copyGray( const unsigned char * src, unsigned char * dst, int n, bool mirror )
+{
+    scalar::copyGray( src, dst, n, mirror );
+}
+
+void GrayKernels::yuyvToGray( const unsigned char * yuyv, unsigned char * dst, int n, bool mirror )
+{
+    scalar::yuyvToGray( yuyv, dst, n, mirror );
+}
+
+void GrayKernels::rgbToGray( const unsigned char * rgb, unsigned char * dst, int n, bool mirror )
+{
+    scalar::rgbToGray( rgb, dst, n, mirror );
+}
+
+void GrayKernels::accumulateWeighted( const unsigned char * src, unsigned short * acc, int n, int rate )
+{
+    kernels_->accumulateWeighted( src, acc, n, rate );
+}
+
+void GrayKernels::roundAccumulator( const unsigned short * acc, unsigned char * dst, int n )
+{
+    kernels_->roundAccumulator( acc, dst, n );
+}
+
+void GrayKernels::subtractAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+{
+    kernels_->subtractAccumulator( src, acc, dst, n );
+}
+
+void GrayKernels::subtractFromAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+{
+    kernels_->subtractFromAccumulator( src, acc, dst, n );
+}
+
+void GrayKernels::applyGain( const unsigned char * src, const unsigned short * gain, unsigned char * dst, int n )
+{
+    kernels_->applyGain( src, gain, dst, n );
+}
+
+/***************************************************************************//**
+Returns the fastest instruction set that was compiled in and that this CPU
+supports.
+*******************************************************************************/
+SimdEnum::Enum GrayKernels::bestInstructionSet()
+{
+    if( avx2Kernels() != NULL && CpuFeatures::hasAvx2() ) {
+        return SimdEnum::AVX2;
+    }
+    if( sse41Kernels() != NULL && CpuFeatures::hasSse41() ) {
+        return SimdEnum::SSE4_1;
+    }
+    if( sse2Kernels() != NULL && CpuFeatures::hasSse2() ) {
+        return SimdEnum::SSE2;
+    }
+    return SimdEnum::SCALAR;
+}
+
+SimdEnum::Enum GrayKernels::instructionSet()
+{
+    return instructionSet_;
+}
+
+/***************************************************************************//**
+Switches all GrayKernels functions to the given instruction set (SCALAR to 
+check the vectorized versions against).  An instruction set that the CPU 
+does not support falls back to the best one it does, and the instruction 
+set actually used is returned.  This is not thread safe, so it should only 
+be called while no filtering is going on.
+*******************************************************************************/
+SimdEnum::Enum GrayKernels::useInstructionSet( SimdEnum::Enum type )
+{
+    SimdEnum::Enum best = bestInstructionSet();
+    instructionSet_ = (type > best) ? best : type;
+    kernels_ = kernelTable( instructionSet_ );
+    return instructionSet_;
+}
+
+const KernelTable * GrayKernels::kernelTable( SimdEnum::Enum type )
+{
+    switch( type ) {
+        case SimdEnum::AVX2:   return avx2Kernels();
+        case SimdEnum::SSE4_1: return sse41Kernels();
+        case SimdEnum::SSE2:   return sse2Kernels();
+        default:               return scalarKernels();
+    }
+}
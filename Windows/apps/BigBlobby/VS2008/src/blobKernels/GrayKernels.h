@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// GrayKernels
+//
+// PURPOSE: Vectorized (SSE2, SSE4.1, or AVX2) versions of the 8-bit image
+//          operations used by the blobFilters classes.  The fastest version the
+//          CPU supports is picked at startup, and a scalar version is kept as the
+//          reference for verifying the others.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBKERNELS_GRAYKERNELS_H
+#define BLOBKERNELS_GRAYKERNELS_H
+
+#include "blobEnums/SimdEnum.h"
+#include <boost/cstdint.hpp>
+
+namespace blobKernels { struct KernelTable; }
+
+namespace blobKernels
+{
+    /***********************************************************************//**
+    Row operations on 8-bit grayscale pixels.  Each function works on n 
+    pixels starting at the given pointers, which need no particular 
+    alignment.  Unless noted, the destination may be the same row as a 
+    source (in-place operation), but rows must not otherwise overlap.
+
+    Every result matches, bit for bit, the OpenCV 2.4 call that it replaces
+    and the scalar reference version, which can be selected with 
+    useInstructionSet( SimdEnum::SCALAR ) to check the others.
+    ***************************************************************************/
+    class GrayKernels
+    {
+    public:
+        /*******************************************************************//**
+        dst = max( a - b, 0 ), like cv::subtract() on 8-bit images.
+        ***********************************************************************/
+        static void subtract( const unsigned char * a, const unsigned char * b, unsigned char * dst, int n );
+
+        /*******************************************************************//**
+        dst = src wherever mask is non-zero, and zero elsewhere.
+        ***********************************************************************/
+        static void mask( const unsigned char * src, const unsigned char * mask, unsigned char * dst, int n );
+
+        /*******************************************************************//**
+        dst = saturate( round( scale * src * src ) ), like cv::multiply() of
+        an image with itself.
+        ***********************************************************************/
+        static void amplifySquare( const unsigned char * src, unsigned char * dst, int n, float scale );
+
+        /*******************************************************************//**
+        dst = (src > level) ? 255 : 0, like cv::threshold() with 
+        CV_THRESH_BINARY.
+        ***********************************************************************/
+        static void threshold( const unsigned char * src, unsigned char * dst, int n, int level );
+
+        /*******************************************************************//**
+        The same test packed one bit per pixel: bit (i % 64) of bits[i / 64]
+        is set if src[i] > level.  Writes (n + 63) / 64 words, and the bits 
+        past n in the last word are zero (see blobBuffers::BitBuffer).
+        ***********************************************************************/
+        static void thresholdBits( const unsigned char * src, boost::uint64_t * bits, int n, int level );
+
+        /*******************************************************************//**
+        Adds (or subtracts) one image row to running column sums, which is 
+        the vertical half of a box blur.
+        ***********************************************************************/
+        static void addRowToSums( const unsigned char * row, unsigned int * sums, int n );
+        static void subtractRowFromSums( const unsigned char * row, unsigned int * sums, int n );
+
+        /*******************************************************************//**
+        The horizontal half of a box blur.  The sums array holds the column 
+        sums for n + windowWidth - 1 columns (the row plus its border), and
+        dst[i] is the sum of sums[i] through sums[i + windowWidth - 1] times
+        scale (one over the box area), rounded to the nearest integer.  The
+        scale is a double so that the rounding is exact for any box that fits
+        in an image (an odd box area never gives a tie).  This one is scalar
+        only; a running sum does not vectorize.
+        ***********************************************************************/
+        static void averageSums( const unsigned int * sums, unsigned char * dst, int n, int windowWidth, double scale );
+
+        /*******************************************************************//**
+        Moves a 16-bit running average (an 8-bit value times 257) toward the 
+        new 8-bit image, acc += (src * 257 - acc) * rate / 65536, where the
+        rate is a learn rate in 0..1 scaled by 65536.  A rate of 65536 or more
+        replaces the average with the image.
+        ***********************************************************************/
+        static void accumulateWeighted( const unsigned char * src, unsigned short * acc, int n, int rate );
+
+        /*******************************************************************//**
+        dst = the 8-bit value nearest to acc / 257, which turns a 16-bit 
+        running average back into an image (like convertTo() with a scale of
+        255/65535).
+        ***********************************************************************/
+        static void roundAccumulator( const unsigned short * acc, unsigned char * dst, int n );
+
+        /*******************************************************************//**
+        dst = max( src - background, 0 ) and max( background - src, 0 ), where
+        background is the rounded 8-bit value of a 16-bit running average, so
+        the 8-bit background image never has to be written out.
+        ***********************************************************************/
+        static void subtractAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n );
+        static void subtractFromAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n );
+
+        /*******************************************************************//**
+        dst = saturate( round( src * gain / 256 ) ), where each gain is fixed
+        point with 8 fractional bits (256 is a gain of 1.0).  Gains must be 
+        below 0x8000 (128.0).
+        ***********************************************************************/
+        static void applyGain( const unsigned char * src, const unsigned short * gain, unsigned char * dst, int n );
+
+        /*******************************************************************//**
+        Turn n camera pixels into gray pixels, like cv::cvtColor() with 
+        CV_RGB2GRAY for RGB24 and by taking the Y bytes of YUYV (YUY2) pairs.
+        If mirror is true, the row is also flipped left to right (dst[0] is 
+        the last pixel), so a horizontal flip takes no extra pass.  The 
+        source and destination must not overlap.  These are scalar only; 
+        they run once per frame on the camera image.
+        ***********************************************************************/
+        static void copyGray( const unsigned char * src, unsigned char * dst, int n, bool mirror );
+        static void yuyvToGray( const unsigned char * yuyv, unsigned char * dst, int n, bool mirror );
+        static void rgbToGray( const unsigned char * rgb, unsigned char * dst, int n, bool mirror );
+
+        static blobEnums::SimdEnum::Enum bestInstructionSet();
+        static blobEnums::SimdEnum::Enum instructionSet();
+        static blobEnums::SimdEnum::Enum useInstructionSet( blobEnums::SimdEnum::Enum type );
+
+    private:
+        static const blobKernels::KernelTable * kernelTable( blobEnums::SimdEnum::Enum type );
+
+        static const blobKernels::KernelTable * kernels_;
+        static blobEnums::SimdEnum::Enum instructionSet_;
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// KernelTable
+//
+// PURPOSE: Function table shared by the scalar, SSE2, SSE4.1, and AVX2 builds
+//          of the GrayKernels functions.  Only included by blobKernels files.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBKERNELS_KERNELTABLE_H
+#define BLOBKERNELS_KERNELTABLE_H
+
+#include <boost/cstdint.hpp>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define BLOBKERNELS_X86
+#endif
+
+// gcc and clang only allow SSE4.1/AVX2 intrinsics in functions compiled for
+// those instruction sets, which the target attribute does one function at a
+// time (so the rest of the program still runs on any x86 CPU).  Visual C++ 
+// allows the intrinsics anywhere, but only has AVX2 from VS2012 on.
+#if defined(__GNUC__)
+#define BLOBKERNELS_TARGET( isa ) __attribute__(( target( isa ) ))
+#else
+#define BLOBKERNELS_TARGET( isa )
+#endif
+
+#if defined(BLOBKERNELS_X86) && (!defined(_MSC_VER) || _MSC_VER >= 1700)
+#define BLOBKERNELS_HAVE_AVX2
+#endif
+
+namespace blobKernels
+{
+    /***********************************************************************//**
+    One implementation of each GrayKernels function.  See GrayKernels.h for
+    what the functions do.
+    ***************************************************************************/
+    struct KernelTable
+    {
+        void (*subtract)( const unsigned char * a, const unsigned char * b, unsigned char * dst, int n );
+        void (*mask)( const unsigned char * src, const unsigned char * mask, unsigned char * dst, int n );
+        void (*amplifySquare)( const unsigned char * src, unsigned char * dst, int n, float scale );
+        void (*threshold)( const unsigned char * src, unsigned char * dst, int n, int level );
+        void (*thresholdBits)( const unsigned char * src, boost::uint64_t * bits, int n, int level );
+        void (*addRowToSums)( const unsigned char * row, unsigned int * sums, int n );
+        void (*subtractRowFromSums)( const unsigned char * row, unsigned int * sums, int n );
+        void (*accumulateWeighted)( const unsigned char * src, unsigned short * acc, int n, int rate );
+        void (*roundAccumulator)( const unsigned short * acc, unsigned char * dst, int n );
+        void (*subtractAccumulator)( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n );
+        void (*subtractFromAccumulator)( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n );
+        void (*applyGain)( const unsigned char * src, const unsigned short * gain, unsigned char * dst, int n );
+    };
+
+    // Each returns NULL if that instruction set was not compiled in.
+    const KernelTable * scalarKernels();
+    const KernelTable * sse2Kernels();
+    const KernelTable * sse41Kernels();
+    const KernelTable * avx2Kernels();
+
+    /***********************************************************************//**
+    The scalar reference versions, also used by the vectorized versions for
+    the pixels left over at the end of a row.
+    ***************************************************************************/
+    namespace scalar
+    {
+        void subtract( const unsigned char * a, const unsigned char * b, unsigned char * dst, int n );
+        void mask( const unsigned char * src, const unsigned char * mask, unsigned char * dst, int n );
+        void amplifySquare( const unsigned char * src, unsigned char * dst, int n, float scale );
+        void threshold( const unsigned char * src, unsigned char * dst, int n, int level );
+        void thresholdBits( const unsigned char * src, boost::uint64_t * bits, int n, int level );
+        void addRowToSums( const unsigned char * row, unsigned int * sums, int n );
+        void subtractRowFromSums( const unsigned char * row, unsigned int * sums, int n );
+        void accumulateWeighted( const unsigned char * src, unsigned short * acc, int n, int rate );
+        void roundAccumulator( const unsigned short * acc, unsigned char * dst, int n );
+        void subtractAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n );
+        void subtractFromAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n );
+        void applyGain( const unsigned char * src, const unsigned short * gain, unsigned char * dst, int n );
+        void averageSums( const unsigned int * sums, unsigned char * dst, int n, int windowWidth, double scale );
+        void copyGray( const unsigned char * src, unsigned char * dst, int n, bool mirror );
+        void yuyvToGray( const unsigned char * yuyv, unsigned char * dst, int n, bool mirror );
+        void rgbToGray( const unsigned char * rgb, unsigned char * dst, int n, bool mirror );
+    }
+}
+
+#endif
@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////////
+// ScalarKernels
+//
+// PURPOSE: Plain C++ versions of the GrayKernels functions.  These are the
+//          reference that the SSE2, SSE4.1, and AVX2 versions must match.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobKernels/KernelTable.h"
+#include <cmath>
+#include <cstring>
+
+namespace blobKernels
+{
+    namespace scalar
+    {
+        void subtract( const unsigned char * a, const unsigned char * b, unsigned char * dst, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                int diff = a[i] - b[i];
+                dst[i] = (unsigned char)((diff > 0) ? diff : 0);
+            }
+        }
+
+        void mask( const unsigned char * src, const unsigned char * mask, unsigned char * dst, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                dst[i] = (mask[i] != 0) ? src[i] : 0;
+            }
+        }
+
+        // Rounds half to even like cvRound() and the SSE conversion 
+        // instructions do (in the default rounding mode).
+        static int roundToNearestEven( float value )
+        {
+            float floorValue = std::floor( value ),
+                  fraction = value - floorValue;
+            int result = (int)floorValue;
+
+            if( fraction > 0.5f || (fraction == 0.5f && (result & 1) != 0) ) {
+                ++result;
+            }
+            return result;
+        }
+
+        void amplifySquare( const unsigned char * src, unsigned char * dst, int n, float scale )
+        {
+            for( int i = 0; i < n; ++i ) {
+                int value = roundToNearestEven( scale * (float)src[i] * src[i] );
+                dst[i] = (unsigned char)((value > 255) ? 255 : ((value < 0) ? 0 : value));
+            }
+        }
+
+        void threshold( const unsigned char * src, unsigned char * dst, int n, int level )
+        {
+            for( int i = 0; i < n; ++i ) {
+                dst[i] = (src[i] > level) ? 255 : 0;
+            }
+        }
+
+        void thresholdBits( const unsigned char * src, boost::uint64_t * bits, int n, int level )
+        {
+            for( int i = 0; i < n; i += 64 ) {
+                int count = (n - i < 64) ? (n - i) : 64;
+                boost::uint64_t word = 0;
+
+                for( int b = 0; b < count; ++b ) {
+                    if( src[i + b] > level ) {
+                        word |= (boost::uint64_t)1 << b;
+                    }
+                }
+                bits[i / 64] = word;
+            }
+        }
+
+        void addRowToSums( const unsigned char * row, unsigned int * sums, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                sums[i] += row[i];
+            }
+        }
+
+        void subtractRowFromSums( const unsigned char * row, unsigned int * sums, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                sums[i] -= row[i];
+            }
+        }
+
+        void accumulateWeighted( const unsigned char * src, unsigned short * acc, int n, int rate )
+        {
+            if( rate >= 65536 ) {
+                for( int i = 0; i < n; ++i ) {
+                    acc[i] = (unsigned short)(src[i] * 257);
+                }
+                return;
+            }
+            unsigned int r = (rate > 0) ? (unsigned int)rate : 0;
+
+            for( int i = 0; i < n; ++i ) {
+                unsigned int target = src[i] * 257u,
+                             current = acc[i];
+
+                if( target >= current ) {
+                    current += ((target - current) * r + 32768u) >> 16;
+                }
+                else {
+                    current -= ((current - target) * r + 32768u) >> 16;
+                }
+                acc[i] = (unsigned short)current;
+            }
+        }
+
+        // The 8-bit value nearest to acc / 257 (no ties, since 257 is odd).
+        static int roundedAccumulator( unsigned int acc )
+        {
+            return (int)((acc + 128u) / 257u);
+        }
+
+        void roundAccumulator( const unsigned short * acc, unsigned char * dst, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                dst[i] = (unsigned char)roundedAccumulator( acc[i] );
+            }
+        }
+
+        void subtractAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                int diff = src[i] - roundedAccumulator( acc[i] );
+                dst[i] = (unsigned char)((diff > 0) ? diff : 0);
+            }
+        }
+
+        void subtractFromAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                int diff = roundedAccumulator( acc[i] ) - src[i];
+                dst[i] = (unsigned char)((diff > 0) ? diff : 0);
+            }
+        }
+
+        void applyGain( const unsigned char * src, const unsigned short * gain, unsigned char * dst, int n )
+        {
+            for( int i = 0; i < n; ++i ) {
+                unsigned int value = (src[i] * (unsigned int)gain[i] + 128u) >> 8;
+                dst[i] = (unsigned char)((value > 255u) ? 255u : value);
+            }
+        }
+
+        void averageSums( const unsigned int * sums, unsigned char * dst, int n, int windowWidth, double scale )
+        {
+            unsigned int windowSum = 0;
+
+            for( int i = 0; i < windowWidth - 1; ++i ) {
+                windowSum += sums[i];
+            }
+            for( int i = 0; i < n; ++i ) {
+                windowSum += sums[i + windowWidth - 1];
+                unsigned int value = (unsigned int)(windowSum * scale + 0.5);
+                dst[i] = (unsigned char)((value > 255u) ? 255u : value);
+                windowSum -= sums[i];
+            }
+        }
+
+        void copyGray( const unsigned char * src, unsigned char * dst, int n, bool mirror )
+        {
+            if( !mirror ) {
+                std::memcpy( dst, src, n );
+                return;
+            }
+            for( int i = 0; i < n; ++i ) {
+                dst[n - 1 - i] = src[i];
+            }
+        }
+
+        void yuyvToGray( const unsigned char * yuyv, unsigned char * dst, int n, bool mirror )
+        {
+            unsigned char * out = mirror ? (dst + n - 1) : dst;
+            int step = mirror ? -1 : 1;
+
+            for( int i = 0; i < n; ++i, out += step ) {
+                *out = yuyv[2 * i];
+            }
+        }
+
+        // The fixed-point weights and rounding that OpenCV 2.4 uses for 
+        // 8-bit CV_RGB2GRAY: 0.299, 0.587, and 0.114 times 2^14.
+        void rgbToGray( const unsigned char * rgb, unsigned char * dst, int n, bool mirror )
+        {
+            const int shift = 14,
+                      redWeight = 4899,
+                      greenWeight = 9617,
+                      blueWeight = 1868,
+                      half = 1 << (shift - 1);
+            unsigned char * out = mirror ? (dst + n - 1) : dst;
+            int step = mirror ? -1 : 1;
+
+            for( int i = 0; i < n; ++i, out += step, rgb += 3 ) {
+                *out = (unsigned char)((rgb[0] * redWeight + rgb[1] * greenWeight + rgb[2] * blueWeight + half) >> shift);
+            }
+        }
+    }
+
+    const KernelTable * scalarKernels()
+    {
+        static const KernelTable table = {
+            scalar::subtract,
+            scalar::mask,
+            scalar::amplifySquare,
+            scalar::threshold,
+            scalar::thresholdBits,
+            scalar::addRowToSums,
+            scalar::subtractRowFromSums,
+            scalar::accumulateWeighted,
+            scalar::roundAccumulator,
+            scalar::subtractAccumulator,
+            scalar::subtractFromAccumulator,
+            scalar::applyGain
+        };
+        return &table;
+    }
+}
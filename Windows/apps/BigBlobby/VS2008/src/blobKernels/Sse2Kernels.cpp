@@ -0,0 +1,324 @@
+////////////////////////////////////////////////////////////////////////////////
+// Sse2Kernels
+//
+// PURPOSE: SSE2 versions of the GrayKernels functions (16 pixels at a time).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobKernels/KernelTable.h"
+
+#ifdef BLOBKERNELS_X86
+#include <emmintrin.h>
+
+namespace blobKernels
+{
+    namespace sse2
+    {
+        void subtract( const unsigned char * a, const unsigned char * b, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i va = _mm_loadu_si128( (const __m128i *)(a + i) ),
+                        vb = _mm_loadu_si128( (const __m128i *)(b + i) );
+                _mm_storeu_si128( (__m128i *)(dst + i), _mm_subs_epu8( va, vb ) );
+            }
+            scalar::subtract( a + i, b + i, dst + i, n - i );
+        }
+
+        void mask( const unsigned char * src, const unsigned char * mask, unsigned char * dst, int n )
+        {
+            __m128i zero = _mm_setzero_si128();
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) ),
+                        m = _mm_loadu_si128( (const __m128i *)(mask + i) ),
+                        masked = _mm_cmpeq_epi8( m, zero );
+                _mm_storeu_si128( (__m128i *)(dst + i), _mm_andnot_si128( masked, v ) );
+            }
+            scalar::mask( src + i, mask + i, dst + i, n - i );
+        }
+
+        // (scale * v) * v for four 32-bit pixels, rounded to the nearest 
+        // (even) integer by cvtps like cvRound().
+        static __m128i amplifyFour( __m128i v, __m128 scale )
+        {
+            __m128 f = _mm_cvtepi32_ps( v );
+            return _mm_cvtps_epi32( _mm_mul_ps( _mm_mul_ps( scale, f ), f ) );
+        }
+
+        void amplifySquare( const unsigned char * src, unsigned char * dst, int n, float scale )
+        {
+            __m128i zero = _mm_setzero_si128();
+            __m128 s = _mm_set1_ps( scale );
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) ),
+                        lo = _mm_unpacklo_epi8( v, zero ),
+                        hi = _mm_unpackhi_epi8( v, zero ),
+                        r0 = amplifyFour( _mm_unpacklo_epi16( lo, zero ), s ),
+                        r1 = amplifyFour( _mm_unpackhi_epi16( lo, zero ), s ),
+                        r2 = amplifyFour( _mm_unpacklo_epi16( hi, zero ), s ),
+                        r3 = amplifyFour( _mm_unpackhi_epi16( hi, zero ), s );
+                __m128i packed = _mm_packus_epi16( _mm_packs_epi32( r0, r1 ), _mm_packs_epi32( r2, r3 ) );
+                _mm_storeu_si128( (__m128i *)(dst + i), packed );
+            }
+            scalar::amplifySquare( src + i, dst + i, n - i, scale );
+        }
+
+        void threshold( const unsigned char * src, unsigned char * dst, int n, int level )
+        {
+            int i = 0;
+
+            if( level >= 0 && level < 255 ) {
+                __m128i t = _mm_set1_epi8( (char)(level + 1) );
+
+                for( ; i + 16 <= n; i += 16 ) {
+                    __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) ),
+                            above = _mm_cmpeq_epi8( _mm_max_epu8( v, t ), v );
+                    _mm_storeu_si128( (__m128i *)(dst + i), above );
+                }
+            }
+            scalar::threshold( src + i, dst + i, n - i, level );
+        }
+
+        // Each movemask gives one bit for each of 16 pixels, in pixel order.
+        void thresholdBits( const unsigned char * src, boost::uint64_t * bits, int n, int level )
+        {
+            int i = 0;
+
+            if( level >= 0 && level < 255 ) {
+                __m128i t = _mm_set1_epi8( (char)(level + 1) );
+
+                for( ; i + 64 <= n; i += 64 ) {
+                    boost::uint64_t word = 0;
+
+                    for( int j = 0; j < 4; ++j ) {
+                        __m128i v = _mm_loadu_si128( (const __m128i *)(src + i + 16 * j) ),
+                                above = _mm_cmpeq_epi8( _mm_max_epu8( v, t ), v );
+                        word |= (boost::uint64_t)(unsigned int)_mm_movemask_epi8( above ) << (16 * j);
+                    }
+                    bits[i / 64] = word;
+                }
+            }
+            scalar::thresholdBits( src + i, bits + i / 64, n - i, level );
+        }
+
+        void addRowToSums( const unsigned char * row, unsigned int * sums, int n )
+        {
+            __m128i zero = _mm_setzero_si128();
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(row + i) ),
+                        lo = _mm_unpacklo_epi8( v, zero ),
+                        hi = _mm_unpackhi_epi8( v, zero );
+                __m128i * s = (__m128i *)(sums + i);
+                _mm_storeu_si128( s, _mm_add_epi32( _mm_loadu_si128( s ), _mm_unpacklo_epi16( lo, zero ) ) );
+                _mm_storeu_si128( s + 1, _mm_add_epi32( _mm_loadu_si128( s + 1 ), _mm_unpackhi_epi16( lo, zero ) ) );
+                _mm_storeu_si128( s + 2, _mm_add_epi32( _mm_loadu_si128( s + 2 ), _mm_unpacklo_epi16( hi, zero ) ) );
+                _mm_storeu_si128( s + 3, _mm_add_epi32( _mm_loadu_si128( s + 3 ), _mm_unpackhi_epi16( hi, zero ) ) );
+            }
+            scalar::addRowToSums( row + i, sums + i, n - i );
+        }
+
+        void subtractRowFromSums( const unsigned char * row, unsigned int * sums, int n )
+        {
+            __m128i zero = _mm_setzero_si128();
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(row + i) ),
+                        lo = _mm_unpacklo_epi8( v, zero ),
+                        hi = _mm_unpackhi_epi8( v, zero );
+                __m128i * s = (__m128i *)(sums + i);
+                _mm_storeu_si128( s, _mm_sub_epi32( _mm_loadu_si128( s ), _mm_unpacklo_epi16( lo, zero ) ) );
+                _mm_storeu_si128( s + 1, _mm_sub_epi32( _mm_loadu_si128( s + 1 ), _mm_unpackhi_epi16( lo, zero ) ) );
+                _mm_storeu_si128( s + 2, _mm_sub_epi32( _mm_loadu_si128( s + 2 ), _mm_unpacklo_epi16( hi, zero ) ) );
+                _mm_storeu_si128( s + 3, _mm_sub_epi32( _mm_loadu_si128( s + 3 ), _mm_unpackhi_epi16( hi, zero ) ) );
+            }
+            scalar::subtractRowFromSums( row + i, sums + i, n - i );
+        }
+
+        // (x * rate + 32768) >> 16 for eight unsigned 16-bit values.
+        static __m128i mulRound( __m128i x, __m128i rate )
+        {
+            __m128i hi = _mm_mulhi_epu16( x, rate ),
+                    lo = _mm_mullo_epi16( x, rate );
+            return _mm_add_epi16( hi, _mm_srli_epi16( lo, 15 ) );
+        }
+
+        // Moves eight accumulators toward their 16-bit targets.
+        static __m128i accumulateEight( __m128i target, __m128i acc, __m128i rate )
+        {
+            __m128i up = _mm_subs_epu16( target, acc ),
+                    down = _mm_subs_epu16( acc, target );
+            return _mm_sub_epi16( _mm_add_epi16( acc, mulRound( up, rate ) ), mulRound( down, rate ) );
+        }
+
+        void accumulateWeighted( const unsigned char * src, unsigned short * acc, int n, int rate )
+        {
+            int i = 0;
+
+            if( rate > 0 && rate < 65536 ) {
+                __m128i zero = _mm_setzero_si128(),
+                        r = _mm_set1_epi16( (short)rate );
+
+                for( ; i + 16 <= n; i += 16 ) {
+                    __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) ),
+                            lo = _mm_unpacklo_epi8( v, zero ),
+                            hi = _mm_unpackhi_epi8( v, zero );
+                    __m128i * a = (__m128i *)(acc + i);
+                    lo = _mm_or_si128( _mm_slli_epi16( lo, 8 ), lo ); // v * 257
+                    hi = _mm_or_si128( _mm_slli_epi16( hi, 8 ), hi );
+                    _mm_storeu_si128( a, accumulateEight( lo, _mm_loadu_si128( a ), r ) );
+                    _mm_storeu_si128( a + 1, accumulateEight( hi, _mm_loadu_si128( a + 1 ), r ) );
+                }
+            }
+            scalar::accumulateWeighted( src + i, acc + i, n - i, rate );
+        }
+
+        // Sixteen accumulators rounded to 8 bits: (mulhi( acc, 65281 ) + 128) >> 8
+        // equals (acc + 128) / 257 for every 16-bit acc.
+        static __m128i roundSixteen( const unsigned short * acc )
+        {
+            __m128i m = _mm_set1_epi16( (short)65281 ),
+                    half = _mm_set1_epi16( 128 ),
+                    lo = _mm_loadu_si128( (const __m128i *)acc ),
+                    hi = _mm_loadu_si128( (const __m128i *)(acc + 8) );
+            lo = _mm_srli_epi16( _mm_add_epi16( _mm_mulhi_epu16( lo, m ), half ), 8 );
+            hi = _mm_srli_epi16( _mm_add_epi16( _mm_mulhi_epu16( hi, m ), half ), 8 );
+            return _mm_packus_epi16( lo, hi );
+        }
+
+        void roundAccumulator( const unsigned short * acc, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                _mm_storeu_si128( (__m128i *)(dst + i), roundSixteen( acc + i ) );
+            }
+            scalar::roundAccumulator( acc + i, dst + i, n - i );
+        }
+
+        void subtractAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) );
+                _mm_storeu_si128( (__m128i *)(dst + i), _mm_subs_epu8( v, roundSixteen( acc + i ) ) );
+            }
+            scalar::subtractAccumulator( src + i, acc + i, dst + i, n - i );
+        }
+
+        void subtractFromAccumulator( const unsigned char * src, const unsigned short * acc, unsigned char * dst, int n )
+        {
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) );
+                _mm_storeu_si128( (__m128i *)(dst + i), _mm_subs_epu8( roundSixteen( acc + i ), v ) );
+            }
+            scalar::subtractFromAccumulator( src + i, acc + i, dst + i, n - i );
+        }
+
+        // (v * gain + 128) >> 8 for eight 16-bit pixel values, put together
+        // from the high and low halves of the 32-bit products.  The result
+        // is at most 0x7FFF for gains below 128, so it packs (with 
+        // saturation) to 8 bits correctly.
+        static __m128i gainEight( __m128i v, __m128i gain )
+        {
+            __m128i hi = _mm_mulhi_epu16( v, gain ),
+                    lo = _mm_mullo_epi16( v, gain ),
+                    roundBit = _mm_and_si128( _mm_srli_epi16( lo, 7 ), _mm_set1_epi16( 1 ) );
+            return _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( hi, 8 ), _mm_srli_epi16( lo, 8 ) ), roundBit );
+        }
+
+        void applyGain( const unsigned char * src, const unsigned short * gain, unsigned char * dst, int n )
+        {
+            __m128i zero = _mm_setzero_si128();
+            int i = 0;
+
+            for( ; i + 16 <= n; i += 16 ) {
+                __m128i v = _mm_loadu_si128( (const __m128i *)(src + i) ),
+                        g0 = _mm_loadu_si128( (const __m128i *)(gain + i) ),
+                        g1 = _mm_loadu_si128( (const __m128i *)(gain + i + 8) ),
+                        r0 = gainEight( _mm_unpacklo_epi8( v, zero ), g0 ),
+                        r1 = gainEight( _mm_unpackhi_epi8( v, zero ), g1 );
+                _mm_storeu_si128( (__m128i *)(dst + i), _mm_packus_epi16( r0, r1 ) );
+            }
+            scalar::applyGain( src + i, gain + i, dst + i, n - i );
+        }
+    }
+
+    const KernelTable * sse2Kernels()
+    {
+        static const KernelTable table = {
+            sse2::subtract,
+            sse2::mask,
+            sse2::amplifySquare,
+            sse2::threshold,
+            sse2::thresholdBits,
+            sse2::addRowToSums,
+            sse2::subtractRowFromSums,
+            sse2::accumulateWeighted,
+            sse2::roundAccumulator,
+            sse2::subtractAccumulator,
+            sse2::subtractFromAccumulator,
+            sse2::applyGain
+        };
+        return &table;
+    }
+}
+
+#else
+
+namespace blobKernels
+{
+    const KernelTable * sse2Kernels()
+    {
+        return NULL;
+    }
+}
+
+#endif
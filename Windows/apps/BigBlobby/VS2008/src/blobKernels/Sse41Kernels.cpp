@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Sse41Kernels
+//
+// PURPOSE: SSE4.1 versions of the GrayKernels functions that gain from the
+//          packed zero-extension instructions.  The rest are the SSE2 versions.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobKernels/KernelTable.h"
+
+#ifdef BLOBKERNELS_X86
+#include <smmintrin.h>
+
+namespace blobKernels
+{
+    namespace sse41
+    {
+        BLOBKERNELS_TARGET( "sse4.1" )
+        void amplifySquare( const unsigned char * src, unsigned char * dst, int n, float scale )
+        {
+            __m128 s = _mm_set1_ps( scale );
+            int i = 0;
+
+            for( ; i + 8 <= n; i += 8 ) {
+                __m128i v = _mm_loadl_epi64( (const __m128i *)(src + i) );
+                __m128 f0 = _mm_cvtepi32_ps( _mm_cvtepu8_epi32( v ) ),
+                       f1 = _mm_cvtepi32_ps( _mm_cvtepu8_epi32( _mm_srli_si128( v, 4 ) ) );
+                __m128i r0 = _mm_cvtps_epi32( _mm_mul_ps( _mm_mul_ps( s, f0 ), f0 ) ),
+                        r1 = _mm_cvtps_epi32( _mm_mul_ps( _mm_mul_ps( s, f1 ), f1 ) ),
+                        packed = _mm_packus_epi16( _mm_packs_epi32( r0, r1 ), _mm_setzero_si128() );
+                _mm_storel_epi64( (__m128i *)(dst + i), packed );
+            }
+            scalar::amplifySquare( src + i, dst + i, n - i, scale );
+        }
+    }
+
+    const KernelTable * sse41Kernels()
+    {
+        const KernelTable * sse2 = sse2Kernels();
+
+        static const KernelTable table = {
+            sse2->subtract,
+            sse2->mask,
+            sse41::amplifySquare,
+            sse2->threshold,
+            sse2->thresholdBits,
+            sse2->addRowToSums,
+            sse2->subtractRowFromSums,
+            sse2->accumulateWeighted,
+            sse2->roundAccumulator,
+            sse2->subtractAccumulator,
+            sse2->subtractFromAccumulator,
+            sse2->applyGain
+        };
+        return &table;
+    }
+}
+
+#else
+
+namespace blobKernels
+{
+    const KernelTable * sse41Kernels()
+    {
+        return NULL;
+    }
+}
+
+#endif
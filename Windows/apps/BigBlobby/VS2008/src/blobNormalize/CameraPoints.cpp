@@ -106,16 +106,16 @@ void CameraPoints::setGrid( CalibrationUtils * calibrationUtils,
 
 void CameraPoints::addPoints( blobTracker::BlobTracker * tracker )
 {
-    std::map<int, blobTracker::Blob> * trackedBlobs = tracker->getTrackedBlobs();
-    std::map<int, blobTracker::Blob>::iterator iter;
+    std::vector<blobTracker::Blob> * trackedBlobs = tracker->getTrackedBlobs();
+    std::vector<blobTracker::Blob>::iterator iter;
     validateSize( trackedBlobs->size() ); // Can throw exception.
 
     for( iter = trackedBlobs->begin(); iter != trackedBlobs->end(); ++iter ) {
         points_.push_back( 
-            blobNormalize::CameraPoint( iter->second.cameraCentroid.x, 
-                                          iter->second.cameraCentroid.y, 
-                                          iter->second.sourceIntensity,
-                                          iter->second.backgroundIntensity ) );
+            blobNormalize::CameraPoint( iter->cameraCentroid.x, 
+                                          iter->cameraCentroid.y, 
+                                          iter->sourceIntensity,
+                                          iter->backgroundIntensity ) );
     }
 }
 
@@ -220,16 +220,16 @@ void CameraPoints::debugPrintPoints()
 
 void CameraPoints::debugPrintBlobs( blobTracker::BlobTracker * tracker )
 {
-    std::map<int, blobTracker::Blob> * trackedBlobs = tracker->getTrackedBlobs();
-    std::map<int, blobTracker::Blob>::iterator iter;
+    std::vector<blobTracker::Blob> * trackedBlobs = tracker->getTrackedBlobs();
+    std::vector<blobTracker::Blob>::iterator iter;
     int count = 0;
     std::cout << "\nUnsortedCameraPoints::debugPrintBlobs():\n\n";
 
     for( iter = trackedBlobs->begin(); iter != trackedBlobs->end(); ++iter, ++count ) {
-        float x = iter->second.cameraCentroid.x,
-              y = iter->second.cameraCentroid.y,
-              src = iter->second.sourceIntensity,
-              bk = iter->second.backgroundIntensity;
+        float x = iter->cameraCentroid.x,
+              y = iter->cameraCentroid.y,
+              src = iter->sourceIntensity,
+              bk = iter->backgroundIntensity;
 
         std::cout << "blob " << count 
                   << " (x, y, srcMinusBk, src, bk) = (" 
@@ -292,6 +292,67 @@ blobNormalize::GridPoint FishEyeGrid::gridPoint( int row, int col )
     return p;
 }
 
+/***************************************************************************//**
+Returns the intensity normalization of the grid point without copying it (or 
+1.0 for a point outside the grid, the same as a default GridPoint).
+*******************************************************************************/
+float FishEyeGrid::intensityNormalization( int row, int col )
+{
+    int index = (row * numCols_) + col;
+    int size = gridPoints_.size();
+
+    if( index >= 0 && index < size ) {
+        return gridPoints_[index].intensityNormalization();
+    }
+    return 1.0f;
+}
+
+/***************************************************************************//**
+Works out the cell column and the deltaX that intensityNormalizationFactor()
+would use for every x from 0 to width - 1.  Since the grid steps only depend 
+on x (or y), a whole image can be rasterized from one of these lists and one
+from cellRowsAndDeltas().
+*******************************************************************************/
+void FishEyeGrid::cellColsAndDeltas( int width, std::vector<int> & cols, std::vector<float> & deltasX )
+{
+    cols.resize( width );
+    deltasX.resize( width );
+
+    for( int i = 0; i < width; ++i ) {
+        float x = (float)i;
+        cols[i] = cellCol( x );
+        deltasX[i] = calculateDeltaX( x, cols[i] );
+    }
+}
+
+/***************************************************************************//**
+Works out the cell row and the deltaY that intensityNormalizationFactor() 
+would use for every y from 0 to height - 1.
+*******************************************************************************/
+void FishEyeGrid::cellRowsAndDeltas( int height, std::vector<int> & rows, std::vector<float> & deltasY )
+{
+    rows.resize( height );
+    deltasY.resize( height );
+
+    for( int i = 0; i < height; ++i ) {
+        float y = (float)i;
+        rows[i] = cellRow( y );
+        deltasY[i] = calculateDeltaY( y, rows[i] );
+    }
+}
+
+/***************************************************************************//**
+Returns true if the other grid has the same grid steps, so that every pixel 
+falls in the same cell (with the same deltas) in both grids.  Only the 
+intensities can differ.
+*******************************************************************************/
+bool FishEyeGrid::hasSameCells( blobNormalize::FishEyeGrid * other )
+{
+    return other != NULL
+        && gridStepsX_ == other->gridStepsX_
+        && gridStepsY_ == other->gridStepsY_;
+}
+
 /***************************************************************************//**
 Before this function is called, x should have been determined to have a value 
 of at least gridStepsX_[col], but less than gridStepsX_[col+1].  This function
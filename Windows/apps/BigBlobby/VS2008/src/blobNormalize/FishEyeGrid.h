@@ -71,7 +71,11 @@ namespace blobNormalize
         void setPointBackgroundIntensity( float intensity, int row, int col );
         void setIntensityNormalization( float intensity, int row, int col );
         blobNormalize::GridPoint gridPoint( int row, int col );
+        float intensityNormalization( int row, int col );
         float intensityNormalizationFactor( float x, float y );
+        void cellColsAndDeltas( int width, std::vector<int> & cols, std::vector<float> & deltasX );
+        void cellRowsAndDeltas( int height, std::vector<int> & rows, std::vector<float> & deltasY );
+        bool hasSameCells( blobNormalize::FishEyeGrid * other );
         void debugPrintGrid();
 
     private:
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+// SharedFrameProducer
+//
+// PURPOSE: Reference producer for the SharedFrameSource: writes synthetic
+//          frames of moving bright blobs into a SharedFrameRing, for testing
+//          the shared-memory ingest without a camera (Linux only).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobVideo/SharedFrameRing.h"
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+/** @file */ 
+
+namespace
+{
+    const int NUMBER_OF_BLOBS = 3,
+              BLOB_RADIUS = 8,
+              BACKGROUND = 20,
+              NUMBER_OF_SLOTS = 4;
+
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    void requestStop( int )
+    {
+        stopRequested = 1;
+    }
+
+    /***********************************************************************//**
+    Draws a dim background with NUMBER_OF_BLOBS bright discs that move around
+    ellipses, so the tracker has blobs that move smoothly from frame to frame.
+    ***************************************************************************/
+    void drawFrame( unsigned char * pixels, int width, int height, int stride, int frameNumber )
+    {
+        for( int row = 0; row < height; ++row ) {
+            std::memset( pixels + row * stride, BACKGROUND, width );
+        }
+        double twoPi = 6.283185307179586;
+
+        for( int i = 0; i < NUMBER_OF_BLOBS; ++i ) {
+            double angle = twoPi * (frameNumber / 240.0 + i / (double)NUMBER_OF_BLOBS);
+            int centerX = (int)(width * (0.5 + 0.35 * std::cos( angle ))),
+                centerY = (int)(height * (0.5 + 0.35 * std::sin( angle )));
+
+            for( int dy = -BLOB_RADIUS; dy <= BLOB_RADIUS; ++dy ) {
+                int y = centerY + dy;
+                if( y < 0 || y >= height ) { continue; }
+
+                for( int dx = -BLOB_RADIUS; dx <= BLOB_RADIUS; ++dx ) {
+                    int x = centerX + dx,
+                        rr = dx * dx + dy * dy;
+                    if( x < 0 || x >= width || rr > BLOB_RADIUS * BLOB_RADIUS ) { continue; }
+
+                    pixels[y * stride + x] = (unsigned char)(255 - 100 * rr / (BLOB_RADIUS * BLOB_RADIUS));
+                }
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+Usage: SharedFrameProducer [name [width [height [framesPerSecond]]]]
+
+Creates the shared frame ring (default "/bigblobby", 320 x 240 GRAY8 at 60 
+frames per second) and writes frames into it until the process gets SIGINT or
+SIGTERM (Ctrl+C).  Set sharedFrameRing in the Camera section of the settings
+file to the same name to have BigBlobby read the frames.
+ ******************************************************************************/
+int main( int argc, char *argv[] )
+{
+    std::string name = (argc > 1) ? argv[1] : "/bigblobby";
+    int width = (argc > 2) ? std::atoi( argv[2] ) : 320,
+        height = (argc > 3) ? std::atoi( argv[3] ) : 240,
+        framesPerSecond = (argc > 4) ? std::atoi( argv[4] ) : 60;
+
+    if( width < 1 || height < 1 || framesPerSecond < 1 ) {
+        std::cout << "Usage: SharedFrameProducer [name [width [height [framesPerSecond]]]]\n";
+        return 1;
+    }
+    std::signal( SIGINT, requestStop );
+    std::signal( SIGTERM, requestStop );
+
+    blobVideo::SharedFrameRing ring;
+
+    if( !ring.create( name, width, height, blobEnums::PixelFormatEnum::GRAY8, NUMBER_OF_SLOTS ) ) {
+        return 1;
+    }
+    std::cout << "Writing " << width << "x" << height << " frames to " << name 
+              << " at " << framesPerSecond << " fps (Ctrl+C to stop)...\n" << std::flush;
+
+    typedef boost::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now(),
+                      nextFrame = start;
+    Clock::duration framePeriod = boost::chrono::duration_cast<Clock::duration>( 
+                                      boost::chrono::duration<double>( 1.0 / framesPerSecond ) );
+    int frameNumber = 0,
+        skippedFrames = 0;
+
+    while( !stopRequested ) {
+        unsigned char * pixels = ring.beginWrite();
+
+        if( pixels != NULL ) {
+            drawFrame( pixels, width, height, ring.stride(), frameNumber );
+            double seconds = boost::chrono::duration<double>( Clock::now() - start ).count();
+            ring.endWrite( seconds );
+        }
+        else {
+            ++skippedFrames;
+        }
+        ++frameNumber;
+        nextFrame += framePeriod;
+        boost::this_thread::sleep_until( nextFrame );
+    }
+    std::cout << "Stopping after " << frameNumber << " frames (" << skippedFrames << " skipped).\n";
+    ring.close();
+    return 0;
+}
@@ -63,12 +63,13 @@ void Stats::showProcessingTime( bool b )
     showProcessingTime_ = b;
 }
 
-std::string Stats::fpsStats( double fps, int videoWidth, int videoHeight )
+std::string Stats::fpsStats( double fps, double droppedFps, int videoWidth, int videoHeight )
 {
     double avgFrameTime = (fps > 0) ? (1.0 / fps) : 0.0;
     std::stringstream strStream;
     strStream << std::fixed << std::setprecision( 0 )
               << "Frame Rate:  " << fps << " fps\n"
+              << "Dropped:       " << droppedFps << " fps\n"
               << "Resolution:    " << videoWidth << " x " << videoHeight << "\n"
               << std::setprecision( 1 )
               << "Frame Time:  " << (avgFrameTime * 1000) << + " millisec";
@@ -60,7 +60,7 @@ namespace blobStats
         Stats();
         ~Stats();
         void showProcessingTime( bool b );
-        std::string fpsStats( double fps, int videoWidth, int videoHeight );
+        std::string fpsStats( double fps, double droppedFps, int videoWidth, int videoHeight );
         std::string networkAndFilterStats( const std::string & tuioOutputSummary,
                                            blobStats::FilterStats * filterStats,
                                            double contourProcessingTime,
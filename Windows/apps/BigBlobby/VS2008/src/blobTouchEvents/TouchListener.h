@@ -60,10 +60,10 @@ namespace blobTouchEvents
 	    void RAWTouchHeld( const void * sender, blobTracker::Blob & blob );
 
     protected:
-	    virtual void RAWTouchDown( blobTracker::Blob blob ) = 0;
-	    virtual void RAWTouchUp( blobTracker::Blob blob ) = 0;
-	    virtual void RAWTouchMoved( blobTracker::Blob blob ) = 0;
-	    virtual void RAWTouchHeld( blobTracker::Blob blob ) = 0;
+	    virtual void RAWTouchDown( const blobTracker::Blob & blob ) = 0;
+	    virtual void RAWTouchUp( const blobTracker::Blob & blob ) = 0;
+	    virtual void RAWTouchMoved( const blobTracker::Blob & blob ) = 0;
+	    virtual void RAWTouchHeld( const blobTracker::Blob & blob ) = 0;
     };
 }
 
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+// AssignmentSolver
+//
+// PURPOSE: Finds the matching of rows to columns of a cost matrix with the smallest
+//          total cost (the Hungarian method).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobTracker/AssignmentSolver.h"
+#include <limits>
+
+using blobTracker::AssignmentSolver;
+
+AssignmentSolver::AssignmentSolver() :
+  rowPotentials_(),
+  colPotentials_(),
+  minSlack_(),
+  rowOfCol_(),
+  previousCol_(),
+  isColUsed_()
+{
+}
+
+AssignmentSolver::~AssignmentSolver()
+{
+}
+
+/***************************************************************************//**
+The costs are stored row by row (costs[row * cols + col]).  On return, 
+colOfRow[row] is the column given to each row, and the total cost is returned.
+Rows are added one at a time, and each is given a column by the cheapest 
+augmenting path found from it with Dijkstra's method on the reduced costs.  
+Columns 0 and rows 0 of the working arrays stand for "not assigned yet".
+*******************************************************************************/
+double AssignmentSolver::solve( const std::vector<double> & costs, 
+                                int rows, 
+                                int cols, 
+                                std::vector<int> & colOfRow )
+{
+    const double infinity = std::numeric_limits<double>::max();
+    colOfRow.assign( rows, -1 );
+
+    if( rows <= 0 || cols < rows ) {
+        return 0.0;
+    }
+    rowPotentials_.assign( rows + 1, 0.0 );
+    colPotentials_.assign( cols + 1, 0.0 );
+    rowOfCol_.assign( cols + 1, 0 );
+    previousCol_.assign( cols + 1, 0 );
+
+    for( int row = 1; row <= rows; ++row ) {
+        rowOfCol_[0] = row;
+        int col0 = 0;
+        minSlack_.assign( cols + 1, infinity );
+        isColUsed_.assign( cols + 1, 0 );
+
+        do {
+            isColUsed_[col0] = 1;
+            int row0 = rowOfCol_[col0],
+                col1 = 0;
+            double delta = infinity;
+            const double * costRow = &costs[(row0 - 1) * cols];
+
+            for( int col = 1; col <= cols; ++col ) {
+                if( !isColUsed_[col] ) {
+                    double slack = costRow[col - 1] - rowPotentials_[row0] - colPotentials_[col];
+
+                    if( slack < minSlack_[col] ) {
+                        minSlack_[col] = slack;
+                        previousCol_[col] = col0;
+                    }
+                    if( minSlack_[col] < delta ) {
+                        delta = minSlack_[col];
+                        col1 = col;
+                    }
+                }
+            }
+            for( int col = 0; col <= cols; ++col ) {
+                if( isColUsed_[col] ) {
+                    rowPotentials_[rowOfCol_[col]] += delta;
+                    colPotentials_[col] -= delta;
+                }
+                else {
+                    minSlack_[col] -= delta;
+                }
+            }
+            col0 = col1;
+        } while( rowOfCol_[col0] != 0 );
+
+        // Flip the augmenting path.
+        do {
+            int col1 = previousCol_[col0];
+            rowOfCol_[col0] = rowOfCol_[col1];
+            col0 = col1;
+        } while( col0 != 0 );
+    }
+    double total = 0.0;
+
+    for( int col = 1; col <= cols; ++col ) {
+        int row = rowOfCol_[col];
+
+        if( row != 0 ) {
+            colOfRow[row - 1] = col - 1;
+            total += costs[(row - 1) * cols + (col - 1)];
+        }
+    }
+    return total;
+}
@@ -43,14 +43,16 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "blobTracker/Blob.h"
+#ifndef BLOBBY_HEADLESS
 #include "ofGraphics.h"
+#endif
 
 using blobTracker::Blob;
 
 const int Blob::DEATH_COUNT = 11; // Skips 10 frames before killing unmatched blob.
 
 Blob::Blob() :
-  pts(),
+  firstPt( 0 ),
   nPts( 0 ),
   id( -1 ),
   deathCount( DEATH_COUNT ),
@@ -83,6 +85,7 @@ Blob::~Blob()
 {
 }
 
+#ifndef BLOBBY_HEADLESS
 void Blob::drawCrosshairs()
 {
     glPushMatrix();
@@ -126,21 +129,25 @@ void Blob::drawAngularBoundingBox()
     glPopMatrix();
 }
 
-void Blob::drawContourPoints()
+/***************************************************************************//**
+The contour points have to be the ones from the frame the blob was found in.
+*******************************************************************************/
+void Blob::drawContourPoints( const std::vector<ofPoint> & contourPoints )
 {
     ofNoFill();
     glLineWidth( 2.0 );
     ofSetColor( 0xFF0099 );
     ofBeginShape();
 
-    for (int i = 0; i < nPts; i++){
-        ofVertex( pts[i].x, pts[i].y );
+    for (int i = firstPt; i < firstPt + nPts; i++){
+        ofVertex( contourPoints[i].x, contourPoints[i].y );
     }
     ofEndShape( true );	
     glLineWidth( 1.0 );
 }
 
-void Blob::drawContours( float x, 
+void Blob::drawContours( const std::vector<ofPoint> & contourPoints,
+                         float x, 
                          float y, 
                          float inputWidth, 
                          float inputHeight, 
@@ -181,9 +188,10 @@ void Blob::drawContours( float x,
     glLineWidth( 2.0 );
     ofSetColor(0xFF0099);
     ofBeginShape();
-    for (int i = 0; i < nPts; i++){
-        ofVertex(x + pts[i].x/inputWidth * outputWidth, y + pts[i].y/(inputHeight) * outputHeight);
+    for (int i = firstPt; i < firstPt + nPts; i++){
+        ofVertex(x + contourPoints[i].x/inputWidth * outputWidth, y + contourPoints[i].y/(inputHeight) * outputHeight);
     }
     ofEndShape(true);	
     glLineWidth( 1.0 );
 }
+#endif
@@ -51,6 +51,13 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace blobTracker
 {
+    /***********************************************************************//**
+    A blob found by the ContourFinder (or a tracked blob built from one).  The
+    contour points are not held by the blob: firstPt and nPts are a span of 
+    the ContourFinder's contourPoints() for the frame the blob was found in 
+    (VisionFrame keeps a copy of both).  So a Blob holds no heap memory, and 
+    copying one never allocates.
+    ***************************************************************************/
     class Blob 
     {
         public: 
@@ -58,8 +65,8 @@ namespace blobTracker
             // frames a tracked blob can go missing before being deleted.
             static const int DEATH_COUNT;
 
-            std::vector <ofPoint> pts;     // contour of the blob
-            int                   nPts;    // number of pts
+            int                   firstPt; // index of the first contour point
+            int                   nPts;    // number of contour points
 		    int					  id;
             int                   deathCount;
 	        float                 area;
@@ -88,16 +95,19 @@ namespace blobTracker
             Blob();
             ~Blob();
 
+#ifndef BLOBBY_HEADLESS
             void drawCrosshairs();
             void drawAngularBoundingBox();
-            void drawContourPoints();
+            void drawContourPoints( const std::vector<ofPoint> & contourPoints );
 
-            void drawContours( float x = 0, 
+            void drawContours( const std::vector<ofPoint> & contourPoints,
+                               float x = 0, 
                                float y = 0, 
                                float inputWidth = ofGetWidth(), 
                                float inputHeight = ofGetHeight(), 
                                float outputWidth = ofGetWidth(), 
                                float outputHeight = ofGetHeight() );
+#endif
 
         private:
     };
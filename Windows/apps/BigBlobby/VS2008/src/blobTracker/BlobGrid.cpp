@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+// BlobGrid
+//
+// PURPOSE: Uniform grid (spatial hash) of the new blobs of a frame, so that the
+//          tracker only compares a tracked blob with the new blobs near it.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobTracker/BlobGrid.h"
+#include <algorithm>
+#include <cmath>
+
+using blobTracker::BlobGrid;
+
+// The cells are made this many times the average spacing of the blobs, so a 
+// 3 x 3 block of cells usually holds enough blobs to end a search.
+const double BlobGrid::CELLS_PER_SPACING = 1.5;
+
+// The cells are at least the largest distance over this, so a search covers at
+// most this many rings of cells (even for one blob, or blobs close together).
+const int BlobGrid::MAX_RINGS = 8;
+
+// Below this many blobs, measuring the distance to all of them is cheaper than
+// searching the cells.
+const int BlobGrid::LINEAR_SCAN_BLOBS = 32;
+
+BlobGrid::BlobGrid() :
+  maxDistanceSquared_( 0.0 ),
+  cellSize_( 1.0 ),
+  cellsPerPixel_( 1.0f ),
+  maxRing_( 1 ),
+  bucketMask_( 0 ),
+  isLinearScan_( false ),
+  bucketStarts_(),
+  entries_(),
+  unsorted_()
+{
+}
+
+BlobGrid::~BlobGrid()
+{
+}
+
+/***************************************************************************//**
+Sorts the blobs into buckets by the cell their centroid is in.  The max 
+distance (not squared) is the largest distance allowed between a tracked blob 
+and its match, and findNear() only gives blobs within that distance.  With 
+fewer than LINEAR_SCAN_BLOBS blobs, they are only copied in index order.
+*******************************************************************************/
+void BlobGrid::build( const std::vector<blobTracker::Blob> & blobs, double maxDistance )
+{
+    int numBlobs = (int)blobs.size(),
+        numBuckets = 16;
+
+    while( numBuckets < 2 * numBlobs ) {
+        numBuckets *= 2;
+    }
+    maxDistanceSquared_ = maxDistance * maxDistance;
+    isLinearScan_ = (numBlobs < LINEAR_SCAN_BLOBS);
+    cellSize_ = std::max( std::min( maxDistance, CELLS_PER_SPACING * averageSpacing( blobs ) ),
+                          maxDistance / MAX_RINGS );
+
+    if( cellSize_ < 1.0 ) {
+        cellSize_ = 1.0;
+    }
+    cellsPerPixel_ = (float)(1.0 / cellSize_);
+    maxRing_ = (int)std::ceil( maxDistance / cellSize_ );
+    bucketMask_ = numBuckets - 1;
+    bucketStarts_.assign( numBuckets + 1, 0 );
+    unsorted_.resize( numBlobs );
+    entries_.resize( numBlobs );
+
+    for( int i = 0; i < numBlobs; ++i ) {
+        Entry & entry = unsorted_[i];
+        entry.x = blobs[i].centroid.x;
+        entry.y = blobs[i].centroid.y;
+        entry.cellX = cellOf( entry.x );
+        entry.cellY = cellOf( entry.y );
+        entry.blobIndex = i;
+        ++bucketStarts_[bucketOf( entry.cellX, entry.cellY )];
+    }
+    if( isLinearScan_ ) {
+        entries_.swap( unsorted_ );
+        return;
+    }
+    // Each count becomes the end of its bucket...
+    for( int b = 1; b < numBuckets; ++b ) {
+        bucketStarts_[b] += bucketStarts_[b - 1];
+    }
+    bucketStarts_[numBuckets] = numBlobs;
+
+    // ...and then its start, as the bucket is filled from the end (so its 
+    // blobs stay in index order).
+    for( int i = numBlobs - 1; i >= 0; --i ) {
+        const Entry & entry = unsorted_[i];
+        entries_[--bucketStarts_[bucketOf( entry.cellX, entry.cellY )]] = entry;
+    }
+}
+
+/***************************************************************************//**
+Appends a match (index and squared distance) for the blobs within the max 
+distance of the point, searching rings of cells outward from the cell the 
+point is in.  The search ends early once minMatches of the blobs found are 
+closer than any blob outside of the rings searched so far, so the minMatches 
+closest blobs are always given (if there are that many within the max 
+distance), but farther ones may not be.  It also ends once every blob has been
+seen.  Blobs in other cells that hash to the same buckets are skipped, so no 
+blob is given twice.
+*******************************************************************************/
+void BlobGrid::findNear( float x, 
+                         float y, 
+                         int minMatches,
+                         std::vector<blobTracker::BlobMatch> & matches ) const
+{
+    if( entries_.empty() ) {
+        return;
+    }
+    if( isLinearScan_ ) {
+        addAllMatches( x, y, matches );
+        return;
+    }
+    int centerX = cellOf( x ),
+        centerY = cellOf( y ),
+        firstMatch = matches.size(),
+        numEntries = entries_.size(),
+        numSeen = 0;
+
+    for( int ring = 0; ring <= maxRing_; ++ring ) {
+        if( ring == 0 ) {
+            numSeen += addCellMatches( centerX, centerY, x, y, matches );
+        }
+        else {
+            for( int i = -ring; i <= ring; ++i ) {
+                numSeen += addCellMatches( centerX + i, centerY - ring, x, y, matches );
+                numSeen += addCellMatches( centerX + i, centerY + ring, x, y, matches );
+            }
+            for( int i = 1 - ring; i < ring; ++i ) {
+                numSeen += addCellMatches( centerX - ring, centerY + i, x, y, matches );
+                numSeen += addCellMatches( centerX + ring, centerY + i, x, y, matches );
+            }
+        }
+        if( numSeen == numEntries ) {
+            break;
+        }
+        // Any blob outside of the rings so far is more than ring cell sizes 
+        // away from the point.
+        double outsideDistance = ring * cellSize_;
+        int numMatches = matches.size(),
+            numCloser = 0;
+
+        for( int m = firstMatch; m < numMatches; ++m ) {
+            if( matches[m].distance() <= outsideDistance * outsideDistance ) {
+                ++numCloser;
+            }
+        }
+        if( numCloser >= minMatches ) {
+            break;
+        }
+    }
+}
+
+/***************************************************************************//**
+Frees the bucket storage.
+*******************************************************************************/
+void BlobGrid::clear()
+{
+    std::vector<int>().swap( bucketStarts_ );
+    std::vector<Entry>().swap( entries_ );
+    std::vector<Entry>().swap( unsorted_ );
+    bucketMask_ = 0;
+}
+
+/***************************************************************************//**
+The side of the square that would hold each blob if the blobs were spread 
+evenly over their bounding box.
+*******************************************************************************/
+double BlobGrid::averageSpacing( const std::vector<blobTracker::Blob> & blobs ) const
+{
+    int numBlobs = (int)blobs.size();
+
+    if( numBlobs < 2 ) {
+        return 0.0;
+    }
+    float left = blobs[0].centroid.x,
+          right = left,
+          top = blobs[0].centroid.y,
+          bottom = top;
+
+    for( int i = 1; i < numBlobs; ++i ) {
+        left = std::min( left, blobs[i].centroid.x );
+        right = std::max( right, blobs[i].centroid.x );
+        top = std::min( top, blobs[i].centroid.y );
+        bottom = std::max( bottom, blobs[i].centroid.y );
+    }
+    double width = std::max( right - left, 1.0f ),
+           height = std::max( bottom - top, 1.0f );
+    return std::sqrt( width * height / numBlobs );
+}
+
+int BlobGrid::cellOf( float coordinate ) const
+{
+    return (int)std::floor( coordinate * cellsPerPixel_ );
+}
+
+int BlobGrid::bucketOf( int cellX, int cellY ) const
+{
+    unsigned int hash = (unsigned int)cellX * 73856093u ^ (unsigned int)cellY * 19349663u;
+    return (int)(hash & (unsigned int)bucketMask_);
+}
+
+/***************************************************************************//**
+Appends the matches within the max distance from the blobs in the cell, and 
+returns the number of blobs in the cell (near enough or not).
+*******************************************************************************/
+int BlobGrid::addCellMatches( int cellX, int cellY, float x, float y, std::vector<blobTracker::BlobMatch> & matches ) const
+{
+    int bucket = bucketOf( cellX, cellY ),
+        end = bucketStarts_[bucket + 1],
+        numInCell = 0;
+
+    for( int i = bucketStarts_[bucket]; i < end; ++i ) {
+        const Entry & entry = entries_[i];
+
+        if( entry.cellX == cellX && entry.cellY == cellY ) {
+            double dx = entry.x - x,
+                   dy = entry.y - y,
+                   distance = dx * dx + dy * dy;
+            ++numInCell;
+
+            if( distance <= maxDistanceSquared_ ) {
+                matches.push_back( blobTracker::BlobMatch( entry.blobIndex, distance ) );
+            }
+        }
+    }
+    return numInCell;
+}
+
+/***************************************************************************//**
+Appends the matches within the max distance from all of the blobs (for the 
+few-blob case, see LINEAR_SCAN_BLOBS).
+*******************************************************************************/
+void BlobGrid::addAllMatches( float x, float y, std::vector<blobTracker::BlobMatch> & matches ) const
+{
+    int numEntries = entries_.size();
+
+    for( int i = 0; i < numEntries; ++i ) {
+        const Entry & entry = entries_[i];
+        double dx = entry.x - x,
+               dy = entry.y - y,
+               distance = dx * dx + dy * dy;
+
+        if( distance <= maxDistanceSquared_ ) {
+            matches.push_back( blobTracker::BlobMatch( entry.blobIndex, distance ) );
+        }
+    }
+}
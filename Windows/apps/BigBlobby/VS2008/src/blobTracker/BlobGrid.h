@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+// BlobGrid
+//
+// PURPOSE: Uniform grid (spatial hash) of the new blobs of a frame, so that the
+//          tracker only compares a tracked blob with the new blobs near it.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBTRACKER_BLOBGRID_H
+#define BLOBTRACKER_BLOBGRID_H
+
+#include "blobTracker/Blob.h"
+#include "blobTracker/BlobMatch.h"
+#include <vector>
+
+namespace blobTracker
+{
+    /***********************************************************************//**
+    Puts the centroids of a frame's new blobs into square cells, so that the 
+    new blobs near a tracked blob can be found without looking at all of 
+    them.  The cells are about the size of the average spacing of the blobs 
+    (but never bigger than the largest distance a tracked blob may move), and
+    findNear() searches rings of cells outward from the tracked blob, so the 
+    cost of a search does not grow with the number of blobs even when the 
+    largest distance covers many of them.  The cells are hashed into a table 
+    of buckets (at least twice as many buckets as blobs), so the grid does 
+    not depend on the image size.  Each bucket is a range of one flat array 
+    that is filled with a counting sort (along with a copy of each centroid, 
+    so a search does not touch the Blobs), and all the storage is kept from 
+    frame to frame.
+
+    The cells are never smaller than an eighth of the largest distance, so a
+    search never looks at more than 17 x 17 cells, and it stops as soon as 
+    every blob has been seen.  With only a few blobs (fewer than 
+    LINEAR_SCAN_BLOBS), findNear() just measures the distance to each of them.
+    ***************************************************************************/
+    class BlobGrid
+    {
+    public:
+        static const double CELLS_PER_SPACING;
+        static const int MAX_RINGS;
+        static const int LINEAR_SCAN_BLOBS;
+
+        BlobGrid();
+        ~BlobGrid();
+
+        void build( const std::vector<blobTracker::Blob> & blobs, double maxDistance );
+        void findNear( float x, 
+                       float y, 
+                       int minMatches,
+                       std::vector<blobTracker::BlobMatch> & matches ) const;
+        void clear();
+
+    private:
+        struct Entry
+        {
+            float x,
+                  y;
+            int cellX,
+                cellY,
+                blobIndex;
+        };
+
+        double averageSpacing( const std::vector<blobTracker::Blob> & blobs ) const;
+        int cellOf( float coordinate ) const;
+        int bucketOf( int cellX, int cellY ) const;
+        int addCellMatches( int cellX, int cellY, float x, float y, std::vector<blobTracker::BlobMatch> & matches ) const;
+        void addAllMatches( float x, float y, std::vector<blobTracker::BlobMatch> & matches ) const;
+
+        double maxDistanceSquared_,
+               cellSize_;
+        float cellsPerPixel_;
+        int maxRing_;
+        int bucketMask_;
+        bool isLinearScan_;
+        std::vector<int> bucketStarts_;
+        std::vector<Entry> entries_,
+                           unsorted_;
+    };
+}
+
+#endif
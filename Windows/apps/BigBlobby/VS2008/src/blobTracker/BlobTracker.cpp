@@ -97,6 +97,22 @@ BlobTracker::BlobTracker() :
   touchEvents_( blobTouchEvents::TouchEvents::instance() ),
   calibrationUtils_( NULL ),
   trackedBlobHolders_(),
+  spareTrackedBlobHolders_(),
+  blobGrid_(),
+  assignmentSolver_(),
+  nearBlobs_(),
+  firstChoiceCounts_(),
+  groupParents_(),
+  groupStarts_(),
+  groupRows_(),
+  groupCols_(),
+  colOfBlob_(),
+  colOfRow_(),
+  groupCosts_(),
+  continuingIds_(),
+  newIds_(),
+  screenPositions_(),
+  screenDimensions_(),
   calibratedTrackedBlobs_(),
   uniqueIdCounter_( 0 ),
   frameCount_( 0 ),
@@ -107,6 +123,7 @@ BlobTracker::BlobTracker() :
   frameCountForLastDelete_( 0 ),
   diffCounts_( MAX_DIFF_INDEX + 1, 0 ),
   maxBlobDistanceSquared_( 0.0 ),
+  useOptimalAssignment_( false ),
   isCalibrating_( false ),
   hasBlobsInScreenArea_( false ),
   debugPrintCurrentFrame_( false ),
@@ -117,6 +134,12 @@ BlobTracker::BlobTracker() :
 
 BlobTracker::~BlobTracker()
 {
+    for( int i = 0; i < (int)trackedBlobHolders_.size(); ++i ) {
+        delete trackedBlobHolders_[i];
+    }
+    for( int i = 0; i < (int)spareTrackedBlobHolders_.size(); ++i ) {
+        delete spareTrackedBlobHolders_[i];
+    }
 }
 
 void BlobTracker::passInCalibration( CalibrationUtils * calibrationUtils ) 
@@ -142,7 +165,25 @@ void BlobTracker::setMaxBlobDistance( int cameraWidth )
     maxBlobDistanceSquared_ = blobDistance * blobDistance;
 }
 
-std::map<int, blobTracker::Blob> * BlobTracker::getTrackedBlobs()
+/***************************************************************************//**
+Turns on or off matching the tracked blobs and new blobs with the smallest 
+total distance (see the class comment) on frames where the closest matches 
+contend for the same new blobs.  Off by default.
+*******************************************************************************/
+void BlobTracker::useOptimalAssignment( bool b )
+{
+    useOptimalAssignment_ = b;
+}
+
+bool BlobTracker::useOptimalAssignment()
+{
+    return useOptimalAssignment_;
+}
+
+/***************************************************************************//**
+The calibrated (screen space) tracked blobs, sorted by ID.
+*******************************************************************************/
+std::vector<blobTracker::Blob> * BlobTracker::getTrackedBlobs()
 {
     return &calibratedTrackedBlobs_;
 }
@@ -173,12 +214,19 @@ void BlobTracker::track( vector<blobTracker::Blob> & newBlobs )
     numberOfTracksLastFrame_ = trackedBlobHolders_.size();
     numberOfNewBlobs_ = newBlobs.size();
     hasBlobsInScreenArea_ = false;
+    continuingIds_.clear();
+    newIds_.clear();
 
     ////checkFrameCount();
     buildListOfPotentialMatches( newBlobs );
+
+    if( useOptimalAssignment_ && hasContendedFirstChoices() ) {
+        assignOptimally();
+    }
     sortTrackedBlobsByDistance();
     processMatches( newBlobs );
     addNewTracks( newBlobs );
+    calibrateOutput();
 }
 
 /***************************************************************************//**
@@ -198,7 +246,8 @@ void BlobTracker::checkFrameCount()
 Each tracked blob from the last frame will identify several nearby new blobs
 as potential matches.  A TrackedBlobHolder object is used to store info on a 
 tracked blob and the index and distance of its nearest MAX_NUMBER_OF_MATCHES
-new blobs.  
+new blobs.  The new blobs are put in a BlobGrid first, so each tracked blob 
+only measures the distance to the new blobs in the cells nearest to it.
 
 NOTE: If a Blob has no potential matches (due to great distance or an empty 
 list of new blobs), the processMatches() function will decrement that blob's 
@@ -207,10 +256,161 @@ deathCount and possibly delete it.
 void BlobTracker::buildListOfPotentialMatches( vector<blobTracker::Blob> & newBlobs )
 {
     int length = trackedBlobHolders_.size();
+    blobGrid_.build( newBlobs, std::sqrt( maxBlobDistanceSquared_ ) );
     
     for( int i = 0; i < length; ++i ) {
         blobTracker::TrackedBlobHolder * trackedBlobHolder = trackedBlobHolders_[i];
-        trackedBlobHolder->setBestMatches( newBlobs, maxBlobDistanceSquared_ );
+        const ofPoint & centroid = trackedBlobHolder->trackedBlob().centroid;
+        nearBlobs_.clear();
+        blobGrid_.findNear( centroid.x, centroid.y, blobTracker::TrackedBlobHolder::MAX_NUMBER_OF_MATCHES, nearBlobs_ );
+        trackedBlobHolder->setBestMatches( nearBlobs_ );
+    }
+}
+
+/***************************************************************************//**
+True if some new blob is the first choice of more than one tracked blob.  If 
+not, the greedy matching already gives every tracked blob its closest new 
+blob, which is also the best matching overall.
+*******************************************************************************/
+bool BlobTracker::hasContendedFirstChoices()
+{
+    int numTracks = trackedBlobHolders_.size();
+    firstChoiceCounts_.assign( numberOfNewBlobs_, 0 );
+
+    for( int i = 0; i < numTracks; ++i ) {
+        int index = trackedBlobHolders_[i]->firstChoiceIndex();
+
+        if( index >= 0 && ++firstChoiceCounts_[index] > 1 ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/***************************************************************************//**
+Splits the tracked blobs and new blobs into groups that are linked by 
+potential matches (a union-find over tracked blobs and new blobs), and works 
+out the matching with the smallest total distance for each group that has 
+more than one tracked blob.  Afterwards, each tracked blob's only match is 
+the one it was given (or it has none), so processMatches() has no contests to
+settle.
+*******************************************************************************/
+void BlobTracker::assignOptimally()
+{
+    int numTracks = trackedBlobHolders_.size(),
+        numNodes = numTracks + numberOfNewBlobs_;
+    groupParents_.resize( numNodes );
+
+    for( int node = 0; node < numNodes; ++node ) {
+        groupParents_[node] = node;
+    }
+    for( int i = 0; i < numTracks; ++i ) {
+        blobTracker::TrackedBlobHolder * trackedBlobHolder = trackedBlobHolders_[i];
+        int numMatches = trackedBlobHolder->numberOfMatches();
+
+        for( int m = 0; m < numMatches; ++m ) {
+            joinGroups( i, numTracks + trackedBlobHolder->match( m ).newBlobIndex() );
+        }
+    }
+    // Counting sort of the tracked blobs by group, so each group is one range.
+    groupStarts_.assign( numNodes + 1, 0 );
+
+    for( int i = 0; i < numTracks; ++i ) {
+        ++groupStarts_[findGroup( i ) + 1];
+    }
+    for( int node = 0; node < numNodes; ++node ) {
+        groupStarts_[node + 1] += groupStarts_[node];
+    }
+    groupRows_.resize( numTracks );
+
+    for( int i = 0; i < numTracks; ++i ) {
+        groupRows_[groupStarts_[findGroup( i )]++] = i;
+    }
+    colOfBlob_.assign( numberOfNewBlobs_, -1 );
+    int begin = 0;
+
+    while( begin < numTracks ) {
+        int group = findGroup( groupRows_[begin] ),
+            end = begin + 1;
+
+        while( end < numTracks && findGroup( groupRows_[end] ) == group ) {
+            ++end;
+        }
+        if( end - begin > 1 ) {
+            assignGroup( begin, end );
+        }
+        begin = end;
+    }
+}
+
+int BlobTracker::findGroup( int node )
+{
+    while( groupParents_[node] != node ) {
+        groupParents_[node] = groupParents_[groupParents_[node]];
+        node = groupParents_[node];
+    }
+    return node;
+}
+
+void BlobTracker::joinGroups( int a, int b )
+{
+    a = findGroup( a );
+    b = findGroup( b );
+
+    if( a != b ) {
+        groupParents_[b] = a;
+    }
+}
+
+/***************************************************************************//**
+Solves the matching for the tracked blobs in groupRows_[begin, end).  The 
+cost of a match is its squared distance.  Each tracked blob also has a column
+of its own for going unmatched, at the cost of the largest allowed squared 
+distance, so a tracked blob is never forced onto a new blob that it cannot 
+match.
+*******************************************************************************/
+void BlobTracker::assignGroup( int begin, int end )
+{
+    int numRows = end - begin;
+    groupCols_.clear();
+
+    for( int r = 0; r < numRows; ++r ) {
+        blobTracker::TrackedBlobHolder * trackedBlobHolder = trackedBlobHolders_[groupRows_[begin + r]];
+        int numMatches = trackedBlobHolder->numberOfMatches();
+
+        for( int m = 0; m < numMatches; ++m ) {
+            int index = trackedBlobHolder->match( m ).newBlobIndex();
+
+            if( colOfBlob_[index] == -1 ) {
+                colOfBlob_[index] = groupCols_.size();
+                groupCols_.push_back( index );
+            }
+        }
+    }
+    int numBlobCols = groupCols_.size(),
+        numCols = numBlobCols + numRows;
+    double unmatchedCost = maxBlobDistanceSquared_,
+           impossibleCost = 4.0 * maxBlobDistanceSquared_ + 1.0;
+    groupCosts_.assign( numRows * numCols, impossibleCost );
+
+    for( int r = 0; r < numRows; ++r ) {
+        blobTracker::TrackedBlobHolder * trackedBlobHolder = trackedBlobHolders_[groupRows_[begin + r]];
+        int numMatches = trackedBlobHolder->numberOfMatches();
+        double * costs = &groupCosts_[r * numCols];
+
+        for( int m = 0; m < numMatches; ++m ) {
+            const blobTracker::BlobMatch & match = trackedBlobHolder->match( m );
+            costs[colOfBlob_[match.newBlobIndex()]] = match.distance();
+        }
+        for( int c = numBlobCols; c < numCols; ++c ) {
+            costs[c] = unmatchedCost;
+        }
+    }
+    assignmentSolver_.solve( groupCosts_, numRows, numCols, colOfRow_ );
+
+    for( int r = 0; r < numRows; ++r ) {
+        int c = colOfRow_[r];
+        trackedBlobHolders_[groupRows_[begin + r]]->setOnlyMatch( (c >= 0 && c < numBlobCols) ? groupCols_[c] : -1 );
     }
 }
 
@@ -318,12 +518,12 @@ void BlobTracker::updateTrackedBlob( blobTracker::Blob & trackedBlob, blobTracke
     //if blob has been 'holding/sitting' for 1 second send a held event
     if( trackedBlob.sitting > 1.0f ) {
         sendRAWTouchHeldEventIfCalibrating( trackedBlob );
-        addContinuingTrackToOutputMap( trackedBlob );
+        addContinuingTrackToOutput( trackedBlob );
         trackedBlob.sitting = -1; // Held event only happens once, so set to -1.
     } 
     else { // Must be moving.
         sendRAWTouchMovedEventIfCalibrating( trackedBlob );
-        addContinuingTrackToOutputMap( trackedBlob );
+        addContinuingTrackToOutput( trackedBlob );
     }
     // The last lastTimeTimeWasChecked is updated at the end 
     // after all acceleration values are calculated. -AlexP
@@ -394,30 +594,21 @@ void BlobTracker::calculateAgeAndTimeSitting( blobTracker::Blob & trackedBlob )
 }
 
 /***************************************************************************//**
-Uses the CalibrationUtils object to adjust the centroid and bounding box of the 
-tracked blob before adding the map of calibrated tracked blobs.
+Writes the tracked blob over the track's calibrated blob from the last frame.
+Its centroid and bounding box are mapped to screen space by calibrateOutput()
+at the end of the frame.
 *******************************************************************************/
-void BlobTracker::addContinuingTrackToOutputMap( const blobTracker::Blob & trackedBlob )
+void BlobTracker::addContinuingTrackToOutput( const blobTracker::Blob & trackedBlob )
 {
-    blobTracker::Blob calibratedBlob = trackedBlob;
-
-    // Calibrate bounding box and centroid.
-    calibrationUtils_->transformDimension( calibratedBlob.boundingRect.width, calibratedBlob.boundingRect.height );
-    calibrationUtils_->cameraToScreenPosition( calibratedBlob.centroid.x, calibratedBlob.centroid.y );
-    calibrationUtils_->cameraToScreenPosition( calibratedBlob.lastCentroid.x, calibratedBlob.lastCentroid.y );
+    blobTracker::Blob & calibratedBlob = outputBlob( trackedBlob.id );
+    calibratedBlob = trackedBlob;
+    continuingIds_.push_back( trackedBlob.id );
     calibratedBlob.D.set( trackedBlob.centroid.x - trackedBlob.lastCentroid.x, trackedBlob.centroid.y - trackedBlob.lastCentroid.y );
 
     // Calibrated acceleration
     ofPoint tD = calibratedBlob.D;
     calibratedBlob.maccel = sqrtf((tD.x*tD.x)+(tD.y*tD.y)) / (elapsedTimeMillis_ - calibratedBlob.lastTimeTimeWasChecked);
     calibratedBlob.lastTimeTimeWasChecked = elapsedTimeMillis_;
-
-    // Add to map of calibrated tracked blobs.
-    calibratedTrackedBlobs_[calibratedBlob.id] = calibratedBlob;
-
-    if( calibratedBlob.centroid.x > 0 || calibratedBlob.centroid.y > 0 ) { 
-        hasBlobsInScreenArea_ = true; 
-    }
 }
 
 /***************************************************************************//**
@@ -459,17 +650,17 @@ void BlobTracker::deleteTrackedBlob( int index )
         TrackedBlobIterator iter = trackedBlobHolders_.begin() + index;
         blobTracker::TrackedBlobHolder * trackedBlobHolder = *iter;
         sendRAWTouchUpEventIfCalibrating( trackedBlobHolder->trackedBlob() );
-        calibratedTrackedBlobs_.erase( trackedBlobHolder->trackedBlobId() );
+        removeOutputBlob( trackedBlobHolder->trackedBlobId() );
         trackedBlobHolders_.erase( iter );
-        delete trackedBlobHolder;
+        spareTrackedBlobHolders_.push_back( trackedBlobHolder );
     }
 }
 
 /***************************************************************************//**
 When this function is called, every blob should be either labeled with a tracked
 id or have an id of -1.  If the id is -1, a new track must be made, and the 
-tracked blob needs to be added to the map of calibrated tracked blobs, as well 
-as to the vector of tracked blobs that will be needed for the next frame.
+tracked blob needs to be added to the calibrated tracked blobs, as well as to
+the vector of tracked blobs that will be needed for the next frame.
 *******************************************************************************/
 void BlobTracker::addNewTracks( vector<blobTracker::Blob> & newBlobs )
 {
@@ -483,38 +674,136 @@ void BlobTracker::addNewTracks( vector<blobTracker::Blob> & newBlobs )
 
             //debugPrintNewTrackedBlob( unmatchedBlob );
             debugPrintNewTrackedBlobDiffCounts( unmatchedBlob );
-            addNewTrackToOutputMap( unmatchedBlob );
+            addNewTrackToOutput( unmatchedBlob );
 		}
 	}
 }
 
 /***************************************************************************//**
-Creates a new TrackedBlobHolder object that stores info on the blob given as an arg.
+Stores info on the blob given as an arg in a TrackedBlobHolder object (one 
+left over from a deleted track if there is one, so a new one is only created 
+when there are more tracks than ever before).
 *******************************************************************************/
 void BlobTracker::addToTrackedBlobs( blobTracker::Blob & blob )
 {
-    blobTracker::TrackedBlobHolder * blobMatches = new blobTracker::TrackedBlobHolder();
+    blobTracker::TrackedBlobHolder * blobMatches = NULL;
+
+    if( spareTrackedBlobHolders_.empty() ) {
+        blobMatches = new blobTracker::TrackedBlobHolder();
+    }
+    else {
+        blobMatches = spareTrackedBlobHolders_.back();
+        spareTrackedBlobHolders_.pop_back();
+    }
     blobMatches->setTrackedBlob( blob );
     trackedBlobHolders_.push_back( blobMatches );
 }
 
 /***************************************************************************//**
-Copies the blob and converts the centroid and bounding box from camera space 
-to screen space before adding it to the map of tracked blobs that servers as 
-the final output from the tracking algorithm.
+Copies the blob into the tracked blobs that serve as the final output from 
+the tracking algorithm.  Its centroid and bounding box are mapped to screen 
+space by calibrateOutput() at the end of the frame.
+*******************************************************************************/
+void BlobTracker::addNewTrackToOutput( const blobTracker::Blob & trackedBlob )
+{
+    outputBlob( trackedBlob.id ) = trackedBlob;
+    newIds_.push_back( trackedBlob.id );
+}
+
+/***************************************************************************//**
+Converts the centroids and bounding box sizes of the output blobs that were 
+updated this frame from camera space to screen space, all in one batch.  The 
+last centroid is only converted for continuing tracks (a new track has none).
+*******************************************************************************/
+void BlobTracker::calibrateOutput()
+{
+    int numContinuing = continuingIds_.size(),
+        numNew = newIds_.size(),
+        numBlobs = numContinuing + numNew;
+
+    if( numBlobs == 0 ) {
+        return;
+    }
+    screenPositions_.clear();
+    screenDimensions_.clear();
+
+    for( int i = 0; i < numBlobs; ++i ) {
+        bool isContinuing = (i < numContinuing);
+        const blobTracker::Blob & blob = outputBlob( isContinuing ? continuingIds_[i] : newIds_[i - numContinuing] );
+        screenPositions_.push_back( vector2df( blob.centroid.x, blob.centroid.y ) );
+
+        if( isContinuing ) {
+            screenPositions_.push_back( vector2df( blob.lastCentroid.x, blob.lastCentroid.y ) );
+        }
+        screenDimensions_.push_back( vector2df( blob.boundingRect.width, blob.boundingRect.height ) );
+    }
+    calibrationUtils_->cameraToScreenPositions( &screenPositions_[0], screenPositions_.size() );
+    calibrationUtils_->transformDimensions( &screenDimensions_[0], numBlobs );
+    int position = 0;
+
+    for( int i = 0; i < numBlobs; ++i ) {
+        bool isContinuing = (i < numContinuing);
+        blobTracker::Blob & calibratedBlob = outputBlob( isContinuing ? continuingIds_[i] : newIds_[i - numContinuing] );
+        calibratedBlob.centroid.set( screenPositions_[position].X, screenPositions_[position].Y );
+        ++position;
+
+        if( isContinuing ) {
+            calibratedBlob.lastCentroid.set( screenPositions_[position].X, screenPositions_[position].Y );
+            ++position;
+        }
+        calibratedBlob.boundingRect.width = screenDimensions_[i].X;
+        calibratedBlob.boundingRect.height = screenDimensions_[i].Y;
+
+        if( calibratedBlob.centroid.x > 0 || calibratedBlob.centroid.y > 0 ) { 
+            hasBlobsInScreenArea_ = true; 
+        }
+    }
+}
+
+/***************************************************************************//**
+Returns the output blob with the given ID, inserting one (in ID order) if 
+there is none yet.  New IDs are higher than all the others, so a new blob goes
+at the end, and nothing has to be moved.
+*******************************************************************************/
+blobTracker::Blob & BlobTracker::outputBlob( int id )
+{
+    int index = findOutputIndex( id );
+
+    if( index == (int)calibratedTrackedBlobs_.size() || calibratedTrackedBlobs_[index].id != id ) {
+        calibratedTrackedBlobs_.insert( calibratedTrackedBlobs_.begin() + index, blobTracker::Blob() );
+    }
+    return calibratedTrackedBlobs_[index];
+}
+
+void BlobTracker::removeOutputBlob( int id )
+{
+    int index = findOutputIndex( id );
+
+    if( index < (int)calibratedTrackedBlobs_.size() && calibratedTrackedBlobs_[index].id == id ) {
+        calibratedTrackedBlobs_.erase( calibratedTrackedBlobs_.begin() + index );
+    }
+}
+
+/***************************************************************************//**
+The index of the first output blob with an ID that is not less than the given
+one (the number of output blobs if there is none).
 *******************************************************************************/
-void BlobTracker::addNewTrackToOutputMap( const blobTracker::Blob & trackedBlob )
+int BlobTracker::findOutputIndex( int id )
 {
-    blobTracker::Blob calibratedBlob = trackedBlob;
-    calibrationUtils_->transformDimension( calibratedBlob.boundingRect.width, 
-                                           calibratedBlob.boundingRect.height);
-    calibrationUtils_->cameraToScreenPosition( calibratedBlob.centroid.x,
-                                               calibratedBlob.centroid.y );
-    calibratedTrackedBlobs_[calibratedBlob.id] = calibratedBlob;
+    int first = 0,
+        last = calibratedTrackedBlobs_.size();
+
+    while( first < last ) {
+        int middle = (first + last) / 2;
 
-    if( calibratedBlob.centroid.x > 0 || calibratedBlob.centroid.y > 0 ) { 
-        hasBlobsInScreenArea_ = true; 
+        if( calibratedTrackedBlobs_[middle].id < id ) {
+            first = middle + 1;
+        }
+        else {
+            last = middle;
+        }
     }
+    return first;
 }
 
 void BlobTracker::sendRAWTouchUpEventIfCalibrating( blobTracker::Blob & blob )
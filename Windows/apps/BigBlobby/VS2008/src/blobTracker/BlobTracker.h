@@ -76,9 +76,10 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BLOBTRACKER_BLOBTRACKER_H
 
 #include "blobTracker/ContourFinder.h"
+#include "blobTracker/BlobGrid.h"
+#include "blobTracker/AssignmentSolver.h"
 #include "blobCalibration/CalibrationUtils.h"
 #include <list>
-#include <map>
 #include <vector>
 
 namespace blobTracker { class TrackedBlobHolder; }
@@ -88,6 +89,25 @@ typedef std::vector<blobTracker::TrackedBlobHolder *>::iterator TrackedBlobItera
 
 namespace blobTracker 
 {
+    /***********************************************************************//**
+    Gives each new blob from the ContourFinder the ID of the tracked blob (from
+    earlier frames) that it continues, or a new ID.  Each tracked blob only 
+    looks at the new blobs that a BlobGrid finds near it, so the cost grows 
+    with the number of blobs rather than with its square.  By default, the 
+    closest pairs are matched first (greedily).  With useOptimalAssignment(),
+    frames where several tracked blobs want the same new blob are instead 
+    matched with the smallest total (squared) distance by an 
+    AssignmentSolver, one group of contending blobs at a time, which avoids 
+    swapped IDs when many fingers are close together.
+
+    The output (see getTrackedBlobs()) is a vector of calibrated blobs sorted 
+    by ID.  IDs only ever go up, so a new track is added at the end, and a 
+    continuing track is found by binary search and overwritten in place.  The
+    output blobs of the frame are then mapped to screen space in one batch 
+    (see CalibrationUtils::cameraToScreenPositions()).  
+    Blobs hold no heap memory (see Blob), so once the tracker has seen as many
+    blobs as the current frame has, tracking a frame does not allocate.
+    ***************************************************************************/
     class BlobTracker
     {
     public:
@@ -102,7 +122,9 @@ namespace blobTracker
 	    void passInCalibration( CalibrationUtils * calibrationUtils );
         void setCalibrating( bool b );
         void setMaxBlobDistance( int cameraWidth );
-	    std::map<int, blobTracker::Blob> * getTrackedBlobs();
+        void useOptimalAssignment( bool b );
+        bool useOptimalAssignment();
+	    std::vector<blobTracker::Blob> * getTrackedBlobs();
         bool hasBlobsInScreenArea();
 
 	    void track( vector<blobTracker::Blob> & newBlobs );
@@ -111,19 +133,28 @@ namespace blobTracker
         void checkFrameCount();
 
         void buildListOfPotentialMatches( vector<blobTracker::Blob> & newBlobs );
+        bool hasContendedFirstChoices();
+        void assignOptimally();
+        int findGroup( int node );
+        void joinGroups( int a, int b );
+        void assignGroup( int begin, int end );
         void sortTrackedBlobsByDistance();
         void processMatches( vector<blobTracker::Blob> & newBlobs );
         void updateKeyParamsOfNewBlob( blobTracker::Blob & newBlob, blobTracker::Blob & trackedBlob );
         void updateTrackedBlob( blobTracker::Blob & trackedBlob, blobTracker::Blob & newBlob );
         void calculateAcceleration( blobTracker::Blob & trackedBlob );
         void calculateAgeAndTimeSitting( blobTracker::Blob & trackedBlob );
-        void addContinuingTrackToOutputMap( const blobTracker::Blob & trackedBlob );
+        void addContinuingTrackToOutput( const blobTracker::Blob & trackedBlob );
         void bubbleUpToMaintainSortedState( int index );
         void deleteTrackedBlob( int index );
 
         void addNewTracks( vector<blobTracker::Blob> & newBlobs );
         void addToTrackedBlobs( blobTracker::Blob & blob );
-        void addNewTrackToOutputMap( const blobTracker::Blob & trackedBlob );
+        void addNewTrackToOutput( const blobTracker::Blob & trackedBlob );
+        void calibrateOutput();
+        blobTracker::Blob & outputBlob( int id );
+        void removeOutputBlob( int id );
+        int findOutputIndex( int id );
 
         void sendRAWTouchUpEventIfCalibrating( blobTracker::Blob & blob );
         void sendRAWTouchHeldEventIfCalibrating( blobTracker::Blob & blob );
@@ -140,8 +171,24 @@ namespace blobTracker
 
         blobTouchEvents::TouchEvents & touchEvents_;
         CalibrationUtils * calibrationUtils_;
-        std::vector<blobTracker::TrackedBlobHolder *> trackedBlobHolders_;
-	    std::map<int, blobTracker::Blob> calibratedTrackedBlobs_;
+        std::vector<blobTracker::TrackedBlobHolder *> trackedBlobHolders_,
+                                                      spareTrackedBlobHolders_;
+        blobTracker::BlobGrid blobGrid_;
+        blobTracker::AssignmentSolver assignmentSolver_;
+        std::vector<blobTracker::BlobMatch> nearBlobs_;
+        std::vector<int> firstChoiceCounts_,
+                         groupParents_,
+                         groupStarts_,
+                         groupRows_,
+                         groupCols_,
+                         colOfBlob_,
+                         colOfRow_;
+        std::vector<double> groupCosts_;
+        std::vector<int> continuingIds_,
+                         newIds_;
+        std::vector<vector2df> screenPositions_,
+                               screenDimensions_;
+	    std::vector<blobTracker::Blob> calibratedTrackedBlobs_;
 	    int uniqueIdCounter_,
             frameCount_,
 	        movementFiltering_,
@@ -151,7 +198,8 @@ namespace blobTracker
             frameCountForLastDelete_;
         std::vector<int> diffCounts_;
         double maxBlobDistanceSquared_;
-	    bool isCalibrating_,
+	    bool useOptimalAssignment_,
+             isCalibrating_,
              hasBlobsInScreenArea_,
              debugPrintCurrentFrame_,
              debugPrint_;
@@ -0,0 +1,675 @@
+////////////////////////////////////////////////////////////////////////////////
+// ComponentLabeller
+//
+// PURPOSE: Finds the connected components (blobs) of a thresholded image in one
+//          pass, with the area, moments, and bounding box of each, and traces
+//          the outline of a component only when asked.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobTracker/ComponentLabeller.h"
+#include "blobUtils/WorkStealingPool.h"
+#include <boost/bind.hpp>
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using blobTracker::ComponentLabeller;
+using blobTracker::Component;
+using blobTracker::OutlinePoint;
+
+// Stripes shorter than this are not worth handing to another thread.
+const int ComponentLabeller::MIN_STRIPE_ROWS = 64;
+
+namespace
+{
+    // Freeman chain codes: 0 is east and the codes go anticlockwise on screen
+    // (so 2 is up, toward row - 1).
+    const int DX[8] = { 1,  1,  0, -1, -1, -1,  0,  1 },
+              DY[8] = { 0, -1, -1, -1,  0,  1,  1,  1 };
+
+    const float SQRT_2 = 1.41421356f;
+
+    // Index of the lowest set bit of a non-zero word.
+    inline int lowestSetBit( boost::uint64_t word )
+    {
+    #if defined(__GNUC__)
+        return __builtin_ctzll( word );
+    #elif defined(_MSC_VER)
+        unsigned long index;
+        if( _BitScanForward( &index, (unsigned long)word ) ) {
+            return (int)index;
+        }
+        _BitScanForward( &index, (unsigned long)(word >> 32) );
+        return (int)index + 32;
+    #else
+        int index = 0;
+        while( ((word >> index) & 1) == 0 ) { ++index; }
+        return index;
+    #endif
+    }
+}
+
+/***************************************************************************//**
+Orders component indices from largest to smallest area.
+*******************************************************************************/
+class ComponentLabeller::LargerArea
+{
+public:
+    LargerArea( const std::vector<Component> & components ) :
+      components_( components )
+    {
+    }
+
+    bool operator()( int a, int b ) const
+    {
+        return components_[a].area > components_[b].area;
+    }
+
+private:
+    const std::vector<Component> & components_;
+};
+
+ComponentLabeller::ComponentLabeller() :
+  threadPool_( NULL ),
+  pixels_( NULL ),
+  words_( NULL ),
+  weights_( NULL ),
+  stride_( 0 ),
+  wordsPerRow_( 0 ),
+  weightStride_( 0 ),
+  left_( 0 ),
+  top_( 0 ),
+  right_( 0 ),
+  bottom_( 0 ),
+  stripes_(),
+  numStripes_( 0 ),
+  stripeOffsets_(),
+  parents_(),
+  componentOfRoot_(),
+  components_(),
+  outline_(),
+  outlineMoves_()
+{
+}
+
+ComponentLabeller::~ComponentLabeller()
+{
+}
+
+/***************************************************************************//**
+Sets the pool (not owned) that labels the stripes.  Passing NULL labels the 
+whole image on the calling thread.
+*******************************************************************************/
+void ComponentLabeller::setThreadPool( blobUtils::WorkStealingPool * threadPool )
+{
+    threadPool_ = threadPool;
+}
+
+/***************************************************************************//**
+Sets the image (not owned, in whole-image coordinates) whose pixel values 
+weight the weighted sums of the components found by the following label() 
+calls.  Passing NULL turns the weighted sums off.
+*******************************************************************************/
+void ComponentLabeller::setWeights( const unsigned char * weights, int stride )
+{
+    weights_ = weights;
+    weightStride_ = stride;
+}
+
+/***************************************************************************//**
+Labels the non-zero pixels inside the rectangle from (left, top) up to (but not
+including) (right, bottom), and returns the number of components found.  The 
+pixels are only read, and must stay unchanged until the last traceOutline() 
+call for this image.
+*******************************************************************************/
+int ComponentLabeller::label( const unsigned char * pixels, int stride, 
+                              int left, int top, int right, int bottom )
+{
+    pixels_ = pixels;
+    words_ = NULL;
+    stride_ = stride;
+    return labelImage( left, top, right, bottom );
+}
+
+/***************************************************************************//**
+Labels the set bits of a bit-packed image (pixel x of a row is bit x % 64 of 
+word x / 64, see blobBuffers::BitBuffer), the same way.
+*******************************************************************************/
+int ComponentLabeller::label( const boost::uint64_t * words, int wordsPerRow, 
+                              int left, int top, int right, int bottom )
+{
+    pixels_ = NULL;
+    words_ = words;
+    wordsPerRow_ = wordsPerRow;
+    return labelImage( left, top, right, bottom );
+}
+
+int ComponentLabeller::labelImage( int left, int top, int right, int bottom )
+{
+    left_ = left;
+    top_ = top;
+    right_ = right;
+    bottom_ = bottom;
+    components_.clear();
+    numStripes_ = 0;
+
+    int rows = bottom - top;
+
+    if( (pixels_ == NULL && words_ == NULL) || rows <= 0 || right <= left ) {
+        return 0;
+    }
+    numStripes_ = 1;
+
+    if( threadPool_ != NULL ) {
+        numStripes_ = std::max( 1, std::min( threadPool_->numThreads(), rows / MIN_STRIPE_ROWS ) );
+    }
+    if( (int)stripes_.size() < numStripes_ ) {
+        stripes_.resize( numStripes_ );
+    }
+    for( int i = 0; i < numStripes_; ++i ) {
+        stripes_[i].firstRow = top + (rows * i) / numStripes_;
+        stripes_[i].endRow = top + (rows * (i + 1)) / numStripes_;
+    }
+    if( numStripes_ > 1 ) {
+        threadPool_->parallelFor( numStripes_, boost::bind( &ComponentLabeller::labelStripe, this, _1 ) );
+    }
+    else {
+        labelStripe( 0 );
+    }
+    // Number the runs of all the stripes in raster order, and join the runs 
+    // that touch across the stripe boundaries.
+    stripeOffsets_.resize( numStripes_ + 1 );
+    stripeOffsets_[0] = 0;
+
+    for( int i = 0; i < numStripes_; ++i ) {
+        stripeOffsets_[i + 1] = stripeOffsets_[i] + (int)stripes_[i].runs.size();
+    }
+    parents_.resize( stripeOffsets_[numStripes_] );
+
+    for( int i = 0; i < numStripes_; ++i ) {
+        const std::vector<Run> & runs = stripes_[i].runs;
+        int offset = stripeOffsets_[i],
+            numRuns = (int)runs.size();
+
+        for( int r = 0; r < numRuns; ++r ) {
+            parents_[offset + r] = offset + runs[r].parent;
+        }
+    }
+    for( int i = 0; i + 1 < numStripes_; ++i ) {
+        joinStripes( i, i + 1 );
+    }
+    addRunsToComponents();
+    return (int)components_.size();
+}
+
+int ComponentLabeller::numComponents() const
+{
+    return (int)components_.size();
+}
+
+const Component & ComponentLabeller::component( int index ) const
+{
+    return components_[index];
+}
+
+/***************************************************************************//**
+Fills indices with the components whose area is between minArea and maxArea 
+(exclusive), largest first, keeping no more than maxCount of them.  Only the 
+kept components are put in order (a partial sort).
+*******************************************************************************/
+void ComponentLabeller::selectLargest( int minArea, int maxArea, int maxCount, std::vector<int> & indices ) const
+{
+    indices.clear();
+    int count = (int)components_.size();
+
+    for( int i = 0; i < count; ++i ) {
+        int area = components_[i].area;
+
+        if( area > minArea && area < maxArea ) {
+            indices.push_back( i );
+        }
+    }
+    maxCount = std::max( maxCount, 0 );
+
+    if( (int)indices.size() > maxCount ) {
+        std::partial_sort( indices.begin(), indices.begin() + maxCount, indices.end(), LargerArea( components_ ) );
+        indices.resize( maxCount );
+    }
+    else {
+        std::sort( indices.begin(), indices.end(), LargerArea( components_ ) );
+    }
+}
+
+/***************************************************************************//**
+Traces the outer outline of a component (Moore neighbour tracing from its seed
+pixel, with Jacob's stopping rule) and returns the length of the outline.  The 
+outline pixels are put into points, up to maxPoints of them.  If approximate is 
+true, only the corners are kept (the pixels where the outline changes 
+direction), like CV_CHAIN_APPROX_SIMPLE.
+*******************************************************************************/
+float ComponentLabeller::traceOutline( int index, bool approximate, int maxPoints, std::vector<OutlinePoint> & points )
+{
+    points.clear();
+    outline_.clear();
+    outlineMoves_.clear();
+
+    const Component & c = components_[index];
+    OutlinePoint start = { c.seedX, c.seedY };
+    outline_.push_back( start );
+
+    // The seed has no neighbours above it or to its left, so the first search 
+    // starts as if the seed had been reached by a move down and to the right.
+    int x = c.seedX,
+        y = c.seedY,
+        direction = 7,
+        maxMoves = 4 * c.area + 4;
+
+    for( int moves = 0; moves < maxMoves; ++moves ) {
+        int first = (direction % 2 == 0) ? (direction + 7) % 8 : (direction + 6) % 8,
+            next = -1;
+
+        for( int i = 0; i < 8; ++i ) {
+            int d = (first + i) % 8;
+
+            if( isSet( x + DX[d], y + DY[d] ) ) {
+                next = d;
+                break;
+            }
+        }
+        if( next < 0 ) {
+            break; // A single pixel.
+        }
+        int nextX = x + DX[next],
+            nextY = y + DY[next];
+
+        // Back at the seed and about to repeat the first move, so the outline
+        // is closed (the copy of the seed at the end is dropped).
+        if( outline_.size() > 1 && x == start.x && y == start.y 
+            && nextX == outline_[1].x && nextY == outline_[1].y ) 
+        {
+            outline_.pop_back();
+            break;
+        }
+        OutlinePoint p = { nextX, nextY };
+        outline_.push_back( p );
+        outlineMoves_.push_back( next );
+        x = nextX;
+        y = nextY;
+        direction = next;
+    }
+    int numPoints = (int)outline_.size(),
+        numMoves = (int)outlineMoves_.size();
+    float length = 0.0f;
+
+    for( int i = 0; i < numMoves; ++i ) {
+        length += (outlineMoves_[i] % 2 == 0) ? 1.0f : SQRT_2;
+    }
+    for( int i = 0; i < numPoints && (int)points.size() < maxPoints; ++i ) {
+        bool isCorner = !approximate 
+                     || numMoves < numPoints
+                     || outlineMoves_[i] != outlineMoves_[(i + numMoves - 1) % numMoves];
+        if( isCorner ) {
+            points.push_back( outline_[i] );
+        }
+    }
+    return length;
+}
+
+/***************************************************************************//**
+Frees the run and component storage.
+*******************************************************************************/
+void ComponentLabeller::clear()
+{
+    std::vector<Stripe>().swap( stripes_ );
+    std::vector<int>().swap( stripeOffsets_ );
+    std::vector<int>().swap( parents_ );
+    std::vector<int>().swap( componentOfRoot_ );
+    std::vector<Component>().swap( components_ );
+    std::vector<OutlinePoint>().swap( outline_ );
+    std::vector<int>().swap( outlineMoves_ );
+    pixels_ = NULL;
+    words_ = NULL;
+    numStripes_ = 0;
+}
+
+/***************************************************************************//**
+The bytes held by the run, component, and outline storage.  This only grows 
+when a frame needs more of it than any frame before, so it can be watched to 
+make sure labelling has stopped allocating.
+*******************************************************************************/
+std::size_t ComponentLabeller::storageBytes() const
+{
+    std::size_t bytes = stripes_.capacity() * sizeof( Stripe )
+                      + (stripeOffsets_.capacity() + parents_.capacity() + componentOfRoot_.capacity() 
+                         + outlineMoves_.capacity()) * sizeof( int )
+                      + components_.capacity() * sizeof( Component )
+                      + outline_.capacity() * sizeof( OutlinePoint );
+    int numStripes = (int)stripes_.size();
+
+    for( int i = 0; i < numStripes; ++i ) {
+        bytes += stripes_[i].runs.capacity() * sizeof( Run );
+    }
+    return bytes;
+}
+
+/***************************************************************************//**
+Finds the runs of one stripe and joins each run with the runs it touches (8-way)
+on the row above.  Afterwards, every run's parent is the root of its set, which
+is the first run of the set in raster order.
+*******************************************************************************/
+void ComponentLabeller::labelStripe( int index )
+{
+    Stripe & stripe = stripes_[index];
+    std::vector<Run> & runs = stripe.runs;
+    runs.clear();
+    int aboveBegin = 0,
+        aboveEnd = 0;
+
+    for( int y = stripe.firstRow; y < stripe.endRow; ++y ) {
+        int rowBegin = (int)runs.size();
+
+        if( words_ != NULL ) {
+            findRunsInWords( y, runs );
+        }
+        else {
+            findRuns( y, runs );
+        }
+        int rowEnd = (int)runs.size(),
+            above = aboveBegin;
+
+        for( int r = rowBegin; r < rowEnd; ++r ) {
+            while( above < aboveEnd && runs[above].x1 < runs[r].x0 ) { ++above; }
+
+            for( int a = above; a < aboveEnd && runs[a].x0 <= runs[r].x1; ++a ) {
+                joinStripeRuns( runs, r, a );
+            }
+        }
+        aboveBegin = rowBegin;
+        aboveEnd = rowEnd;
+    }
+    int numRuns = (int)runs.size();
+
+    for( int r = 0; r < numRuns; ++r ) {
+        runs[r].parent = findStripeRoot( runs, r );
+    }
+}
+
+/***************************************************************************//**
+Adds the runs of non-zero pixels of row y to runs.
+*******************************************************************************/
+void ComponentLabeller::findRuns( int y, std::vector<Run> & runs )
+{
+    const unsigned char * row = pixels_ + y * stride_;
+    int x = left_;
+
+    while( x < right_ ) {
+        while( x < right_ && row[x] == 0 ) { ++x; }
+        if( x == right_ ) { break; }
+
+        Run run = { x, x, y, (int)runs.size() };
+        while( x < right_ && row[x] != 0 ) { ++x; }
+        run.x1 = x;
+        runs.push_back( run );
+    }
+}
+
+/***************************************************************************//**
+Adds the runs of set bits of row y to runs.  Outside of a run, a word with no 
+bits set is passed over whole, and so is a word with every bit set inside of 
+one.  Within a word, the next edge of a run is its lowest set bit (or lowest 
+clear bit) at or above the current position.
+*******************************************************************************/
+void ComponentLabeller::findRunsInWords( int y, std::vector<Run> & runs )
+{
+    const boost::uint64_t * row = words_ + y * wordsPerRow_;
+    const boost::uint64_t ALL_BITS = ~(boost::uint64_t)0;
+    int firstWord = left_ / 64,
+        endWord = (right_ + 63) / 64;
+    bool isInRun = false;
+    Run run = { 0, 0, y, 0 };
+
+    for( int w = firstWord; w < endWord; ++w ) {
+        boost::uint64_t word = row[w];
+
+        if( w == firstWord ) {
+            word &= ALL_BITS << (left_ % 64);
+        }
+        if( w == endWord - 1 && right_ % 64 != 0 ) {
+            word &= ~(ALL_BITS << (right_ % 64));
+        }
+        int position = 0;
+
+        while( true ) {
+            boost::uint64_t edges = (isInRun ? ~word : word) & (ALL_BITS << position);
+
+            if( edges == 0 ) {
+                break;
+            }
+            position = lowestSetBit( edges );
+
+            if( isInRun ) {
+                run.x1 = w * 64 + position;
+                runs.push_back( run );
+            }
+            else {
+                run.x0 = w * 64 + position;
+                run.parent = (int)runs.size();
+            }
+            isInRun = !isInRun;
+        }
+    }
+    if( isInRun ) {
+        run.x1 = right_;
+        runs.push_back( run );
+    }
+}
+
+int ComponentLabeller::findStripeRoot( std::vector<Run> & runs, int run )
+{
+    while( runs[run].parent != run ) {
+        runs[run].parent = runs[runs[run].parent].parent; // Path halving.
+        run = runs[run].parent;
+    }
+    return run;
+}
+
+/***************************************************************************//**
+The root with the larger index goes under the other, so each root stays the 
+first run of its set.
+*******************************************************************************/
+void ComponentLabeller::joinStripeRuns( std::vector<Run> & runs, int a, int b )
+{
+    a = findStripeRoot( runs, a );
+    b = findStripeRoot( runs, b );
+
+    if( a < b ) {
+        runs[b].parent = a;
+    }
+    else if( b < a ) {
+        runs[a].parent = b;
+    }
+}
+
+/***************************************************************************//**
+Joins the runs on the last row of the upper stripe with the runs they touch on
+the first row of the lower stripe.
+*******************************************************************************/
+void ComponentLabeller::joinStripes( int upper, int lower )
+{
+    const std::vector<Run> & upperRuns = stripes_[upper].runs,
+                           & lowerRuns = stripes_[lower].runs;
+    int lastRow = stripes_[upper].endRow - 1,
+        firstRow = stripes_[lower].firstRow,
+        upperEnd = (int)upperRuns.size(),
+        upperBegin = upperEnd,
+        lowerEnd = 0,
+        numLower = (int)lowerRuns.size();
+
+    while( upperBegin > 0 && upperRuns[upperBegin - 1].y == lastRow ) { --upperBegin; }
+    while( lowerEnd < numLower && lowerRuns[lowerEnd].y == firstRow ) { ++lowerEnd; }
+
+    int upperOffset = stripeOffsets_[upper],
+        lowerOffset = stripeOffsets_[lower],
+        above = upperBegin;
+
+    for( int r = 0; r < lowerEnd; ++r ) {
+        while( above < upperEnd && upperRuns[above].x1 < lowerRuns[r].x0 ) { ++above; }
+
+        for( int a = above; a < upperEnd && upperRuns[a].x0 <= lowerRuns[r].x1; ++a ) {
+            joinRuns( upperOffset + a, lowerOffset + r );
+        }
+    }
+}
+
+/***************************************************************************//**
+Adds each run's area, moments, and extent to its component.  Components are 
+numbered in the order of their roots, so the first run seen for a component
+holds its seed pixel.
+*******************************************************************************/
+void ComponentLabeller::addRunsToComponents()
+{
+    componentOfRoot_.assign( parents_.size(), -1 );
+
+    for( int i = 0; i < numStripes_; ++i ) {
+        const std::vector<Run> & runs = stripes_[i].runs;
+        int offset = stripeOffsets_[i],
+            numRuns = (int)runs.size();
+
+        for( int r = 0; r < numRuns; ++r ) {
+            const Run & run = runs[r];
+            int root = findRoot( offset + r ),
+                c = componentOfRoot_[root];
+
+            if( c < 0 ) {
+                c = (int)components_.size();
+                componentOfRoot_[root] = c;
+                Component first = { 0, 0.0, 0.0, 0.0, 0.0, 0.0, 
+                                    0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+                                    run.x0, run.y, run.x1 - 1, run.y, run.x0, run.y };
+                components_.push_back( first );
+            }
+            Component & component = components_[c];
+            double n = run.x1 - run.x0,
+                   a = run.x0,
+                   b = run.x1 - 1,
+                   y = run.y,
+                   sumX = (a + b) * n * 0.5,
+                   sumXX = (b * (b + 1.0) * (2.0 * b + 1.0) - (a - 1.0) * a * (2.0 * a - 1.0)) / 6.0;
+
+            component.area += run.x1 - run.x0;
+            component.sumX += sumX;
+            component.sumY += n * y;
+            component.sumXX += sumXX;
+            component.sumXY += sumX * y;
+            component.sumYY += n * y * y;
+            component.left = std::min( component.left, run.x0 );
+            component.right = std::max( component.right, run.x1 - 1 );
+            component.bottom = run.y;
+
+            if( weights_ != NULL ) {
+                addWeightedRun( component, run );
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+Adds the run's weighted moments to its component.  Within the run the sums 
+are whole numbers, so they are added up exactly in integers first.
+*******************************************************************************/
+void ComponentLabeller::addWeightedRun( Component & component, const Run & run )
+{
+    const unsigned char * weights = weights_ + (std::ptrdiff_t)run.y * weightStride_;
+    boost::uint64_t sumW = 0,
+                    sumWX = 0,
+                    sumWXX = 0;
+
+    for( int x = run.x0; x < run.x1; ++x ) {
+        boost::uint64_t w = weights[x];
+        sumW += w;
+        sumWX += w * x;
+        sumWXX += w * x * x;
+    }
+    double y = run.y,
+           weight = (double)sumW,
+           weightedX = (double)sumWX;
+
+    component.weight += weight;
+    component.weightedX += weightedX;
+    component.weightedY += weight * y;
+    component.weightedXX += (double)sumWXX;
+    component.weightedXY += weightedX * y;
+    component.weightedYY += weight * y * y;
+}
+
+int ComponentLabeller::findRoot( int run )
+{
+    while( parents_[run] != run ) {
+        parents_[run] = parents_[parents_[run]]; // Path halving.
+        run = parents_[run];
+    }
+    return run;
+}
+
+void ComponentLabeller::joinRuns( int a, int b )
+{
+    a = findRoot( a );
+    b = findRoot( b );
+
+    if( a < b ) {
+        parents_[b] = a;
+    }
+    else if( b < a ) {
+        parents_[a] = b;
+    }
+}
+
+bool ComponentLabeller::isSet( int x, int y ) const
+{
+    if( x < left_ || x >= right_ || y < top_ || y >= bottom_ ) {
+        return false;
+    }
+    if( words_ != NULL ) {
+        return ((words_[y * wordsPerRow_ + x / 64] >> (x % 64)) & 1) != 0;
+    }
+    return pixels_[y * stride_ + x] != 0;
+}
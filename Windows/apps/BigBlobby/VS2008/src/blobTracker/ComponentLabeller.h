@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+// ComponentLabeller
+//
+// PURPOSE: Finds the connected components (blobs) of a thresholded image in one
+//          pass, with the area, moments, and bounding box of each, and traces
+//          the outline of a component only when asked.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBTRACKER_COMPONENTLABELLER_H
+#define BLOBTRACKER_COMPONENTLABELLER_H
+
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace blobUtils { class WorkStealingPool; }
+
+namespace blobTracker
+{
+    /***********************************************************************//**
+    The sums gathered for one connected component.  Pixel coordinates are 
+    whole-image coordinates, and the box edges are inclusive.  The seed is the
+    component's first pixel in raster order (its top row, leftmost pixel), 
+    which is always on its outline.  The weighted sums are the same moments 
+    with each pixel counted by its value in the weight image (see 
+    ComponentLabeller::setWeights()), and are zero if there is none.
+    ***************************************************************************/
+    struct Component
+    {
+        int area;
+        double sumX,
+               sumY,
+               sumXX,
+               sumXY,
+               sumYY,
+               weight,
+               weightedX,
+               weightedY,
+               weightedXX,
+               weightedXY,
+               weightedYY;
+        int left,
+            top,
+            right,
+            bottom,
+            seedX,
+            seedY;
+    };
+
+    /***********************************************************************//**
+    A point on a traced outline.
+    ***************************************************************************/
+    struct OutlinePoint
+    {
+        int x,
+            y;
+    };
+
+    /***********************************************************************//**
+    Labels the 8-connected components of the non-zero pixels of an image, 
+    without writing to it.  Each row is scanned once for runs of non-zero 
+    pixels, runs that touch a run on the row above are joined with a 
+    union-find, and each run then adds its area, moments, and extent to its 
+    component in closed form.  If a weight image has been set, each run also
+    adds its pixels' weighted moments, which takes one read per pixel.
+
+    With a thread pool, horizontal stripes of rows are labelled at the same 
+    time, and the runs on either side of each stripe boundary are joined 
+    afterwards.
+
+    Only the outlines of the components that are asked for are traced (see 
+    traceOutline()), so the noise specks that the size filter throws away 
+    cost no more than a scan.  A bit-packed image (see blobBuffers::BitBuffer)
+    is scanned a word at a time, so runs of 64 empty (or 64 set) pixels are 
+    passed over with one test.  The run and component storage is kept from 
+    frame to frame, so labelling does not allocate once it has seen a frame
+    with as many runs as the current one.
+    ***************************************************************************/
+    class ComponentLabeller
+    {
+    public:
+        static const int MIN_STRIPE_ROWS;
+
+        ComponentLabeller();
+        ~ComponentLabeller();
+
+        void setThreadPool( blobUtils::WorkStealingPool * threadPool );
+        void setWeights( const unsigned char * weights, int stride );
+        int label( const unsigned char * pixels, int stride, 
+                   int left, int top, int right, int bottom );
+        int label( const boost::uint64_t * words, int wordsPerRow, 
+                   int left, int top, int right, int bottom );
+        int numComponents() const;
+        const Component & component( int index ) const;
+        void selectLargest( int minArea, int maxArea, int maxCount, std::vector<int> & indices ) const;
+        float traceOutline( int index, bool approximate, int maxPoints, std::vector<OutlinePoint> & points );
+        void clear();
+        std::size_t storageBytes() const;
+
+    private:
+        struct Run
+        {
+            int x0,     // First pixel.
+                x1,     // One past the last pixel.
+                y,
+                parent; // Index of the parent run (within its stripe).
+        };
+
+        struct Stripe
+        {
+            int firstRow,
+                endRow;
+            std::vector<Run> runs;
+        };
+
+        class LargerArea;
+
+        int labelImage( int left, int top, int right, int bottom );
+        void labelStripe( int index );
+        void findRuns( int y, std::vector<Run> & runs );
+        void findRunsInWords( int y, std::vector<Run> & runs );
+        int findStripeRoot( std::vector<Run> & runs, int run );
+        void joinStripeRuns( std::vector<Run> & runs, int a, int b );
+        void joinStripes( int upper, int lower );
+        void addRunsToComponents();
+        void addWeightedRun( Component & component, const Run & run );
+        int findRoot( int run );
+        void joinRuns( int a, int b );
+        bool isSet( int x, int y ) const;
+
+        // Not copyable.
+        ComponentLabeller( const ComponentLabeller & );
+        ComponentLabeller & operator=( const ComponentLabeller & );
+
+        blobUtils::WorkStealingPool * threadPool_;
+        const unsigned char * pixels_;
+        const boost::uint64_t * words_;
+        const unsigned char * weights_;
+        int stride_,
+            wordsPerRow_,
+            weightStride_,
+            left_,
+            top_,
+            right_,
+            bottom_;
+        std::vector<Stripe> stripes_;
+        int numStripes_;
+        std::vector<int> stripeOffsets_,
+                         parents_,
+                         componentOfRoot_;
+        std::vector<Component> components_;
+        std::vector<OutlinePoint> outline_;
+        std::vector<int> outlineMoves_;
+    };
+}
+
+#endif
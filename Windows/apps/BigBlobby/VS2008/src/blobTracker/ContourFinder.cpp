@@ -50,30 +50,27 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobTracker/ContourFinder.h"
 #include "blobNormalize/FishEyeGrid.h"
 #include "blobBuffers/GrayBuffer.h"
+#include "blobBuffers/BitBuffer.h"
+#include <cmath>
 
 using blobTracker::ContourFinder;
+using blobTracker::Component;
 
 //------------------------------------------------------------------------------
-static int qsort_carea_compare( const void* _a, const void* _b) 
-{
-	int out = 0;
-	// pointers, ugh.... sorry about this
-	CvSeq* a = *((CvSeq **)_a);
-	CvSeq* b = *((CvSeq **)_b);
-	// use opencv to calc size, then sort based on size
-	float areaa = fabs(cvContourArea(a, CV_WHOLE_SEQ));
-	float areab = fabs(cvContourArea(b, CV_WHOLE_SEQ));
-	// note, based on the -1 / 1 flip
-	// we sort biggest to smallest, not smallest to biggest
-	if( areaa > areab )		out = -1;
-	else					out =  1;
-	return out;
-}
-
-//------------------------------------------------------------------------------
-ContourFinder::ContourFinder()
+ContourFinder::ContourFinder() :
+  labeller_(),
+  selected_(),
+  outline_(),
+  blobs_(),
+  contourPoints_(),
+  storageBytes_( 0 ),
+  allocatingFrameCount_( 0 )
 {
-	myMoments_ = (CvMoments*)malloc( sizeof(CvMoments) );
+    hasSearchRegion_ = false;
+    searchRegion_ = cvRect( 0, 0, 0, 0 );
+    signalImage_ = NULL;
+    useWeightedCentroids_ = false;
+    useWeightedAngles_ = false;
     debugPrint_ = false;
 
     setUnmatchedBlobFramesToSkip( blobTracker::Blob::DEATH_COUNT - 1 );
@@ -82,7 +79,6 @@ ContourFinder::ContourFinder()
 //------------------------------------------------------------------------------
 ContourFinder::~ContourFinder() 
 {
-	free( myMoments_ );
 }
 
 void ContourFinder::setUnmatchedBlobFramesToSkip( int frames )
@@ -96,182 +92,400 @@ int ContourFinder::unmatchedBlobFramesToSkip()
     return unmatchedBlobDeathCount_ - 1;
 }
 
+/***************************************************************************//**
+Limits the next findContours() calls to the given rectangle of the image.  
+The caller has to make sure that there are no blob pixels outside of it (for
+example, because the filters have masked them out).  The blob coordinates are
+still in the whole image.
+*******************************************************************************/
+void ContourFinder::setSearchRegion( CvRect region )
+{
+    hasSearchRegion_ = true;
+    searchRegion_ = region;
+}
+
+/***************************************************************************//**
+Goes back to searching the whole image.
+*******************************************************************************/
+void ContourFinder::clearSearchRegion()
+{
+    hasSearchRegion_ = false;
+}
+
+/***************************************************************************//**
+The search region clipped to an image of the given size (the whole image if 
+there is no search region).
+*******************************************************************************/
+CvRect ContourFinder::searchRegion( int width, int height )
+{
+    if( !hasSearchRegion_ ) {
+        return cvRect( 0, 0, width, height );
+    }
+    int left = MAX( searchRegion_.x, 0 ),
+        top = MAX( searchRegion_.y, 0 ),
+        right = MIN( searchRegion_.x + searchRegion_.width, width ),
+        bottom = MIN( searchRegion_.y + searchRegion_.height, height );
+
+    if( right <= left || bottom <= top ) {
+        return cvRect( 0, 0, 0, 0 );
+    }
+    return cvRect( left, top, right - left, bottom - top );
+}
+
+/***************************************************************************//**
+Sets the image (not owned) that the next findContours() calls weight the 
+blob pixels by, which should be the image that was thresholded (see 
+ImageFilters::signalBuffer()).  Passing NULL (or an image of a different size
+than the thresholded one) goes back to unweighted centroids and angles.
+*******************************************************************************/
+void ContourFinder::setSignalImage( blobBuffers::GrayBuffer * signalImage )
+{
+    signalImage_ = signalImage;
+}
+
+/***************************************************************************//**
+When true, each blob's centroid is weighted by the signal image.
+*******************************************************************************/
+void ContourFinder::useWeightedCentroids( bool b )
+{
+    useWeightedCentroids_ = b;
+}
+
+bool ContourFinder::useWeightedCentroids()
+{
+    return useWeightedCentroids_;
+}
+
+/***************************************************************************//**
+When true, the angle of each blob's angled bounding box comes from its second
+moments weighted by the signal image.  The size of the box still comes from 
+the thresholded pixels.
+*******************************************************************************/
+void ContourFinder::useWeightedAngles( bool b )
+{
+    useWeightedAngles_ = b;
+}
+
+bool ContourFinder::useWeightedAngles()
+{
+    return useWeightedAngles_;
+}
+
+/***************************************************************************//**
+Hands the signal image to the labeller if the weighted sums are needed and it
+is the same size as the thresholded image.
+*******************************************************************************/
+void ContourFinder::setLabellerWeights( int width, int height )
+{
+    if( (useWeightedCentroids_ || useWeightedAngles_) && signalImage_ != NULL
+        && signalImage_->width() == width && signalImage_->height() == height ) {
+        labeller_.setWeights( signalImage_->pixels(), signalImage_->stride() );
+    }
+    else {
+        labeller_.setWeights( NULL, 0 );
+    }
+}
+
+/***************************************************************************//**
+Sets the pool (not owned) used to label horizontal stripes of the image at the
+same time.  Passing NULL labels the image on the calling thread.
+*******************************************************************************/
+void ContourFinder::setThreadPool( blobUtils::WorkStealingPool * threadPool )
+{
+    labeller_.setThreadPool( threadPool );
+}
+
+/***************************************************************************//**
+Removes the blobs and frees the labelling buffers.
+*******************************************************************************/
+void ContourFinder::clear()
+{
+    blobs_.clear();
+    labeller_.clear();
+    std::vector<int>().swap( selected_ );
+    std::vector<blobTracker::OutlinePoint>().swap( outline_ );
+    std::vector<ofPoint>().swap( contourPoints_ );
+    storageBytes_ = 0;
+}
+
+/***************************************************************************//**
+The number of findContours() calls so far that had to allocate more storage.
+In steady state (no more blobs, and no longer outlines, than have been seen 
+before) this stops going up.
+*******************************************************************************/
+int ContourFinder::allocatingFrameCount()
+{
+    return allocatingFrameCount_;
+}
+
+/***************************************************************************//**
+The bytes of storage kept from frame to frame, as of the last findContours().
+*******************************************************************************/
+std::size_t ContourFinder::storageBytes()
+{
+    return storageBytes_;
+}
+
+/***************************************************************************//**
+Empties the blobs and contour points of the last frame without freeing their 
+storage.
+*******************************************************************************/
+void ContourFinder::clearBlobs()
+{
+    blobs_.clear();
+    contourPoints_.clear();
+}
+
+/***************************************************************************//**
+Adds up the storage that is kept from frame to frame, and counts the frame as
+an allocating one if that went up.  Storage only ever grows (until clear()), 
+so this catches every frame that allocated.
+*******************************************************************************/
+void ContourFinder::countAllocations()
+{
+    std::size_t bytes = labeller_.storageBytes()
+                      + selected_.capacity() * sizeof( int )
+                      + outline_.capacity() * sizeof( blobTracker::OutlinePoint )
+                      + blobs_.capacity() * sizeof( blobTracker::Blob )
+                      + contourPoints_.capacity() * sizeof( ofPoint );
+
+    if( bytes > storageBytes_ ) {
+        ++allocatingFrameCount_;
+    }
+    storageBytes_ = bytes;
+}
+
 vector<blobTracker::Blob> & ContourFinder::getBlobs()
 {
     return blobs_;
 }
 
+/***************************************************************************//**
+The contour points of all the blobs from the last findContours() call.  Each 
+blob's points are contourPoints()[firstPt] to contourPoints()[firstPt + nPts - 1].
+*******************************************************************************/
+const std::vector<ofPoint> & ContourFinder::contourPoints()
+{
+    return contourPoints_;
+}
+
 bool ContourFinder::isEmpty()
 {
     return (blobs_.size() > 0);
 }
 
-//------------------------------------------------------------------------------
-int ContourFinder::findContours( ofxCvGrayscaleImage & input,
+/***************************************************************************//**
+Finds the blobs (8-connected groups of non-zero pixels) of the input image 
+whose area in pixels is between minArea and maxArea, and keeps the nConsidered
+largest of them (largest first).  The input image is only read.
+
+Holes inside blobs are not reported (the original cvFindContours() version 
+only reported them when asked to, and BigBlobby never asked).
+*******************************************************************************/
+int ContourFinder::findContours( blobBuffers::GrayBuffer * input,
 								 int minArea,
 								 int maxArea,
 								 int nConsidered,
-								 bool bFindHoles,
                                  int frameCount /*= 0*/,
                                  blobBuffers::GrayBuffer * sourceBuffer /*= NULL*/,
                                  blobBuffers::GrayBuffer * backgroundBuffer /*= NULL*/,
                                  bool bUseApproximation /*= true*/ )
 {
     //debugPrint_ = ((frameCount % 60) == 0);
+    clearBlobs();
 
-    // OpenCV will clobber the image used to find contours, so create a copy.
-    if( inputCopy_.width != input.width || inputCopy_.height != input.height ) { 
-		inputCopy_.allocate( input.width, input.height );
+    // Only the search region is labelled.  The blob coordinates are still in
+    // the whole image.
+    CvRect region = searchRegion( input->width(), input->height() );
+
+    if( region.width == 0 || region.height == 0 ) {
+        return 0;
     }
-    inputCopy_ = input;
-	blobs_.clear();
-
-	CvSeq * contour_list = NULL;
-	contourStorage_ = cvCreateMemStorage( 1000 );
-	storage_	= cvCreateMemStorage( 1000 );
-	cvFindContours( inputCopy_.getCvImage(), 
-                    contourStorage_, 
-                    &contour_list,
-                    sizeof(CvContour), 
-                    bFindHoles ? CV_RETR_LIST : CV_RETR_EXTERNAL, 
-                    bUseApproximation ? CV_CHAIN_APPROX_SIMPLE : CV_CHAIN_APPROX_NONE );
-
-	CvSeq * contour_ptr = contour_list;
-	nCvSeqsFound = 0;
-
-	// put the contours from the linked list, into an array for sorting
-	while( (contour_ptr != NULL) ) {
-		float area = fabs( cvContourArea( contour_ptr, CV_WHOLE_SEQ ) );
-
-		if( (area > minArea) && (area < maxArea) ) {
-            ////if (nCvSeqsFound < TOUCH_MAX_CONTOUR_LENGTH) { // Wrong constant!
-            if (nCvSeqsFound < TOUCH_MAX_CONTOURS) { // // Added by JRW on 6/15/2012
-				cvSeqBlobs[nCvSeqsFound] = contour_ptr;	 // copy the pointer
-                nCvSeqsFound++;
-		    }
-            else {
-                break; // Added by JRW on 6/15/2012
-            }
-		}
-		contour_ptr = contour_ptr->h_next;
-	}
-	// sort the pointers based on size
-	if( nCvSeqsFound > 0 ) {
-		qsort( cvSeqBlobs, nCvSeqsFound, sizeof(CvSeq*), qsort_carea_compare);
-	}
-	// now, we have nCvSeqsFound contours, sorted by size in the array
-    // cvSeqBlobs let's get the data out and into our structures that we like
-	for( int i = 0; i < MIN( nConsidered, nCvSeqsFound ); ++i ) {
-        createBlob( cvSeqBlobs[i], sourceBuffer, backgroundBuffer );
-	}
-	// Free the storage memory.
-	// Warning: do this inside this function otherwise a strange memory leak
-	if( contourStorage_ != NULL ) { cvReleaseMemStorage(&contourStorage_); }
-	if( storage_ != NULL ) { cvReleaseMemStorage(&storage_); }
+    setLabellerWeights( input->width(), input->height() );
+    labeller_.label( input->pixels(), input->stride(), 
+                     region.x, region.y, region.x + region.width, region.y + region.height );
+    return createBlobs( minArea, maxArea, nConsidered, sourceBuffer, backgroundBuffer, bUseApproximation );
+}
+
+/***************************************************************************//**
+Same as above for a bit-packed thresholded image (see blobBuffers::BitBuffer),
+which is scanned 64 pixels at a time.
+*******************************************************************************/
+int ContourFinder::findContours( blobBuffers::BitBuffer * input,
+								 int minArea,
+								 int maxArea,
+								 int nConsidered,
+                                 int frameCount /*= 0*/,
+                                 blobBuffers::GrayBuffer * sourceBuffer /*= NULL*/,
+                                 blobBuffers::GrayBuffer * backgroundBuffer /*= NULL*/,
+                                 bool bUseApproximation /*= true*/ )
+{
+    clearBlobs();
+    CvRect region = searchRegion( input->width(), input->height() );
+
+    if( region.width == 0 || region.height == 0 ) {
+        return 0;
+    }
+    setLabellerWeights( input->width(), input->height() );
+    labeller_.label( input->words(), input->wordsPerRow(), 
+                     region.x, region.y, region.x + region.width, region.y + region.height );
+    return createBlobs( minArea, maxArea, nConsidered, sourceBuffer, backgroundBuffer, bUseApproximation );
+}
 
+/***************************************************************************//**
+Makes a blob from each of the nConsidered largest components that the 
+labeller found within the size limits.
+*******************************************************************************/
+int ContourFinder::createBlobs( int minArea, 
+                                int maxArea, 
+                                int nConsidered,
+                                blobBuffers::GrayBuffer * sourceBuffer, 
+                                blobBuffers::GrayBuffer * backgroundBuffer,
+                                bool useApproximation )
+{
+    labeller_.selectLargest( minArea, maxArea, nConsidered, selected_ );
+    int numSelected = (int)selected_.size();
+
+    blobs_.reserve( numSelected );
+
+	for( int i = 0; i < numSelected; ++i ) {
+        int index = selected_[i];
+        createBlob( labeller_.component( index ), index, useApproximation, sourceBuffer, backgroundBuffer );
+	}
+    countAllocations();
 	return blobs_.size();
 }
 
-void ContourFinder::createBlob( CvSeq * cvSeqBlob, 
+void ContourFinder::createBlob( const Component & component,
+                                int componentIndex,
+                                bool useApproximation,
                                 blobBuffers::GrayBuffer * sourceBuffer, 
                                 blobBuffers::GrayBuffer * backgroundBuffer )
 {
-    blobTracker::Blob blob;
-    float area = cvContourArea( cvSeqBlob, CV_WHOLE_SEQ );
-    cvMoments( cvSeqBlob, myMoments_ );
-    addBoundingRectangle( blob, cvSeqBlob );
-    addAngularBoundingRectangle( blob, cvSeqBlob );
-    addCentroids( blob );
+    blobs_.push_back( blobTracker::Blob() );
+    blobTracker::Blob & blob = blobs_.back();
+    addBoundingRectangle( blob, component );
+    addCentroids( blob, component );
+    addAngularBoundingRectangle( blob, component );
     addSrcAndBackgroundIntensities( blob, sourceBuffer, backgroundBuffer );
 
     // assign other parameters
     blob.deathCount = unmatchedBlobDeathCount_;
-    float absoluteArea = fabs(area);
-    blob.area           = absoluteArea;
+    float area = (float)component.area;
+    blob.area           = area;
     blob.areaSum        = 0;
     blob.areaFrameCount = 0;
     blob.areaTime       = ofGetElapsedTimef();
-    blob.averageArea    = absoluteArea;
-    blob.hole           = area < 0 ? true : false;
-    blob.length 	    = cvArcLength( cvSeqBlob );
-    
-    // get the points for the blob:
-    CvPoint pt;
-    CvSeqReader reader;
-    cvStartReadSeq( cvSeqBlob, &reader, 0 );
-    int length = min( TOUCH_MAX_CONTOUR_LENGTH, cvSeqBlob->total );
-
-    for( int j = 0; j < length; ++j ) {
-        CV_READ_SEQ_ELEM( pt, reader );
-        blob.pts.push_back( ofPoint( (float)pt.x, (float)pt.y ) );
-    }
-    blob.nPts = blob.pts.size();
-    blobs_.push_back( blob );
+    blob.averageArea    = component.area;
+    blob.hole           = false;
+    addContour( blob, componentIndex, useApproximation );
 
     //if( debugPrint_ ) { debugPrint( blob ); }
 }
 
-void ContourFinder::addBoundingRectangle( blobTracker::Blob & blob, CvSeq * cvSeqBlob )
+void ContourFinder::addBoundingRectangle( blobTracker::Blob & blob, const Component & component )
 {
-    CvRect rect	= cvBoundingRect( cvSeqBlob, 0 );
-    blob.boundingRect.x = rect.x;
-    blob.boundingRect.y = rect.y;
-    blob.boundingRect.width  = rect.width;
-    blob.boundingRect.height = rect.height;
+    blob.boundingRect.x = component.left;
+    blob.boundingRect.y = component.top;
+    blob.boundingRect.width  = component.right - component.left + 1;
+    blob.boundingRect.height = component.bottom - component.top + 1;
 }
 
 /***************************************************************************//**
-The original CCV 1.3 code had width and height criss-crossed (not sure why).
-That has been corrected here (11/6/2014). -JRW
+The angled box is the rectangle with the same second moments as the blob: its 
+width runs along the blob's major axis, and a uniform W x H rectangle of 
+pixels gets back a W x H box.  (The original CCV 1.3 code used 
+cvMinAreaRect2() on the contour, which needed the whole contour of every blob.)
+<br />
 
-The OpenCV cvMinAreaRect2() function uses a scheme where the angle will always
+The OpenCV cvMinAreaRect2() function used a scheme where the angle would always
 be from 0.0 to -89.9 degrees, and when 90 degrees would be expected, the width 
-and height flip and the angle goes to 0.0.  That 90 degree range with 
-width-height flipping scheme works because flipping the width and height is the
-same thing as a 90 degree rotation.  However, that scheme will generate some 
-odd problems when a camera image is mapped to a monitor/projector with a
-different aspect ratio.  The non-uniform scaling can cause a noticeable 
+and height flipped and the angle went to 0.0.  That scheme generated some 
+odd problems when a camera image was mapped to a monitor/projector with a
+different aspect ratio.  The non-uniform scaling caused a noticeable 
 change in the dimensions of the angled bounding box when the width and height 
-are flipped because the x-scaling does not match the y-scaling.  To avoid an 
-odd jitter effect when going from -89.9 degrees to 0 degrees, this function will 
-always set the major axis (greater dimension) to be the width and will just 
-add 90 degrees instead of flipping the width and height.  This feature has 
-been tested with a finger paint app that draws bounding boxes, and the -89.9 to 
-+90.0 degree scheme (with no width-height flipping) produces a nicer, smoother 
-rotation for oblong blobs.  This feature is best tested using a blob that is 
-at least 3 times longer than its width.
+were flipped because the x-scaling does not match the y-scaling.  To avoid an 
+odd jitter effect, the major axis (greater dimension) is always the width and 
+the angle goes from -89.9 to +90.0 degrees, which gives a nicer, smoother 
+rotation for oblong blobs in a finger paint app that draws bounding boxes.
+This feature is best tested using a blob that is at least 3 times longer than 
+its width.
+<br />
+
+The box is centered on the blob's centroid (see addCentroids()).  With 
+weighted angles turned on, the angle comes from the weighted second moments,
+which follow the brightest part of the blob rather than its thresholded edge.
 *******************************************************************************/
-void ContourFinder::addAngularBoundingRectangle( blobTracker::Blob & blob, CvSeq * cvSeqBlob )
-{
-    CvBox2D32f box = cvMinAreaRect2( cvSeqBlob );
-    blob.angleBoundingRect.x = box.center.x;
-    blob.angleBoundingRect.y = box.center.y;
-    float width = box.size.width,
-          height = box.size.height,
-          angle = box.angle;
-
-    if( height > width  ) {
-        float temp = width;
-        width = height;
-        height = temp;
-        angle += 90.0;
+void ContourFinder::addAngularBoundingRectangle( blobTracker::Blob & blob, const Component & component )
+{
+    double n = component.area,
+           x = component.sumX / n,
+           y = component.sumY / n,
+           mu20 = component.sumXX / n - x * x,
+           mu02 = component.sumYY / n - y * y,
+           mu11 = component.sumXY / n - x * y,
+           halfDifference = 0.5 * (mu20 - mu02),
+           spread = std::sqrt( halfDifference * halfDifference + mu11 * mu11 ),
+           majorVariance = 0.5 * (mu20 + mu02) + spread,
+           minorVariance = MAX( 0.5 * (mu20 + mu02) - spread, 0.0 );
+
+    // A row of L pixels has a variance of (L * L - 1) / 12.
+    blob.angleBoundingRect.x = blob.centroid.x;
+    blob.angleBoundingRect.y = blob.centroid.y;
+    blob.angleBoundingRect.width  = (float)std::sqrt( 12.0 * majorVariance + 1.0 );
+    blob.angleBoundingRect.height = (float)std::sqrt( 12.0 * minorVariance + 1.0 );
+
+    if( useWeightedAngles_ && component.weight > 0 ) {
+        double w = component.weight,
+               wx = component.weightedX / w,
+               wy = component.weightedY / w;
+        mu20 = component.weightedXX / w - wx * wx;
+        mu02 = component.weightedYY / w - wy * wy;
+        mu11 = component.weightedXY / w - wx * wy;
     }
-    blob.angleBoundingRect.width  = width;
-    blob.angleBoundingRect.height = height;
-    blob.angle = angle;
+    blob.angle = (float)(0.5 * std::atan2( 2.0 * mu11, mu20 - mu02 ) * 180.0 / PI);
 
+    if( blob.angle <= -90.0f ) {
+        blob.angle += 180.0f;
+    }
 }
 
-void ContourFinder::addCentroids( blobTracker::Blob & blob )
+/***************************************************************************//**
+The centroid is the mean of the blob's pixels, weighted by the signal image if
+weighted centroids are turned on (and the blob has any signal).
+*******************************************************************************/
+void ContourFinder::addCentroids( blobTracker::Blob & blob, const Component & component )
 {
-    blob.centroid.x = (myMoments_->m10 / myMoments_->m00);
-    blob.centroid.y = (myMoments_->m01 / myMoments_->m00);
+    if( useWeightedCentroids_ && component.weight > 0 ) {
+        blob.centroid.x = (float)(component.weightedX / component.weight);
+        blob.centroid.y = (float)(component.weightedY / component.weight);
+    }
+    else {
+        blob.centroid.x = (float)(component.sumX / component.area);
+        blob.centroid.y = (float)(component.sumY / component.area);
+    }
     blob.lastCentroid.x = 0;
     blob.lastCentroid.y = 0;
     blob.cameraCentroid.x = blob.centroid.x;
     blob.cameraCentroid.y = blob.centroid.y;
 }
 
+/***************************************************************************//**
+Traces the outline of the blob (up to TOUCH_MAX_CONTOUR_LENGTH points), which 
+also gives its length, and appends it to the contour points.
+*******************************************************************************/
+void ContourFinder::addContour( blobTracker::Blob & blob, int componentIndex, bool useApproximation )
+{
+    blob.length = labeller_.traceOutline( componentIndex, useApproximation, TOUCH_MAX_CONTOUR_LENGTH, outline_ );
+    int numPoints = (int)outline_.size();
+    blob.firstPt = contourPoints_.size();
+    blob.nPts = numPoints;
+
+    for( int j = 0; j < numPoints; ++j ) {
+        contourPoints_.push_back( ofPoint( (float)outline_[j].x, (float)outline_[j].y ) );
+    }
+}
+
 void ContourFinder::addSrcAndBackgroundIntensities( blobTracker::Blob & blob, 
                                                     blobBuffers::GrayBuffer * sourceBuffer, 
                                                     blobBuffers::GrayBuffer * backgroundBuffer )
@@ -57,25 +57,46 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ofMain.h"
 #include "ofxOpenCv.h"
 #include "blobTracker/Blob.h"
+#include "blobTracker/ComponentLabeller.h"
 
-#define TOUCH_MAX_CONTOURS			128
 #define TOUCH_MAX_CONTOUR_LENGTH	1024
 
 namespace blobNormalize { class FishEyeGrid; }
 namespace blobBuffers { class GrayBuffer; }
+namespace blobBuffers { class BitBuffer; }
+namespace blobUtils { class WorkStealingPool; }
 
 namespace blobTracker
 {
+    /***********************************************************************//**
+    Finds the blobs in the thresholded image.  The image is labelled in one 
+    read-only pass by a ComponentLabeller (so, unlike cvFindContours(), it 
+    does not have to be copied first), which gives the area, centroid, moments,
+    and bounding box of every blob.  Only the nConsidered largest blobs within
+    the size limits are kept, and only their outlines are traced.
+
+    With weighted centroids turned on (and a signal image set, see 
+    setSignalImage()), a blob's centroid is the mean of its pixels weighted by
+    the pre-threshold signal, rather than the plain mean of its thresholded
+    pixels, so it moves smoothly by fractions of a pixel instead of jumping 
+    when a pixel crosses the threshold.  The angle of the angled bounding box
+    can be worked out from the weighted second moments the same way.
+
+    The contour points of all the blobs are kept end to end in one vector 
+    (see contourPoints()), and each blob only holds its span of it.  Nothing 
+    is freed from frame to frame, so once the finder has seen a frame with as
+    many (and as long) blobs as the current one, findContours() does not 
+    allocate, which allocatingFrameCount() keeps track of.
+    ***************************************************************************/
     class ContourFinder 
     {
     public:
         ContourFinder();
         ~ContourFinder();
-	    int findContours( ofxCvGrayscaleImage& input,
+	    int findContours( blobBuffers::GrayBuffer * input,
                           int minArea, 
                           int maxArea,
                           int nConsidered, 
-                          bool bFindHoles,
                           int frameCount = 0,
                           blobBuffers::GrayBuffer * sourceBuffer = NULL,
                           blobBuffers::GrayBuffer * backgroundBuffer = NULL,
@@ -83,36 +104,70 @@ namespace blobTracker
                           // approximation = don't do points for all 
                           // points of the contour, if the contour runs
                           // along a straight line, for example...
+	    int findContours( blobBuffers::BitBuffer * input,
+                          int minArea, 
+                          int maxArea,
+                          int nConsidered, 
+                          int frameCount = 0,
+                          blobBuffers::GrayBuffer * sourceBuffer = NULL,
+                          blobBuffers::GrayBuffer * backgroundBuffer = NULL,
+                          bool bUseApproximation = true );
         blobTracker::Blob getBlob(int num);
         vector<blobTracker::Blob> & getBlobs();
+        const std::vector<ofPoint> & contourPoints();
         bool isEmpty();
         void setUnmatchedBlobFramesToSkip( int frames );
         int unmatchedBlobFramesToSkip();
-
-    protected:
-        ofxCvGrayscaleImage inputCopy_;
-        CvMemStorage * contourStorage_;
-        CvMemStorage * storage_;
-        CvMoments * myMoments_;
-
-        // internally, we find cvSeqs, they will become blobs.
-        CvSeq * cvSeqBlobs[TOUCH_MAX_CONTOURS];
-        int nCvSeqsFound;
+        void setSearchRegion( CvRect region );
+        void clearSearchRegion();
+        void setSignalImage( blobBuffers::GrayBuffer * signalImage );
+        void useWeightedCentroids( bool b );
+        bool useWeightedCentroids();
+        void useWeightedAngles( bool b );
+        bool useWeightedAngles();
+        void setThreadPool( blobUtils::WorkStealingPool * threadPool );
+        void clear();
+        int allocatingFrameCount();
+        std::size_t storageBytes();
 
     private:
-        void createBlob( CvSeq * cvSeqBlob, 
+        CvRect searchRegion( int width, int height );
+        void setLabellerWeights( int width, int height );
+        void clearBlobs();
+        void countAllocations();
+        int createBlobs( int minArea, 
+                         int maxArea, 
+                         int nConsidered,
+                         blobBuffers::GrayBuffer * sourceBuffer, 
+                         blobBuffers::GrayBuffer * backgroundBuffer,
+                         bool useApproximation );
+        void createBlob( const blobTracker::Component & component,
+                         int componentIndex,
+                         bool useApproximation,
                          blobBuffers::GrayBuffer * sourceBuffer, 
                          blobBuffers::GrayBuffer * backgroundBuffer );
-        void addBoundingRectangle( blobTracker::Blob & blob, CvSeq * cvSeqBlob );
-        void addAngularBoundingRectangle( blobTracker::Blob & blob, CvSeq * cvSeqBlob );
-        void addCentroids( blobTracker::Blob & blob );
+        void addBoundingRectangle( blobTracker::Blob & blob, const blobTracker::Component & component );
+        void addAngularBoundingRectangle( blobTracker::Blob & blob, const blobTracker::Component & component );
+        void addCentroids( blobTracker::Blob & blob, const blobTracker::Component & component );
+        void addContour( blobTracker::Blob & blob, int componentIndex, bool useApproximation );
         void addSrcAndBackgroundIntensities( blobTracker::Blob & blob, 
                                              blobBuffers::GrayBuffer * sourceBuffer, 
                                              blobBuffers::GrayBuffer * backgroundBuffer );
         void debugPrint( blobTracker::Blob & blob );
 
+        blobTracker::ComponentLabeller labeller_;
+        std::vector<int> selected_;
+        std::vector<blobTracker::OutlinePoint> outline_;
         vector <blobTracker::Blob> blobs_;
+        std::vector<ofPoint> contourPoints_;
+        std::size_t storageBytes_;
+        int allocatingFrameCount_;
         int unmatchedBlobDeathCount_;
+        bool hasSearchRegion_;
+        CvRect searchRegion_;
+        blobBuffers::GrayBuffer * signalImage_;
+        bool useWeightedCentroids_,
+             useWeightedAngles_;
         bool debugPrint_;
     };
 }
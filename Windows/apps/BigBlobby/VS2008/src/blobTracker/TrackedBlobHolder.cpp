@@ -53,8 +53,10 @@ const int TrackedBlobHolder::MAX_NUMBER_OF_MATCHES = 6;
 
 TrackedBlobHolder::TrackedBlobHolder() :
   trackedBlob_(),
-  newBlobMatches_()
+  newBlobMatches_(),
+  firstMatch_( 0 )
 {
+    newBlobMatches_.reserve( MAX_NUMBER_OF_MATCHES + 1 );
 }
 
 TrackedBlobHolder::~TrackedBlobHolder()
@@ -85,7 +87,7 @@ firstChoiceDistance().
 *******************************************************************************/
 bool TrackedBlobHolder::hasMatchRequest()
 {
-    return (newBlobMatches_.size() > 0);
+    return (firstMatch_ < (int)newBlobMatches_.size());
 }
 
 int TrackedBlobHolder::trackedBlobId()
@@ -97,8 +99,8 @@ int TrackedBlobHolder::firstChoiceIndex() const
 {
     int index = -1;
 
-    if( newBlobMatches_.size() > 0 ) {
-        index = newBlobMatches_.front().newBlobIndex();
+    if( firstMatch_ < (int)newBlobMatches_.size() ) {
+        index = newBlobMatches_[firstMatch_].newBlobIndex();
     }
     return index;
 }
@@ -107,96 +109,117 @@ double TrackedBlobHolder::firstChoiceDistance() const
 {
     double distance = 1000000000.0;
 
-    if( newBlobMatches_.size() > 0 ) {
-        distance = newBlobMatches_.front().distance();
+    if( firstMatch_ < (int)newBlobMatches_.size() ) {
+        distance = newBlobMatches_[firstMatch_].distance();
     }
     return distance;
 }
 
 void TrackedBlobHolder::deleteCurrentFirstChoice()
 {
-    if( !newBlobMatches_.empty() ) {
-        newBlobMatches_.pop_front();
+    if( firstMatch_ < (int)newBlobMatches_.size() ) {
+        ++firstMatch_;
     }
 }
 
+/***************************************************************************//**
+The number of matches that are left (not deleted as first choices).
+*******************************************************************************/
+int TrackedBlobHolder::numberOfMatches() const
+{
+    return (int)newBlobMatches_.size() - firstMatch_;
+}
+
+/***************************************************************************//**
+The match that is left at the index (0 is the first choice).
+*******************************************************************************/
+const blobTracker::BlobMatch & TrackedBlobHolder::match( int i ) const
+{
+    return newBlobMatches_[firstMatch_ + i];
+}
+
+/***************************************************************************//**
+Drops every match except the one for the new blob at the index, which becomes 
+the only choice (used when the BlobTracker has worked out all of the matches
+at once).  If the new blob is not one of the matches (an index of -1, for 
+example), no matches are left.
+*******************************************************************************/
+void TrackedBlobHolder::setOnlyMatch( int newBlobIndex )
+{
+    int numMatches = (int)newBlobMatches_.size();
+    int i = firstMatch_;
+
+    while( i < numMatches && newBlobMatches_[i].newBlobIndex() != newBlobIndex ) {
+        ++i;
+    }
+    if( i < numMatches ) {
+        newBlobMatches_[0] = newBlobMatches_[i];
+        newBlobMatches_.resize( 1 );
+    }
+    else {
+        newBlobMatches_.clear();
+    }
+    firstMatch_ = 0;
+}
+
 /***************************************************************************//**
 The tracked blob must be set before calling this function.  This function will 
-build and save a list of the new blobs that are closest to the tracked blob.  
-The list of matches will never be greater in length than MAX_NUMBER_OF_MATCHES,
-and the distance (squared) will never be greater than the maxBlobDistanceSquared
+build and save a list of the new blobs that are closest to the tracked blob,
+out of the candidates (the new blobs that a BlobGrid found within the largest
+allowed distance of the tracked blob, with their squared distances).  
+The list of matches will never be greater in length than MAX_NUMBER_OF_MATCHES
 (square of the distance is used to avoid square root calculations in the
-Pythagorean theorem).  The list of matches will be empty if the vector of new 
-blobs given as an argument is empty or if the tracked blob is not valid 
-(an ID of -1 is non-valid track).
+Pythagorean theorem).  The list of matches will be empty if there are no 
+candidates or if the tracked blob is not valid (an ID of -1 is non-valid track).
+The list is kept in a small array that is reused from frame to frame.
 *******************************************************************************/
-void TrackedBlobHolder::setBestMatches( std::vector<blobTracker::Blob> & newBlobs,
-                                        double maxBlobDistanceSquared )
+void TrackedBlobHolder::setBestMatches( const std::vector<blobTracker::BlobMatch> & candidates )
 {
-    int numberOfNewBlobs = newBlobs.size();
+    int numberOfCandidates = candidates.size();
     newBlobMatches_.clear();
+    firstMatch_ = 0;
+
+    if( trackedBlob_.id != -1 ) {
+        for( int c = 0; c < numberOfCandidates; ++c ) {
+            const blobTracker::BlobMatch & candidate = candidates[c];
+            int numMatches = newBlobMatches_.size(),
+                position = numMatches;
+
+            // Search for the first existing match with a bigger distance (or
+            // the same distance and a bigger index, so the order does not 
+            // depend on the order of the candidates).
+            for( int m = numMatches - 1; m >= 0 && isCloser( candidate, newBlobMatches_[m] ); --m ) {
+                position = m;
+            }
+            if( position < MAX_NUMBER_OF_MATCHES ) {
+                // Insert new blob in the list of matches.
+                newBlobMatches_.insert( newBlobMatches_.begin() + position, candidate );
 
-    if( numberOfNewBlobs > 0 && trackedBlob_.id != -1) {
-        // Declare the first new blob as the current best match for distance.
-        double distance = distanceSquared( newBlobs[0], trackedBlob_ );
-        blobTracker::BlobMatch currentMatch( 0, distance );
-        newBlobMatches_.push_back( currentMatch );
-
-        // Look for better matches and store up to MAX_NUMBER_OF_MATCHES.
-        for( int i = 1; i < numberOfNewBlobs; ++i ) {
-            distance = distanceSquared( newBlobs[i], trackedBlob_ );
-
-            if( distance <= maxBlobDistanceSquared ) {
-                // Within the allowed distance, so add to sorted linked list.
-                std::list<BlobMatch>::iterator iter = newBlobMatches_.begin(),
-                                               end = newBlobMatches_.end();
-                
-                // Search for first existing match where distance is not greater.
-                while( iter != end && distance >= iter->distance() ) {
-                    ++iter;
-                }
-                // Iterator is now pointing at either a bigger distance or the end.
-                if( iter != end || newBlobMatches_.size() < MAX_NUMBER_OF_MATCHES ) {
-                    // Insert new blob in the list of matches.
-                    currentMatch.setIndexAndDistance( i, distance );
-                    newBlobMatches_.insert( iter, currentMatch );
-
-                    if( newBlobMatches_.size() > MAX_NUMBER_OF_MATCHES ) {
-                        // There are too many matches, so trim the list.
-				        newBlobMatches_.pop_back();
-                    }
+                if( (int)newBlobMatches_.size() > MAX_NUMBER_OF_MATCHES ) {
+                    // There are too many matches, so trim the list.
+				    newBlobMatches_.pop_back();
                 }
             }
         }
     }
 }
 
-/***************************************************************************//**
-Returns the square of the distance between the two blobs.
-*******************************************************************************/
-double TrackedBlobHolder::distanceSquared( blobTracker::Blob & blob1, 
-                                     blobTracker::Blob & blob2 )
+bool TrackedBlobHolder::isCloser( const blobTracker::BlobMatch & a, const blobTracker::BlobMatch & b )
 {
-    double xDistance = blob1.centroid.x - blob2.centroid.x,
-           yDistance = blob1.centroid.y - blob2.centroid.y;
-    return (xDistance * xDistance) + (yDistance * yDistance);
+    return a.distance() < b.distance() || (a.distance() == b.distance() && a.newBlobIndex() < b.newBlobIndex());
 }
 
 void TrackedBlobHolder::debugPrint()
 {
-    int numMatches = newBlobMatches_.size();
+    int numMatches = numberOfMatches();
     std::cout << "\nTracked blob id = " << trackedBlob_.id 
               << ": matches = " << numMatches << "\n";
 
-    std::list<BlobMatch>::iterator iter = newBlobMatches_.begin(),
-                                   end = newBlobMatches_.end();
-
-    while( iter != end ) {
-        int index = iter->newBlobIndex();
-        double distance = iter->distance();
+    for( int m = 0; m < numMatches; ++m ) {
+        int index = match( m ).newBlobIndex();
+        double distance = match( m ).distance();
         std::cout << "    index " << index 
                   << ": distance = " << std::sqrt( distance ) << "\n";
-        ++iter;
     }
     std::cout << "\n";
 }
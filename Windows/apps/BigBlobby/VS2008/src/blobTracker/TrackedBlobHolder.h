@@ -49,7 +49,6 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blobTracker/Blob.h"
 #include "blobTracker/BlobMatch.h"
 #include <vector>
-#include <list>
 
 namespace blobTracker
 {
@@ -69,16 +68,19 @@ namespace blobTracker
         double firstChoiceDistance() const;
         void deleteCurrentFirstChoice();
 
-        void setBestMatches( std::vector<blobTracker::Blob> & newBlobs,
-                             double maxBlobDistanceSquared );
+        void setBestMatches( const std::vector<blobTracker::BlobMatch> & candidates );
+        void setOnlyMatch( int newBlobIndex );
+        int numberOfMatches() const;
+        const blobTracker::BlobMatch & match( int i ) const;
         bool hasMatchRequest();
         void debugPrint();
 
     private:
-        double distanceSquared( blobTracker::Blob & blob1, blobTracker::Blob & blob2 );
+        static bool isCloser( const blobTracker::BlobMatch & a, const blobTracker::BlobMatch & b );
 
         blobTracker::Blob trackedBlob_;
-        std::list<blobTracker::BlobMatch> newBlobMatches_;
+        std::vector<blobTracker::BlobMatch> newBlobMatches_; // Sorted by distance.
+        int firstMatch_;                                     // Choices before this were taken.
     };
 }
 
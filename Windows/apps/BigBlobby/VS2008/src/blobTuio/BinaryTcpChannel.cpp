@@ -66,7 +66,7 @@ void BinaryTcpChannel::setup( const std::string & localHost, int port )
     tcpServer_.setup( port );
 }
 
-void BinaryTcpChannel::sendTUIO( std::map<int, blobTracker::Blob> * blobs )
+void BinaryTcpChannel::sendTUIO( std::vector<blobTracker::Blob> * blobs )
 {
     ++frameseq_;
     unsigned char buf[1024 * 8];
@@ -84,12 +84,12 @@ void BinaryTcpChannel::sendTUIO( std::map<int, blobTracker::Blob> * blobs )
 	} 
     else {
         int count = 0;
-        map<int, blobTracker::Blob>::iterator blob;
+        std::vector<blobTracker::Blob>::iterator blob;
 
         // count the blobs that are non (0,0)
         for( blob = blobs->begin(); blob != blobs->end(); blob++ ) {
             // omit point (0,0) since this means that we are outside of the range
-            if( blob->second.centroid.x == 0 && blob->second.centroid.y == 0 ) {
+            if( blob->centroid.x == 0 && blob->centroid.y == 0 ) {
                 continue;
             }
             count++;
@@ -101,26 +101,26 @@ void BinaryTcpChannel::sendTUIO( std::map<int, blobTracker::Blob> * blobs )
         // send blob information
         for( blob = blobs->begin(); blob != blobs->end(); blob++ ) {
             // omit point (0,0) since this means that we are outside of the range
-            if( blob->second.centroid.x == 0 && blob->second.centroid.y == 0 ) {
+            if( blob->centroid.x == 0 && blob->centroid.y == 0 ) {
                 continue;
             }
-            memcpy( p, &blob->second.id, 4 );
+            memcpy( p, &blob->id, 4 );
             p += 4;
-            memcpy( p, &blob->second.centroid.x, 4 );					
+            memcpy( p, &blob->centroid.x, 4 );					
             p += 4;
-            memcpy( p, &blob->second.centroid.y, 4 );					
+            memcpy( p, &blob->centroid.y, 4 );					
             p += 4;
-            memcpy( p, &blob->second.D.x, 4 );						
+            memcpy( p, &blob->D.x, 4 );						
             p += 4;
-            memcpy( p, &blob->second.D.y, 4 );						
+            memcpy( p, &blob->D.y, 4 );						
             p += 4;
-            memcpy( p, &blob->second.maccel, 4 );						
+            memcpy( p, &blob->maccel, 4 );						
             p += 4;
 
             if( includeHeightAndWidth() ) {
-                memcpy( p, &blob->second.boundingRect.width, 4 );		
+                memcpy( p, &blob->boundingRect.width, 4 );		
                 p += 4;
-                memcpy( p, &blob->second.boundingRect.height, 4 );	
+                memcpy( p, &blob->boundingRect.height, 4 );	
                 p += 4;
             }
         }
@@ -57,7 +57,7 @@ namespace blobTuio
 		BinaryTcpChannel();
 		~BinaryTcpChannel();
         virtual void setup( const std::string & localHost, int port );
-		virtual void sendTUIO( std::map<int, blobTracker::Blob> * blobs );
+		virtual void sendTUIO( std::vector<blobTracker::Blob> * blobs );
 
     private:
 		ofxTCPServer tcpServer_;
@@ -91,7 +91,7 @@ void FlashXmlChannel::setCameraWidthAndHeight( double width, double height )
     cameraArea_ = cameraWidth_ * cameraHeight_;
 }
 
-void FlashXmlChannel::sendTUIO( std::map<int, blobTracker::Blob> * blobs )
+void FlashXmlChannel::sendTUIO( std::vector<blobTracker::Blob> * blobs )
 {
     ++frameseq_;
 
@@ -109,7 +109,7 @@ void FlashXmlChannel::sendTUIO( std::map<int, blobTracker::Blob> * blobs )
     }
 }
 
-void FlashXmlChannel::sendMessage( std::map<int, blobTracker::Blob> * blobs, 
+void FlashXmlChannel::sendMessage( std::vector<blobTracker::Blob> * blobs, 
                                    const std::string & profileName,
                                    TuioProfileEnum::Enum profile )
 {
@@ -122,19 +122,19 @@ void FlashXmlChannel::sendMessage( std::map<int, blobTracker::Blob> * blobs,
         std::string aliveEndMsg = "</MESSAGE>";
         std::string aliveBlobsMsg;
 
-        for( map<int, blobTracker::Blob>::iterator blob = blobs->begin(); blob != blobs->end(); ++blob ) {
+        for( std::vector<blobTracker::Blob>::iterator blob = blobs->begin(); blob != blobs->end(); ++blob ) {
             // Omit point (0,0) because this means that we are outside of the calibration grid.
-            if( (blob->second.centroid.x == 0) && (blob->second.centroid.y == 0) ) {
+            if( (blob->centroid.x == 0) && (blob->centroid.y == 0) ) {
                 continue;
             }
             switch( profile ) {
                 case TuioProfileEnum::TUIO_2D_CURSOR:
-		            add2DcurProfile( setBlobsMsg, blob->second );
-                    aliveBlobsMsg += "<ARGUMENT TYPE=\"i\" VALUE=\"" + ofToString( blob->second.id ) + "\"/>";
+		            add2DcurProfile( setBlobsMsg, *blob );
+                    aliveBlobsMsg += "<ARGUMENT TYPE=\"i\" VALUE=\"" + ofToString( blob->id ) + "\"/>";
                     break;
                 case TuioProfileEnum::TUIO_2D_BLOB:
-                    add2DblbProfile( setBlobsMsg, blob->second );
-                    aliveBlobsMsg += "<ARGUMENT TYPE=\"i\" VALUE=\"" + ofToString( blob->second.id ) + "\"/>";
+                    add2DblbProfile( setBlobsMsg, *blob );
+                    aliveBlobsMsg += "<ARGUMENT TYPE=\"i\" VALUE=\"" + ofToString( blob->id ) + "\"/>";
                     break;
             }
         }
@@ -63,7 +63,7 @@ namespace blobTuio
 		OutputChannel();
 		virtual ~OutputChannel();
         virtual void setup( const std::string & localHost, int port ) = 0;
-		virtual void sendTUIO( std::map<int, blobTracker::Blob> * blobs ) = 0;
+		virtual void sendTUIO( std::vector<blobTracker::Blob> * blobs ) = 0;
 
         std::string getLocalHost();
         int getPort();
@@ -74,7 +74,7 @@ TuioChannels::~TuioChannels()
     delete processTimer_;
 }
 
-void TuioChannels::sendTuio( std::map<int, blobTracker::Blob> * blobs )
+void TuioChannels::sendTuio( std::vector<blobTracker::Blob> * blobs )
 {
     processTimer_->startTiming();
     
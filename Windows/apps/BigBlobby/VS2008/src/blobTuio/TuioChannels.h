@@ -71,7 +71,7 @@ namespace blobTuio
         TuioChannels();
         ~TuioChannels();
 
-        void sendTuio( std::map<int, blobTracker::Blob> * blobs );
+        void sendTuio( std::vector<blobTracker::Blob> * blobs );
         std::string getOutputSummary();
 
         void setupTuio( const std::string & localHost,
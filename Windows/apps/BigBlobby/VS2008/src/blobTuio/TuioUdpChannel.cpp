@@ -91,7 +91,7 @@ void TuioUdpChannel::setCameraWidthAndHeight( double width, double height )
     cameraArea_ = cameraWidth_ * cameraHeight_;
 }
 
-void TuioUdpChannel::sendTUIO( std::map<int, blobTracker::Blob> * blobs )
+void TuioUdpChannel::sendTUIO( std::vector<blobTracker::Blob> * blobs )
 {
     ++frameseq_;
 
@@ -111,7 +111,7 @@ void TuioUdpChannel::sendTUIO( std::map<int, blobTracker::Blob> * blobs )
     }
 }
 
-void TuioUdpChannel::sendMessage( std::map<int, blobTracker::Blob> * blobs, 
+void TuioUdpChannel::sendMessage( std::vector<blobTracker::Blob> * blobs, 
                                   const std::string & profileName,
                                   TuioProfileEnum::Enum profile )
 {
@@ -126,18 +126,18 @@ void TuioUdpChannel::sendMessage( std::map<int, blobTracker::Blob> * blobs,
 	fseq.addStringArg( "fseq" );
 	fseq.addIntArg( frameseq_ );
 
-    for( map<int, blobTracker::Blob>::iterator blob = blobs->begin(); blob != blobs->end(); ++blob ) {
-        if( blob->second.centroid.x == 0 && blob->second.centroid.y == 0 ) {
+    for( std::vector<blobTracker::Blob>::iterator blob = blobs->begin(); blob != blobs->end(); ++blob ) {
+        if( blob->centroid.x == 0 && blob->centroid.y == 0 ) {
 			continue;  // Skip point outside calibration grid.
         }
         switch( profile ) {
             case TuioProfileEnum::TUIO_2D_CURSOR:
-		        add2DcurProfile( oscBundle, blob->second );
-		        alive.addIntArg( blob->second.id );
+		        add2DcurProfile( oscBundle, *blob );
+		        alive.addIntArg( blob->id );
                 break;
             case TuioProfileEnum::TUIO_2D_BLOB:
-                add2DblbProfile( oscBundle, blob->second );
-		        alive.addIntArg( blob->second.id );
+                add2DblbProfile( oscBundle, *blob );
+		        alive.addIntArg( blob->id );
                 break;
             default:
                 break;
@@ -65,10 +65,10 @@ namespace blobTuio
         virtual void setup( const std::string & localHost, int port );
         void setTuioProfile( blobEnums::TuioProfileEnum::Enum profile );
         void setCameraWidthAndHeight( double width, double height );
-		virtual void sendTUIO( std::map<int, blobTracker::Blob> * blobs );
+		virtual void sendTUIO( std::vector<blobTracker::Blob> * blobs );
 
     private:
-        void sendMessage( std::map<int, blobTracker::Blob> * blobs, 
+        void sendMessage( std::vector<blobTracker::Blob> * blobs, 
                           const std::string & profileName,
                           blobEnums::TuioProfileEnum::Enum profile );
         void add2DcurProfile( ofxOscBundle & oscBundle, blobTracker::Blob & blob );
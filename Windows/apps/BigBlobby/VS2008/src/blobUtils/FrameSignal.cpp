@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+// FrameSignal
+//
+// PURPOSE: Lets a frame source (or anything that changes what the vision
+//          thread should do) wake up the vision thread immediately, instead
+//          of the vision thread polling on a timer.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobUtils/FrameSignal.h"
+#include <boost/thread/locks.hpp>
+#include <boost/chrono/chrono.hpp>
+
+using blobUtils::FrameSignal;
+
+FrameSignal::FrameSignal() :
+  mutex_(),
+  condition_(),
+  isNotified_( false )
+{
+}
+
+FrameSignal::~FrameSignal()
+{
+}
+
+/***************************************************************************//**
+Wakes up the waiting thread (or makes its next waitFor() return immediately).
+*******************************************************************************/
+void FrameSignal::notify()
+{
+    {
+        boost::lock_guard<boost::mutex> lock( mutex_ );
+        isNotified_ = true;
+    }
+    condition_.notify_one();
+}
+
+/***************************************************************************//**
+Blocks until notify() is called or the time (in seconds) runs out.  Returns 
+true if notified, and clears the notification either way.
+*******************************************************************************/
+bool FrameSignal::waitFor( double seconds )
+{
+    boost::unique_lock<boost::mutex> lock( mutex_ );
+
+    if( !isNotified_ && seconds > 0.0 ) {
+        boost::chrono::steady_clock::time_point timeout = boost::chrono::steady_clock::now()
+            + boost::chrono::duration_cast<boost::chrono::steady_clock::duration>( 
+                  boost::chrono::duration<double>( seconds ) );
+
+        while( !isNotified_ ) {
+            if( condition_.wait_until( lock, timeout ) == boost::cv_status::timeout ) {
+                break;
+            }
+        }
+    }
+    bool wasNotified = isNotified_;
+    isNotified_ = false;
+    return wasNotified;
+}
@@ -71,6 +71,16 @@ void FunctionTimer::stopTiming()
     ++numFunctionCalls_;
 }
 
+/***************************************************************************//**
+Counts a time measured some other way (for example, the sum of the times of 
+the parts of a call that ran on different threads) as one call.
+*******************************************************************************/
+void FunctionTimer::addTime( double seconds )
+{
+    totalTime_ += seconds;
+    ++numFunctionCalls_;
+}
+
 double FunctionTimer::calculateAverageTime()
 {
     double averageTime = 0.0;
@@ -58,6 +58,7 @@ namespace blobUtils
 
         void startTiming();
         void stopTiming();
+        void addTime( double seconds );
         double calculateAverageTime();
 
     private:
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+// SpscQueue
+//
+// PURPOSE: Bounded lock-free queue for passing values from one producer thread
+//          to one consumer thread.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBUTILS_SPSCQUEUE_H
+#define BLOBUTILS_SPSCQUEUE_H
+
+#include <boost/atomic.hpp>
+#include <vector>
+
+namespace blobUtils
+{
+    /***********************************************************************//**
+    A fixed-capacity ring buffer that is safe to use without locks as long as
+    exactly one thread calls tryPush() and exactly one (other) thread calls 
+    tryPop().  Neither call ever blocks: tryPush() returns false when the queue
+    is full and tryPop() returns false when it is empty, so the caller decides
+    what to do about it (the FramePipeline drops frames rather than waiting).
+
+    The ring has one more slot than the capacity so that a full queue can be 
+    told apart from an empty one without a shared counter.
+    ***************************************************************************/
+    template <typename T>
+    class SpscQueue
+    {
+    public:
+        explicit SpscQueue( int capacity ) :
+          slots_( (capacity > 0 ? capacity : 1) + 1 ),
+          head_( 0 ),
+          tail_( 0 )
+        {
+        }
+
+        /*******************************************************************//**
+        Producer side.  Returns false (and does not copy the value) if full.
+        ***********************************************************************/
+        bool tryPush( const T & value )
+        {
+            size_t tail = tail_.load( boost::memory_order_relaxed ),
+                   next = increment( tail );
+
+            if( next == head_.load( boost::memory_order_acquire ) ) {
+                return false;
+            }
+            slots_[tail] = value;
+            tail_.store( next, boost::memory_order_release );
+            return true;
+        }
+
+        /*******************************************************************//**
+        Consumer side.  Returns false (and leaves the arg alone) if empty.
+        ***********************************************************************/
+        bool tryPop( T & value )
+        {
+            size_t head = head_.load( boost::memory_order_relaxed );
+
+            if( head == tail_.load( boost::memory_order_acquire ) ) {
+                return false;
+            }
+            value = slots_[head];
+            head_.store( increment( head ), boost::memory_order_release );
+            return true;
+        }
+
+        /*******************************************************************//**
+        Only a hint when called while the other thread is active.
+        ***********************************************************************/
+        bool isEmpty() const
+        {
+            return head_.load( boost::memory_order_acquire ) 
+                == tail_.load( boost::memory_order_acquire );
+        }
+
+    private:
+        size_t increment( size_t index ) const
+        {
+            return (index + 1 == slots_.size()) ? 0 : index + 1;
+        }
+
+        // Not copyable.
+        SpscQueue( const SpscQueue & );
+        SpscQueue & operator=( const SpscQueue & );
+
+        std::vector<T> slots_;
+        boost::atomic<size_t> head_,
+                              tail_;
+    };
+}
+
+#endif
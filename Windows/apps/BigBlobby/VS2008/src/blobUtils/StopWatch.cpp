@@ -90,7 +90,7 @@ void StopWatch::print( double timeInSeconds )
 /******************************************************************************/
 /*********************** Linux Version with sys/timeb.h ***********************/
 /******************************************************************************/
-#include "ghostUtils/StopWatch.h"
+#include "blobUtils/StopWatch.h"
 #include <iostream>
 #include <time.h>
 #include <sys/timeb.h>
@@ -113,8 +113,9 @@ void StopWatch::start()
 
 double StopWatch::restart()
 {
-    double diff = seconds() - startTime_;
-    startTime_ = diff;
+    double now = seconds(),
+           diff = now - startTime_;
+    startTime_ = now;
     return diff;
 }
 
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// TripleBuffer
+//
+// PURPOSE: Hands the latest value written by one thread to a reader on another
+//          thread without either thread ever blocking.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBUTILS_TRIPLEBUFFER_H
+#define BLOBUTILS_TRIPLEBUFFER_H
+
+#include <boost/atomic.hpp>
+
+namespace blobUtils
+{
+    /***********************************************************************//**
+    A lock-free triple buffer for one writer thread and one reader thread.
+
+    The writer fills backBuffer() and then calls publish(), which swaps the 
+    back buffer with the middle buffer.  The reader calls fetch(), which swaps
+    the middle buffer with the front buffer if something new has been published
+    since the last fetch.  The reader then uses frontBuffer() until its next
+    fetch.  Neither side ever waits on the other, and the reader always sees the
+    most recent complete value (older values are simply overwritten).
+
+    The template type must be default constructible.  The three values are 
+    created up front and reused, so a type that holds on to its allocations 
+    (like a vector of pixel buffers) does not allocate again in steady state.
+    ***************************************************************************/
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer() :
+          middle_( 1 ),
+          front_( 0 ),
+          back_( 2 )
+        {
+        }
+
+        /*******************************************************************//**
+        Writer side: the buffer to fill before calling publish().
+        ***********************************************************************/
+        T & backBuffer()
+        {
+            return buffers_[back_];
+        }
+
+        /*******************************************************************//**
+        Writer side: makes the back buffer available to the reader and takes 
+        over the old middle buffer as the new back buffer.
+        ***********************************************************************/
+        void publish()
+        {
+            int old = middle_.exchange( back_ | DIRTY_BIT, boost::memory_order_acq_rel );
+            back_ = old & INDEX_MASK;
+        }
+
+        /*******************************************************************//**
+        Reader side: returns true (and swaps in the newest value) if the writer
+        has published since the last call.  Returns false if nothing changed.
+        ***********************************************************************/
+        bool fetch()
+        {
+            if( (middle_.load( boost::memory_order_acquire ) & DIRTY_BIT) == 0 ) {
+                return false;
+            }
+            int old = middle_.exchange( front_, boost::memory_order_acq_rel );
+            front_ = old & INDEX_MASK;
+            return true;
+        }
+
+        /*******************************************************************//**
+        Reader side: the value obtained by the last successful fetch().
+        ***********************************************************************/
+        T & frontBuffer()
+        {
+            return buffers_[front_];
+        }
+
+    private:
+        enum { INDEX_MASK = 0x3, DIRTY_BIT = 0x4 };
+
+        // Not copyable.
+        TripleBuffer( const TripleBuffer & );
+        TripleBuffer & operator=( const TripleBuffer & );
+
+        T buffers_[3];
+        boost::atomic<int> middle_;
+        int front_,
+            back_;
+    };
+}
+
+#endif
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+// WorkStealingPool
+//
+// PURPOSE: A small fixed set of worker threads that share out the iterations of
+//          a parallel loop.  Each worker starts with its own contiguous block of
+//          iterations and steals from the other workers when it runs dry.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobUtils/WorkStealingPool.h"
+#include <boost/thread/thread.hpp>
+#include <boost/thread/locks.hpp>
+
+using blobUtils::WorkStealingPool;
+
+/***************************************************************************//**
+Creates the pool with the given number of workers (counting the thread that 
+calls parallelFor()).  Zero or less means one worker per hardware thread.
+*******************************************************************************/
+WorkStealingPool::WorkStealingPool( int numThreads ) :
+  queues_(),
+  threads_(),
+  task_(),
+  callMutex_(),
+  poolMutex_(),
+  wakeCondition_(),
+  doneCondition_(),
+  pendingTasks_( 0 ),
+  generation_( 0 ),
+  isStopping_( false )
+{
+    if( numThreads <= 0 ) {
+        numThreads = (int)boost::thread::hardware_concurrency();
+    }
+    if( numThreads <= 0 ) {
+        numThreads = 1;
+    }
+    for( int i = 0; i < numThreads; ++i ) {
+        queues_.push_back( new WorkerQueue() );
+    }
+    for( int i = 1; i < numThreads; ++i ) {
+        threads_.push_back( new boost::thread( &WorkStealingPool::runWorker, this, i ) );
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        boost::mutex::scoped_lock lock( poolMutex_ );
+        isStopping_ = true;
+    }
+    wakeCondition_.notify_all();
+
+    for( size_t i = 0; i < threads_.size(); ++i ) {
+        threads_[i]->join();
+        delete threads_[i];
+    }
+    for( size_t i = 0; i < queues_.size(); ++i ) {
+        delete queues_[i];
+    }
+}
+
+int WorkStealingPool::numThreads() const
+{
+    return (int)queues_.size();
+}
+
+/***************************************************************************//**
+Calls task( i ) once for every i in [0, count) and returns when all of the 
+calls have finished.  The calls run concurrently, so the task must only write
+to data that belongs to its own iteration.
+*******************************************************************************/
+void WorkStealingPool::parallelFor( int count, const TaskFunction & task )
+{
+    if( count <= 0 ) {
+        return;
+    }
+    boost::mutex::scoped_lock callLock( callMutex_ );
+
+    if( threads_.empty() || count == 1 ) {
+        for( int i = 0; i < count; ++i ) {
+            task( i );
+        }
+        return;
+    }
+    {
+        boost::mutex::scoped_lock lock( poolMutex_ );
+        task_ = task;
+        pendingTasks_ = count;
+        dealTasks( count );
+        ++generation_;
+    }
+    wakeCondition_.notify_all();
+    runTasks( 0 );
+
+    boost::mutex::scoped_lock lock( poolMutex_ );
+
+    while( pendingTasks_ > 0 ) {
+        doneCondition_.wait( lock );
+    }
+    task_ = TaskFunction();
+}
+
+/***************************************************************************//**
+Splits [0, count) into one contiguous block per worker.
+*******************************************************************************/
+void WorkStealingPool::dealTasks( int count )
+{
+    int numWorkers = (int)queues_.size(),
+        first = 0;
+
+    for( int i = 0; i < numWorkers; ++i ) {
+        int end = (int)(((long long)count * (i + 1)) / numWorkers);
+        boost::mutex::scoped_lock lock( queues_[i]->mutex );
+
+        for( int task = first; task < end; ++task ) {
+            queues_[i]->tasks.push_back( task );
+        }
+        first = end;
+    }
+}
+
+void WorkStealingPool::runWorker( int index )
+{
+    int seenGeneration = 0;
+
+    while( true ) {
+        {
+            boost::mutex::scoped_lock lock( poolMutex_ );
+
+            while( !isStopping_ && generation_ == seenGeneration ) {
+                wakeCondition_.wait( lock );
+            }
+            if( isStopping_ ) {
+                return;
+            }
+            seenGeneration = generation_;
+        }
+        runTasks( index );
+    }
+}
+
+/***************************************************************************//**
+Keeps running tasks (its own first, then stolen ones) until there are none 
+left to take.  The last task to finish wakes up the parallelFor() caller.
+*******************************************************************************/
+void WorkStealingPool::runTasks( int index )
+{
+    int task = 0;
+
+    while( popTask( index, task ) || stealTask( index, task ) ) {
+        task_( task );
+
+        if( --pendingTasks_ == 0 ) {
+            boost::mutex::scoped_lock lock( poolMutex_ );
+            doneCondition_.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::popTask( int index, int & task )
+{
+    WorkerQueue * queue = queues_[index];
+    boost::mutex::scoped_lock lock( queue->mutex );
+
+    if( queue->tasks.empty() ) {
+        return false;
+    }
+    task = queue->tasks.front();
+    queue->tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::stealTask( int thief, int & task )
+{
+    int numWorkers = (int)queues_.size();
+
+    for( int i = 1; i < numWorkers; ++i ) {
+        WorkerQueue * victim = queues_[(thief + i) % numWorkers];
+        boost::mutex::scoped_lock lock( victim->mutex );
+
+        if( !victim->tasks.empty() ) {
+            task = victim->tasks.back();
+            victim->tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// WorkStealingPool
+//
+// PURPOSE: A small fixed set of worker threads that share out the iterations of
+//          a parallel loop.  Each worker starts with its own contiguous block of
+//          iterations and steals from the other workers when it runs dry.
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBUTILS_WORKSTEALINGPOOL_H
+#define BLOBUTILS_WORKSTEALINGPOOL_H
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <deque>
+#include <vector>
+
+namespace boost { class thread; }
+
+namespace blobUtils
+{
+    /***********************************************************************//**
+    Runs parallelFor() loops on a fixed set of worker threads.  The thread 
+    that calls parallelFor() works as worker zero, so a pool created for one 
+    thread starts no threads at all and simply runs the loop in place.
+
+    The iterations are dealt out in contiguous blocks, one deque per worker, 
+    so neighbouring iterations (neighbouring image strips, for instance) tend 
+    to run on the same core.  A worker takes from the front of its own deque 
+    and, once that is empty, steals from the back of another worker's deque,
+    which evens out the load when some iterations take longer than others.
+
+    Only one parallelFor() can run at a time; a second caller waits its turn.
+    ***************************************************************************/
+    class WorkStealingPool
+    {
+    public:
+        typedef boost::function<void (int)> TaskFunction;
+
+        explicit WorkStealingPool( int numThreads = 0 );
+        ~WorkStealingPool();
+
+        int numThreads() const;
+        void parallelFor( int count, const TaskFunction & task );
+
+    private:
+        struct WorkerQueue
+        {
+            boost::mutex mutex;
+            std::deque<int> tasks;
+        };
+
+        void runWorker( int index );
+        void runTasks( int index );
+        bool popTask( int index, int & task );
+        bool stealTask( int thief, int & task );
+        void dealTasks( int count );
+
+        // Not copyable.
+        WorkStealingPool( const WorkStealingPool & );
+        WorkStealingPool & operator=( const WorkStealingPool & );
+
+        std::vector<WorkerQueue *> queues_;
+        std::vector<boost::thread *> threads_;
+        TaskFunction task_;
+        boost::mutex callMutex_,
+                     poolMutex_;
+        boost::condition_variable wakeCondition_,
+                                  doneCondition_;
+        boost::atomic<int> pendingTasks_;
+        int generation_;
+        bool isStopping_;
+    };
+}
+
+#endif
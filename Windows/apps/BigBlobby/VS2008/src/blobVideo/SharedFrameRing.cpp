@@ -0,0 +1,431 @@
+////////////////////////////////////////////////////////////////////////////////
+// SharedFrameRing
+//
+// PURPOSE: A ring of frame slots in POSIX shared memory, written by one process
+//          (the producer) and read without copying by another (the consumer).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobVideo/SharedFrameRing.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+using blobVideo::SharedFrameRing;
+using blobVideo::SharedFrameHeader;
+using blobVideo::SharedFrameSlot;
+using blobEnums::PixelFormatEnum;
+
+const boost::uint32_t SharedFrameRing::MAGIC = 0x42424652, // "BBFR"
+                      SharedFrameRing::VERSION = 1;
+
+// One slot held by the consumer, one latest frame, and one for the producer to
+// write into.
+const int SharedFrameRing::MIN_SLOTS = 3;
+
+namespace
+{
+    size_t roundUp( size_t n, size_t multiple )
+    {
+        return ((n + multiple - 1) / multiple) * multiple;
+    }
+
+    // The slot records start on the cache line after the header.
+    const size_t SLOT_RECORDS_OFFSET = roundUp( sizeof(SharedFrameHeader), 64 );
+}
+
+SharedFrameRing::SharedFrameRing() :
+  name_(),
+  isProducer_( false ),
+  memory_( NULL ),
+  size_( 0 ),
+  header_( NULL ),
+  writeSlot_( -1 ),
+  heldSlot_( -1 ),
+  nextSequence_( 1 ),
+  heldSequence_( 0 ),
+  heldTimestamp_( 0.0 ),
+  device_( 0 ),
+  inode_( 0 )
+{
+}
+
+SharedFrameRing::~SharedFrameRing()
+{
+    close();
+}
+
+/***************************************************************************//**
+Creates the shared memory (replacing any left over under the same name) with
+room for numSlots frames of the given size and format.  The name should start
+with a slash, for example "/bigblobby".  Rows are padded to 16 bytes and 
+slots start on 64-byte boundaries, so the consumer's filters see aligned rows.
+*******************************************************************************/
+bool SharedFrameRing::create( const std::string & name, int width, int height,
+                              PixelFormatEnum::Enum pixelFormat, int numSlots )
+{
+    close();
+    name_ = name;
+
+    if( width < 1 || height < 1 ) {
+        return false;
+    }
+    if( numSlots < MIN_SLOTS ) {
+        numSlots = MIN_SLOTS;
+    }
+    size_t stride = roundUp( width * PixelFormatEnum::bytesPerPixel( pixelFormat ), 16 ),
+           slotSize = roundUp( stride * height, 64 ),
+           slotOffset = roundUp( SLOT_RECORDS_OFFSET + numSlots * sizeof(SharedFrameSlot), 64 ),
+           size = slotOffset + numSlots * slotSize;
+
+    shm_unlink( name_.c_str() );
+    int fd = shm_open( name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666 );
+
+    if( fd < 0 ) {
+        printError( "shm_open" );
+        return false;
+    }
+    if( ftruncate( fd, (off_t)size ) < 0 ) {
+        printError( "ftruncate" );
+        ::close( fd );
+        shm_unlink( name_.c_str() );
+        return false;
+    }
+    if( !map( fd, size ) ) {
+        shm_unlink( name_.c_str() );
+        return false;
+    }
+    isProducer_ = true;
+    header_ = new( memory_ ) SharedFrameHeader();
+    header_->version = VERSION;
+    header_->width = width;
+    header_->height = height;
+    header_->stride = (boost::uint32_t)stride;
+    header_->pixelFormat = pixelFormat;
+    header_->numSlots = numSlots;
+    header_->slotOffset = (boost::uint32_t)slotOffset;
+    header_->slotSize = (boost::uint32_t)slotSize;
+    header_->latestSlot.store( -1 );
+    header_->readerSlot.store( -1 );
+
+    for( int i = 0; i < numSlots; ++i ) {
+        SharedFrameSlot * s = new( slot( i ) ) SharedFrameSlot();
+        s->sequence.store( 0 );
+        s->timestamp = 0.0;
+    }
+    header_->magic.store( MAGIC ); // The consumer can use the ring from now on.
+    return true;
+}
+
+/***************************************************************************//**
+Returns the pixels of a slot that the consumer is not reading, or NULL if the 
+ring was not create()d by this object.  The frame is not seen by the consumer 
+until endWrite() is called.
+*******************************************************************************/
+unsigned char * SharedFrameRing::beginWrite()
+{
+    if( !isProducer_ || header_ == NULL ) {
+        return NULL;
+    }
+    int n = numSlots(),
+        latest = header_->latestSlot.load();
+
+    for( int i = 1; i <= 2 * n; ++i ) {
+        int index = (latest + i + n) % n;
+
+        if( index == latest || index == header_->readerSlot.load() ) {
+            continue;
+        }
+        // Mark the slot as being written, then make sure the consumer did not
+        // take it in the meantime.
+        SharedFrameSlot * s = slot( index );
+        boost::uint32_t oldSequence = s->sequence.exchange( 0 );
+
+        if( header_->readerSlot.load() == index ) {
+            s->sequence.store( oldSequence );
+            continue;
+        }
+        writeSlot_ = index;
+        return slotPixels( index );
+    }
+    return NULL;
+}
+
+/***************************************************************************//**
+Publishes the frame written since beginWrite() as the latest frame.
+*******************************************************************************/
+void SharedFrameRing::endWrite( double timestamp )
+{
+    if( writeSlot_ < 0 ) {
+        return;
+    }
+    SharedFrameSlot * s = slot( writeSlot_ );
+    s->timestamp = timestamp;
+    s->sequence.store( nextSequence_ );
+    header_->latestSlot.store( writeSlot_ );
+    writeSlot_ = -1;
+
+    // Zero means "being written", so it is skipped when the count wraps.
+    ++nextSequence_;
+    if( nextSequence_ == 0 ) {
+        nextSequence_ = 1;
+    }
+}
+
+/***************************************************************************//**
+Maps a ring that a producer has create()d.  Returns false if there is no ring
+by that name yet, or if it is not a ring of this version.
+*******************************************************************************/
+bool SharedFrameRing::open( const std::string & name )
+{
+    close();
+    name_ = name;
+    int fd = shm_open( name_.c_str(), O_RDWR, 0 );
+
+    if( fd < 0 ) {
+        return false;
+    }
+    struct stat info;
+
+    if( fstat( fd, &info ) < 0 || (size_t)info.st_size < SLOT_RECORDS_OFFSET ) {
+        ::close( fd );
+        return false;
+    }
+    if( !map( fd, (size_t)info.st_size ) ) {
+        return false;
+    }
+    device_ = info.st_dev;
+    inode_ = info.st_ino;
+    header_ = (SharedFrameHeader *)memory_;
+
+    if( header_->magic.load() != MAGIC 
+        || header_->version != VERSION
+        || header_->numSlots < (boost::uint32_t)MIN_SLOTS
+        || header_->slotOffset < SLOT_RECORDS_OFFSET + header_->numSlots * sizeof(SharedFrameSlot)
+        || header_->slotOffset + (size_t)header_->numSlots * header_->slotSize > size_ 
+        || (size_t)header_->stride * header_->height > header_->slotSize ) 
+    {
+        close();
+        return false;
+    }
+    isProducer_ = false;
+    return true;
+}
+
+/***************************************************************************//**
+Takes the latest frame if its sequence number is not lastSequence, and holds it
+(the producer will not write to it) until the next call.  Returns false if 
+there is no new frame.  If the producer has closed the ring, the ring is closed
+here as well, so that the consumer can open() the producer's next ring.
+*******************************************************************************/
+bool SharedFrameRing::acquireLatest( boost::uint32_t lastSequence )
+{
+    if( isProducer_ || header_ == NULL ) {
+        return false;
+    }
+    if( header_->magic.load() != MAGIC ) {
+        close();
+        return false;
+    }
+    int n = numSlots();
+
+    for( int tries = 0; tries < n; ++tries ) {
+        int index = header_->latestSlot.load();
+
+        if( index < 0 || index >= n ) {
+            break;
+        }
+        // Mark the slot as held, then make sure the producer was not already
+        // writing to it.
+        header_->readerSlot.store( index );
+        boost::uint32_t sequence = slot( index )->sequence.load();
+
+        if( sequence != 0 ) {
+            heldSlot_ = index;
+            heldSequence_ = sequence;
+            heldTimestamp_ = slot( index )->timestamp;
+            return sequence != lastSequence;
+        }
+    }
+    heldSlot_ = -1;
+    return false;
+}
+
+/***************************************************************************//**
+Returns true if the name no longer refers to the shared memory that open() 
+mapped.  A producer that dies without calling close() leaves the magic set, so
+acquireLatest() never finds out, but a restarted producer's create() puts new 
+shared memory under the name.  The consumer should then close() and open() 
+again.  This costs a system call or three, so it is meant to be called only 
+after no new frame has come for a while.
+*******************************************************************************/
+bool SharedFrameRing::isReplaced()
+{
+    if( isProducer_ || header_ == NULL ) {
+        return false;
+    }
+    int fd = shm_open( name_.c_str(), O_RDONLY, 0 );
+
+    if( fd < 0 ) {
+        return errno == ENOENT;
+    }
+    struct stat info;
+    bool isReplaced = (fstat( fd, &info ) == 0) 
+                      && (info.st_dev != device_ || info.st_ino != inode_);
+    ::close( fd );
+    return isReplaced;
+}
+
+/***************************************************************************//**
+The pixels of the frame taken by acquireLatest(), or NULL if there is none.
+*******************************************************************************/
+unsigned char * SharedFrameRing::heldPixels()
+{
+    return (heldSlot_ >= 0) ? slotPixels( heldSlot_ ) : NULL;
+}
+
+boost::uint32_t SharedFrameRing::heldSequence()
+{
+    return heldSequence_;
+}
+
+double SharedFrameRing::heldTimestamp()
+{
+    return heldTimestamp_;
+}
+
+/***************************************************************************//**
+Unmaps the ring.  A producer also marks the ring as closed and removes its 
+name, which tells the consumer to let go of it.
+*******************************************************************************/
+void SharedFrameRing::close()
+{
+    if( header_ != NULL ) {
+        if( isProducer_ ) {
+            header_->magic.store( 0 );
+            shm_unlink( name_.c_str() );
+        }
+        else if( heldSlot_ >= 0 ) {
+            header_->readerSlot.store( -1 );
+        }
+    }
+    if( memory_ != NULL ) {
+        munmap( memory_, size_ );
+    }
+    isProducer_ = false;
+    memory_ = NULL;
+    size_ = 0;
+    header_ = NULL;
+    writeSlot_ = -1;
+    heldSlot_ = -1;
+    heldSequence_ = 0;
+    heldTimestamp_ = 0.0;
+    device_ = 0;
+    inode_ = 0;
+}
+
+bool SharedFrameRing::isOpen()
+{
+    return header_ != NULL;
+}
+
+int SharedFrameRing::width()
+{
+    return (header_ != NULL) ? (int)header_->width : 0;
+}
+
+int SharedFrameRing::height()
+{
+    return (header_ != NULL) ? (int)header_->height : 0;
+}
+
+int SharedFrameRing::stride()
+{
+    return (header_ != NULL) ? (int)header_->stride : 0;
+}
+
+PixelFormatEnum::Enum SharedFrameRing::pixelFormat()
+{
+    return (header_ != NULL) ? (PixelFormatEnum::Enum)header_->pixelFormat : PixelFormatEnum::GRAY8;
+}
+
+int SharedFrameRing::numSlots()
+{
+    return (header_ != NULL) ? (int)header_->numSlots : 0;
+}
+
+/***************************************************************************//**
+Maps the whole of the shared memory and closes the file descriptor (the 
+mapping stays valid without it).
+*******************************************************************************/
+bool SharedFrameRing::map( int fd, size_t size )
+{
+    void * memory = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if( memory == MAP_FAILED ) {
+        printError( "mmap" );
+        return false;
+    }
+    memory_ = (unsigned char *)memory;
+    size_ = size;
+    return true;
+}
+
+SharedFrameSlot * SharedFrameRing::slot( int index )
+{
+    return (SharedFrameSlot *)(memory_ + SLOT_RECORDS_OFFSET) + index;
+}
+
+unsigned char * SharedFrameRing::slotPixels( int index )
+{
+    return memory_ + header_->slotOffset + (size_t)index * header_->slotSize;
+}
+
+void SharedFrameRing::printError( const std::string & what )
+{
+    std::cout << "SharedFrameRing: " << what << " failed for " << name_ 
+              << " (" << std::strerror( errno ) << ").\n";
+}
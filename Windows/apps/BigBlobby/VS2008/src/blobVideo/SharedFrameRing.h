@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+// SharedFrameRing
+//
+// PURPOSE: A ring of frame slots in POSIX shared memory, written by one process
+//          (the producer) and read without copying by another (the consumer).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBVIDEO_SHAREDFRAMERING_H
+#define BLOBVIDEO_SHAREDFRAMERING_H
+
+#include "blobEnums/PixelFormatEnum.h"
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <sys/types.h>
+#include <cstddef>
+#include <string>
+
+namespace blobVideo
+{
+    /***********************************************************************//**
+    The start of the shared memory.  Everything but the atomics is written 
+    once by the producer before magic is set, and never changes after that.
+    ***************************************************************************/
+    struct SharedFrameHeader
+    {
+        boost::atomic<boost::uint32_t> magic;
+        boost::uint32_t version,
+                        width,
+                        height,
+                        stride,
+                        pixelFormat,
+                        numSlots,
+                        slotOffset, // Bytes from the header to the pixels of slot 0.
+                        slotSize;   // Bytes from the pixels of one slot to the next.
+        boost::atomic<boost::int32_t> latestSlot, // Last slot published (-1 if none).
+                                      readerSlot; // Slot the consumer holds (-1 if none).
+    };
+
+    /***********************************************************************//**
+    One of the numSlots records that follow the header.  The sequence number
+    is zero while the producer is writing the slot.
+    ***************************************************************************/
+    struct SharedFrameSlot
+    {
+        boost::atomic<boost::uint32_t> sequence;
+        boost::uint32_t reserved;
+        double timestamp;
+    };
+
+    /***********************************************************************//**
+    Frames passed from one process to another through POSIX shared memory 
+    (shm_open), with no copy on the consumer side.  The producer create()s the
+    ring and the consumer open()s it by the same name.
+
+    The producer writes each frame into a free slot and then publishes it as
+    the latest slot.  The consumer takes the latest slot and marks it as held,
+    and the producer never writes to the held slot or the latest slot, so the
+    consumer can read the held pixels for as long as it needs.  With at least
+    three slots, the producer always has a free slot and never waits on the 
+    consumer.  A slow consumer skips frames, which shows up as a jump in the
+    sequence numbers.
+
+    Marking a slot as held and checking that it is not being written (and the 
+    producer doing the reverse) are sequentially consistent atomics, so at 
+    least one side always sees the other and backs off.
+    ***************************************************************************/
+    class SharedFrameRing
+    {
+    public:
+        static const boost::uint32_t MAGIC,
+                                     VERSION;
+        static const int MIN_SLOTS;
+
+        SharedFrameRing();
+        ~SharedFrameRing();
+
+        // Producer
+        bool create( const std::string & name, int width, int height,
+                     blobEnums::PixelFormatEnum::Enum pixelFormat, int numSlots );
+        unsigned char * beginWrite();
+        void endWrite( double timestamp );
+
+        // Consumer
+        bool open( const std::string & name );
+        bool acquireLatest( boost::uint32_t lastSequence );
+        bool isReplaced();
+        unsigned char * heldPixels();
+        boost::uint32_t heldSequence();
+        double heldTimestamp();
+
+        void close();
+        bool isOpen();
+        int width();
+        int height();
+        int stride();
+        blobEnums::PixelFormatEnum::Enum pixelFormat();
+        int numSlots();
+
+    private:
+        bool map( int fd, size_t size );
+        SharedFrameSlot * slot( int index );
+        unsigned char * slotPixels( int index );
+        void printError( const std::string & what );
+
+        // Not copyable (owns the mapping).
+        SharedFrameRing( const SharedFrameRing & );
+        SharedFrameRing & operator=( const SharedFrameRing & );
+
+        std::string name_;
+        bool isProducer_;
+        unsigned char * memory_;
+        size_t size_;
+        SharedFrameHeader * header_;
+        int writeSlot_,
+            heldSlot_;
+        boost::uint32_t nextSequence_,
+                        heldSequence_;
+        double heldTimestamp_;
+        dev_t device_;
+        ino_t inode_;
+    };
+}
+
+#endif
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+// SharedFrameSource
+//
+// PURPOSE: Reads frames that another process writes into a SharedFrameRing
+//          (Linux only).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobVideo/SharedFrameSource.h"
+#include "blobVideo/SharedFrameRing.h"
+#include <iostream>
+
+using blobVideo::SharedFrameSource;
+using blobEnums::PixelFormatEnum;
+
+// Calls to readFrame() with no new frame before checking whether the producer
+// was restarted under the same ring name.
+const int SharedFrameSource::IDLE_POLLS_BEFORE_CHECK = 30;
+
+SharedFrameSource::SharedFrameSource( const std::string & ringName ) :
+  ring_( new blobVideo::SharedFrameRing() ),
+  ringName_( ringName ),
+  lastSequence_( 0 ),
+  droppedFrames_( 0 ),
+  idlePolls_( 0 ),
+  isWaitingForRing_( false )
+{
+}
+
+SharedFrameSource::~SharedFrameSource()
+{
+    delete ring_;
+}
+
+/***************************************************************************//**
+Takes the latest frame from the ring if there is one that has not been read 
+yet, and returns true if so.  Does not wait.  If no frame has come for a while
+and the producer has put a new ring under the same name, the new ring is 
+opened.
+*******************************************************************************/
+bool SharedFrameSource::readFrame()
+{
+    if( !ring_->isOpen() && !openRing() ) {
+        return false;
+    }
+    if( !ring_->acquireLatest( lastSequence_ ) ) {
+        if( ring_->isOpen() && ++idlePolls_ >= IDLE_POLLS_BEFORE_CHECK ) {
+            idlePolls_ = 0;
+
+            if( ring_->isReplaced() ) {
+                std::cout << "SharedFrameSource: the producer of " << ringName_ << " went away.\n";
+                ring_->close();
+                openRing();
+            }
+        }
+        return false;
+    }
+    unsigned int sequence = ring_->heldSequence();
+    idlePolls_ = 0;
+
+    if( lastSequence_ != 0 ) {
+        droppedFrames_ += sequence - lastSequence_ - 1;
+    }
+    lastSequence_ = sequence;
+    return true;
+}
+
+bool SharedFrameSource::isOpen()
+{
+    return ring_->isOpen();
+}
+
+std::string SharedFrameSource::ringName()
+{
+    return ringName_;
+}
+
+int SharedFrameSource::width()
+{
+    return ring_->width();
+}
+
+int SharedFrameSource::height()
+{
+    return ring_->height();
+}
+
+PixelFormatEnum::Enum SharedFrameSource::pixelFormat()
+{
+    return ring_->pixelFormat();
+}
+
+unsigned char * SharedFrameSource::pixels()
+{
+    return ring_->heldPixels();
+}
+
+int SharedFrameSource::stride()
+{
+    return ring_->stride();
+}
+
+/***************************************************************************//**
+The timestamp that the producer gave the current frame.
+*******************************************************************************/
+double SharedFrameSource::timestamp()
+{
+    return ring_->heldTimestamp();
+}
+
+unsigned int SharedFrameSource::sequence()
+{
+    return lastSequence_;
+}
+
+unsigned int SharedFrameSource::droppedFrames()
+{
+    return droppedFrames_;
+}
+
+/***************************************************************************//**
+Opens the ring, printing a message the first time it is missing and when it is
+found (readFrame() tries again on every call until then).  The sequence count
+starts over, since a new producer numbers its frames from one.
+*******************************************************************************/
+bool SharedFrameSource::openRing()
+{
+    if( !ring_->open( ringName_ ) ) {
+        if( !isWaitingForRing_ ) {
+            std::cout << "SharedFrameSource: waiting for a producer to create " << ringName_ << "...\n";
+            isWaitingForRing_ = true;
+        }
+        return false;
+    }
+    std::cout << "SharedFrameSource: reading " << ring_->width() << "x" << ring_->height() << " "
+              << PixelFormatEnum::convertToString( ring_->pixelFormat() ) 
+              << " frames from " << ringName_ << ".\n";
+    isWaitingForRing_ = false;
+    lastSequence_ = 0;
+    idlePolls_ = 0;
+    return true;
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// SharedFrameSource
+//
+// PURPOSE: Reads frames that another process writes into a SharedFrameRing
+//          (Linux only).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBVIDEO_SHAREDFRAMESOURCE_H
+#define BLOBVIDEO_SHAREDFRAMESOURCE_H
+
+#include "blobVideo/FrameSource.h"
+#include <string>
+
+namespace blobVideo { class SharedFrameRing; }
+
+namespace blobVideo
+{
+    /***********************************************************************//**
+    Frames from camera software running in another process, which writes them
+    into a SharedFrameRing (see the SharedFrameProducer for an example).  The
+    pixels() point into the shared memory, so the frames are filtered without
+    a copy.
+
+    The ring is opened the first time readFrame() finds it, so the producer
+    can be started before or after BigBlobby, and is opened again if the 
+    producer is restarted (even if the old one died without closing the ring,
+    which is checked for after IDLE_POLLS_BEFORE_CHECK calls with no new 
+    frame).  Frames that the producer wrote but that were never read (because
+    the filters were still busy) are counted by droppedFrames().
+    ***************************************************************************/
+    class SharedFrameSource : public FrameSource
+    {
+    public:
+        static const int IDLE_POLLS_BEFORE_CHECK;
+
+        SharedFrameSource( const std::string & ringName );
+        virtual ~SharedFrameSource();
+
+        bool readFrame();
+        bool isOpen();
+        std::string ringName();
+
+        virtual int width();
+        virtual int height();
+        virtual blobEnums::PixelFormatEnum::Enum pixelFormat();
+        virtual unsigned char * pixels();
+        virtual int stride();
+        virtual double timestamp();
+        unsigned int sequence();
+        unsigned int droppedFrames();
+
+    private:
+        bool openRing();
+
+        // Not copyable (owns the SharedFrameRing).
+        SharedFrameSource( const SharedFrameSource & );
+        SharedFrameSource & operator=( const SharedFrameSource & );
+
+        SharedFrameRing * ring_;
+        std::string ringName_;
+        unsigned int lastSequence_,
+                     droppedFrames_;
+        int idlePolls_;
+        bool isWaitingForRing_;
+    };
+}
+
+#endif
@@ -145,12 +145,40 @@ bool SimpleVideoReader::isFrameNew()
     return isFrameNew_;
 }
 
+/***************************************************************************//**
+Returns how long (in seconds) until updateFrame() will read the next frame at
+the video's frame rate, so the caller can sleep until then.  Returns zero if 
+the next frame is already due.
+*******************************************************************************/
+double SimpleVideoReader::secondsUntilNextFrame()
+{
+    double seconds = minFrameTime_ - stopWatch_->elapsed();
+    return (seconds > 0.0) ? seconds : 0.0;
+}
+
 unsigned char * SimpleVideoReader::getPixels()
 {
     isFrameNew_ = false;
     return rgbPixels_;
 }
 
+/***************************************************************************//**
+The frames are decoded into a buffer with no row padding, with three bytes
+per pixel.
+*******************************************************************************/
+blobEnums::PixelFormatEnum::Enum SimpleVideoReader::pixelFormat()
+{
+    return blobEnums::PixelFormatEnum::RGB24;
+}
+
+/***************************************************************************//**
+Same as getPixels(), but leaves the new frame flag alone.
+*******************************************************************************/
+unsigned char * SimpleVideoReader::pixels()
+{
+    return rgbPixels_;
+}
+
 void SimpleVideoReader::close()
 {
     //std::cout << "\nSimpleVideoReader::close() called.\n\n";
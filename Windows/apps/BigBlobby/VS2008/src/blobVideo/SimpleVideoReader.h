@@ -45,6 +45,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BLOBVIDEO_VIDEOREADER_H
 #define BLOBVIDEO_VIDEOREADER_H
 
+#include "blobVideo/FrameSource.h"
 #include <string>
 
 namespace blobBuffers { class GrayBuffer; }
@@ -54,17 +55,20 @@ namespace blobUtils { class StopWatch; }
 
 namespace blobVideo
 {
-    class SimpleVideoReader
+    class SimpleVideoReader : public FrameSource
     {
     public:
         SimpleVideoReader();
-        ~SimpleVideoReader();
+        virtual ~SimpleVideoReader();
 
         bool init( const std::string & filename );
-        int width();
-        int height();
+        virtual int width();
+        virtual int height();
+        virtual blobEnums::PixelFormatEnum::Enum pixelFormat();
+        virtual unsigned char * pixels();
         void updateFrame();
         bool isFrameNew();
+        double secondsUntilNextFrame();
         unsigned char * getPixels();
         void close();
 
@@ -142,7 +142,7 @@ bool SimpleVideoWriter::processGrayscaleImage( blobBuffers::GrayBuffer * srcImag
             cols = srcImage->width();
 
         if(  cols == bufferWidth_ && rows == bufferHeight_ ) {
-            cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), cols );
+            cv::Mat srcM( rows, cols, CV_8U, srcImage->pixels(), srcImage->stride() );
             cv::Mat dstM( rows, cols, CV_8UC3, rgbPixels_, cols * RGB_BYTES );
             cv::cvtColor( srcM, dstM, CV_GRAY2RGB );
             flipIfRequested( dstM );
@@ -0,0 +1,474 @@
+////////////////////////////////////////////////////////////////////////////////
+// V4l2FrameSource
+//
+// PURPOSE: Reads camera frames through the Linux V4L2 streaming interface, using
+//          memory-mapped kernel buffers (Linux only).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "blobVideo/V4l2FrameSource.h"
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <linux/videodev2.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+using blobVideo::V4l2FrameSource;
+using blobEnums::PixelFormatEnum;
+
+// Enough buffers that the driver can keep filling while one frame is being 
+// filtered and another is waiting, without adding frames of latency.
+const int V4l2FrameSource::NUMBER_OF_BUFFERS = 4;
+
+V4l2FrameSource::V4l2FrameSource() :
+  fd_( -1 ),
+  deviceName_(),
+  buffers_(),
+  width_( 0 ),
+  height_( 0 ),
+  stride_( 0 ),
+  fourcc_( 0 ),
+  dequeuedIndex_( -1 ),
+  bytesUsed_( 0 ),
+  decodedM_( new cv::Mat() ),
+  timestamp_( 0.0 ),
+  sequence_( 0 ),
+  isStreaming_( false )
+{
+}
+
+V4l2FrameSource::~V4l2FrameSource()
+{
+    close();
+    delete decodedM_;
+}
+
+/***************************************************************************//**
+Opens /dev/video<deviceID>, asks for the given size and frame rate (the driver
+may pick the nearest it supports), maps the kernel buffers, and starts 
+streaming.  Returns false (and leaves the source closed) if the device is 
+missing or cannot stream in GREY, YUYV, or MJPEG.
+*******************************************************************************/
+bool V4l2FrameSource::open( int deviceID, int width, int height, int framesPerSecond )
+{
+    close();
+    std::ostringstream name;
+    name << "/dev/video" << deviceID;
+    deviceName_ = name.str();
+
+    fd_ = ::open( deviceName_.c_str(), O_RDWR | O_NONBLOCK );
+
+    if( fd_ < 0 ) {
+        printError( "open" );
+        return false;
+    }
+    struct v4l2_capability capability;
+    std::memset( &capability, 0, sizeof(capability) );
+
+    if( xioctl( VIDIOC_QUERYCAP, &capability ) < 0 
+        || (capability.capabilities & V4L2_CAP_VIDEO_CAPTURE) == 0
+        || (capability.capabilities & V4L2_CAP_STREAMING) == 0 ) 
+    {
+        std::cout << "V4l2FrameSource: " << deviceName_ << " is not a streaming capture device.\n";
+        close();
+        return false;
+    }
+    if( !setFormat( width, height ) ) {
+        std::cout << "V4l2FrameSource: " << deviceName_ << " does not support GREY, YUYV, or MJPEG.\n";
+        close();
+        return false;
+    }
+    setFrameRate( framesPerSecond );
+
+    if( !mapBuffers() || !startStreaming() ) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/***************************************************************************//**
+Stops streaming, unmaps the buffers, and closes the device.  Safe to call if
+the source is not open.
+*******************************************************************************/
+void V4l2FrameSource::close()
+{
+    if( fd_ >= 0 ) {
+        stopStreaming();
+        unmapBuffers();
+        ::close( fd_ );
+        fd_ = -1;
+    }
+    width_ = 0;
+    height_ = 0;
+    stride_ = 0;
+    fourcc_ = 0;
+    dequeuedIndex_ = -1;
+    bytesUsed_ = 0;
+    timestamp_ = 0.0;
+    sequence_ = 0;
+}
+
+bool V4l2FrameSource::isOpen()
+{
+    return fd_ >= 0 && isStreaming_;
+}
+
+/***************************************************************************//**
+Waits up to the given number of milliseconds (in select(), so no CPU is used 
+while waiting) for the driver to fill a buffer, then dequeues it.  Returns 
+true if there is a new frame.
+*******************************************************************************/
+bool V4l2FrameSource::waitForFrame( int millis )
+{
+    if( !isOpen() ) {
+        return false;
+    }
+    fd_set readSet;
+    FD_ZERO( &readSet );
+    FD_SET( fd_, &readSet );
+
+    struct timeval timeout;
+    timeout.tv_sec = millis / 1000;
+    timeout.tv_usec = (millis % 1000) * 1000;
+
+    int result = select( fd_ + 1, &readSet, NULL, NULL, &timeout );
+
+    if( result < 0 ) {
+        if( errno != EINTR ) {
+            printError( "select" );
+        }
+        return false;
+    }
+    if( result == 0 ) {
+        return false; // Timed out.
+    }
+    return dequeueBuffer();
+}
+
+int V4l2FrameSource::width()
+{
+    return width_;
+}
+
+int V4l2FrameSource::height()
+{
+    return height_;
+}
+
+/***************************************************************************//**
+MJPEG frames are decoded to gray, so they are reported as GRAY8.
+*******************************************************************************/
+PixelFormatEnum::Enum V4l2FrameSource::pixelFormat()
+{
+    if( fourcc_ == V4L2_PIX_FMT_YUYV ) {
+        return PixelFormatEnum::YUYV;
+    }
+    return PixelFormatEnum::GRAY8;
+}
+
+/***************************************************************************//**
+The mapped kernel buffer of the last frame dequeued (or the decoded image for
+MJPEG), or NULL if no frame has been dequeued yet.
+*******************************************************************************/
+unsigned char * V4l2FrameSource::pixels()
+{
+    if( dequeuedIndex_ < 0 ) {
+        return NULL;
+    }
+    if( fourcc_ == V4L2_PIX_FMT_MJPEG ) {
+        return decodedM_->empty() ? NULL : decodedM_->data;
+    }
+    return (unsigned char *)buffers_[dequeuedIndex_].start;
+}
+
+/***************************************************************************//**
+The bytesperline that the driver reported, which may include row padding.
+*******************************************************************************/
+int V4l2FrameSource::stride()
+{
+    if( fourcc_ == V4L2_PIX_FMT_MJPEG ) {
+        return (int)decodedM_->step;
+    }
+    return stride_;
+}
+
+/***************************************************************************//**
+The driver's timestamp of the last frame dequeued, in seconds.  Most drivers 
+use the monotonic clock (the clock is not the same as ofGetElapsedTimef()).
+*******************************************************************************/
+double V4l2FrameSource::timestamp()
+{
+    return timestamp_;
+}
+
+/***************************************************************************//**
+The driver's sequence number of the last frame dequeued.  A jump of more than
+one means that the driver dropped frames.
+*******************************************************************************/
+unsigned int V4l2FrameSource::sequence()
+{
+    return sequence_;
+}
+
+bool V4l2FrameSource::setFormat( int width, int height )
+{
+    return trySetFormat( V4L2_PIX_FMT_GREY, width, height )
+        || trySetFormat( V4L2_PIX_FMT_YUYV, width, height )
+        || trySetFormat( V4L2_PIX_FMT_MJPEG, width, height );
+}
+
+/***************************************************************************//**
+Asks for the given format, which the driver accepts by handing back the same
+pixelformat (it changes the pixelformat to one it supports otherwise).
+*******************************************************************************/
+bool V4l2FrameSource::trySetFormat( unsigned int fourcc, int width, int height )
+{
+    struct v4l2_format format;
+    std::memset( &format, 0, sizeof(format) );
+    format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    format.fmt.pix.width = width;
+    format.fmt.pix.height = height;
+    format.fmt.pix.pixelformat = fourcc;
+    format.fmt.pix.field = V4L2_FIELD_NONE;
+
+    if( xioctl( VIDIOC_S_FMT, &format ) < 0 || format.fmt.pix.pixelformat != fourcc ) {
+        return false;
+    }
+    fourcc_ = fourcc;
+    width_ = (int)format.fmt.pix.width;
+    height_ = (int)format.fmt.pix.height;
+    stride_ = (int)format.fmt.pix.bytesperline;
+
+    if( stride_ == 0 && fourcc != V4L2_PIX_FMT_MJPEG ) {
+        stride_ = width_ * PixelFormatEnum::bytesPerPixel( pixelFormat() );
+    }
+    return true;
+}
+
+/***************************************************************************//**
+Not every driver lets the frame rate be set, so a failure is ignored.
+*******************************************************************************/
+void V4l2FrameSource::setFrameRate( int framesPerSecond )
+{
+    if( framesPerSecond > 0 ) {
+        struct v4l2_streamparm parm;
+        std::memset( &parm, 0, sizeof(parm) );
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        parm.parm.capture.timeperframe.numerator = 1;
+        parm.parm.capture.timeperframe.denominator = framesPerSecond;
+        xioctl( VIDIOC_S_PARM, &parm );
+    }
+}
+
+bool V4l2FrameSource::mapBuffers()
+{
+    struct v4l2_requestbuffers request;
+    std::memset( &request, 0, sizeof(request) );
+    request.count = NUMBER_OF_BUFFERS;
+    request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    request.memory = V4L2_MEMORY_MMAP;
+
+    if( xioctl( VIDIOC_REQBUFS, &request ) < 0 ) {
+        printError( "VIDIOC_REQBUFS" );
+        return false;
+    }
+    if( request.count < 2 ) {
+        std::cout << "V4l2FrameSource: not enough buffers on " << deviceName_ << ".\n";
+        return false;
+    }
+    for( unsigned int i = 0; i < request.count; ++i ) {
+        struct v4l2_buffer buffer;
+        std::memset( &buffer, 0, sizeof(buffer) );
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        buffer.index = i;
+
+        if( xioctl( VIDIOC_QUERYBUF, &buffer ) < 0 ) {
+            printError( "VIDIOC_QUERYBUF" );
+            return false;
+        }
+        MappedBuffer mapped;
+        mapped.length = buffer.length;
+        mapped.start = mmap( NULL, buffer.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, buffer.m.offset );
+
+        if( mapped.start == MAP_FAILED ) {
+            printError( "mmap" );
+            return false;
+        }
+        buffers_.push_back( mapped );
+    }
+    return true;
+}
+
+void V4l2FrameSource::unmapBuffers()
+{
+    for( size_t i = 0; i < buffers_.size(); ++i ) {
+        munmap( buffers_[i].start, buffers_[i].length );
+    }
+    buffers_.clear();
+
+    // Lets the driver free its buffers.
+    struct v4l2_requestbuffers request;
+    std::memset( &request, 0, sizeof(request) );
+    request.count = 0;
+    request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    request.memory = V4L2_MEMORY_MMAP;
+    xioctl( VIDIOC_REQBUFS, &request );
+}
+
+bool V4l2FrameSource::startStreaming()
+{
+    for( int i = 0; i < (int)buffers_.size(); ++i ) {
+        if( !queueBuffer( i ) ) {
+            return false;
+        }
+    }
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+
+    if( xioctl( VIDIOC_STREAMON, &type ) < 0 ) {
+        printError( "VIDIOC_STREAMON" );
+        return false;
+    }
+    isStreaming_ = true;
+    return true;
+}
+
+void V4l2FrameSource::stopStreaming()
+{
+    if( isStreaming_ ) {
+        int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl( VIDIOC_STREAMOFF, &type ); // Also takes back every buffer.
+        isStreaming_ = false;
+    }
+    dequeuedIndex_ = -1;
+}
+
+/***************************************************************************//**
+Takes the next filled buffer from the driver.  The buffer of the previous frame
+is only given back to the driver after that, so the pixels() that the filters
+were reading are never overwritten while in use.
+*******************************************************************************/
+bool V4l2FrameSource::dequeueBuffer()
+{
+    struct v4l2_buffer buffer;
+    std::memset( &buffer, 0, sizeof(buffer) );
+    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+
+    if( xioctl( VIDIOC_DQBUF, &buffer ) < 0 ) {
+        if( errno != EAGAIN ) {
+            printError( "VIDIOC_DQBUF" );
+        }
+        return false;
+    }
+    if( (buffer.flags & V4L2_BUF_FLAG_ERROR) != 0 || buffer.index >= buffers_.size() ) {
+        queueBuffer( buffer.index ); // Corrupt frame.
+        return false;
+    }
+    if( dequeuedIndex_ >= 0 ) {
+        queueBuffer( dequeuedIndex_ );
+    }
+    dequeuedIndex_ = (int)buffer.index;
+    bytesUsed_ = (int)buffer.bytesused;
+    timestamp_ = buffer.timestamp.tv_sec + buffer.timestamp.tv_usec * 1.0e-6;
+    sequence_ = buffer.sequence;
+
+    if( fourcc_ == V4L2_PIX_FMT_MJPEG ) {
+        decodeMjpeg();
+    }
+    return true;
+}
+
+bool V4l2FrameSource::queueBuffer( int index )
+{
+    struct v4l2_buffer buffer;
+    std::memset( &buffer, 0, sizeof(buffer) );
+    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+    buffer.index = index;
+
+    if( xioctl( VIDIOC_QBUF, &buffer ) < 0 ) {
+        printError( "VIDIOC_QBUF" );
+        return false;
+    }
+    return true;
+}
+
+/***************************************************************************//**
+Decodes the compressed frame straight to gray.  If the frame cannot be decoded
+the last good frame is kept.
+*******************************************************************************/
+void V4l2FrameSource::decodeMjpeg()
+{
+    cv::Mat encodedM( 1, bytesUsed_, CV_8U, buffers_[dequeuedIndex_].start );
+    cv::Mat decodedM = cv::imdecode( encodedM, CV_LOAD_IMAGE_GRAYSCALE );
+
+    if( decodedM.cols == width_ && decodedM.rows == height_ ) {
+        *decodedM_ = decodedM;
+    }
+}
+
+/***************************************************************************//**
+ioctl() that is tried again if a signal interrupts it.
+*******************************************************************************/
+int V4l2FrameSource::xioctl( unsigned long request, void * arg )
+{
+    int result;
+
+    do {
+        result = ioctl( fd_, request, arg );
+    } while( result < 0 && errno == EINTR );
+
+    return result;
+}
+
+void V4l2FrameSource::printError( const std::string & what )
+{
+    std::cout << "V4l2FrameSource: " << what << " failed on " << deviceName_ 
+              << " (" << std::strerror( errno ) << ").\n";
+}
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// V4l2FrameSource
+//
+// PURPOSE: Reads camera frames through the Linux V4L2 streaming interface, using
+//          memory-mapped kernel buffers (Linux only).
+//
+// CREATED: 10/17/2026
+////////////////////////////////////////////////////////////////////////////////
+/*
+BigBlobby (GUI front end for Community Core Vision version 1.3)
+Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com> (BigBlobby classes)
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer as
+the first lines of this file unmodified.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+ 
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License, version 2.1.
+You should have received a copy of the GNU Lesser General Public License along
+with this program.  If not, go to 
+
+http://www.gnu.org/licenses/old-licenses/lgpl-2.1.en.html 
+
+or write to 
+ 
+Free Software  Foundation, Inc.
+59 Temple Place, Suite 330
+Boston, MA  02111-1307  USA
+ 
+THIS SOFTWARE IS PROVIDED BY NUI GROUP ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL BEN WOODHOUSE BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BLOBVIDEO_V4L2FRAMESOURCE_H
+#define BLOBVIDEO_V4L2FRAMESOURCE_H
+
+#include "blobVideo/FrameSource.h"
+#include <string>
+#include <vector>
+
+namespace cv { class Mat; }
+
+namespace blobVideo
+{
+    /***********************************************************************//**
+    Frames from a V4L2 camera (/dev/videoN), read with streaming I/O: the 
+    kernel fills a small ring of buffers that are mmap'd into this process, 
+    and waitForFrame() dequeues the next filled buffer.  The pixels() of a 
+    GREY or YUYV frame point straight into the mapped buffer, so the frame 
+    reaches the ImageFilters without a copy.  The buffer is handed back to the
+    kernel when the next frame is dequeued, so pixels() stay valid until then.
+
+    The formats are tried in the order GREY, YUYV, MJPEG.  MJPEG frames (the 
+    only format many USB cameras offer at higher frame rates) have to be 
+    decoded, so they are decoded straight to gray.
+
+    timestamp() is the time that the driver stamped the frame with, which is
+    closer to the exposure than the time the frame is processed.
+    ***************************************************************************/
+    class V4l2FrameSource : public FrameSource
+    {
+    public:
+        static const int NUMBER_OF_BUFFERS;
+
+        V4l2FrameSource();
+        virtual ~V4l2FrameSource();
+
+        bool open( int deviceID, int width, int height, int framesPerSecond );
+        void close();
+        bool isOpen();
+        bool waitForFrame( int millis );
+
+        virtual int width();
+        virtual int height();
+        virtual blobEnums::PixelFormatEnum::Enum pixelFormat();
+        virtual unsigned char * pixels();
+        virtual int stride();
+        virtual double timestamp();
+        unsigned int sequence();
+
+    private:
+        struct MappedBuffer
+        {
+            void * start;
+            size_t length;
+        };
+
+        bool setFormat( int width, int height );
+        bool trySetFormat( unsigned int fourcc, int width, int height );
+        void setFrameRate( int framesPerSecond );
+        bool mapBuffers();
+        void unmapBuffers();
+        bool startStreaming();
+        void stopStreaming();
+        bool dequeueBuffer();
+        bool queueBuffer( int index );
+        void decodeMjpeg();
+        int xioctl( unsigned long request, void * arg );
+        void printError( const std::string & what );
+
+        // Not copyable (owns a file descriptor and mapped memory).
+        V4l2FrameSource( const V4l2FrameSource & );
+        V4l2FrameSource & operator=( const V4l2FrameSource & );
+
+        int fd_;
+        std::string deviceName_;
+        std::vector<MappedBuffer> buffers_;
+        int width_,
+            height_,
+            stride_;
+        unsigned int fourcc_;
+        int dequeuedIndex_;
+        int bytesUsed_;
+        cv::Mat * decodedM_;
+        double timestamp_;
+        unsigned int sequence_;
+        bool isStreaming_;
+    };
+}
+
+#endif
@@ -122,6 +122,8 @@ float ofLerp(float start, float stop, float amt) {
     return start + (stop-start) * amt;
 }
 
+// the headless BigBlobby tracker has no window (ofAppRunner isn't linked)
+#ifndef BLOBBY_HEADLESS
 //--------------------------------------------------
 float ofRandomWidth() {
    return ofRandom(0, ofGetWidth());
@@ -131,3 +133,4 @@ float ofRandomWidth() {
 float ofRandomHeight() {
    return ofRandom(0, ofGetHeight());
 }
+#endif
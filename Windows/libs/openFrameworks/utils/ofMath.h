@@ -33,7 +33,9 @@ int			ofSign(float n);
 bool		ofInRange(float t, float min, float max);
 float		ofRadToDeg(float radians);
 float		ofDegToRad(float degrees);
+#ifndef BLOBBY_HEADLESS
 float		ofRandomWidth();
 float		ofRandomHeight();
+#endif
 
 #endif
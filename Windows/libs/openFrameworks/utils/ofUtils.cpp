@@ -1,5 +1,7 @@
 #include "ofUtils.h"
-#include "ofImage.h"
+#ifndef BLOBBY_HEADLESS
+	#include "ofImage.h"
+#endif
 
 #if defined(TARGET_OF_IPHONE) || defined(TARGET_OSX )
 	#include "sys/time.h"
@@ -271,6 +273,8 @@ string ofGetVersionInfo(){
 //---- new to 006
 //from the forums http://www.openframeworks.cc/forum/viewtopic.php?t=1413
 
+// the headless BigBlobby tracker has no window or GL context to grab
+#ifndef BLOBBY_HEADLESS
 //--------------------------------------------------
 void ofSaveScreen(string filename) {
    ofImage screen;
@@ -286,6 +290,7 @@ void ofSaveFrame(){
    ofSaveScreen(fileName);
    saveImageCounter++;
 }
+#endif
 
 //levels are currently:
 // see ofConstants.h
@@ -42,8 +42,10 @@ string  ofToString(int  value);
 
 string 	ofGetVersionInfo();
 
+#ifndef BLOBBY_HEADLESS
 void	ofSaveScreen(string filename);
 void	ofSaveFrame();
+#endif
 
 vector<string>	ofSplitString(const string & text, const string & delimiter);
 